@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cost_estimation/physical_cost_coefficients.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk.hpp"
+#include "storage/index/group_key/group_key_index.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+#include "utils/timer.hpp"
+
+/**
+ * Micro benchmarks for calibrating the PhysicalCostCoefficients of the CostEstimatorPhysical on a machine. Each
+ * benchmark reports the execution time per processed row in nanoseconds as its counter. The comments name the
+ * coefficients that the counters correspond to. Where an operator's cost comprises several coefficients, the
+ * difference between two benchmarks isolates one of them.
+ *
+ * After all other CostModelCalibration benchmarks, BM_CostModelCalibration_FitCoefficients fits the coefficients to
+ * the measured times, installs them in Hyrise::get().physical_cost_coefficients, and saves them to
+ * COEFFICIENTS_FILENAME (see physical_cost_coefficients.hpp).
+ */
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+constexpr auto SEED = size_t{17};
+constexpr auto ROW_COUNT = size_t{100'000};
+constexpr auto CHUNK_SIZE = ChunkOffset{10'000};
+// Each value occurs DUPLICATE_COUNT times on average, so that joins neither degenerate to key lookups nor explode
+constexpr auto DUPLICATE_COUNT = size_t{4};
+
+constexpr auto COEFFICIENTS_FILENAME = "cost_model_coefficients.json";
+
+struct CalibrationMeasurement {
+  double ns_per_row{};
+  size_t output_row_count{};
+};
+
+// Measurements of the benchmarks that ran so far, by benchmark
+std::map<std::string, CalibrationMeasurement>& calibration_measurements() {
+  static auto measurements = std::map<std::string, CalibrationMeasurement>{};
+  return measurements;
+}
+
+// Scales the @param coefficients, given with the number of times that they are incurred per row, so that the modeled
+// time per row matches the measured one. @param fixed_ns_per_row is the modeled time of the parts of the operator that
+// are not covered by the coefficients. If the measured time does not exceed it, the coefficients are not changed.
+void fit(const CalibrationMeasurement& measurement, const double fixed_ns_per_row,
+         std::initializer_list<std::pair<Cost*, double>> coefficients) {
+  auto modeled_ns_per_row = 0.0;
+  for (const auto& [coefficient, count_per_row] : coefficients) {
+    modeled_ns_per_row += *coefficient * count_per_row;
+  }
+
+  const auto scale = (measurement.ns_per_row - fixed_ns_per_row) / modeled_ns_per_row;
+  if (scale <= 0.0) return;
+
+  for (const auto& [coefficient, count_per_row] : coefficients) {
+    *coefficient = static_cast<Cost>(*coefficient * scale);
+  }
+}
+
+using namespace opossum::expression_functional;  // NOLINT
+
+// Generates a single-column table of random integers. If requested, the values are sorted within their chunks and
+// each chunk gets a GroupKeyIndex.
+std::shared_ptr<TableWrapper> create_calibration_table(const bool sorted, const bool indexed = false) {
+  std::default_random_engine random_engine(SEED);
+  std::uniform_int_distribution<int32_t> distribution(0, static_cast<int32_t>(ROW_COUNT / DUPLICATE_COUNT));
+
+  const auto table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data, CHUNK_SIZE);
+  for (auto chunk_begin = size_t{0}; chunk_begin < ROW_COUNT; chunk_begin += CHUNK_SIZE) {
+    auto values = pmr_vector<int32_t>(std::min(static_cast<size_t>(CHUNK_SIZE), ROW_COUNT - chunk_begin));
+    std::generate(values.begin(), values.end(), [&]() { return distribution(random_engine); });
+    if (sorted) std::sort(values.begin(), values.end());
+
+    table->append_chunk({std::make_shared<ValueSegment<int32_t>>(std::move(values))});
+    const auto chunk = table->last_chunk();
+    chunk->finalize();
+    if (sorted) chunk->set_individually_sorted_by(SortColumnDefinition(ColumnID{0}, SortMode::Ascending));
+    if (indexed) chunk->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  }
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+// Sets a counter that reports the time per processed row in nanoseconds
+void set_time_per_row_counter(benchmark::State& state, const size_t row_count) {
+  state.counters["ns_per_row"] = benchmark::Counter(static_cast<double>(row_count) / 1e9,
+                                                    benchmark::Counter::kIsIterationInvariantRate |
+                                                        benchmark::Counter::kInvert);
+}
+
+// Runs the operator created by @param make_operator and records its time per processed row as the measurement of
+// @param benchmark_name
+template <typename MakeOperator>
+void bm_cost_model_calibration(benchmark::State& state, const std::string& benchmark_name,
+                               const MakeOperator& make_operator) {
+  auto warm_up = make_operator();
+  warm_up->execute();
+
+  auto timer = Timer{};
+  for (auto _ : state) {
+    auto op = make_operator();
+    op->execute();
+  }
+  const auto duration = static_cast<double>(timer.lap().count());
+
+  calibration_measurements()[benchmark_name] = CalibrationMeasurement{
+      duration / static_cast<double>(state.iterations()) / static_cast<double>(ROW_COUNT),
+      warm_up->get_output()->row_count()};
+}
+
+template <typename JoinType>
+void bm_cost_model_calibration_join(benchmark::State& state, const std::string& benchmark_name,
+                                    const std::shared_ptr<TableWrapper>& left,
+                                    const std::shared_ptr<TableWrapper>& right) {
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  bm_cost_model_calibration(state, benchmark_name, [&]() {
+    return std::make_shared<JoinType>(left, right, JoinMode::Inner, primary_predicate);
+  });
+}
+
+template <typename AggregateType>
+void bm_cost_model_calibration_aggregate(benchmark::State& state, const std::string& benchmark_name,
+                                         const std::shared_ptr<TableWrapper>& input) {
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      std::static_pointer_cast<AggregateExpression>(count_(pqp_column_(ColumnID{0}, DataType::Int, false, "a")))};
+  const auto groupby = std::vector<ColumnID>{ColumnID{0}};
+  bm_cost_model_calibration(state, benchmark_name,
+                            [&]() { return std::make_shared<AggregateType>(input, aggregates, groupby); });
+}
+
+}  // namespace
+
+namespace opossum {
+
+// Each benchmark starts with a fresh Hyrise instance. The coefficients that BM_CostModelCalibration_FitCoefficients
+// installs are thus only reset before the next benchmark, not while they are in use.
+class CostModelCalibrationFixture : public benchmark::Fixture {
+ public:
+  void SetUp(::benchmark::State&) override { Hyrise::reset(); }
+};
+
+// Both inputs are of the same size: hash_build_per_row + hash_probe_per_row
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinHash)(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_join<JoinHash>(state, "JoinHash", create_calibration_table(false),
+                                           create_calibration_table(false));
+}
+
+// 2 * (cluster_per_row + merge_per_row) + sort_per_comparison * 2 * log2(ROW_COUNT)
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinSortMergeUnsorted)
+(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_join<JoinSortMerge>(state, "JoinSortMergeUnsorted", create_calibration_table(false),
+                                                create_calibration_table(false));
+}
+
+// 2 * merge_per_row
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinSortMergeSorted)(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_join<JoinSortMerge>(state, "JoinSortMergeSorted", create_calibration_table(true),
+                                                create_calibration_table(true));
+}
+
+// Per row of the left input: index_lookup_per_chunk * (ROW_COUNT / CHUNK_SIZE)
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinIndex)(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_join<JoinIndex>(state, "JoinIndex", create_calibration_table(false),
+                                            create_calibration_table(false, true));
+}
+
+// aggregate_per_row + aggregate_hash_per_row + aggregate_hash_per_group / DUPLICATE_COUNT
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_AggregateHash)(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_aggregate<AggregateHash>(state, "AggregateHash", create_calibration_table(false));
+}
+
+// aggregate_per_row + aggregate_sort_copy_per_row + aggregate_sort_boundary_per_row +
+// sort_per_comparison * log2(ROW_COUNT)
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_AggregateSort)(benchmark::State& state) {
+  set_time_per_row_counter(state, ROW_COUNT);
+  bm_cost_model_calibration_aggregate<AggregateSort>(state, "AggregateSort", create_calibration_table(false));
+}
+
+// Fits the coefficients to the times measured by the benchmarks above, in the order of the dependencies between them.
+// The costs of reading and writing rows, the read factors, and the nested loop coefficient are not calibrated.
+BENCHMARK_DEFINE_F(CostModelCalibrationFixture, BM_CostModelCalibration_FitCoefficients)
+(benchmark::State& state) {
+  auto& measurements = calibration_measurements();
+  for (const auto* const benchmark_name : {"JoinHash", "JoinSortMergeUnsorted", "JoinSortMergeSorted", "JoinIndex",
+                                           "AggregateHash", "AggregateSort"}) {
+    if (!measurements.contains(benchmark_name)) {
+      state.SkipWithError("All other CostModelCalibration benchmarks have to run before the coefficients are fitted");
+      return;
+    }
+  }
+
+  auto coefficients = PhysicalCostCoefficients{};
+  const auto row_count = static_cast<double>(ROW_COUNT);
+  const auto log_row_count = std::log2(row_count);
+  const auto output_ns_per_row = [&](const std::string& benchmark_name) {
+    return coefficients.output_per_row * static_cast<double>(measurements[benchmark_name].output_row_count) / row_count;
+  };
+  const auto group_count_per_row = static_cast<double>(measurements["AggregateHash"].output_row_count) / row_count;
+
+  fit(measurements["JoinHash"], 2 * coefficients.read_per_row + output_ns_per_row("JoinHash"),
+      {{&coefficients.hash_build_per_row, 1.0}, {&coefficients.hash_probe_per_row, 1.0}});
+
+  fit(measurements["JoinSortMergeSorted"], 2 * coefficients.read_per_row + output_ns_per_row("JoinSortMergeSorted"),
+      {{&coefficients.merge_per_row, 2.0}});
+
+  fit(measurements["JoinSortMergeUnsorted"],
+      2 * coefficients.read_per_row + 2 * coefficients.merge_per_row + output_ns_per_row("JoinSortMergeUnsorted"),
+      {{&coefficients.cluster_per_row, 2.0}, {&coefficients.sort_per_comparison, 2 * log_row_count}});
+
+  fit(measurements["JoinIndex"], coefficients.read_per_row + output_ns_per_row("JoinIndex"),
+      {{&coefficients.index_lookup_per_chunk, row_count / static_cast<double>(CHUNK_SIZE)}});
+
+  fit(measurements["AggregateHash"],
+      coefficients.read_per_row + coefficients.aggregate_per_row + output_ns_per_row("AggregateHash"),
+      {{&coefficients.aggregate_hash_per_row, 1.0}, {&coefficients.aggregate_hash_per_group, group_count_per_row}});
+
+  fit(measurements["AggregateSort"],
+      coefficients.read_per_row + coefficients.aggregate_per_row + output_ns_per_row("AggregateSort") +
+          coefficients.sort_per_comparison * log_row_count,
+      {{&coefficients.aggregate_sort_copy_per_row, 1.0}, {&coefficients.aggregate_sort_boundary_per_row, 1.0}});
+
+  // Later queries of this process use the calibrated coefficients, too
+  Hyrise::get().physical_cost_coefficients = coefficients;
+
+  for (auto _ : state) {
+    save_physical_cost_coefficients(coefficients, COEFFICIENTS_FILENAME);
+  }
+}
+
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinHash);
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinSortMergeUnsorted);
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinSortMergeSorted);
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_JoinIndex);
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_AggregateHash);
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_AggregateSort);
+// Registered last, so that it runs after the benchmarks whose measurements it fits the coefficients to
+BENCHMARK_REGISTER_F(CostModelCalibrationFixture, BM_CostModelCalibration_FitCoefficients)->Iterations(1);
+
+}  // namespace opossum
@@ -7,6 +7,8 @@
 #include "operators/limit.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/immediate_execution_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 #include "synthetic_table_generator.hpp"
@@ -89,11 +91,35 @@ static void BM_SortWithStrings(benchmark::State& state) {
   BM_Sort(state, row_count, DataType::String);
 }
 
+// Sorts with a NodeQueueScheduler that has state.range(1) workers. If the machine has fewer cores, the number of
+// workers is capped at the number of cores.
+static void BM_SortParallel(benchmark::State& state) {
+  const size_t row_count = state.range(0);
+  const auto worker_count = static_cast<uint32_t>(state.range(1));
+
+  Hyrise::get().topology.use_non_numa_topology(worker_count);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  BM_Sort(state, row_count);
+
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+  Hyrise::get().topology.use_default_topology();
+}
+
+static void SortParallelArguments(benchmark::internal::Benchmark* instance) {
+  for (const auto row_count : {1'000'000, 10'000'000}) {
+    for (const auto worker_count : {1, 2, 4, 8, 16, 32}) {
+      instance->Args({row_count, worker_count});
+    }
+  }
+}
+
 BENCHMARK(BM_Sort)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithNullValues)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegments)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegmentsTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithStrings)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_SortParallel)->Apply(SortParallelArguments)->UseRealTime();
 
 }  // namespace opossum
@@ -0,0 +1,159 @@
+#include <arpa/inet.h>
+#include <sys/resource.h>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "benchmark/benchmark.h"
+#include "hyrise.hpp"
+#include "micro_benchmark_basic_fixture.hpp"
+#include "server/server.hpp"
+#include "utils/assert.hpp"
+#include "utils/load_table.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Minimal client for the PostgreSQL wire protocol. It only supports simple queries and discards their results, which
+// keeps the client's overhead small compared to the server's work.
+class PostgresClient {
+ public:
+  PostgresClient(boost::asio::io_service& io_service, const uint16_t port) : _socket(io_service) {
+    _socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+    _socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+    // Startup message: message length, protocol version 3.0, and an empty list of parameters
+    auto message = std::string{};
+    _append_uint32(message, 9);
+    _append_uint32(message, 196'608);
+    message.push_back('\0');
+    boost::asio::write(_socket, boost::asio::buffer(message));
+    _read_until_ready_for_query();
+  }
+
+  ~PostgresClient() {
+    auto message = std::string{"X"};
+    _append_uint32(message, 4);
+    auto error = boost::system::error_code{};
+    boost::asio::write(_socket, boost::asio::buffer(message), error);
+    _socket.close(error);
+  }
+
+  PostgresClient(const PostgresClient&) = delete;
+  PostgresClient& operator=(const PostgresClient&) = delete;
+
+  void query(const std::string& sql) {
+    auto message = std::string{"Q"};
+    _append_uint32(message, static_cast<uint32_t>(sizeof(uint32_t) + sql.size() + 1));
+    message.append(sql);
+    message.push_back('\0');
+    boost::asio::write(_socket, boost::asio::buffer(message));
+    _read_until_ready_for_query();
+  }
+
+ private:
+  static void _append_uint32(std::string& message, const uint32_t value) {
+    const auto network_value = htonl(value);
+    message.append(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+  }
+
+  void _read_until_ready_for_query() {
+    while (true) {
+      auto header = std::array<char, 5>{};
+      boost::asio::read(_socket, boost::asio::buffer(header));
+
+      auto body_length = uint32_t{};
+      std::memcpy(&body_length, header.data() + 1, sizeof(body_length));
+      _body.resize(ntohl(body_length) - sizeof(body_length));
+      boost::asio::read(_socket, boost::asio::buffer(_body));
+
+      Assert(header[0] != 'E', "Query failed");
+      if (header[0] == 'Z') return;
+    }
+  }
+
+  boost::asio::ip::tcp::socket _socket;
+  std::vector<char> _body;
+};
+
+}  // namespace
+
+namespace opossum {
+
+// Measures how the latency of a client's queries develops with an increasing number of idle connections to the server.
+// Both the clients and the server run in this process and each connection uses two file descriptors. Thus, benchmarking
+// thousands of connections requires raising the limit of open files (ulimit -n).
+class ServerConnectionBenchmark : public MicroBenchmarkBasicFixture {
+ public:
+  void SetUp(::benchmark::State& state) override {
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+
+    // Port 0 to select random open port
+    _server = std::make_unique<Server>(boost::asio::ip::address_v4::loopback(), 0, SendExecutionInfo::No);
+    _server_thread = std::thread([&]() { _server->run(); });
+    while (!_server->is_initialized()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    const auto idle_connection_count = static_cast<size_t>(state.range(0));
+    // Each connection (including the measuring client's) needs two file descriptors, plus some headroom for others
+    auto open_file_limit = rlimit{};
+    getrlimit(RLIMIT_NOFILE, &open_file_limit);
+    Assert(open_file_limit.rlim_cur == RLIM_INFINITY || open_file_limit.rlim_cur > 2 * (idle_connection_count + 1) + 64,
+           "Raise the limit of open files (ulimit -n) to benchmark " + std::to_string(idle_connection_count) +
+               " idle connections");
+    _idle_clients.reserve(idle_connection_count);
+    for (auto client_id = size_t{0}; client_id < idle_connection_count; ++client_id) {
+      _idle_clients.emplace_back(std::make_unique<PostgresClient>(_io_service, _server->server_port()));
+    }
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    // The server waits for all sessions to be closed before it shuts down.
+    _idle_clients.clear();
+    _server->shutdown();
+    _server_thread.join();
+    _server.reset();
+
+    MicroBenchmarkBasicFixture::TearDown(state);
+  }
+
+ protected:
+  const std::string _query = "SELECT * FROM table_a WHERE a > 1000;";
+
+  boost::asio::io_service _io_service;
+  std::unique_ptr<Server> _server;
+  std::thread _server_thread;
+  std::vector<std::unique_ptr<PostgresClient>> _idle_clients;
+};
+
+BENCHMARK_DEFINE_F(ServerConnectionBenchmark, BM_QueryWithIdleConnections)(benchmark::State& state) {
+  auto client = PostgresClient{_io_service, _server->server_port()};
+  for (auto _ : state) {
+    client.query(_query);
+  }
+}
+BENCHMARK_REGISTER_F(ServerConnectionBenchmark, BM_QueryWithIdleConnections)
+    ->RangeMultiplier(4)
+    ->Range(1, 4096)
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(ServerConnectionBenchmark, BM_ConnectWithIdleConnections)(benchmark::State& state) {
+  for (auto _ : state) {
+    auto client = PostgresClient{_io_service, _server->server_port()};
+    client.query(_query);
+  }
+}
+BENCHMARK_REGISTER_F(ServerConnectionBenchmark, BM_ConnectWithIdleConnections)
+    ->RangeMultiplier(4)
+    ->Range(1, 4096)
+    ->UseRealTime();
+
+}  // namespace opossum
@@ -1,12 +1,22 @@
 #include "tpcc/tpcc_table_generator.hpp"
 
 #include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include "benchmark_runner.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "tpcc/constants.hpp"
 #include "tpcc/tpcc_benchmark_item_runner.hpp"
+#include "utils/format_duration.hpp"
+#include "utils/timer.hpp"
 
 using namespace opossum;  // NOLINT
 
@@ -26,13 +36,20 @@ using namespace opossum;  // NOLINT
  *
  * Most importantly, we do not claim to report correctly calculated tpmC.
  *
+ * With --scaling_clients, the benchmark is executed once per given number of clients (each time on freshly generated
+ * tables) and the number of committed transactions per second is reported for each client count. This is used to
+ * evaluate how well the transaction handling scales with the number of concurrent terminals. Read-only transactions
+ * do not acquire a commit id and are thus not counted.
+ *
  * main() is mostly concerned with parsing the CLI options while BenchmarkRunner.run() performs the actual benchmark
  * logic.
  */
 
 namespace {
+void run_client_scaling(const BenchmarkConfig& base_config, const nlohmann::json& context,
+                        const size_t num_warehouses, const std::vector<uint32_t>& client_counts);
 void check_consistency(const size_t num_warehouses);
-}
+}  // namespace
 
 int main(int argc, char* argv[]) {
   auto cli_options = BenchmarkRunner::get_basic_cli_options("TPC-C Benchmark");
@@ -41,12 +58,14 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
     // We use -s instead of -w for consistency with the options of our other TPC-x binaries.
     ("s,scale", "Scale factor (warehouses)", cxxopts::value<size_t>()->default_value("1")) // NOLINT
-    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("scaling_clients", "Comma-separated list of client counts (e.g., 1,8,64). Runs the benchmark for each count and reports the commits per second", cxxopts::value<std::string>()->default_value("")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> config;
   size_t num_warehouses;
   bool consistency_checks;
+  std::string comma_separated_client_counts;
 
   // Parse command line args
   const auto cli_parse_result = cli_options.parse(argc, argv);
@@ -55,9 +74,26 @@ int main(int argc, char* argv[]) {
 
   num_warehouses = cli_parse_result["scale"].as<size_t>();
   consistency_checks = cli_parse_result["consistency_checks"].as<bool>();
+  comma_separated_client_counts = cli_parse_result["scaling_clients"].as<std::string>();
 
   config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_cli_options(cli_parse_result));
 
+  auto client_counts = std::vector<uint32_t>{};
+  if (!comma_separated_client_counts.empty()) {
+    // Split the input into client counts, ignoring leading, trailing, or duplicate commas
+    auto client_counts_str = std::vector<std::string>();
+    boost::trim_if(comma_separated_client_counts, boost::is_any_of(","));
+    boost::split(client_counts_str, comma_separated_client_counts, boost::is_any_of(","), boost::token_compress_on);
+    for (const auto& client_count_str : client_counts_str) {
+      const auto client_count = boost::lexical_cast<uint32_t>(client_count_str);
+      Assert(client_count > 0, "Invalid value for --scaling_clients");
+      client_counts.emplace_back(client_count);
+    }
+
+    Assert(config->enable_scheduler, "--scaling_clients requires the scheduler (--scheduler)");
+    Assert(!config->verify, "Cannot run verification with more than one client");
+  }
+
   // As TPC-C procedures may run into conflicts on both the Hyrise and the SQLite side, we cannot guarantee that the
   // two databases stay in sync.
   Assert(!config->verify || config->clients == 1, "Cannot run verification with more than one client");
@@ -70,10 +106,14 @@ int main(int argc, char* argv[]) {
   context.emplace("scale_factor", num_warehouses);
 
   // Run the benchmark
-  auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
-  BenchmarkRunner(*config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config),
-                  context)
-      .run();
+  if (client_counts.empty()) {
+    auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
+    BenchmarkRunner(*config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config),
+                    context)
+        .run();
+  } else {
+    run_client_scaling(*config, context, num_warehouses, client_counts);
+  }
 
   if (consistency_checks || config->verify) {
     std::cout << "- Running consistency checks at the end of the benchmark" << std::endl;
@@ -83,6 +123,53 @@ int main(int argc, char* argv[]) {
 }
 
 namespace {
+void run_client_scaling(const BenchmarkConfig& base_config, const nlohmann::json& context,
+                        const size_t num_warehouses, const std::vector<uint32_t>& client_counts) {
+  auto results = nlohmann::json::array();
+
+  for (const auto client_count : client_counts) {
+    std::cout << "- Running TPC-C with " << client_count << " client(s)" << std::endl;
+
+    auto config = std::make_shared<BenchmarkConfig>(base_config);
+    config->clients = client_count;
+    // The per-run reports would overwrite each other. Instead, the scaling results are written below.
+    config->output_file_path = std::nullopt;
+
+    auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
+    auto benchmark_runner = BenchmarkRunner(*config, std::move(item_runner),
+                                            std::make_unique<TPCCTableGenerator>(num_warehouses, config), context);
+
+    // Warmup runs (if any) are included in both the commit count and the duration.
+    const auto first_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+    auto timer = Timer{};
+    benchmark_runner.run();
+    const auto duration = timer.lap();
+    const auto commit_count = Hyrise::get().transaction_manager.last_commit_id() - first_commit_id;
+
+    const auto commits_per_second =
+        static_cast<double>(commit_count) / std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+    std::cout << "  -> " << commit_count << " commits in " << format_duration(duration) << " (" << std::fixed
+              << std::setprecision(1) << commits_per_second << " commits/s)" << std::endl;
+
+    results.push_back({{"clients", client_count},
+                       {"commits", commit_count},
+                       {"duration", duration.count()},
+                       {"commits_per_second", commits_per_second}});
+  }
+
+  std::cout << "- Client scaling results" << std::endl;
+  std::cout << std::setw(10) << "clients" << std::setw(16) << "commits/s" << std::endl;
+  for (const auto& result : results) {
+    std::cout << std::setw(10) << result["clients"].get<uint32_t>() << std::setw(16) << std::fixed
+              << std::setprecision(1) << result["commits_per_second"].get<double>() << std::endl;
+  }
+
+  if (base_config.output_file_path) {
+    const auto report = nlohmann::json{{"context", context}, {"client_scaling", results}};
+    std::ofstream{*base_config.output_file_path} << std::setw(2) << report << std::endl;
+  }
+}
+
 template <typename T, typename = std::enable_if<std::is_floating_point_v<T>>>
 bool floats_near(T a, T b) {
   if (a == b) return true;
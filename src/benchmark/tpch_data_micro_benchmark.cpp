@@ -3,6 +3,7 @@
 #include "benchmark_config.hpp"
 #include "constant_mappings.hpp"
 #include "expression/aggregate_expression.hpp"
+#include "expression/evaluation/expression_evaluator.hpp"
 #include "expression/expression_functional.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/join_node.hpp"
@@ -89,6 +90,65 @@ class TPCHDataMicroBenchmarkFixture : public MicroBenchmarkBasicFixture {
     _lineitem_receiptdate = _lineitem_table_node->get_column("l_receiptdate");
   }
 
+  // Evaluates the expression on all chunks of lineitem, as the ExpressionEvaluatorTableScanImpl would
+  void evaluate_to_pos_lists(benchmark::State& state, const AbstractExpression& expression,
+                             const ExpressionEvaluator::EvaluationMode evaluation_mode) {
+    const auto lineitem_table = Hyrise::get().storage_manager.get_table("lineitem");
+    const auto chunk_count = lineitem_table->chunk_count();
+
+    for (auto _ : state) {
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        auto pos_list = ExpressionEvaluator{lineitem_table, chunk_id, {}, {}, evaluation_mode}
+                            .evaluate_expression_to_pos_list(expression);
+        benchmark::DoNotOptimize(pos_list);
+      }
+    }
+  }
+
+  // Evaluates the expressions on all chunks of lineitem, as the Projection would
+  void evaluate_to_segments(benchmark::State& state,
+                            const std::vector<std::shared_ptr<AbstractExpression>>& expressions,
+                            const ExpressionEvaluator::EvaluationMode evaluation_mode) {
+    const auto lineitem_table = Hyrise::get().storage_manager.get_table("lineitem");
+    const auto chunk_count = lineitem_table->chunk_count();
+
+    for (auto _ : state) {
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        auto segments = ExpressionEvaluator{lineitem_table, chunk_id, {}, {}, evaluation_mode}
+                            .evaluate_expressions_to_segments(expressions);
+        benchmark::DoNotOptimize(segments);
+      }
+    }
+  }
+
+  // Projections of TPC-H Q1: l_extendedprice * (1 - l_discount) and l_extendedprice * (1 - l_discount) * (1 + l_tax)
+  std::vector<std::shared_ptr<AbstractExpression>> tpchq1_projection_expressions() const {
+    const auto lineitem_table = Hyrise::get().storage_manager.get_table("lineitem");
+    const auto extendedprice = PQPColumnExpression::from_table(*lineitem_table, "l_extendedprice");
+    const auto discount = PQPColumnExpression::from_table(*lineitem_table, "l_discount");
+    const auto tax = PQPColumnExpression::from_table(*lineitem_table, "l_tax");
+
+    const auto discounted_price = mul_(extendedprice, sub_(1, discount));
+    return {discounted_price, mul_(discounted_price, add_(1, tax))};
+  }
+
+  // All predicates of TPC-H Q6 as a single conjunction
+  std::shared_ptr<AbstractExpression> tpchq6_predicate() const {
+    return and_(and_(_tpchq6_discount_predicate, _tpchq6_shipdate_less_predicate), _tpchq6_quantity_predicate);
+  }
+
+  // The lineitem predicates of TPC-H Q19 (without the part predicates and the join)
+  std::shared_ptr<AbstractExpression> tpchq19_predicate() const {
+    const auto lineitem_table = Hyrise::get().storage_manager.get_table("lineitem");
+    const auto quantity = PQPColumnExpression::from_table(*lineitem_table, "l_quantity");
+    const auto shipinstruct = PQPColumnExpression::from_table(*lineitem_table, "l_shipinstruct");
+    const auto shipmode = PQPColumnExpression::from_table(*lineitem_table, "l_shipmode");
+
+    return and_(and_(in_(shipmode, list_("AIR", "AIR REG")), equals_(shipinstruct, "DELIVER IN PERSON")),
+                or_(or_(between_inclusive_(quantity, 1, 11), between_inclusive_(quantity, 10, 20)),
+                    between_inclusive_(quantity, 20, 30)));
+  }
+
   // Required to avoid resetting of StorageManager in MicroBenchmarkBasicFixture::TearDown()
   void TearDown(::benchmark::State&) override {}
 
@@ -156,6 +216,34 @@ BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_TPCHQ6ThirdScanPredicate)(benchmar
   }
 }
 
+/**
+ * The following benchmarks compare the chunk-at-a-time and the batched mode of the ExpressionEvaluator on expressions
+ * taken from TPC-H queries
+ */
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ1ProjectionChunk)(benchmark::State& state) {
+  evaluate_to_segments(state, tpchq1_projection_expressions(), ExpressionEvaluator::EvaluationMode::Chunk);
+}
+
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ1ProjectionBatched)(benchmark::State& state) {
+  evaluate_to_segments(state, tpchq1_projection_expressions(), ExpressionEvaluator::EvaluationMode::Batched);
+}
+
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ6PredicateChunk)(benchmark::State& state) {
+  evaluate_to_pos_lists(state, *tpchq6_predicate(), ExpressionEvaluator::EvaluationMode::Chunk);
+}
+
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ6PredicateBatched)(benchmark::State& state) {
+  evaluate_to_pos_lists(state, *tpchq6_predicate(), ExpressionEvaluator::EvaluationMode::Batched);
+}
+
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ19PredicateChunk)(benchmark::State& state) {
+  evaluate_to_pos_lists(state, *tpchq19_predicate(), ExpressionEvaluator::EvaluationMode::Chunk);
+}
+
+BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_ExpressionEvaluatorTPCHQ19PredicateBatched)(benchmark::State& state) {
+  evaluate_to_pos_lists(state, *tpchq19_predicate(), ExpressionEvaluator::EvaluationMode::Batched);
+}
+
 BENCHMARK_F(TPCHDataMicroBenchmarkFixture, BM_TableScanIntegerOnPhysicalTable)(benchmark::State& state) {
   for (auto _ : state) {
     const auto table_scan = std::make_shared<TableScan>(_table_wrapper_map.at("lineitem"), _int_predicate);
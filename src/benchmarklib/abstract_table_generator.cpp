@@ -247,7 +247,7 @@ void AbstractTableGenerator::generate_and_store() {
 
       std::cout << "- Writing '" << table_name << "' into binary file " << binary_file_path << " " << std::flush;
       Timer per_table_timer;
-      BinaryWriter::write(*table_info.table, binary_file_path);
+      BinaryWriter::write_with_chunk_directory(*table_info.table, binary_file_path);
       std::cout << "(" << per_table_timer.lap_formatted() << ")" << std::endl;
     }
     metrics.binary_caching_duration = timer.lap();
@@ -289,7 +289,7 @@ void AbstractTableGenerator::generate_and_store() {
   if (_benchmark_config->indexes) {
     std::cout << "- Creating indexes" << std::endl;
     const auto& indexes_by_table = _indexes_by_table();
-    if (indexes_by_table.empty()) {
+    if (indexes_by_table.empty() && _table_indexes_by_table().empty()) {
       std::cout << "-  No indexes defined by benchmark" << std::endl;
     }
     for (const auto& [table_name, indexes] : indexes_by_table) {
@@ -318,6 +318,16 @@ void AbstractTableGenerator::generate_and_store() {
         std::cout << "(" << per_index_timer.lap_formatted() << ")" << std::endl;
       }
     }
+    for (const auto& [table_name, column_names] : _table_indexes_by_table()) {
+      const auto& table = table_info_by_name[table_name].table;
+
+      for (const auto& column_name : column_names) {
+        std::cout << "-  Creating table index on " << table_name << " [ " << column_name << " ] " << std::flush;
+        Timer per_index_timer;
+        table->create_table_index(table->column_id_by_name(column_name));
+        std::cout << "(" << per_index_timer.lap_formatted() << ")" << std::endl;
+      }
+    }
     metrics.index_duration = timer.lap();
     std::cout << "- Creating indexes done (" << format_duration(metrics.index_duration) << ")" << std::endl;
   } else {
@@ -334,6 +344,8 @@ std::shared_ptr<BenchmarkConfig> AbstractTableGenerator::create_benchmark_config
 
 AbstractTableGenerator::IndexesByTable AbstractTableGenerator::_indexes_by_table() const { return {}; }
 
+AbstractTableGenerator::TableIndexesByTable AbstractTableGenerator::_table_indexes_by_table() const { return {}; }
+
 AbstractTableGenerator::SortOrderByTable AbstractTableGenerator::_sort_order_by_table() const { return {}; }
 
 void AbstractTableGenerator::_add_constraints(
@@ -68,6 +68,12 @@ class AbstractTableGenerator {
   using IndexesByTable = std::map<std::string, std::vector<std::vector<std::string>>>;
   virtual IndexesByTable _indexes_by_table() const;
 
+  // Optionally, the benchmark may define table indexes (see Table::create_table_index()). Unlike the chunk indexes
+  // above, they cover the mutable chunks as well and are thus suited for tables that are inserted into. They are
+  // created together with the chunk indexes.
+  using TableIndexesByTable = std::map<std::string, std::vector<std::string>>;
+  virtual TableIndexesByTable _table_indexes_by_table() const;
+
   // Optionally, the benchmark may define tables (left side) that are sorted (aka. clustered) by one of their columns
   // (right side).
   using SortOrderByTable = std::map<std::string, std::string>;
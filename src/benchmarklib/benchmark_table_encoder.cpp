@@ -55,11 +55,8 @@ bool is_chunk_encoding_spec_satisfied(const ChunkEncodingSpec& expected_chunk_en
 
 namespace opossum {
 
-bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::shared_ptr<Table>& table,
-                                   const EncodingConfig& encoding_config) {
-  /**
-   * 1. Build the ChunkEncodingSpec, i.e. the Encoding to be used
-   */
+ChunkEncodingSpec BenchmarkTableEncoder::chunk_encoding_spec(const std::string& table_name, const Table& table,
+                                                             const EncodingConfig& encoding_config) {
   const auto& type_mapping = encoding_config.type_encoding_mapping;
   const auto& custom_mapping = encoding_config.custom_encoding_mapping;
 
@@ -68,10 +65,10 @@ bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::sha
 
   ChunkEncodingSpec chunk_encoding_spec;
 
-  for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
     // Check if a column specific encoding was specified
     if (table_has_custom_encoding) {
-      const auto& column_name = table->column_name(column_id);
+      const auto& column_name = table.column_name(column_id);
       const auto& encoding_by_column_name = column_mapping_it->second;
       const auto& segment_encoding = encoding_by_column_name.find(column_name);
       if (segment_encoding != encoding_by_column_name.end()) {
@@ -82,7 +79,7 @@ bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::sha
     }
 
     // Check if a type specific encoding was specified
-    const auto& column_data_type = table->column_data_type(column_id);
+    const auto& column_data_type = table.column_data_type(column_id);
     const auto& encoding_by_data_type = type_mapping.find(column_data_type);
     if (encoding_by_data_type != type_mapping.end()) {
       // The column type has a specific encoding
@@ -95,7 +92,7 @@ bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::sha
     if (encoding_supports_data_type(encoding_config.default_encoding_spec.encoding_type, column_data_type)) {
       chunk_encoding_spec.push_back(encoding_config.default_encoding_spec);
     } else {
-      std::cout << " - Column '" << table_name << "." << table->column_name(column_id) << "' of type ";
+      std::cout << " - Column '" << table_name << "." << table.column_name(column_id) << "' of type ";
       std::cout << column_data_type << " cannot be encoded as ";
       std::cout << encoding_config.default_encoding_spec.encoding_type << " and is ";
       std::cout << "left Unencoded." << std::endl;
@@ -103,6 +100,16 @@ bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::sha
     }
   }
 
+  return chunk_encoding_spec;
+}
+
+bool BenchmarkTableEncoder::encode(const std::string& table_name, const std::shared_ptr<Table>& table,
+                                   const EncodingConfig& encoding_config) {
+  /**
+   * 1. Build the ChunkEncodingSpec, i.e. the Encoding to be used
+   */
+  const auto chunk_encoding_spec = BenchmarkTableEncoder::chunk_encoding_spec(table_name, *table, encoding_config);
+
   /**
    * 2. Actually encode chunks
    */
@@ -92,7 +92,16 @@ std::unordered_map<std::string, BenchmarkTableInfo> FileBasedTableGenerator::gen
       if (extension == ".tbl") {
         table_info.table = load_table(*table_info.text_file_path, _benchmark_config->chunk_size);
       } else if (extension == ".csv") {
-        table_info.table = CsvParser::parse(*table_info.text_file_path, _benchmark_config->chunk_size);
+        // Files without a meta file get an inferred one. The chunks are encoded by the jobs that parse them, so that
+        // BenchmarkTableEncoder::encode() later finds them encoded already.
+        const auto& text_file_path = table_info.text_file_path->string();
+        const auto meta_file_path = text_file_path + CsvMeta::META_FILE_EXTENSION;
+        const auto meta = std::filesystem::exists(meta_file_path) ? process_csv_meta_file(meta_file_path)
+                                                                  : CsvParser::infer_meta(text_file_path);
+        const auto chunk_encoding_spec = BenchmarkTableEncoder::chunk_encoding_spec(
+            table_name, *CsvParser::create_table_from_meta(meta), _benchmark_config->encoding_config);
+        table_info.table =
+            CsvParser::parse(text_file_path, _benchmark_config->chunk_size, meta, chunk_encoding_spec);
       } else {
         Fail("Unknown textual file format. This should have been caught earlier.");
       }
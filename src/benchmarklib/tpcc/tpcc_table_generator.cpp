@@ -545,6 +545,16 @@ std::unordered_map<std::string, BenchmarkTableInfo> TPCCTableGenerator::generate
   return table_info_by_name;
 }
 
+AbstractTableGenerator::TableIndexesByTable TPCCTableGenerator::_table_indexes_by_table() const {
+  // The procedures look up orders and order lines by their order and customer ids. As new orders keep being inserted,
+  // chunk indexes would not cover the recent ones.
+  return {
+      {"ORDER", {"O_ID", "O_C_ID"}},
+      {"ORDER_LINE", {"OL_O_ID"}},
+      {"NEW_ORDER", {"NO_O_ID"}},
+  };
+}
+
 void TPCCTableGenerator::_add_constraints(
     std::unordered_map<std::string, BenchmarkTableInfo>& table_info_by_name) const {
   const auto& warehouse_table = table_info_by_name.at("WAREHOUSE").table;
@@ -5,6 +5,8 @@
 
 #include "benchmark_config.hpp"
 #include "cli_config_parser.hpp"
+#include "cost_estimation/physical_cost_coefficients.hpp"
+#include "hyrise.hpp"
 #include "server/server.hpp"
 #include "tpcc/tpcc_table_generator.hpp"
 #include "tpcds/tpcds_table_generator.hpp"
@@ -63,6 +65,9 @@ cxxopts::Options get_server_cli_options() {
                        "TPC-DS, and TPC-H. The sizing factor determines the scale factor in TPC-DS and TPC-H, and the "
                        "warehouse count in TPC-C.", cxxopts::value<std::string>()) // NOLINT
     ("execution_info", "Send execution information after statement execution", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("plan_cache", "Plan cache implementation: GDFS or Sharded (for many concurrent clients)", cxxopts::value<std::string>()->default_value("GDFS")) // NOLINT
+    ("session_threads", "Number of threads handling the network communication of all sessions. 0 means one thread per core", cxxopts::value<uint32_t>()->default_value("0")) // NOLINT
+    ("cost_coefficients", "JSON file with the cost model coefficients written by the CostModelCalibration micro benchmarks", cxxopts::value<std::string>()) // NOLINT
     ;  // NOLINT
   // clang-format on
 
@@ -91,15 +96,29 @@ int main(int argc, char* argv[]) {
     generate_benchmark_data(parsed_options["benchmark_data"].as<std::string>());
   }
 
+  if (parsed_options.count("cost_coefficients")) {
+    opossum::Hyrise::get().physical_cost_coefficients =
+        opossum::load_physical_cost_coefficients(parsed_options["cost_coefficients"].as<std::string>());
+  }
+
   const auto execution_info = parsed_options["execution_info"].as<bool>();
   const auto port = parsed_options["port"].as<uint16_t>();
+  const auto session_thread_count = parsed_options["session_threads"].as<uint32_t>();
+
+  auto plan_cache_name = parsed_options["plan_cache"].as<std::string>();
+  boost::algorithm::to_lower(plan_cache_name);
+  Assert(plan_cache_name == "gdfs" || plan_cache_name == "sharded",
+         "Unknown plan cache: " + parsed_options["plan_cache"].as<std::string>());
+  const auto plan_cache_type =
+      plan_cache_name == "gdfs" ? opossum::PlanCacheType::GDFS : opossum::PlanCacheType::Sharded;
 
   boost::system::error_code error;
   const auto address = boost::asio::ip::make_address(parsed_options["address"].as<std::string>(), error);
 
   Assert(!error, "Not a valid IPv4 address: " + parsed_options["address"].as<std::string>() + ", terminating...");
 
-  auto server = opossum::Server{address, port, static_cast<opossum::SendExecutionInfo>(execution_info)};
+  auto server = opossum::Server{address, port, static_cast<opossum::SendExecutionInfo>(execution_info), plan_cache_type,
+                                session_thread_count};
   server.run();
 
   return 0;
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "abstract_cache.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Cache implementation for caches that are accessed by many threads concurrently (e.g., the plan caches used by the
+ * server's sessions). The GDFSCache has to lock exclusively on every hit because it updates the priority of the entry
+ * in its heap. Instead, this cache
+ *   (1) splits the entries into shards by the hash of their key, each with its own lock,
+ *   (2) only takes a shared lock in try_get, as hits merely set an atomic reference flag and increment an atomic
+ *       counter (both are approximate, no ordering is guaranteed between concurrent accesses),
+ *   (3) evicts entries using the CLOCK policy (second chance), and
+ *   (4) admits a new entry to a full shard only if it has been accessed more often than the entry it would replace
+ *       (TinyLFU). The access frequencies of all keys, cached or not, are approximated using a count-min sketch with
+ *       saturating counters that are halved periodically so that old accesses lose their weight.
+ * As the capacity is distributed over the shards, a full shard may evict entries while other shards still have space.
+ */
+template <typename Key, typename Value>
+class ShardedCache : public AbstractCache<Key, Value> {
+ public:
+  using SnapshotEntry = typename AbstractCache<Key, Value>::SnapshotEntry;
+
+  explicit ShardedCache(size_t capacity = DEFAULT_CACHE_CAPACITY)
+      : AbstractCache<Key, Value>(capacity), _shards(_shard_count(capacity)) {
+    _distribute_capacity(capacity);
+  }
+
+  void set(const Key& key, const Value& value, double cost = 1.0, double size = 1.0) final {
+    const auto hash = std::hash<Key>{}(key);
+    auto& shard = _shard(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.sketch.increment(hash);
+    if (shard.capacity == 0) return;
+
+    const auto iter = shard.slot_ids.find(key);
+    if (iter != shard.slot_ids.end()) {
+      auto& entry = *shard.slots[iter->second];
+      entry.value = value;
+      entry.frequency.fetch_add(1, std::memory_order_relaxed);
+      entry.referenced.store(true, std::memory_order_relaxed);
+      return;
+    }
+
+    if (shard.slot_ids.size() < shard.capacity) {
+      shard.slot_ids.emplace(key, shard.slots.size());
+      shard.slots.emplace_back(std::make_unique<Entry>(key, value));
+      return;
+    }
+
+    // The shard is full. Only replace the CLOCK victim if the new key is accessed more frequently.
+    const auto victim_slot_id = _find_victim(shard);
+    auto& victim = shard.slots[victim_slot_id];
+    if (shard.sketch.estimate(hash) <= shard.sketch.estimate(std::hash<Key>{}(victim->key))) return;
+
+    shard.slot_ids.erase(victim->key);
+    victim = std::make_unique<Entry>(key, value);
+    shard.slot_ids.emplace(key, victim_slot_id);
+  }
+
+  std::optional<Value> try_get(const Key& key) final {
+    const auto hash = std::hash<Key>{}(key);
+    auto& shard = _shard(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    shard.sketch.increment(hash);
+
+    const auto iter = shard.slot_ids.find(key);
+    if (iter == shard.slot_ids.end()) return std::nullopt;
+
+    auto& entry = *shard.slots[iter->second];
+    entry.frequency.fetch_add(1, std::memory_order_relaxed);
+    entry.referenced.store(true, std::memory_order_relaxed);
+    return entry.value;
+  }
+
+  bool has(const Key& key) const final {
+    const auto& shard = _shard(std::hash<Key>{}(key));
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.slot_ids.contains(key);
+  }
+
+  size_t size() const final {
+    auto size = size_t{0};
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      size += shard.slot_ids.size();
+    }
+    return size;
+  }
+
+  void clear() final {
+    for (auto& shard : _shards) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.slot_ids.clear();
+      shard.slots.clear();
+      shard.clock_hand = 0;
+    }
+  }
+
+  void resize(size_t capacity) final {
+    auto locks = std::vector<std::unique_lock<std::shared_mutex>>{};
+    locks.reserve(_shards.size());
+    for (auto& shard : _shards) {
+      locks.emplace_back(shard.mutex);
+    }
+
+    this->_capacity = capacity;
+    _distribute_capacity(capacity);
+
+    for (auto& shard : _shards) {
+      while (shard.slot_ids.size() > shard.capacity) {
+        _evict(shard);
+      }
+
+      // Compact the slots so that new entries are appended again.
+      auto slots = std::vector<std::unique_ptr<Entry>>{};
+      slots.reserve(shard.capacity);
+      for (auto& slot : shard.slots) {
+        if (!slot) continue;
+        shard.slot_ids[slot->key] = slots.size();
+        slots.emplace_back(std::move(slot));
+      }
+      shard.slots = std::move(slots);
+      shard.clock_hand = 0;
+    }
+  }
+
+  std::unordered_map<Key, SnapshotEntry> snapshot() const final {
+    auto map_copy = std::unordered_map<Key, SnapshotEntry>{};
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      for (const auto& slot : shard.slots) {
+        if (!slot) continue;
+        map_copy[slot->key] = SnapshotEntry{slot->value, slot->frequency.load(std::memory_order_relaxed)};
+      }
+    }
+    return map_copy;
+  }
+
+ protected:
+  friend class CachePolicyTest;
+
+  static constexpr auto MAX_SHARD_COUNT = size_t{16};
+
+  struct Entry {
+    Entry(const Key& init_key, const Value& init_value) : key(init_key), value(init_value) {}
+
+    const Key key;
+    Value value;
+    std::atomic_size_t frequency{1};
+    std::atomic_bool referenced{true};
+  };
+
+  // Count-min sketch with four rows of saturating 4-bit counters (stored in a byte each for simplicity).
+  class FrequencySketch {
+   public:
+    void resize(const size_t capacity) {
+      auto width = size_t{16};
+      while (width < capacity * 4) {
+        width *= 2;
+      }
+      _counters = std::vector<std::atomic_uint8_t>(width * ROW_COUNT);
+      _width = width;
+      _sample_size = width * 2;
+      _increment_count = 0;
+    }
+
+    void increment(const size_t hash) {
+      for (auto row = size_t{0}; row < ROW_COUNT; ++row) {
+        auto& counter = _counters[_index(hash, row)];
+        // Concurrent increments may get lost. This is fine as the sketch is only an approximation anyway.
+        const auto count = counter.load(std::memory_order_relaxed);
+        if (count < MAX_COUNT) counter.store(count + 1, std::memory_order_relaxed);
+      }
+
+      // Age the counters. Only the thread that reaches the sample size halves them.
+      if (_increment_count.fetch_add(1, std::memory_order_relaxed) + 1 == _sample_size) {
+        for (auto& counter : _counters) {
+          counter.store(counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+        }
+        _increment_count.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    uint8_t estimate(const size_t hash) const {
+      auto estimate = MAX_COUNT;
+      for (auto row = size_t{0}; row < ROW_COUNT; ++row) {
+        estimate = std::min(estimate, _counters[_index(hash, row)].load(std::memory_order_relaxed));
+      }
+      return estimate;
+    }
+
+   private:
+    static constexpr auto ROW_COUNT = size_t{4};
+    static constexpr auto MAX_COUNT = uint8_t{15};
+
+    // Derives one index per row from the hash. The multiplication spreads the bits of weak hashes (e.g., std::hash for
+    // integers is the identity), the per-row seeds make the rows independent.
+    size_t _index(const size_t hash, const size_t row) const {
+      static constexpr auto SEEDS = std::array<size_t, ROW_COUNT>{0x9E3779B97F4A7C15, 0xC2B2AE3D27D4EB4F,
+                                                                  0x165667B19E3779F9, 0xD6E8FEB86659FD93};
+      const auto mixed_hash = (hash ^ (hash >> 32)) * SEEDS[row];
+      return row * _width + (mixed_hash >> 32) % _width;
+    }
+
+    std::vector<std::atomic_uint8_t> _counters;
+    size_t _width{0};
+    size_t _sample_size{0};
+    std::atomic_size_t _increment_count{0};
+  };
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    size_t capacity{0};
+
+    // Entries are stored in slots that the CLOCK hand iterates over. A slot is empty (i.e., nullptr) only after
+    // evictions during resize().
+    std::vector<std::unique_ptr<Entry>> slots;
+    std::unordered_map<Key, size_t> slot_ids;
+    size_t clock_hand{0};
+
+    FrequencySketch sketch;
+  };
+
+  std::vector<Shard> _shards;
+
+  // Use fewer shards for small caches so that every shard can hold at least one entry.
+  static size_t _shard_count(const size_t capacity) {
+    auto shard_count = size_t{1};
+    while (shard_count * 2 <= std::min(MAX_SHARD_COUNT, capacity)) {
+      shard_count *= 2;
+    }
+    return shard_count;
+  }
+
+  Shard& _shard(const size_t hash) { return _shards[_shard_id(hash)]; }
+
+  const Shard& _shard(const size_t hash) const { return _shards[_shard_id(hash)]; }
+
+  size_t _shard_id(const size_t hash) const {
+    // The shard count is a power of two. Use the upper bits so that the sketch (which uses the lower bits of the mixed
+    // hash) and the shard selection are independent.
+    return ((hash * 0x9E3779B97F4A7C15) >> 32) & (_shards.size() - 1);
+  }
+
+  // Splits the capacity evenly over the shards. Requires the shards to be locked or not yet shared.
+  void _distribute_capacity(const size_t capacity) {
+    const auto shard_count = _shards.size();
+    for (auto shard_id = size_t{0}; shard_id < shard_count; ++shard_id) {
+      auto& shard = _shards[shard_id];
+      shard.capacity = capacity / shard_count + (shard_id < capacity % shard_count ? 1 : 0);
+      shard.sketch.resize(shard.capacity);
+    }
+  }
+
+  // Returns the slot of the first entry that has not been referenced since the clock hand passed it last. Clears the
+  // reference flags of the entries that the hand passes. Requires the shard to be locked exclusively.
+  size_t _find_victim(Shard& shard) {
+    DebugAssert(!shard.slot_ids.empty(), "Cannot find a victim in an empty shard");
+    while (true) {
+      const auto slot_id = shard.clock_hand;
+      shard.clock_hand = (shard.clock_hand + 1) % shard.slots.size();
+
+      const auto& slot = shard.slots[slot_id];
+      if (!slot) continue;
+      if (!slot->referenced.exchange(false, std::memory_order_relaxed)) return slot_id;
+    }
+  }
+
+  void _evict(Shard& shard) {
+    const auto slot_id = _find_victim(shard);
+    shard.slot_ids.erase(shard.slots[slot_id]->key);
+    shard.slots[slot_id] = nullptr;
+  }
+
+  // Evicts an entry from the first non-empty shard.
+  void _evict() final {
+    for (auto& shard : _shards) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      if (shard.slot_ids.empty()) continue;
+
+      _evict(shard);
+      return;
+    }
+  }
+};
+
+}  // namespace opossum
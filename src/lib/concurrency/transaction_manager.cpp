@@ -1,10 +1,24 @@
 #include "transaction_manager.hpp"
 
+#include <algorithm>
+#include <thread>
+
 #include "commit_context.hpp"
 #include "storage/mvcc_data.hpp"
 #include "transaction_context.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+// Slot at which the calling thread starts probing for free (or its own) active snapshot slots.
+size_t first_active_snapshot_slot_id(const size_t slot_count) {
+  static thread_local const auto slot_id = (std::hash<std::thread::id>{}(std::this_thread::get_id()) *
+                                            size_t{0x9E3779B97F4A7C15}) >> 32;
+  return slot_id % slot_count;
+}
+
+}  // namespace
+
 namespace opossum {
 
 TransactionManager::TransactionManager()
@@ -13,7 +27,7 @@ TransactionManager::TransactionManager()
       _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)} {}
 
 TransactionManager::~TransactionManager() {
-  Assert(_active_snapshot_commit_ids.empty(),
+  Assert(_active_snapshot_commit_ids().empty(),
          "Some transactions do not seem to have finished yet as they are still registered as active.");
 }
 
@@ -21,7 +35,12 @@ TransactionManager& TransactionManager::operator=(TransactionManager&& transacti
   _next_transaction_id = transaction_manager._next_transaction_id.load();
   _last_commit_id = transaction_manager._last_commit_id.load();
   _last_commit_context = transaction_manager._last_commit_context;
-  _active_snapshot_commit_ids = transaction_manager._active_snapshot_commit_ids;
+  for (auto slot_id = size_t{0}; slot_id < ACTIVE_SNAPSHOT_SLOT_COUNT; ++slot_id) {
+    _active_snapshot_slots[slot_id].snapshot_commit_id =
+        transaction_manager._active_snapshot_slots[slot_id].snapshot_commit_id.load();
+  }
+  _overflowing_snapshot_commit_id_count = transaction_manager._overflowing_snapshot_commit_id_count.load();
+  _overflowing_snapshot_commit_ids = transaction_manager._overflowing_snapshot_commit_ids;
   return *this;
 }
 
@@ -33,35 +52,79 @@ std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context(
 }
 
 void TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-  _active_snapshot_commit_ids.insert(snapshot_commit_id);
+  DebugAssert(snapshot_commit_id != FREE_SLOT, "Snapshot-commit-id collides with the marker for free slots.");
+
+  const auto first_slot_id = first_active_snapshot_slot_id(ACTIVE_SNAPSHOT_SLOT_COUNT);
+  for (auto offset = size_t{0}; offset < ACTIVE_SNAPSHOT_SLOT_COUNT; ++offset) {
+    auto& slot = _active_snapshot_slots[(first_slot_id + offset) % ACTIVE_SNAPSHOT_SLOT_COUNT].snapshot_commit_id;
+    auto expected_commit_id = FREE_SLOT;
+    // Check before trying to claim the slot so that occupied cache lines are not written to.
+    if (slot.load(std::memory_order_relaxed) == FREE_SLOT &&
+        slot.compare_exchange_strong(expected_commit_id, snapshot_commit_id)) {
+      return;
+    }
+  }
+
+  // All slots are in use.
+  std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+  _overflowing_snapshot_commit_ids.insert(snapshot_commit_id);
+  ++_overflowing_snapshot_commit_id_count;
 }
 
 void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-
-  auto it = std::find(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end(), snapshot_commit_id);
+  // As transactions with the same snapshot-commit-id are indistinguishable here, we release any matching slot.
+  const auto first_slot_id = first_active_snapshot_slot_id(ACTIVE_SNAPSHOT_SLOT_COUNT);
+  for (auto offset = size_t{0}; offset < ACTIVE_SNAPSHOT_SLOT_COUNT; ++offset) {
+    auto& slot = _active_snapshot_slots[(first_slot_id + offset) % ACTIVE_SNAPSHOT_SLOT_COUNT].snapshot_commit_id;
+    auto expected_commit_id = snapshot_commit_id;
+    if (slot.load(std::memory_order_relaxed) == snapshot_commit_id &&
+        slot.compare_exchange_strong(expected_commit_id, FREE_SLOT)) {
+      return;
+    }
+  }
 
-  if (it != _active_snapshot_commit_ids.end()) {
-    _active_snapshot_commit_ids.erase(it);
-    return;
+  if (_overflowing_snapshot_commit_id_count > 0) {
+    std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+    const auto iter = _overflowing_snapshot_commit_ids.find(snapshot_commit_id);
+    if (iter != _overflowing_snapshot_commit_ids.end()) {
+      _overflowing_snapshot_commit_ids.erase(iter);
+      --_overflowing_snapshot_commit_id_count;
+      return;
+    }
   }
 
-  Assert(
-      it == _active_snapshot_commit_ids.end(),
-      "Could not find snapshot_commit_id in TransactionManager's _active_snapshot_commit_ids. Therefore, the removal "
+  Fail(
+      "Could not find snapshot_commit_id in TransactionManager's active snapshot-commit-ids. Therefore, the removal "
       "failed and the function should not have been called.");
 }
 
+std::unordered_multiset<CommitID> TransactionManager::_active_snapshot_commit_ids() const {
+  auto active_snapshot_commit_ids = std::unordered_multiset<CommitID>{};
+  for (const auto& slot : _active_snapshot_slots) {
+    const auto snapshot_commit_id = slot.snapshot_commit_id.load();
+    if (snapshot_commit_id != FREE_SLOT) active_snapshot_commit_ids.insert(snapshot_commit_id);
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+  active_snapshot_commit_ids.insert(_overflowing_snapshot_commit_ids.cbegin(), _overflowing_snapshot_commit_ids.cend());
+  return active_snapshot_commit_ids;
+}
+
 std::optional<CommitID> TransactionManager::get_lowest_active_snapshot_commit_id() const {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+  auto lowest_snapshot_commit_id = FREE_SLOT;
+  for (const auto& slot : _active_snapshot_slots) {
+    lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, slot.snapshot_commit_id.load());
+  }
 
-  if (_active_snapshot_commit_ids.empty()) {
-    return std::nullopt;
+  if (_overflowing_snapshot_commit_id_count > 0) {
+    std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+    for (const auto snapshot_commit_id : _overflowing_snapshot_commit_ids) {
+      lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, snapshot_commit_id);
+    }
   }
 
-  auto it = std::min_element(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end());
-  return *it;
+  if (lowest_snapshot_commit_id == FREE_SLOT) return std::nullopt;
+  return lowest_snapshot_commit_id;
 }
 
 /**
@@ -104,19 +167,38 @@ std::shared_ptr<CommitContext> TransactionManager::_new_commit_context() {
   return next_context;
 }
 
+/**
+ * Group commit
+ *
+ * Instead of publishing one pending context after the other, the thread that manages to commit a context also commits
+ * all pending contexts that directly follow it. Their commit ids are consecutive, so a single compare-and-swap on
+ * _last_commit_id makes the whole batch visible. If the compare-and-swap fails, another thread has already published
+ * (parts of) the batch or a preceding context is not pending yet. In both cases, the thread that publishes the
+ * preceding context continues with the following ones. Callbacks are only fired after the batch has been published.
+ */
 void TransactionManager::_try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context) {
   auto current_context = context;
 
   while (current_context->is_pending()) {
-    auto expected_last_commit_id = current_context->commit_id() - 1;
+    auto last_pending_context = current_context;
+    while (last_pending_context->has_next()) {
+      auto next_context = last_pending_context->next();
+      if (!next_context->is_pending()) break;
+      last_pending_context = std::move(next_context);
+    }
 
-    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+    auto expected_last_commit_id = current_context->commit_id() - 1;
+    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, last_pending_context->commit_id())) return;
 
-    current_context->fire_callback();
+    while (true) {
+      current_context->fire_callback();
+      if (current_context == last_pending_context) break;
+      current_context = current_context->next();
+    }
 
-    if (!current_context->has_next()) return;
+    if (!last_pending_context->has_next()) return;
 
-    current_context = current_context->next();
+    current_context = last_pending_context->next();
   }
 }
 
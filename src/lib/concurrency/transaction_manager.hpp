@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <unordered_set>
@@ -62,7 +64,8 @@ class TransactionManager : public Noncopyable {
   std::shared_ptr<TransactionContext> new_transaction_context(const AutoCommit auto_commit);
 
   /**
-   * Returns the lowest snapshot-commit-id currently used by a transaction.
+   * Returns the lowest snapshot-commit-id currently used by a transaction. Does not block, but a transaction that
+   * registers concurrently may or may not be considered.
    */
   std::optional<CommitID> get_lowest_active_snapshot_commit_id() const;
 
@@ -81,12 +84,15 @@ class TransactionManager : public Noncopyable {
   /**
    * The TransactionManager keeps track of issued snapshot-commit-ids,
    * which are in use by unfinished transactions.
-   * The following two functions are used to keep the multiset of active
+   * The following two functions are used to keep the set of active
    * snapshot-commit-ids up to date.
    */
   void _register_transaction(CommitID snapshot_commit_id);
   void _deregister_transaction(CommitID snapshot_commit_id);
 
+  // Returns all active snapshot-commit-ids. Only consistent if no transactions are registered concurrently.
+  std::unordered_multiset<CommitID> _active_snapshot_commit_ids() const;
+
   std::atomic<TransactionID> _next_transaction_id;
 
   std::atomic<CommitID> _last_commit_id;
@@ -96,7 +102,23 @@ class TransactionManager : public Noncopyable {
 
   std::shared_ptr<CommitContext> _last_commit_context;
 
-  mutable std::mutex _mutex_active_snapshot_commit_ids;
-  std::unordered_multiset<CommitID> _active_snapshot_commit_ids;
+  /**
+   * Active snapshot-commit-ids are stored in a fixed number of slots, which are claimed and released with a single
+   * compare-and-swap each. Threads start probing at a slot derived from their thread id so that concurrent
+   * transactions rarely compete for the same slot (or cache line). Finding the lowest active snapshot-commit-id only
+   * requires a scan over the slots. Only if all slots are in use, we fall back to the mutex-protected multiset.
+   */
+  static constexpr auto ACTIVE_SNAPSHOT_SLOT_COUNT = size_t{256};
+  static constexpr auto FREE_SLOT = std::numeric_limits<CommitID>::max();
+
+  struct alignas(64) ActiveSnapshotSlot {
+    std::atomic<CommitID> snapshot_commit_id{FREE_SLOT};
+  };
+
+  std::array<ActiveSnapshotSlot, ACTIVE_SNAPSHOT_SLOT_COUNT> _active_snapshot_slots;
+
+  mutable std::mutex _mutex_overflowing_snapshot_commit_ids;
+  std::atomic_size_t _overflowing_snapshot_commit_id_count{0};
+  std::unordered_multiset<CommitID> _overflowing_snapshot_commit_ids;
 };
 }  // namespace opossum
@@ -0,0 +1,223 @@
+#include "cost_estimator_physical.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "magic_enum.hpp"
+
+#include "expression/abstract_predicate_expression.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "statistics/abstract_cardinality_estimator.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of comparisons needed to sort row_count rows
+float sort_comparison_count(const float row_count) { return row_count * std::log2(std::max(row_count, 1.0f)); }
+
+}  // namespace
+
+namespace opossum {
+
+CostEstimatorPhysical::CostEstimatorPhysical(
+    const std::shared_ptr<AbstractCardinalityEstimator>& init_cardinality_estimator,
+    const PhysicalCostCoefficients& init_coefficients)
+    : AbstractCostEstimator(init_cardinality_estimator), coefficients(init_coefficients) {}
+
+std::shared_ptr<AbstractCostEstimator> CostEstimatorPhysical::new_instance() const {
+  return std::make_shared<CostEstimatorPhysical>(cardinality_estimator->new_instance(), coefficients);
+}
+
+Cost CostEstimatorPhysical::estimate_node_cost(const std::shared_ptr<AbstractLQPNode>& node) const {
+  switch (node->type) {
+    case LQPNodeType::Join: {
+      const auto join_node = std::static_pointer_cast<JoinNode>(node);
+      if (join_node->join_mode == JoinMode::Cross) break;
+
+      // JoinHash only supports equi joins
+      const auto& primary_predicate =
+          static_cast<const AbstractPredicateExpression&>(*join_node->join_predicates().front());
+      const auto sort_merge_cost = estimate_join_cost(join_node, OperatorType::JoinSortMerge);
+      if (primary_predicate.predicate_condition != PredicateCondition::Equals) return sort_merge_cost;
+      return std::min(estimate_join_cost(join_node, OperatorType::JoinHash), sort_merge_cost);
+    }
+
+    case LQPNodeType::Aggregate:
+      return estimate_aggregate_cost(std::static_pointer_cast<AggregateNode>(node), AggregateImplementation::Hash);
+
+    default:
+      break;
+  }
+
+  const auto output_row_count = cardinality_estimator->estimate_cardinality(node);
+  const auto left_input_row_count =
+      node->left_input() ? cardinality_estimator->estimate_cardinality(node->left_input()) : 0.0f;
+  const auto right_input_row_count =
+      node->right_input() ? cardinality_estimator->estimate_cardinality(node->right_input()) : 0.0f;
+
+  return coefficients.read_per_row * (left_input_row_count + right_input_row_count) +
+         coefficients.output_per_row * output_row_count;
+}
+
+Cost CostEstimatorPhysical::estimate_join_cost(const std::shared_ptr<JoinNode>& join_node,
+                                               const OperatorType join_operator_type,
+                                               const PhysicalInputProperties& input_properties) const {
+  Assert(join_node->join_mode != JoinMode::Cross, "Cross joins are not executed by join operators");
+
+  const auto left_row_count = cardinality_estimator->estimate_cardinality(join_node->left_input());
+  const auto right_row_count = cardinality_estimator->estimate_cardinality(join_node->right_input());
+  const auto output_row_count = cardinality_estimator->estimate_cardinality(join_node);
+
+  // The arguments of the primary predicate are not necessarily in the order of the inputs
+  const auto& primary_predicate = *join_node->join_predicates().front();
+  auto left_read_factor = _read_factor(*primary_predicate.arguments[0]);
+  auto right_read_factor = _read_factor(*primary_predicate.arguments[1]);
+  if (!join_node->left_input()->find_column_id(*primary_predicate.arguments[0])) {
+    std::swap(left_read_factor, right_read_factor);
+  }
+
+  const auto left_read_cost = coefficients.read_per_row * left_read_factor * left_row_count;
+  const auto right_read_cost = coefficients.read_per_row * right_read_factor * right_row_count;
+  const auto output_cost = coefficients.output_per_row * output_row_count;
+
+  switch (join_operator_type) {
+    case OperatorType::JoinHash: {
+      // For inner joins, the hash table is built for the smaller input. For all other join modes, the build side is
+      // determined by the join mode (see JoinHash::_on_execute()).
+      auto build_row_count = std::min(left_row_count, right_row_count);
+      switch (join_node->join_mode) {
+        case JoinMode::Left:
+        case JoinMode::Semi:
+        case JoinMode::AntiNullAsTrue:
+        case JoinMode::AntiNullAsFalse:
+          build_row_count = right_row_count;
+          break;
+        case JoinMode::Right:
+          build_row_count = left_row_count;
+          break;
+        default:
+          break;
+      }
+      const auto probe_row_count = left_row_count + right_row_count - build_row_count;
+
+      return left_read_cost + right_read_cost + coefficients.hash_build_per_row * build_row_count +
+             coefficients.hash_probe_per_row * probe_row_count + output_cost;
+    }
+
+    case OperatorType::JoinSortMerge: {
+      auto cost = left_read_cost + right_read_cost + coefficients.merge_per_row * (left_row_count + right_row_count) +
+                  output_cost;
+
+      // Inputs that are sorted within their chunks are merged without clustering and sorting them
+      if (!input_properties.sorted) {
+        cost += coefficients.cluster_per_row * (left_row_count + right_row_count) +
+                coefficients.sort_per_comparison *
+                    (sort_comparison_count(left_row_count) + sort_comparison_count(right_row_count));
+      }
+      return cost;
+    }
+
+    case OperatorType::JoinIndex:
+      // Each row of the left input is looked up in the index of every indexed chunk of the right input. Chunks without
+      // an index are joined with a nested loop.
+      return left_read_cost +
+             coefficients.index_lookup_per_chunk * left_row_count *
+                 static_cast<float>(input_properties.indexed_chunk_count) +
+             coefficients.nested_loop_per_pair * left_row_count * right_row_count *
+                 input_properties.unindexed_row_share +
+             output_cost;
+
+    case OperatorType::JoinNestedLoop:
+      return left_read_cost + right_read_cost +
+             coefficients.nested_loop_per_pair * left_row_count * right_row_count + output_cost;
+
+    default:
+      Fail("Not a join implementation: " + std::string{magic_enum::enum_name(join_operator_type)});
+  }
+}
+
+Cost CostEstimatorPhysical::estimate_aggregate_cost(const std::shared_ptr<AggregateNode>& aggregate_node,
+                                                    const AggregateImplementation aggregate_implementation,
+                                                    const PhysicalInputProperties& input_properties) const {
+  const auto input_row_count = cardinality_estimator->estimate_cardinality(aggregate_node->left_input());
+  const auto group_count = cardinality_estimator->estimate_cardinality(aggregate_node);
+
+  const auto group_by_column_count = aggregate_node->aggregate_expressions_begin_idx;
+  auto read_factor_sum = 0.0f;
+  for (auto expression_idx = size_t{0}; expression_idx < group_by_column_count; ++expression_idx) {
+    read_factor_sum += _read_factor(*aggregate_node->node_expressions[expression_idx]);
+  }
+
+  const auto cost = coefficients.read_per_row * read_factor_sum * input_row_count +
+                    coefficients.aggregate_per_row * input_row_count + coefficients.output_per_row * group_count;
+
+  // Without group-by columns, both implementations aggregate all rows in a single pass
+  if (group_by_column_count == 0) return cost;
+
+  switch (aggregate_implementation) {
+    case AggregateImplementation::Hash:
+      return cost + coefficients.aggregate_hash_per_row * input_row_count +
+             coefficients.aggregate_hash_per_group * group_count;
+
+    case AggregateImplementation::Sort: {
+      const auto boundary_cost = coefficients.aggregate_sort_boundary_per_row * input_row_count;
+
+      // Value-clustered inputs are sorted chunk by chunk, chunks that are already sorted are not sorted again
+      if (input_properties.value_clustered && input_properties.sorted) return cost + boundary_cost;
+      const auto sorted_run_length = input_properties.value_clustered
+                                         ? std::min(input_row_count, static_cast<float>(Chunk::DEFAULT_SIZE))
+                                         : input_row_count;
+      const auto run_count = sorted_run_length > 0.0f ? input_row_count / sorted_run_length : 0.0f;
+
+      return cost + boundary_cost + coefficients.aggregate_sort_copy_per_row * input_row_count +
+             coefficients.sort_per_comparison * run_count * sort_comparison_count(sorted_run_length);
+    }
+  }
+
+  Fail("Invalid enum value");
+}
+
+float CostEstimatorPhysical::_read_factor(const AbstractExpression& column_expression) const {
+  // Only columns of stored tables are encoded. All other columns (e.g., aggregates or projections) are materialized.
+  if (column_expression.type != ExpressionType::LQPColumn) return 1.0f;
+
+  const auto& lqp_column_expression = static_cast<const LQPColumnExpression&>(column_expression);
+  const auto original_node = lqp_column_expression.original_node.lock();
+  if (!original_node || original_node->type != LQPNodeType::StoredTable) return 1.0f;
+
+  const auto& table_name = static_cast<const StoredTableNode&>(*original_node).table_name;
+  const auto stored_column = StoredColumn{table_name, lqp_column_expression.original_column_id};
+  if (cost_estimation_by_lqp_cache) {
+    const auto read_factor_iter = _read_factor_by_stored_column.find(stored_column);
+    if (read_factor_iter != _read_factor_by_stored_column.end()) return read_factor_iter->second;
+  }
+
+  const auto table = Hyrise::get().storage_manager.get_table(table_name);
+
+  auto read_factor_sum = 0.0f;
+  auto segment_count = size_t{0};
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    const auto segment = chunk->get_segment(lqp_column_expression.original_column_id);
+    read_factor_sum += coefficients.read_factor_by_encoding.at(get_segment_encoding_spec(segment).encoding_type);
+    ++segment_count;
+  }
+
+  const auto read_factor = segment_count > 0 ? read_factor_sum / static_cast<float>(segment_count) : 1.0f;
+  if (cost_estimation_by_lqp_cache) _read_factor_by_stored_column.emplace(stored_column, read_factor);
+  return read_factor;
+}
+
+}  // namespace opossum
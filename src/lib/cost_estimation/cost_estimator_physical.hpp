@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+
+#include "abstract_cost_estimator.hpp"
+#include "operators/abstract_operator.hpp"
+#include "physical_cost_coefficients.hpp"
+
+namespace opossum {
+
+class AbstractExpression;
+class AggregateNode;
+class JoinNode;
+
+// The aggregate implementations share OperatorType::Aggregate, thus the CostEstimatorPhysical distinguishes them by
+// this enum. Join implementations are distinguished by their OperatorType.
+enum class AggregateImplementation { Hash, Sort };
+
+/**
+ * Physical properties of an operator's inputs that are not part of the LQP but affect the costs of the operator's
+ * implementations. The LQPTranslator determines them from the already translated input operators.
+ */
+struct PhysicalInputProperties {
+  // Joins: both inputs are sorted by the join columns within each chunk.
+  // Aggregates: the input is sorted by its only group-by column within each chunk.
+  bool sorted{false};
+
+  // Aggregates: all rows of a group are in the same chunk (see Table::value_clustered_by).
+  bool value_clustered{false};
+
+  // Joins: number of chunks of the right input that have an index on the join column, and the share of the right
+  // input's rows that are not covered by such an index.
+  size_t indexed_chunk_count{0};
+  float unindexed_row_share{1.0f};
+};
+
+/**
+ * Cost model for the physical operators that implement joins and aggregates. Costs approximate the execution time in
+ * nanoseconds. They are derived from the estimated cardinalities, the encodings of the accessed columns, and the
+ * PhysicalInputProperties. The PhysicalCostCoefficients can be calibrated for a machine with the
+ * CostModelCalibration micro benchmarks (see physical_cost_coefficients.hpp).
+ *
+ * All other nodes are costed by the number of rows that they read and write.
+ */
+class CostEstimatorPhysical : public AbstractCostEstimator {
+ public:
+  explicit CostEstimatorPhysical(const std::shared_ptr<AbstractCardinalityEstimator>& init_cardinality_estimator,
+                                 const PhysicalCostCoefficients& init_coefficients = {});
+
+  std::shared_ptr<AbstractCostEstimator> new_instance() const override;
+
+  /**
+   * Joins and aggregates are costed with their cheapest implementation, assuming inputs without physical properties.
+   */
+  Cost estimate_node_cost(const std::shared_ptr<AbstractLQPNode>& node) const override;
+
+  /**
+   * @return the estimated cost of executing @param join_node with the join implementation @param join_operator_type.
+   *         Whether the implementation supports the join is not checked.
+   */
+  Cost estimate_join_cost(const std::shared_ptr<JoinNode>& join_node, const OperatorType join_operator_type,
+                          const PhysicalInputProperties& input_properties = {}) const;
+
+  /**
+   * @return the estimated cost of executing @param aggregate_node with @param aggregate_implementation
+   */
+  Cost estimate_aggregate_cost(const std::shared_ptr<AggregateNode>& aggregate_node,
+                               const AggregateImplementation aggregate_implementation,
+                               const PhysicalInputProperties& input_properties = {}) const;
+
+  const PhysicalCostCoefficients coefficients;
+
+ private:
+  // Average factor by which reading the values of a column is slower than reading them from unencoded segments
+  float _read_factor(const AbstractExpression& column_expression) const;
+
+  // Read factors of stored columns by table name and column id. As determining them requires looking at every segment
+  // of the column, they are cached if guarantee_bottom_up_construction() was called, i.e., while a single plan is
+  // costed. Translating a plan costs every join with several implementations.
+  using StoredColumn = std::pair<std::string, ColumnID>;
+  mutable std::unordered_map<StoredColumn, float, boost::hash<StoredColumn>> _read_factor_by_stored_column;
+};
+
+}  // namespace opossum
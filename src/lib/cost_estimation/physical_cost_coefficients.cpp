@@ -0,0 +1,82 @@
+#include "physical_cost_coefficients.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "constant_mappings.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Keys of the coefficients in the JSON file, except for the read factors, which are stored by encoding
+const auto COST_COEFFICIENT_KEYS = std::vector<std::pair<std::string, Cost PhysicalCostCoefficients::*>>{
+    {"read_per_row", &PhysicalCostCoefficients::read_per_row},
+    {"output_per_row", &PhysicalCostCoefficients::output_per_row},
+    {"hash_build_per_row", &PhysicalCostCoefficients::hash_build_per_row},
+    {"hash_probe_per_row", &PhysicalCostCoefficients::hash_probe_per_row},
+    {"cluster_per_row", &PhysicalCostCoefficients::cluster_per_row},
+    {"sort_per_comparison", &PhysicalCostCoefficients::sort_per_comparison},
+    {"merge_per_row", &PhysicalCostCoefficients::merge_per_row},
+    {"index_lookup_per_chunk", &PhysicalCostCoefficients::index_lookup_per_chunk},
+    {"nested_loop_per_pair", &PhysicalCostCoefficients::nested_loop_per_pair},
+    {"aggregate_per_row", &PhysicalCostCoefficients::aggregate_per_row},
+    {"aggregate_hash_per_row", &PhysicalCostCoefficients::aggregate_hash_per_row},
+    {"aggregate_hash_per_group", &PhysicalCostCoefficients::aggregate_hash_per_group},
+    {"aggregate_sort_copy_per_row", &PhysicalCostCoefficients::aggregate_sort_copy_per_row},
+    {"aggregate_sort_boundary_per_row", &PhysicalCostCoefficients::aggregate_sort_boundary_per_row}};
+
+constexpr auto READ_FACTOR_KEY = "read_factor_by_encoding";
+
+}  // namespace
+
+namespace opossum {
+
+PhysicalCostCoefficients load_physical_cost_coefficients(const std::string& filename) {
+  std::ifstream file{filename};
+  Assert(file.good(), "Cost coefficients file does not exist: " + filename);
+  nlohmann::json json;
+  file >> json;
+  Assert(json.is_object(), "Cost coefficients file has to contain a JSON object: " + filename);
+
+  auto coefficients = PhysicalCostCoefficients{};
+  for (const auto& [key, value] : json.items()) {
+    if (key == READ_FACTOR_KEY) {
+      for (const auto& [encoding_name, read_factor] : value.items()) {
+        const auto encoding_iter = encoding_type_to_string.right.find(encoding_name);
+        Assert(encoding_iter != encoding_type_to_string.right.end(), "Unknown encoding: " + encoding_name);
+        coefficients.read_factor_by_encoding[encoding_iter->second] = read_factor.get<float>();
+      }
+      continue;
+    }
+
+    const auto key_iter = std::find_if(COST_COEFFICIENT_KEYS.cbegin(), COST_COEFFICIENT_KEYS.cend(),
+                                       [&](const auto& coefficient_key) { return coefficient_key.first == key; });
+    Assert(key_iter != COST_COEFFICIENT_KEYS.cend(), "Unknown cost coefficient: " + key);
+    coefficients.*(key_iter->second) = value.get<Cost>();
+  }
+
+  return coefficients;
+}
+
+void save_physical_cost_coefficients(const PhysicalCostCoefficients& coefficients, const std::string& filename) {
+  auto json = nlohmann::json::object();
+  for (const auto& [key, coefficient] : COST_COEFFICIENT_KEYS) {
+    json[key] = coefficients.*coefficient;
+  }
+  for (const auto& [encoding_type, read_factor] : coefficients.read_factor_by_encoding) {
+    json[READ_FACTOR_KEY][encoding_type_to_string.left.at(encoding_type)] = read_factor;
+  }
+
+  std::ofstream file{filename};
+  Assert(file.good(), "Cannot write cost coefficients file: " + filename);
+  file << json.dump(2) << std::endl;
+}
+
+}  // namespace opossum
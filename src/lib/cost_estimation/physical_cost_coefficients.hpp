@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "storage/encoding_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Coefficients of the CostEstimatorPhysical, all given in nanoseconds
+struct PhysicalCostCoefficients {
+  // Reading a value from an unencoded segment and writing a row of the output (i.e., its positions)
+  Cost read_per_row{5.0f};
+  Cost output_per_row{10.0f};
+
+  // Factor by which reading a value from a segment with the given encoding is slower than reading it from an
+  // unencoded segment
+  std::unordered_map<EncodingType, float> read_factor_by_encoding{
+      {EncodingType::Unencoded, 1.0f},        {EncodingType::Dictionary, 1.0f},
+      {EncodingType::RunLength, 1.5f},        {EncodingType::FixedStringDictionary, 1.2f},
+      {EncodingType::FrameOfReference, 1.2f}, {EncodingType::LZ4, 5.0f}};
+
+  // JoinHash: partitioning a row and inserting it into the hash table of the build input, and probing the hash
+  // table with a row of the probe input
+  Cost hash_build_per_row{40.0f};
+  Cost hash_probe_per_row{20.0f};
+
+  // JoinSortMerge: radix clustering a row, comparing two rows while sorting, and merging a row
+  Cost cluster_per_row{30.0f};
+  Cost sort_per_comparison{4.0f};
+  Cost merge_per_row{10.0f};
+
+  // JoinIndex: looking up a value of the probe input in the index of a single chunk
+  Cost index_lookup_per_chunk{50.0f};
+
+  // JoinNestedLoop: comparing a pair of rows
+  Cost nested_loop_per_pair{2.0f};
+
+  // Aggregates: updating the aggregate values with a row
+  Cost aggregate_per_row{15.0f};
+
+  // AggregateHash: looking up the group of a row in the hash table, and adding a new group to it
+  Cost aggregate_hash_per_row{15.0f};
+  Cost aggregate_hash_per_group{25.0f};
+
+  // AggregateSort: copying a row to sort the input (comparisons are costed with sort_per_comparison), and checking
+  // whether a row starts a new group
+  Cost aggregate_sort_copy_per_row{40.0f};
+  Cost aggregate_sort_boundary_per_row{5.0f};
+};
+
+/**
+ * The CostModelCalibration micro benchmarks fit the coefficients for the machine that they run on and save them as a
+ * JSON file. When loading the file, coefficients that it does not contain keep their default values. To use the
+ * coefficients for all queries, install them in Hyrise::get().physical_cost_coefficients before queries are
+ * translated (e.g., with `hyriseServer --cost_coefficients <file>`).
+ */
+PhysicalCostCoefficients load_physical_cost_coefficients(const std::string& filename);
+void save_physical_cost_coefficients(const PhysicalCostCoefficients& coefficients, const std::string& filename);
+
+}  // namespace opossum
@@ -0,0 +1,62 @@
+#include "correlated_subquery_results_cache.hpp"
+
+#include <mutex>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+CorrelatedSubqueryResultsCache::CorrelatedSubqueryResultsCache(const size_t capacity) : _capacity(capacity) {}
+
+std::shared_ptr<const Table> CorrelatedSubqueryResultsCache::try_get(
+    const AbstractOperator& pqp, const std::vector<AllTypeVariant>& parameter_values) {
+  {
+    std::shared_lock<std::shared_mutex> lock(_mutex);
+    const auto iter = _results.find(Key{&pqp, parameter_values});
+    if (iter != _results.end()) {
+      ++_hit_count;
+      return iter->second;
+    }
+  }
+
+  ++_miss_count;
+  return nullptr;
+}
+
+void CorrelatedSubqueryResultsCache::set(const AbstractOperator& pqp,
+                                         const std::vector<AllTypeVariant>& parameter_values,
+                                         const std::shared_ptr<const Table>& result) {
+  DebugAssert(result, "Expected a result table");
+  for (const auto& value : parameter_values) {
+    if (variant_is_null(value)) return;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  if (_results.size() >= _capacity) return;
+  _results.emplace(Key{&pqp, parameter_values}, result);
+}
+
+size_t CorrelatedSubqueryResultsCache::size() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _results.size();
+}
+
+size_t CorrelatedSubqueryResultsCache::hit_count() const { return _hit_count; }
+
+size_t CorrelatedSubqueryResultsCache::miss_count() const { return _miss_count; }
+
+bool CorrelatedSubqueryResultsCache::Key::operator==(const Key& other) const {
+  return pqp == other.pqp && parameter_values == other.parameter_values;
+}
+
+size_t CorrelatedSubqueryResultsCache::KeyHash::operator()(const Key& key) const {
+  auto hash = std::hash<const AbstractOperator*>{}(key.pqp);
+  for (const auto& value : key.parameter_values) {
+    boost::hash_combine(hash, std::hash<AllTypeVariant>{}(value));
+  }
+  return hash;
+}
+
+}  // namespace opossum
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class Table;
+
+/**
+ * Correlated subqueries are executed by the ExpressionEvaluator once per input row. As the result of a subquery only
+ * depends on the values of its parameters, an operator can share this cache between the evaluators of all chunks of
+ * one execution. The subquery is then only executed once per distinct combination of parameter values, which pays off
+ * if the correlated columns have few distinct values (e.g., TPC-H Q2 and Q17).
+ *
+ * The cache is bounded by the number of entries. Once it is full, further results are not cached. Results for
+ * parameter values that contain NULLs are never cached, as NULLs do not compare equal.
+ *
+ * Thread-safe. If two evaluators miss the same key concurrently, both execute the subquery and the first result is
+ * kept.
+ */
+class CorrelatedSubqueryResultsCache : private Noncopyable {
+ public:
+  static constexpr auto DEFAULT_CAPACITY = size_t{1'024};
+
+  explicit CorrelatedSubqueryResultsCache(const size_t capacity = DEFAULT_CAPACITY);
+
+  // Returns the cached result of `pqp` for the given parameter values or nullptr. Counts a hit or a miss.
+  std::shared_ptr<const Table> try_get(const AbstractOperator& pqp,
+                                       const std::vector<AllTypeVariant>& parameter_values);
+
+  void set(const AbstractOperator& pqp, const std::vector<AllTypeVariant>& parameter_values,
+           const std::shared_ptr<const Table>& result);
+
+  size_t size() const;
+  size_t hit_count() const;
+  size_t miss_count() const;
+
+ private:
+  struct Key {
+    const AbstractOperator* pqp;
+    std::vector<AllTypeVariant> parameter_values;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  const size_t _capacity;
+
+  mutable std::shared_mutex _mutex;
+  std::unordered_map<Key, std::shared_ptr<const Table>, KeyHash> _results;
+
+  std::atomic_size_t _hit_count{0};
+  std::atomic_size_t _miss_count{0};
+};
+
+}  // namespace opossum
@@ -1,7 +1,9 @@
 #include "expression_evaluator.hpp"
 
+#include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/variant/apply_visitor.hpp>
@@ -30,6 +32,8 @@
 #include "operators/abstract_operator.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_accessor.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/value_segment.hpp"
 #include "utils/assert.hpp"
@@ -139,11 +143,15 @@ namespace opossum {
 
 ExpressionEvaluator::ExpressionEvaluator(
     const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
-    const std::shared_ptr<const UncorrelatedSubqueryResults>& uncorrelated_subquery_results)
+    const std::shared_ptr<const UncorrelatedSubqueryResults>& uncorrelated_subquery_results,
+    const std::shared_ptr<CorrelatedSubqueryResultsCache>& correlated_subquery_results_cache,
+    const EvaluationMode evaluation_mode)
     : _table(table),
       _chunk(_table->get_chunk(chunk_id)),
       _chunk_id(chunk_id),
-      _uncorrelated_subquery_results(uncorrelated_subquery_results) {
+      _evaluation_mode(evaluation_mode),
+      _uncorrelated_subquery_results(uncorrelated_subquery_results),
+      _correlated_subquery_results_cache(correlated_subquery_results_cache) {
   _output_row_count = _chunk->size();
   _segment_materializations.resize(_chunk->column_count());
 }
@@ -323,13 +331,11 @@ ExpressionEvaluator::_evaluate_like_expression<ExpressionEvaluator::Bool>(const
     }
   } else if (!left_results->is_literal() && right_results->is_literal()) {
     // E.g., `a LIKE '%hello%'` -- A single matcher for all rows
-    LikeMatcher like_matcher{right_results->values.front()};
-
-    for (auto row_idx = ChunkOffset{0}; row_idx < result_size; ++row_idx) {
-      like_matcher.resolve(invert_results, [&](const auto& matcher) {
+    LikeMatcher{right_results->values.front()}.resolve(invert_results, [&](const auto& matcher) {
+      for (auto row_idx = ChunkOffset{0}; row_idx < result_size; ++row_idx) {
         result_values[row_idx] = matcher(left_results->values[row_idx]);
-      });
-    }
+      }
+    });
   } else {
     // E.g., `'hello' LIKE b` -- A new matcher for each row but the value to check is constant
     for (auto row_idx = ChunkOffset{0}; row_idx < result_size; ++row_idx) {
@@ -916,8 +922,11 @@ std::vector<std::shared_ptr<const Table>> ExpressionEvaluator::_evaluate_subquer
                   "All uncorrelated PQPSubqueryExpression should be cached if cache is present");
       return {table_iter->second};
     } else {
-      // If a subquery is uncorrelated, it has the same result for all rows, so we just execute it for the first row
-      return {_evaluate_subquery_expression_for_row(expression, ChunkOffset{0})};
+      // If a subquery is uncorrelated, it has the same result for all rows, so we just execute it for the first row.
+      // The result is kept for the following batches.
+      auto& result = _evaluated_uncorrelated_subquery_results[expression.pqp];
+      if (!result) result = _evaluate_subquery_expression_for_row(expression, ChunkOffset{0});
+      return {result};
     }
   }
 
@@ -956,6 +965,8 @@ std::shared_ptr<const Table> ExpressionEvaluator::_evaluate_subquery_expression_
          "Sub-SELECT references external Columns but Expression doesn't operate on a Table/Chunk");
 
   std::unordered_map<ParameterID, AllTypeVariant> parameters;
+  auto parameter_values = std::vector<AllTypeVariant>{};
+  parameter_values.reserve(expression.parameters.size());
 
   for (auto parameter_idx = size_t{0}; parameter_idx < expression.parameters.size(); ++parameter_idx) {
     const auto& parameter_id_column_id = expression.parameters[parameter_idx];
@@ -965,6 +976,16 @@ std::shared_ptr<const Table> ExpressionEvaluator::_evaluate_subquery_expression_
     const auto value = _segment_materializations[column_id]->value_as_variant(chunk_offset);
 
     parameters.emplace(parameter_id, value);
+    parameter_values.emplace_back(value);
+  }
+
+  // The result of a correlated subquery only depends on its parameter values. If another row (possibly of another
+  // chunk) had the same values, we can reuse its result.
+  const auto use_cache = _correlated_subquery_results_cache && expression.is_correlated();
+  if (use_cache) {
+    if (auto cached_result = _correlated_subquery_results_cache->try_get(*expression.pqp, parameter_values)) {
+      return cached_result;
+    }
   }
 
   auto row_pqp = expression.pqp;
@@ -978,44 +999,149 @@ std::shared_ptr<const Table> ExpressionEvaluator::_evaluate_subquery_expression_
   const auto tasks = OperatorTask::make_tasks_from_operator(row_pqp);
   Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
 
-  return row_pqp->get_output();
+  const auto result = row_pqp->get_output();
+  if (use_cache) _correlated_subquery_results_cache->set(*expression.pqp, parameter_values, result);
+
+  return result;
+}
+
+bool ExpressionEvaluator::_evaluates_in_batches() const {
+  return _evaluation_mode == EvaluationMode::Batched && _chunk && _chunk->size() > BATCH_SIZE;
+}
+
+template <typename Functor>
+void ExpressionEvaluator::_for_each_batch(const Functor& functor) {
+  DebugAssert(!_selection, "Batches cannot be nested in a selection");
+  const auto chunk_size = _chunk->size();
+
+  for (auto batch_begin = ChunkOffset{0}; batch_begin < chunk_size; batch_begin += BATCH_SIZE) {
+    _restrict_to_rows(batch_begin, std::min(BATCH_SIZE, static_cast<ChunkOffset>(chunk_size - batch_begin)));
+    functor();
+  }
+
+  _restrict_to_rows(ChunkOffset{0}, chunk_size);
+}
+
+template <typename Functor>
+auto ExpressionEvaluator::_with_selection(const std::shared_ptr<const RowIDPosList>& selection,
+                                          const Functor& functor) {
+  // Results of the currently evaluated rows are kept and restored afterwards, as the caller might still need them
+  auto segment_materializations = std::vector<std::shared_ptr<BaseExpressionResult>>(_chunk->column_count());
+  auto cached_expression_results = ConstExpressionUnorderedMap<std::shared_ptr<BaseExpressionResult>>{};
+  std::swap(segment_materializations, _segment_materializations);
+  std::swap(cached_expression_results, _cached_expression_results);
+  const auto previous_selection = std::exchange(_selection, selection);
+  const auto previous_output_row_count = std::exchange(_output_row_count, selection->size());
+
+  auto result = functor();
+
+  _segment_materializations = std::move(segment_materializations);
+  _cached_expression_results = std::move(cached_expression_results);
+  _selection = previous_selection;
+  _output_row_count = previous_output_row_count;
+
+  return result;
+}
+
+void ExpressionEvaluator::_restrict_to_rows(const ChunkOffset rows_begin, const ChunkOffset row_count) {
+  _rows_begin = rows_begin;
+  _output_row_count = row_count;
+  _batch_positions = nullptr;
+  std::fill(_segment_materializations.begin(), _segment_materializations.end(), nullptr);
+  _cached_expression_results.clear();
+}
+
+ChunkOffset ExpressionEvaluator::_chunk_offset(const ChunkOffset row_idx) const {
+  return _selection ? (*_selection)[row_idx].chunk_offset : _rows_begin + row_idx;
 }
 
 std::shared_ptr<BaseValueSegment> ExpressionEvaluator::evaluate_expression_to_segment(
     const AbstractExpression& expression) {
-  std::shared_ptr<BaseValueSegment> segment;
-  pmr_vector<bool> nulls;
+  return _evaluate_expressions_to_segments({&expression}).front();
+}
 
-  _resolve_to_expression_result_view(expression, [&](const auto& view) {
-    using ColumnDataType = typename std::decay_t<decltype(view)>::Type;
+std::vector<std::shared_ptr<BaseValueSegment>> ExpressionEvaluator::evaluate_expressions_to_segments(
+    const std::vector<std::shared_ptr<AbstractExpression>>& expressions) {
+  auto expression_ptrs = std::vector<const AbstractExpression*>(expressions.size());
+  std::transform(expressions.begin(), expressions.end(), expression_ptrs.begin(),
+                 [](const auto& expression) { return expression.get(); });
+  return _evaluate_expressions_to_segments(expression_ptrs);
+}
 
-    if constexpr (std::is_same_v<ColumnDataType, NullValue>) {
-      Fail("Can't create a Segment from a NULL");
-    } else {
-      pmr_vector<ColumnDataType> values(_output_row_count);
+std::vector<std::shared_ptr<BaseValueSegment>> ExpressionEvaluator::_evaluate_expressions_to_segments(
+    const std::vector<const AbstractExpression*>& expressions) {
+  const auto expression_count = expressions.size();
+  auto segments = std::vector<std::shared_ptr<BaseValueSegment>>(expression_count);
 
-      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-           ++chunk_offset) {
-        values[chunk_offset] = std::move(view.value(chunk_offset));
-      }
+  // The values and nulls of the output segments. Nulls are only materialized once a batch is nullable.
+  auto results = std::vector<std::shared_ptr<BaseExpressionResult>>(expression_count);
+  const auto row_count = _output_row_count;
+
+  const auto evaluate_rows = [&]() {
+    for (auto expression_idx = size_t{0}; expression_idx < expression_count; ++expression_idx) {
+      _resolve_to_expression_result_view(*expressions[expression_idx], [&](const auto& view) {
+        using ColumnDataType = typename std::decay_t<decltype(view)>::Type;
+
+        if constexpr (std::is_same_v<ColumnDataType, NullValue>) {
+          Fail("Can't create a Segment from a NULL");
+        } else {
+          if (!results[expression_idx]) {
+            results[expression_idx] =
+                std::make_shared<ExpressionResult<ColumnDataType>>(pmr_vector<ColumnDataType>(row_count));
+          }
+          auto& result = static_cast<ExpressionResult<ColumnDataType>&>(*results[expression_idx]);
 
-      if (view.is_nullable()) {
-        nulls.resize(_output_row_count);
-        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-             ++chunk_offset) {
-          nulls[chunk_offset] = view.is_null(chunk_offset);
+          for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+            result.values[_rows_begin + row_idx] = std::move(view.value(row_idx));
+          }
+
+          if (view.is_nullable()) {
+            result.nulls.resize(row_count);
+            for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+              result.nulls[_rows_begin + row_idx] = view.is_null(row_idx);
+            }
+          }
         }
-        segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(nulls));
+      });
+    }
+  };
+
+  if (_evaluates_in_batches()) {
+    _for_each_batch(evaluate_rows);
+  } else {
+    evaluate_rows();
+  }
+
+  for (auto expression_idx = size_t{0}; expression_idx < expression_count; ++expression_idx) {
+    resolve_data_type(expressions[expression_idx]->data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      auto& result = static_cast<ExpressionResult<ColumnDataType>&>(*results[expression_idx]);
+      if (result.nulls.empty()) {
+        segments[expression_idx] = std::make_shared<ValueSegment<ColumnDataType>>(std::move(result.values));
       } else {
-        segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+        segments[expression_idx] =
+            std::make_shared<ValueSegment<ColumnDataType>>(std::move(result.values), std::move(result.nulls));
       }
-    }
-  });
+    });
+  }
 
-  return segment;
+  return segments;
 }
 
 RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const AbstractExpression& expression) {
+  if (!_evaluates_in_batches()) return _evaluate_expression_to_pos_list(expression);
+
+  auto result_pos_list = RowIDPosList{};
+  _for_each_batch([&]() {
+    const auto batch_pos_list = _evaluate_expression_to_pos_list(expression);
+    result_pos_list.insert(result_pos_list.end(), batch_pos_list.begin(), batch_pos_list.end());
+  });
+
+  return result_pos_list;
+}
+
+RowIDPosList ExpressionEvaluator::_evaluate_expression_to_pos_list(const AbstractExpression& expression) {
   /**
    * Only Expressions returning a Bool can be evaluated to a PosList of matches.
    *
@@ -1059,14 +1185,13 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
 
               if constexpr (ExpressionFunctorType::template supports<ExpressionEvaluator::Bool, LeftDataType,
                                                                      RightDataType>::value) {
-                for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-                     ++chunk_offset) {
-                  if (left_result.is_null(chunk_offset) || right_result.is_null(chunk_offset)) continue;
+                for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+                  if (left_result.is_null(row_idx) || right_result.is_null(row_idx)) continue;
 
                   auto matches = ExpressionEvaluator::Bool{0};
-                  ExpressionFunctorType{}(matches, left_result.value(chunk_offset),  // NOLINT
-                                          right_result.value(chunk_offset));
-                  if (matches != 0) result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+                  ExpressionFunctorType{}(matches, left_result.value(row_idx),  // NOLINT
+                                          right_result.value(row_idx));
+                  if (matches != 0) result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
                 }
               } else {
                 Fail("Argument types not compatible");
@@ -1079,7 +1204,7 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
         case PredicateCondition::BetweenLowerExclusive:
         case PredicateCondition::BetweenUpperExclusive:
         case PredicateCondition::BetweenExclusive:
-          return evaluate_expression_to_pos_list(*rewrite_between_expression(expression));
+          return _evaluate_expression_to_pos_list(*rewrite_between_expression(expression));
 
         case PredicateCondition::IsNull:
         case PredicateCondition::IsNotNull: {
@@ -1087,14 +1212,12 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
 
           _resolve_to_expression_result_view(*is_null_expression.operand(), [&](const auto& result) {
             if (is_null_expression.predicate_condition == PredicateCondition::IsNull) {
-              for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-                   ++chunk_offset) {
-                if (result.is_null(chunk_offset)) result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+              for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+                if (result.is_null(row_idx)) result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
               }
             } else {  // PredicateCondition::IsNotNull
-              for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-                   ++chunk_offset) {
-                if (!result.is_null(chunk_offset)) result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+              for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+                if (!result.is_null(row_idx)) result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
               }
             }
           });
@@ -1112,10 +1235,9 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
           // b) Like/In are on the slower end anyway
           const auto result = evaluate_expression_to_result<ExpressionEvaluator::Bool>(expression);
           result->as_view([&](const auto& result_view) {
-            for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-                 ++chunk_offset) {
-              if (result_view.value(chunk_offset) != 0 && !result_view.is_null(chunk_offset)) {
-                result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+            for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+              if (result_view.value(row_idx) != 0 && !result_view.is_null(row_idx)) {
+                result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
               }
             }
           });
@@ -1125,9 +1247,12 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
 
     case ExpressionType::Logical: {
       const auto& logical_expression = static_cast<const LogicalExpression&>(expression);
+      if (_evaluation_mode == EvaluationMode::Batched && _chunk) {
+        return _evaluate_logical_expression_to_pos_list(logical_expression);
+      }
 
-      const auto left_pos_list = evaluate_expression_to_pos_list(*logical_expression.arguments[0]);
-      const auto right_pos_list = evaluate_expression_to_pos_list(*logical_expression.arguments[1]);
+      const auto left_pos_list = _evaluate_expression_to_pos_list(*logical_expression.arguments[0]);
+      const auto right_pos_list = _evaluate_expression_to_pos_list(*logical_expression.arguments[1]);
 
       switch (logical_expression.logical_operator) {
         case LogicalOperator::And:
@@ -1151,17 +1276,15 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
 
       const auto subquery_result_tables = _evaluate_subquery_expression_to_tables(*subquery_expression);
       if (subquery_expression->is_correlated()) {
-        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-             ++chunk_offset) {
-          if ((subquery_result_tables[chunk_offset]->row_count() > 0) ^ invert) {
-            result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+        for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+          if ((subquery_result_tables[row_idx]->row_count() > 0) ^ invert) {
+            result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
           }
         }
       } else {
         if ((subquery_result_tables.front()->row_count() > 0) ^ invert) {
-          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-               ++chunk_offset) {
-            result_pos_list.emplace_back(RowID{_chunk_id, chunk_offset});
+          for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+            result_pos_list.emplace_back(RowID{_chunk_id, _chunk_offset(row_idx)});
           }
         }
       }
@@ -1175,9 +1298,8 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
       // TRUE literal returns the entire Chunk, FALSE literal returns empty PosList
       if (boost::get<ExpressionEvaluator::Bool>(value_expression.value) != 0) {
         result_pos_list.resize(_output_row_count);
-        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(_output_row_count);
-             ++chunk_offset) {
-          result_pos_list[chunk_offset] = {_chunk_id, chunk_offset};
+        for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+          result_pos_list[row_idx] = {_chunk_id, _chunk_offset(row_idx)};
         }
       }
     } break;
@@ -1189,6 +1311,53 @@ RowIDPosList ExpressionEvaluator::evaluate_expression_to_pos_list(const Abstract
   return result_pos_list;
 }
 
+RowIDPosList ExpressionEvaluator::_evaluate_logical_expression_to_pos_list(const LogicalExpression& expression) {
+  /**
+   * The left operand decides some rows on its own: For AND, the rows where it is not TRUE do not match, for OR, the
+   * rows where it is TRUE do. The right operand is only evaluated for the remaining rows, which are passed as a
+   * selection vector. Thus, `a = 5 AND b LIKE '%x%'` evaluates the LIKE only for rows with a = 5.
+   */
+  const auto is_and = expression.logical_operator == LogicalOperator::And;
+  auto left_pos_list = _evaluate_expression_to_pos_list(*expression.arguments[0]);
+
+  const auto undecided_row_count = is_and ? left_pos_list.size() : _output_row_count - left_pos_list.size();
+  if (undecided_row_count == 0) return left_pos_list;
+
+  // No row was decided, so the right operand is evaluated for the same rows as the left one. Its intermediate results
+  // can be reused.
+  if (undecided_row_count == _output_row_count) return _evaluate_expression_to_pos_list(*expression.arguments[1]);
+
+  auto selection = std::shared_ptr<RowIDPosList>{};
+  if (is_and) {
+    selection = std::make_shared<RowIDPosList>(std::move(left_pos_list));
+  } else {
+    // Both the currently evaluated rows and left_pos_list are ordered by their ChunkOffsets, so the rows not in
+    // left_pos_list can be collected in a single pass
+    selection = std::make_shared<RowIDPosList>();
+    selection->reserve(undecided_row_count);
+    auto left_iter = left_pos_list.begin();
+    for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+      const auto chunk_offset = _chunk_offset(row_idx);
+      if (left_iter != left_pos_list.end() && left_iter->chunk_offset == chunk_offset) {
+        ++left_iter;
+        continue;
+      }
+      selection->emplace_back(RowID{_chunk_id, chunk_offset});
+    }
+  }
+  selection->guarantee_single_chunk();
+
+  auto right_pos_list = _with_selection(
+      selection, [&]() { return _evaluate_expression_to_pos_list(*expression.arguments[1]); });
+  if (is_and) return right_pos_list;
+
+  auto result_pos_list = RowIDPosList{};
+  result_pos_list.reserve(left_pos_list.size() + right_pos_list.size());
+  std::merge(left_pos_list.begin(), left_pos_list.end(), right_pos_list.begin(), right_pos_list.end(),
+             std::back_inserter(result_pos_list));
+  return result_pos_list;
+}
+
 template <>
 std::shared_ptr<ExpressionResult<ExpressionEvaluator::Bool>>
 ExpressionEvaluator::_evaluate_logical_expression<ExpressionEvaluator::Bool>(const LogicalExpression& expression) {
@@ -1378,6 +1547,8 @@ void ExpressionEvaluator::_materialize_segment_if_not_yet_materialized(const Col
   if (_segment_materializations[column_id]) return;
 
   const auto& segment = *_chunk->get_segment(column_id);
+  const auto evaluates_entire_chunk = !_selection && _rows_begin == 0 && _output_row_count == segment.size();
+  const auto is_reference_segment = dynamic_cast<const ReferenceSegment*>(&segment) != nullptr;
 
   resolve_data_type(segment.data_type(), [&](const auto column_data_type_t) {
     using ColumnDataType = typename decltype(column_data_type_t)::type;
@@ -1385,7 +1556,47 @@ void ExpressionEvaluator::_materialize_segment_if_not_yet_materialized(const Col
     pmr_vector<ColumnDataType> values;
     pmr_vector<bool> nulls;
 
-    if (const auto value_segment = dynamic_cast<const ValueSegment<ColumnDataType>*>(&segment)) {
+    if (_selection || (!evaluates_entire_chunk && is_reference_segment)) {
+      // Only materialize the selected rows or the rows of the current batch. Reference segments cannot be iterated
+      // with a position filter, so they are accessed row by row as well.
+      values.resize(_output_row_count);
+      if (_table->column_is_nullable(column_id)) nulls.resize(_output_row_count);
+
+      const auto segment_accessor = create_segment_accessor<ColumnDataType>(_chunk->get_segment(column_id));
+      for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+        auto value = segment_accessor->access(_chunk_offset(row_idx));
+        if (value) {
+          values[row_idx] = std::move(*value);
+        } else {
+          DebugAssert(!nulls.empty(), "Encountered NULL value in non-nullable column");
+          nulls[row_idx] = true;
+        }
+      }
+    } else if (!evaluates_entire_chunk) {
+      // Only materialize the current batch. Iterating over the entire segment and skipping to the batch would decode
+      // the segment (e.g., decompress all LZ4 blocks) once per batch.
+      values.resize(_output_row_count);
+      if (_table->column_is_nullable(column_id)) nulls.resize(_output_row_count);
+
+      if (!_batch_positions) {
+        _batch_positions = std::make_shared<RowIDPosList>(_output_row_count);
+        for (auto row_idx = ChunkOffset{0}; row_idx < static_cast<ChunkOffset>(_output_row_count); ++row_idx) {
+          (*_batch_positions)[row_idx] = RowID{_chunk_id, _rows_begin + row_idx};
+        }
+        _batch_positions->guarantee_single_chunk();
+      }
+
+      auto row_idx = ChunkOffset{0};
+      segment_iterate_filtered<ColumnDataType>(segment, _batch_positions, [&](const auto& position) {
+        if (position.is_null()) {
+          DebugAssert(!nulls.empty(), "Encountered NULL value in non-nullable column");
+          nulls[row_idx] = true;
+        } else {
+          values[row_idx] = position.value();
+        }
+        ++row_idx;
+      });
+    } else if (const auto value_segment = dynamic_cast<const ValueSegment<ColumnDataType>*>(&segment)) {
       // Shortcut
       values = pmr_vector<ColumnDataType>{value_segment->values()};
       if (_table->column_is_nullable(column_id)) {
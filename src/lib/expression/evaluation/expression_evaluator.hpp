@@ -6,6 +6,7 @@
 #include <boost/variant.hpp>
 
 #include "all_type_variant.hpp"
+#include "correlated_subquery_results_cache.hpp"
 #include "expression/logical_expression.hpp"
 #include "expression/pqp_subquery_expression.hpp"
 #include "expression_result.hpp"
@@ -41,6 +42,12 @@ class PQPColumnExpression;
  * Operates either
  *      - ...on a Chunk, thus returning a value for each row in it
  *      - ...without a Chunk, thus returning a single value (and failing if Columns are encountered in the Expression)
+ *
+ * In EvaluationMode::Batched (the default), evaluate_expression_to_segment(s)() and evaluate_expression_to_pos_list()
+ * process the Chunk in batches of BATCH_SIZE rows. Intermediate results are then materialized for one batch at a time
+ * and stay in the CPU caches instead of being written to and read from memory once per subexpression. Additionally,
+ * the second operand of AND/OR is only evaluated to a PosList for the rows that the first one did not decide yet
+ * (i.e., using a selection vector). EvaluationMode::Chunk materializes each subexpression for the entire Chunk.
  */
 class ExpressionEvaluator final {
  public:
@@ -55,6 +62,10 @@ class ExpressionEvaluator final {
   using UncorrelatedSubqueryResults =
       std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<const Table>>;
 
+  enum class EvaluationMode { Chunk, Batched };
+
+  static constexpr auto BATCH_SIZE = ChunkOffset{2'048};
+
   // For Expressions that do not reference any columns (e.g. in the LIMIT clause)
   ExpressionEvaluator() = default;
 
@@ -62,13 +73,24 @@ class ExpressionEvaluator final {
    * For Expressions that reference segments from a single table
    * @param uncorrelated_subquery_results  Results from pre-computed uncorrelated selects, so they do not need to be
    *                                     evaluated for every chunk. Solely for performance.
+   * @param correlated_subquery_results_cache  Cache for the results of correlated selects, shared by the evaluators
+   *                                           of all chunks of an operator. Solely for performance.
+   * @param evaluation_mode  See class comment
    */
-  ExpressionEvaluator(const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
-                      const std::shared_ptr<const UncorrelatedSubqueryResults>& uncorrelated_subquery_results = {});
+  ExpressionEvaluator(
+      const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
+      const std::shared_ptr<const UncorrelatedSubqueryResults>& uncorrelated_subquery_results = {},
+      const std::shared_ptr<CorrelatedSubqueryResultsCache>& correlated_subquery_results_cache = {},
+      const EvaluationMode evaluation_mode = EvaluationMode::Batched);
 
   std::shared_ptr<BaseValueSegment> evaluate_expression_to_segment(const AbstractExpression& expression);
   RowIDPosList evaluate_expression_to_pos_list(const AbstractExpression& expression);
 
+  // Evaluates multiple expressions batch by batch, so that common subexpressions (e.g., in TPC-H Q1) are computed
+  // only once per batch
+  std::vector<std::shared_ptr<BaseValueSegment>> evaluate_expressions_to_segments(
+      const std::vector<std::shared_ptr<AbstractExpression>>& expressions);
+
   template <typename Result>
   std::shared_ptr<ExpressionResult<Result>> evaluate_expression_to_result(const AbstractExpression& expression);
 
@@ -83,6 +105,27 @@ class ExpressionEvaluator final {
       const std::vector<std::shared_ptr<PQPSubqueryExpression>>& expressions);
 
  private:
+  // Evaluate for the rows the evaluator is currently restricted to, see _rows_begin and _selection
+  std::vector<std::shared_ptr<BaseValueSegment>> _evaluate_expressions_to_segments(
+      const std::vector<const AbstractExpression*>& expressions);
+  RowIDPosList _evaluate_expression_to_pos_list(const AbstractExpression& expression);
+  RowIDPosList _evaluate_logical_expression_to_pos_list(const LogicalExpression& expression);
+
+  bool _evaluates_in_batches() const;
+
+  // Restricts the evaluator to each batch of the Chunk in turn and calls @param functor for it
+  template <typename Functor>
+  void _for_each_batch(const Functor& functor);
+
+  // Restricts the evaluator to the rows in @param selection while calling @param functor
+  template <typename Functor>
+  auto _with_selection(const std::shared_ptr<const RowIDPosList>& selection, const Functor& functor);
+
+  void _restrict_to_rows(const ChunkOffset rows_begin, const ChunkOffset row_count);
+
+  // Maps the index of a row in the ExpressionResults to its offset in the Chunk
+  ChunkOffset _chunk_offset(const ChunkOffset row_idx) const;
+
   template <typename Result>
   std::shared_ptr<ExpressionResult<Result>> _evaluate_arithmetic_expression(const ArithmeticExpression& expression);
 
@@ -198,15 +241,32 @@ class ExpressionEvaluator final {
   std::shared_ptr<const Table> _table;
   std::shared_ptr<const Chunk> _chunk;
   const ChunkID _chunk_id;
+  const EvaluationMode _evaluation_mode{EvaluationMode::Chunk};
+
+  // The rows that are currently evaluated: Either the _output_row_count rows starting at _rows_begin (the entire Chunk
+  // or a batch of it) or, if set, the rows in _selection
+  ChunkOffset _rows_begin{0};
   size_t _output_row_count{1};
+  std::shared_ptr<const RowIDPosList> _selection;
+
+  // Positions of the current batch, created on the first segment materialization of each batch. Used as a position
+  // filter so that only the rows of the batch are decoded (and counted as accessed).
+  std::shared_ptr<RowIDPosList> _batch_positions;
 
-  // One entry for each segment in the _chunk, may be nullptr if the segment hasn't been materialized
+  // One entry for each segment in the _chunk, may be nullptr if the segment hasn't been materialized. Only contains
+  // the rows that are currently evaluated.
   std::vector<std::shared_ptr<BaseExpressionResult>> _segment_materializations;
 
   // Optionally, uncorrelated selects can be evaluated by the caller and passed in to the evaluator. This way, they
   // do not have to be executed multiple times by different evaluators
   const std::shared_ptr<const UncorrelatedSubqueryResults> _uncorrelated_subquery_results;
 
+  // If they were not passed in, uncorrelated selects are executed once per evaluator and not once per batch
+  UncorrelatedSubqueryResults _evaluated_uncorrelated_subquery_results;
+
+  // Optionally, the results of correlated selects are cached per combination of parameter values
+  const std::shared_ptr<CorrelatedSubqueryResultsCache> _correlated_subquery_results_cache;
+
   // Some expressions can be reused, either in the same result column (SELECT (a+3)*(a+3)), or across columns
   // (TPC-H Q1)
   ConstExpressionUnorderedMap<std::shared_ptr<BaseExpressionResult>> _cached_expression_results;
@@ -1,14 +1,168 @@
 #include "like_matcher.hpp"
 
+#include <array>
+#include <bit>
+#include <cstring>
 #include <optional>
 #include <utility>
 
-#include <boost/algorithm/string/replace.hpp>
-
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+LikeMatcher::GeneralPattern compile_general_pattern(const pmr_string& pattern) {
+  auto general_pattern = LikeMatcher::GeneralPattern{};
+  general_pattern.leading_any_chars = !pattern.empty() && pattern.front() == '%';
+  general_pattern.trailing_any_chars = !pattern.empty() && pattern.back() == '%';
+
+  auto segment_begin = size_t{0};
+  while (segment_begin < pattern.size()) {
+    auto segment_end = pattern.find('%', segment_begin);
+    if (segment_end == pmr_string::npos) segment_end = pattern.size();
+
+    if (segment_end > segment_begin) {
+      auto characters = pattern.substr(segment_begin, segment_end - segment_begin);
+
+      // Find the longest run of characters without '_' as the anchor for the search
+      auto anchor_offset = size_t{0};
+      auto anchor_size = size_t{0};
+      auto run_begin = size_t{0};
+      for (auto char_idx = size_t{0}; char_idx <= characters.size(); ++char_idx) {
+        if (char_idx < characters.size() && characters[char_idx] != '_') continue;
+        if (char_idx - run_begin > anchor_size) {
+          anchor_offset = run_begin;
+          anchor_size = char_idx - run_begin;
+        }
+        run_begin = char_idx + 1;
+      }
+
+      auto anchor_searcher = LikeMatcher::Searcher{characters.substr(anchor_offset, anchor_size)};
+      general_pattern.segments.push_back({std::move(characters), anchor_offset, std::move(anchor_searcher)});
+    }
+
+    segment_begin = segment_end + 1;
+  }
+
+  return general_pattern;
+}
+
+}  // namespace
+
+LikeMatcher::Searcher::Searcher(const pmr_string& needle) : _needle(needle) {}
+
+size_t LikeMatcher::Searcher::find(const std::string_view& string, const size_t offset) const {
+  const auto needle_size = _needle.size();
+  if (offset > string.size() || string.size() - offset < needle_size) return std::string_view::npos;
+  if (needle_size == 0) return offset;
+
+  const auto* const string_data = string.data();
+  const auto* const needle_data = _needle.data();
+  const auto first_char = needle_data[0];
+  const auto last_char = needle_data[needle_size - 1];
+
+  // Process blocks of BLOCK_SIZE candidate positions. For each position, a bit in `mask` is set if the first and the
+  // last character of the needle match. Only for these, the characters in between are compared.
+  constexpr auto BLOCK_SIZE = size_t{32};
+  const auto last_candidate_position = string.size() - needle_size;
+
+  auto position = offset;
+  for (; position + BLOCK_SIZE <= last_candidate_position + 1; position += BLOCK_SIZE) {
+    const auto* const block_first = string_data + position;
+    const auto* const block_last = string_data + position + needle_size - 1;
+
+    auto mask = uint32_t{0};
+
+    // See abstract_table_scan_impl.hpp for the pragma. We do not use the OpenMP runtime.
+    // NOLINTNEXTLINE
+    {}  // clang-format off
+    #pragma omp simd reduction(|:mask) safelen(BLOCK_SIZE)
+    // clang-format on
+    for (auto char_idx = size_t{0}; char_idx < BLOCK_SIZE; ++char_idx) {
+      mask |= static_cast<uint32_t>((block_first[char_idx] == first_char) & (block_last[char_idx] == last_char))
+              << char_idx;
+    }
+
+    while (mask) {
+      const auto candidate_position = position + static_cast<size_t>(std::countr_zero(mask));
+      if (needle_size <= 2 ||
+          std::memcmp(string_data + candidate_position + 1, needle_data + 1, needle_size - 2) == 0) {
+        return candidate_position;
+      }
+      mask &= mask - 1;
+    }
+  }
+
+  // Handle the remainder
+  return string.find(std::string_view{needle_data, needle_size}, position);
+}
+
+const pmr_string& LikeMatcher::Searcher::needle() const { return _needle; }
+
+bool LikeMatcher::GeneralPattern::Segment::matches_at(const std::string_view& string, const size_t position) const {
+  const auto segment_size = characters.size();
+  if (position > string.size() || string.size() - position < segment_size) return false;
+
+  for (auto char_idx = size_t{0}; char_idx < segment_size; ++char_idx) {
+    if (characters[char_idx] != '_' && characters[char_idx] != string[position + char_idx]) return false;
+  }
+  return true;
+}
+
+size_t LikeMatcher::GeneralPattern::Segment::find(const std::string_view& string, const size_t offset) const {
+  if (anchor_searcher.needle().empty()) {
+    // The segment only consists of '_'
+    return matches_at(string, offset) ? offset : std::string_view::npos;
+  }
+
+  auto search_position = offset + anchor_offset;
+  while (true) {
+    const auto anchor_position = anchor_searcher.find(string, search_position);
+    if (anchor_position == std::string_view::npos) return std::string_view::npos;
+
+    const auto segment_position = anchor_position - anchor_offset;
+    if (string.size() - segment_position < characters.size()) return std::string_view::npos;
+    if (matches_at(string, segment_position)) return segment_position;
+
+    search_position = anchor_position + 1;
+  }
+}
+
+bool LikeMatcher::GeneralPattern::matches(const std::string_view& string) const {
+  if (segments.empty()) {
+    // The pattern is either empty or consists only of '%'
+    return leading_any_chars || string.empty();
+  }
+
+  auto position = size_t{0};
+  const auto segment_count = segments.size();
+  for (auto segment_idx = size_t{0}; segment_idx < segment_count; ++segment_idx) {
+    const auto& segment = segments[segment_idx];
+    const auto anchored_at_begin = segment_idx == 0 && !leading_any_chars;
+    const auto anchored_at_end = segment_idx == segment_count - 1 && !trailing_any_chars;
+
+    if (anchored_at_end) {
+      if (string.size() - position < segment.characters.size()) return false;
+      const auto segment_position = string.size() - segment.characters.size();
+      if (anchored_at_begin && segment_position != 0) return false;
+      return segment.matches_at(string, segment_position);
+    }
+
+    if (anchored_at_begin) {
+      if (!segment.matches_at(string, 0)) return false;
+      position = segment.characters.size();
+      continue;
+    }
+
+    const auto segment_position = segment.find(string, position);
+    if (segment_position == std::string_view::npos) return false;
+    position = segment_position + segment.characters.size();
+  }
+
+  return true;
+}
+
 LikeMatcher::LikeMatcher(const pmr_string& pattern) { _pattern_variant = pattern_string_to_pattern_variant(pattern); }
 
 size_t LikeMatcher::get_index_of_next_wildcard(const pmr_string& pattern, const size_t offset) {
@@ -83,19 +237,19 @@ LikeMatcher::AllPatternVariant LikeMatcher::pattern_string_to_pattern_variant(co
   } else if (tokens.size() == 3 && tokens[0] == PatternToken{Wildcard::AnyChars} &&
              std::holds_alternative<pmr_string>(tokens[1]) && tokens[2] == PatternToken{Wildcard::AnyChars}) {
     // Pattern has the form '%hello%'
-    return ContainsPattern{std::get<pmr_string>(tokens[1])};
+    return ContainsPattern{Searcher{std::get<pmr_string>(tokens[1])}};
 
   } else {
     /**
      * Pattern is either MultipleContainsPattern, e.g., '%hello%world%how%are%you%' or we fall back to
-     * using a regex matcher.
+     * the GeneralPattern.
      *
      * A MultipleContainsPattern begins and ends with '%' and  contains only strings and '%'.
      */
 
-    // Pick ContainsMultiple or Regex
+    // Pick ContainsMultiple or GeneralPattern
     auto pattern_is_contains_multiple = true;  // Set to false if tokens don't match %(, string, %)* pattern
-    auto strings = std::vector<pmr_string>{};  // arguments used for ContainsMultiple, if it gets used
+    auto searchers = std::vector<Searcher>{};  // arguments used for ContainsMultiple, if it gets used
     auto expect_any_chars = true;              // If true, expect '%', if false, expect a string
 
     // Check if the tokens match the layout expected for MultipleContainsPattern - or break and set
@@ -110,45 +264,23 @@ LikeMatcher::AllPatternVariant LikeMatcher::pattern_string_to_pattern_variant(co
         break;
       }
       if (!expect_any_chars) {
-        strings.emplace_back(std::get<pmr_string>(token));
+        searchers.emplace_back(std::get<pmr_string>(token));
       }
 
       expect_any_chars = !expect_any_chars;
     }
 
+    // The pattern also has to end with '%' (e.g., not '%hello%world'). An empty pattern only matches empty strings.
+    if (tokens.empty() || expect_any_chars) pattern_is_contains_multiple = false;
+
     if (pattern_is_contains_multiple) {
-      return MultipleContainsPattern{strings};
+      return MultipleContainsPattern{std::move(searchers)};
     } else {
-      return std::regex(sql_like_to_regex(pattern));
+      return compile_general_pattern(pattern);
     }
   }
 }
 
-std::string LikeMatcher::sql_like_to_regex(pmr_string sql_like) {
-  // Do substitution of <backslash> with <backslash><backslash> FIRST, because otherwise it will also replace
-  // backslashes introduced by the other substitutions
-  constexpr auto REPLACE_BY = std::array<std::pair<const char*, const char*>, 14u>{{{"\\", "\\\\"},
-                                                                                    {".", "\\."},
-                                                                                    {"^", "\\^"},
-                                                                                    {"$", "\\$"},
-                                                                                    {"+", "\\+"},
-                                                                                    {"?", "\\?"},
-                                                                                    {"(", "\\("},
-                                                                                    {")", "\\)"},
-                                                                                    {"{", "\\{"},
-                                                                                    {"}", "\\}"},
-                                                                                    {"|", "\\|"},
-                                                                                    {"*", "\\*"},
-                                                                                    {"%", ".*"},
-                                                                                    {"_", "."}}};
-
-  for (const auto& pair : REPLACE_BY) {
-    boost::replace_all(sql_like, pair.first, pair.second);
-  }
-
-  return std::string{"^" + sql_like + "$"};
-}
-
 std::ostream& operator<<(std::ostream& stream, const LikeMatcher::Wildcard& wildcard) {
   switch (wildcard) {
     case LikeMatcher::Wildcard::SingleChar:
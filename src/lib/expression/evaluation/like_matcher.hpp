@@ -1,9 +1,8 @@
 #pragma once
 
-#include <experimental/functional>
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -16,22 +15,32 @@ namespace opossum {
 /**
  * Wraps an SQL LIKE pattern (e.g. "Hello%Wo_ld") which strings can be tested against.
  *
- * Performance optimizations exist for several simple patterns, such as "Hello%" - which is really just a starts_with()
- * check.
+ * The pattern is compiled once, when the LikeMatcher is constructed. Performance optimizations exist for several
+ * simple patterns, such as "Hello%" - which is really just a starts_with() check.
  */
 class LikeMatcher {
-  // A faster search algorithm than the typical byte-wise search if we can reuse the searcher
-#ifdef __GLIBCXX__
-  using Searcher = std::boyer_moore_searcher<pmr_string::const_iterator>;
-#else
-  using Searcher = std::experimental::boyer_moore_searcher<pmr_string::const_iterator>;
-#endif
-
  public:
   /**
-   * Turn SQL LIKE-pattern into a C++ regex.
+   * Finds a needle in strings. As the searcher owns the needle, it can be built once per pattern and reused for all
+   * values that are matched.
+   *
+   * Compares the first and the last character of the needle with a block of 32 positions of the string at once and
+   * only compares the full needle at the positions where both match. The block comparison is written so that the
+   * compiler vectorizes it (SSE2/AVX2, see -fopenmp-simd). Strings shorter than a block are handled by
+   * std::string_view::find.
    */
-  static std::string sql_like_to_regex(pmr_string sql_like);
+  class Searcher {
+   public:
+    explicit Searcher(const pmr_string& needle);
+
+    // Returns the position of the first occurrence of the needle at or after `offset` or std::string_view::npos.
+    size_t find(const std::string_view& string, const size_t offset = 0) const;
+
+    const pmr_string& needle() const;
+
+   private:
+    pmr_string _needle;
+  };
 
   static size_t get_index_of_next_wildcard(const pmr_string& pattern, const size_t offset = 0);
   static bool contains_wildcard(const pmr_string& pattern);
@@ -59,7 +68,7 @@ class LikeMatcher {
 
   /**
    * To speed up LIKE there are special implementations available for simple, common patterns.
-   * Any other pattern will fall back to regex.
+   * Any other pattern is matched as a GeneralPattern.
    */
   // 'hello%'
   struct StartsWithPattern final {
@@ -71,19 +80,45 @@ class LikeMatcher {
   };
   // '%hello%'
   struct ContainsPattern final {
-    pmr_string string;
+    Searcher searcher;
   };
   // '%hello%world%nice%weather%'
   struct MultipleContainsPattern final {
-    std::vector<pmr_string> strings;
+    std::vector<Searcher> searchers;
+  };
+  // Any other pattern, e.g., 'H_llo%W%ld' or 'hello'. The pattern is split at '%' into segments, which are matched
+  // from left to right, each at the leftmost position where it fits. As segments have a fixed length, this never
+  // misses a match. Within a segment, '_' matches any single character.
+  struct GeneralPattern final {
+    struct Segment {
+      // Matches `string` at `position` (including the '_' characters)
+      bool matches_at(const std::string_view& string, const size_t position) const;
+
+      // Returns the first position at or after `offset` where the segment matches or std::string_view::npos
+      size_t find(const std::string_view& string, const size_t offset) const;
+
+      pmr_string characters;
+
+      // To find candidate positions, we search for the longest substring of the segment that does not contain '_'.
+      // If the segment consists only of '_', the anchor is empty.
+      size_t anchor_offset;
+      Searcher anchor_searcher;
+    };
+
+    bool matches(const std::string_view& string) const;
+
+    // Whether the pattern starts or ends with a '%'
+    bool leading_any_chars;
+    bool trailing_any_chars;
+
+    std::vector<Segment> segments;
   };
 
   /**
-   * Contains one of the specialised patterns from above (StartsWithPattern, ...) or falls back to std::regex for a
-   * general pattern.
+   * Contains one of the specialised patterns from above (StartsWithPattern, ...) or the GeneralPattern.
    */
   using AllPatternVariant =
-      std::variant<std::regex, StartsWithPattern, EndsWithPattern, ContainsPattern, MultipleContainsPattern>;
+      std::variant<GeneralPattern, StartsWithPattern, EndsWithPattern, ContainsPattern, MultipleContainsPattern>;
 
   static AllPatternVariant pattern_string_to_pattern_variant(const pmr_string& pattern);
 
@@ -111,37 +146,28 @@ class LikeMatcher {
       });
 
     } else if (std::holds_alternative<ContainsPattern>(_pattern_variant)) {
-      const auto& contains_str = std::get<ContainsPattern>(_pattern_variant).string;
-      // It's really hard to store the searcher in the pattern as it only holds iterators into the string that easily
-      // get invalidated when the pattern is passed around.
-      const auto searcher = Searcher{contains_str.begin(), contains_str.end()};
+      const auto& searcher = std::get<ContainsPattern>(_pattern_variant).searcher;
       functor([&](const auto& string) -> bool {
-        return (std::search(string.begin(), string.end(), searcher) != string.end()) ^ invert_results;
+        return (searcher.find(std::string_view{string}) != std::string_view::npos) ^ invert_results;
       });
 
     } else if (std::holds_alternative<MultipleContainsPattern>(_pattern_variant)) {
-      const auto& contains_strs = std::get<MultipleContainsPattern>(_pattern_variant).strings;
-      std::vector<Searcher> searchers;
-      searchers.reserve(contains_strs.size());
-      for (const auto& contains_str : contains_strs) {
-        searchers.emplace_back(Searcher(contains_str.begin(), contains_str.end()));
-      }
-
+      const auto& searchers = std::get<MultipleContainsPattern>(_pattern_variant).searchers;
       functor([&](const auto& string) -> bool {
-        auto current_position = string.begin();
-        for (auto searcher_idx = size_t{0}; searcher_idx < searchers.size(); ++searcher_idx) {
-          current_position = std::search(current_position, string.end(), searchers[searcher_idx]);
-          if (current_position == string.end()) return invert_results;
-          current_position += contains_strs[searcher_idx].size();
+        const auto string_view = std::string_view{string};
+        auto current_position = size_t{0};
+        for (const auto& searcher : searchers) {
+          current_position = searcher.find(string_view, current_position);
+          if (current_position == std::string_view::npos) return invert_results;
+          current_position += searcher.needle().size();
         }
         return !invert_results;
       });
 
-    } else if (std::holds_alternative<std::regex>(_pattern_variant)) {
-      const auto& regex = std::get<std::regex>(_pattern_variant);
-
+    } else if (std::holds_alternative<GeneralPattern>(_pattern_variant)) {
+      const auto& general_pattern = std::get<GeneralPattern>(_pattern_variant);
       functor([&](const auto& string) -> bool {
-        return std::regex_match(string.cbegin(), string.cend(), regex) ^ invert_results;
+        return general_pattern.matches(std::string_view{string}) ^ invert_results;
       });
 
     } else {
@@ -3,6 +3,7 @@
 #include <boost/container/pmr/memory_resource.hpp>
 
 #include "concurrency/transaction_manager.hpp"
+#include "cost_estimation/physical_cost_coefficients.hpp"
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/topology.hpp"
 #include "sql/sql_plan_cache.hpp"
@@ -53,6 +54,10 @@ class Hyrise : public Singleton<Hyrise> {
   std::shared_ptr<SQLPhysicalPlanCache> default_pqp_cache;
   std::shared_ptr<SQLLogicalPlanCache> default_lqp_cache;
 
+  // Coefficients of the cost model that the LQPTranslator uses to choose between operator implementations unless it is
+  // given a cost estimator. Every translation reads them, so they should only be replaced while no queries are running.
+  PhysicalCostCoefficients physical_cost_coefficients;
+
   // The BenchmarkRunner is available here so that non-benchmark components can add information to the benchmark
   // result JSON.
   std::weak_ptr<BenchmarkRunner> benchmark_runner;
@@ -1,16 +1,27 @@
 #include "binary_parser.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "binary_writer.hpp"
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/chunk.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/vector_compression/fixed_size_byte_aligned/fixed_size_byte_aligned_vector.hpp"
@@ -19,6 +30,57 @@
 
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Read-only, private mapping of an entire file. The pages are only read when they are accessed.
+class MappedFile : private Noncopyable {
+ public:
+  explicit MappedFile(const std::string& filename) {
+    const auto file_descriptor = open(filename.c_str(), O_RDONLY);
+    Assert(file_descriptor != -1, "Could not open '" + filename + "': " + std::strerror(errno));
+
+    struct stat file_status {};
+    const auto stat_result = fstat(file_descriptor, &file_status);
+    _size = static_cast<size_t>(file_status.st_size);
+    if (stat_result == 0 && _size > 0) {
+      _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    }
+    close(file_descriptor);
+    Assert(stat_result == 0 && _size > 0 && _data != MAP_FAILED, "Could not map '" + filename + "'");
+  }
+
+  ~MappedFile() { munmap(_data, _size); }
+
+  const char* data() const { return static_cast<const char*>(_data); }
+  size_t size() const { return _size; }
+
+  // Lets the kernel read the range [begin, end) before it is accessed. Advising the entire file at once would make the
+  // kernel read all of it, even if it does not fit into the page cache. This is only a hint, so we ignore failures.
+  void will_need(const size_t begin, const size_t end) const {
+    static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const auto aligned_begin = begin - begin % page_size;
+    madvise(static_cast<char*>(_data) + aligned_begin, end - aligned_begin, MADV_WILLNEED);
+  }
+
+ private:
+  void* _data{MAP_FAILED};
+  size_t _size{0};
+};
+
+// Lets an std::istream read from memory without copying it into a separate buffer first
+class MemoryStreamBuffer : public std::streambuf {
+ public:
+  MemoryStreamBuffer(const char* begin, const char* end) {
+    // The get area is never written to, as we do not put characters back into the stream
+    auto* const data = const_cast<char*>(begin);  // NOLINT
+    setg(data, data, const_cast<char*>(end));     // NOLINT
+  }
+};
+
+}  // namespace
+
 namespace opossum {
 
 std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
@@ -26,16 +88,77 @@ std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
   file.open(filename, std::ios::binary);
   file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 
+  // Files in the original format start with the chunk size and the chunk count, which never match the magic number
+  auto magic_number = uint64_t{0};
+  file.read(reinterpret_cast<char*>(&magic_number), sizeof(magic_number));
+  if (magic_number == BinaryWriter::CHUNK_DIRECTORY_FORMAT_MAGIC) {
+    file.close();
+    return _parse_with_chunk_directory(filename);
+  }
+  file.seekg(0);
+
   auto [table, chunk_count] = _read_header(file);
   for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-    _import_chunk(file, table);
+    _append_chunk(*table, _import_chunk(file, *table));
+  }
+
+  return table;
+}
+
+std::shared_ptr<Table> BinaryParser::_parse_with_chunk_directory(const std::string& filename) {
+  const auto mapped_file = MappedFile{filename};
+  const auto* const file_begin = mapped_file.data();
+  const auto* const file_end = mapped_file.data() + mapped_file.size();
+
+  auto header_buffer = MemoryStreamBuffer{file_begin, file_end};
+  auto header_stream = std::istream{&header_buffer};
+  header_stream.exceptions(std::istream::failbit | std::istream::badbit);
+
+  header_stream.ignore(sizeof(BinaryWriter::CHUNK_DIRECTORY_FORMAT_MAGIC));
+  const auto version = _read_value<uint32_t>(header_stream);
+  Assert(version == BinaryWriter::CHUNK_DIRECTORY_FORMAT_VERSION,
+         "Cannot import '" + filename + "', which uses version " + std::to_string(version) + " of the binary format");
+
+  // Not a structured binding, as these cannot be captured by the import jobs
+  const auto table_and_chunk_count = _read_header(header_stream);
+  const auto& table = table_and_chunk_count.first;
+  const auto chunk_count = table_and_chunk_count.second;
+  const auto chunk_directory = _read_values<uint64_t>(header_stream, chunk_count + 1);
+  Assert(chunk_directory.back() == mapped_file.size(), "File '" + filename + "' is truncated or corrupted");
+
+  // Each import job lets the kernel read the following chunk while it parses its own one. Only the first chunk is
+  // requested up front.
+  const auto will_need_chunk = [&](const ChunkID chunk_id) {
+    if (chunk_id < chunk_count) mapped_file.will_need(chunk_directory[chunk_id], chunk_directory[chunk_id + 1]);
+  };
+  will_need_chunk(ChunkID{0});
+
+  auto imported_chunks = std::vector<ImportedChunk>(chunk_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    Assert(chunk_directory[chunk_id] <= chunk_directory[chunk_id + 1],
+           "Invalid chunk directory in '" + filename + "'");
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      will_need_chunk(ChunkID{chunk_id + 1});
+      auto chunk_buffer =
+          MemoryStreamBuffer{file_begin + chunk_directory[chunk_id], file_begin + chunk_directory[chunk_id + 1]};
+      auto chunk_stream = std::istream{&chunk_buffer};
+      chunk_stream.exceptions(std::istream::failbit | std::istream::badbit);
+      imported_chunks[chunk_id] = _import_chunk(chunk_stream, *table);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  for (const auto& imported_chunk : imported_chunks) {
+    _append_chunk(*table, imported_chunk);
   }
 
   return table;
 }
 
 template <typename T>
-pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<T> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<T> values(count);
   file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
   return values;
@@ -43,19 +166,19 @@ pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count
 
 // specialized implementation for string values
 template <>
-pmr_vector<pmr_string> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_values(std::istream& file, const size_t count) {
   return _read_string_values(file, count);
 }
 
 // specialized implementation for bool values
 template <>
-pmr_vector<bool> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<bool> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<BoolAsByteType> readable_bools(count);
   file.read(reinterpret_cast<char*>(readable_bools.data()), readable_bools.size() * sizeof(BoolAsByteType));
   return pmr_vector<bool>(readable_bools.begin(), readable_bools.end());
 }
 
-pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_string_values(std::istream& file, const size_t count) {
   const auto string_lengths = _read_values<size_t>(file, count);
   const auto total_length = std::accumulate(string_lengths.cbegin(), string_lengths.cend(), static_cast<size_t>(0));
   const auto buffer = _read_values<char>(file, total_length);
@@ -72,13 +195,13 @@ pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, co
 }
 
 template <typename T>
-T BinaryParser::_read_value(std::ifstream& file) {
+T BinaryParser::_read_value(std::istream& file) {
   T result;
   file.read(reinterpret_cast<char*>(&result), sizeof(T));
   return result;
 }
 
-std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstream& file) {
+std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::istream& file) {
   const auto chunk_size = _read_value<ChunkOffset>(file);
   const auto chunk_count = _read_value<ChunkID>(file);
   const auto column_count = _read_value<ColumnID>(file);
@@ -98,31 +221,35 @@ std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstr
   return std::make_pair(table, chunk_count);
 }
 
-void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& table) {
-  const auto row_count = _read_value<ChunkOffset>(file);
+BinaryParser::ImportedChunk BinaryParser::_import_chunk(std::istream& file, const Table& table) {
+  auto imported_chunk = ImportedChunk{};
+  imported_chunk.row_count = _read_value<ChunkOffset>(file);
 
   // Import sort column definitions
   const auto num_sorted_columns = _read_value<uint32_t>(file);
-  std::vector<SortColumnDefinition> sorted_columns;
   for (ColumnID sorted_column_id{0}; sorted_column_id < num_sorted_columns; ++sorted_column_id) {
     const auto column_id = _read_value<ColumnID>(file);
     const auto sort_mode = _read_value<SortMode>(file);
-    sorted_columns.emplace_back(SortColumnDefinition{column_id, sort_mode});
+    imported_chunk.sorted_by.emplace_back(SortColumnDefinition{column_id, sort_mode});
   }
 
-  Segments output_segments;
-  for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
-    output_segments.push_back(
-        _import_segment(file, row_count, table->column_data_type(column_id), table->column_is_nullable(column_id)));
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+    imported_chunk.segments.push_back(_import_segment(file, imported_chunk.row_count,
+                                                      table.column_data_type(column_id),
+                                                      table.column_is_nullable(column_id)));
   }
 
-  const auto mvcc_data = std::make_shared<MvccData>(row_count, CommitID{0});
-  table->append_chunk(output_segments, mvcc_data);
-  table->last_chunk()->finalize();
-  if (num_sorted_columns > 0) table->last_chunk()->set_individually_sorted_by(sorted_columns);
+  return imported_chunk;
+}
+
+void BinaryParser::_append_chunk(Table& table, const ImportedChunk& imported_chunk) {
+  const auto mvcc_data = std::make_shared<MvccData>(imported_chunk.row_count, CommitID{0});
+  table.append_chunk(imported_chunk.segments, mvcc_data);
+  table.last_chunk()->finalize();
+  if (!imported_chunk.sorted_by.empty()) table.last_chunk()->set_individually_sorted_by(imported_chunk.sorted_by);
 }
 
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                                DataType data_type, bool column_is_nullable) {
   std::shared_ptr<AbstractSegment> result;
   resolve_data_type(data_type, [&](auto type) {
@@ -134,7 +261,7 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
 }
 
 template <typename ColumnDataType>
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                                bool column_is_nullable) {
   const auto column_type = _read_value<EncodingType>(file);
 
@@ -167,7 +294,7 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
 }
 
 template <typename T>
-std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                      bool column_is_nullable) {
   if (column_is_nullable) {
     const auto segment_is_nullable = _read_value<bool>(file);
@@ -183,7 +310,7 @@ std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstre
 }
 
 template <typename T>
-std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::ifstream& file,
+std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::istream& file,
                                                                                ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
@@ -195,7 +322,7 @@ std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(s
 }
 
 std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_fixed_string_dictionary_segment(
-    std::ifstream& file, ChunkOffset row_count) {
+    std::istream& file, ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
   auto dictionary = _import_fixed_string_vector(file, dictionary_size);
@@ -205,7 +332,7 @@ std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_
 }
 
 template <typename T>
-std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::ifstream& file,
+std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::istream& file,
                                                                               ChunkOffset row_count) {
   const auto size = _read_value<uint32_t>(file);
   const auto values = std::make_shared<pmr_vector<T>>(_read_values<T>(file, size));
@@ -216,7 +343,7 @@ std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(st
 }
 
 template <typename T>
-std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::ifstream& file,
+std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::istream& file,
                                                                                              ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto block_count = _read_value<uint32_t>(file);
@@ -234,7 +361,7 @@ std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_refer
 }
 
 template <typename T>
-std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream& file, ChunkOffset row_count) {
+std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::istream& file, ChunkOffset row_count) {
   const auto num_elements = _read_value<uint32_t>(file);
   const auto block_count = _read_value<uint32_t>(file);
   const auto block_size = _read_value<uint32_t>(file);
@@ -284,7 +411,7 @@ std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream&
 }
 
 std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_shared<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -298,7 +425,7 @@ std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
 }
 
 std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_unique<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -311,7 +438,7 @@ std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_v
   }
 }
 
-std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(std::ifstream& file, const size_t count) {
+std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(std::istream& file, const size_t count) {
   const auto string_length = _read_value<uint32_t>(file);
   pmr_vector<char> values(string_length * count);
   file.read(values.data(), values.size());
@@ -22,6 +22,10 @@ namespace opossum {
 /*
  * This parser reads an Opossum binary file and creates a table from that input.
  * Documentation of the file formats can be found in BinaryWriter header file.
+ *
+ * Files written by BinaryWriter::write are read sequentially. Files with a chunk directory (see
+ * BinaryWriter::write_with_chunk_directory) are mapped into memory and their chunks are imported in parallel. The
+ * segments are still copied out of the mapping, so importing such a file remains O(data).
  */
 class BinaryParser {
  public:
@@ -44,10 +48,20 @@ class BinaryParser {
    * Creates an empty table from the extracted information and
    * returns that table and the number of chunks.
    */
-  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::ifstream& file);
+  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::istream& file);
+
+  // Imports the chunks of a file with a chunk directory. The magic number has already been checked.
+  static std::shared_ptr<Table> _parse_with_chunk_directory(const std::string& filename);
+
+  // Segments and sort order of a chunk that has been read by _import_chunk but not yet added to the table
+  struct ImportedChunk {
+    ChunkOffset row_count;
+    std::vector<SortColumnDefinition> sorted_by;
+    Segments segments;
+  };
 
   /*
-   * Creates a chunk from chunk information from the given file and adds it to the given table.
+   * Reads a chunk of the given table from the given file. The table is only used to look up the column definitions.
    * The chunk information has the following form:
    *
    * ----------------
@@ -58,54 +72,56 @@ class BinaryParser {
    *
    * ¹Number of columns is provided in the binary header
    */
-  static void _import_chunk(std::ifstream& file, std::shared_ptr<Table>& table);
+  static ImportedChunk _import_chunk(std::istream& file, const Table& table);
+
+  static void _append_chunk(Table& table, const ImportedChunk& imported_chunk);
 
   // Calls the right _import_column<ColumnDataType> depending on the given data_type.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(std::istream& file, ChunkOffset row_count,
                                                           DataType data_type, bool column_is_nullable);
 
   template <typename ColumnDataType>
   // Reads the column type from the given file and chooses a segment import function from it.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(std::istream& file, ChunkOffset row_count,
                                                           bool column_is_nullable);
 
   template <typename T>
-  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                 bool column_is_nullable);
   template <typename T>
-  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::istream& file, ChunkOffset row_count);
 
   static std::shared_ptr<FixedStringDictionarySegment<pmr_string>> _import_fixed_string_dictionary_segment(
-      std::ifstream& file, ChunkOffset row_count);
+      std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::ifstream& file,
+  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::istream& file,
                                                                                         ChunkOffset row_count);
   template <typename T>
-  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::istream& file, ChunkOffset row_count);
 
   // Calls the _import_attribute_vector<uintX_t> function that corresponds to the given attribute_vector_width.
-  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::istream& file, ChunkOffset row_count,
                                                                         AttributeVectorWidth attribute_vector_width);
 
   static std::unique_ptr<const BaseCompressedVector> _import_offset_value_vector(
-      std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
+      std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
 
-  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(std::ifstream& file, const size_t count);
+  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(std::istream& file, const size_t count);
 
   // Reads row_count many values from type T and returns them in a vector
   template <typename T>
-  static pmr_vector<T> _read_values(std::ifstream& file, const size_t count);
+  static pmr_vector<T> _read_values(std::istream& file, const size_t count);
 
   // Reads row_count many strings from input file. String lengths are encoded in type T.
-  static pmr_vector<pmr_string> _read_string_values(std::ifstream& file, const size_t count);
+  static pmr_vector<pmr_string> _read_string_values(std::istream& file, const size_t count);
 
   // Reads a single value of type T from the input file.
   template <typename T>
-  static T _read_value(std::ifstream& file);
+  static T _read_value(std::istream& file);
 };
 
 }  // namespace opossum
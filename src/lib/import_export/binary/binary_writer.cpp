@@ -102,6 +102,40 @@ void BinaryWriter::write(const Table& table, const std::string& filename) {
   }
 }
 
+void BinaryWriter::write_with_chunk_directory(const Table& table, const std::string& filename) {
+  std::ofstream ofstream;
+  ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  ofstream.open(filename, std::ios::binary);
+
+  export_value(ofstream, CHUNK_DIRECTORY_FORMAT_MAGIC);
+  export_value(ofstream, CHUNK_DIRECTORY_FORMAT_VERSION);
+  _write_header(table, ofstream);
+
+  // The offsets of the chunks are only known once they have been written. Reserve the space for the directory now
+  // and fill it in afterwards.
+  const auto chunk_count = table.chunk_count();
+  const auto chunk_directory_position = ofstream.tellp();
+  auto chunk_directory = pmr_vector<uint64_t>(chunk_count + 1);
+  export_values(ofstream, chunk_directory);
+
+  const auto pad_to_chunk_alignment = [&]() {
+    const auto position = static_cast<uint64_t>(ofstream.tellp());
+    const auto padding = (CHUNK_DIRECTORY_FORMAT_ALIGNMENT - position % CHUNK_DIRECTORY_FORMAT_ALIGNMENT) %
+                         CHUNK_DIRECTORY_FORMAT_ALIGNMENT;
+    export_values(ofstream, pmr_vector<char>(padding));
+  };
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    pad_to_chunk_alignment();
+    chunk_directory[chunk_id] = static_cast<uint64_t>(ofstream.tellp());
+    _write_chunk(table, ofstream, chunk_id);
+  }
+  chunk_directory.back() = static_cast<uint64_t>(ofstream.tellp());
+
+  ofstream.seekp(chunk_directory_position);
+  export_values(ofstream, chunk_directory);
+}
+
 void BinaryWriter::_write_header(const Table& table, std::ofstream& ofstream) {
   const auto target_chunk_size = table.type() == TableType::Data ? table.target_chunk_size() : Chunk::DEFAULT_SIZE;
   export_value(ofstream, static_cast<ChunkOffset>(target_chunk_size));
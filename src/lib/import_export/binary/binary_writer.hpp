@@ -22,6 +22,37 @@ class BinaryWriter {
  public:
   static void write(const Table& table, const std::string& filename);
 
+  /**
+   * Writes the table in the versioned format with a chunk directory. The BinaryParser recognizes it by its magic
+   * number and imports the chunks in parallel. It has the following layout:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Magic number                | uint64_t                            | 8
+   * Format version              | uint32_t                            | 4
+   * Table header                | see _write_header                   |
+   * Chunk directory             | uint64_t array                      | (Chunk count + 1) * 8
+   * Padding                     | zero bytes                          | up to CHUNK_DIRECTORY_FORMAT_ALIGNMENT - 1
+   * Chunks¹                     | see _write_chunk                    |
+   *
+   * The chunk directory holds the file offset of each chunk, followed by the size of the file. Each chunk starts at
+   * a multiple of CHUNK_DIRECTORY_FORMAT_ALIGNMENT, so that the import jobs of different chunks do not read the
+   * same pages.
+   *
+   * ¹: Each chunk is followed by padding to the next multiple of CHUNK_DIRECTORY_FORMAT_ALIGNMENT, except for the
+   *    last.
+   */
+  static void write_with_chunk_directory(const Table& table, const std::string& filename);
+
+  // "HYRSBIN" followed by a zero byte, stored in little endian. Files in the original format, which start with the
+  // target chunk size, do not start with this number.
+  static constexpr auto CHUNK_DIRECTORY_FORMAT_MAGIC = uint64_t{0x004E494253525948};
+
+  // Increase the version whenever the layout of the header, the chunks, or the segments changes
+  static constexpr auto CHUNK_DIRECTORY_FORMAT_VERSION = uint32_t{1};
+
+  static constexpr auto CHUNK_DIRECTORY_FORMAT_ALIGNMENT = uint64_t{4096};
+
  private:
   /**
    * This methods writes the header of this table into the given ofstream.
@@ -1,28 +1,164 @@
 #include "csv_parser.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <fstream>
 #include <list>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include <boost/algorithm/string.hpp>
+
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
 #include "import_export/csv/csv_converter.hpp"
 #include "import_export/csv/csv_meta.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+/**
+ * Reads a csv file in blocks and holds the content that has not been consumed yet. Once the end of the file has been
+ * reached, the content is made to end with a delimiter for better row processing later.
+ */
+class CsvBlockReader {
+ public:
+  CsvBlockReader(std::ifstream& file, const char delimiter, const size_t min_block_size)
+      : _file(file), _delimiter(delimiter), _min_block_size(min_block_size) {
+    Assert(_min_block_size > 0, "Block size must be positive");
+  }
+
+  // Appends the next block of the file to the content. The block is at least as large as the current content, so that
+  // rows that span many blocks do not have to be searched for fields over and over again.
+  void read_block() {
+    DebugAssert(!_end_of_file, "File has already been read completely");
+
+    // Drop the consumed content once per block instead of moving the remaining content on every consume()
+    _content.erase(0, _consumed_size);
+    _consumed_size = 0;
+
+    const auto previous_size = _content.size();
+    const auto block_size = std::max(_min_block_size, previous_size);
+    _content.resize(previous_size + block_size);
+    _file.read(_content.data() + previous_size, static_cast<std::streamsize>(block_size));
+    _content.resize(previous_size + static_cast<size_t>(_file.gcount()));
+
+    if (_file.eof()) {
+      _end_of_file = true;
+      if (!_content.empty() && _content.back() != _delimiter) _content.push_back(_delimiter);
+    } else {
+      Assert(_file.good(), "Error while reading the csv file");
+    }
+  }
+
+  bool end_of_file() const { return _end_of_file; }
+
+  std::string_view content() const { return std::string_view{_content}.substr(_consumed_size); }
+
+  // Removes the first `length` characters from the content and returns them
+  std::string consume(const size_t length) {
+    DebugAssert(length <= _content.size() - _consumed_size, "Cannot consume more than the remaining content");
+    auto consumed_content = _content.substr(_consumed_size, length);
+    _consumed_size += length;
+    return consumed_content;
+  }
+
+ private:
+  std::ifstream& _file;
+  const char _delimiter;
+  const size_t _min_block_size;
+  std::string _content;
+  size_t _consumed_size{0};
+  bool _end_of_file{false};
+};
+
+constexpr auto SPECIAL_CHARACTER_MASK_SIZE = size_t{64};
+
+// Returns a bit mask of the characters in csv_content[begin, begin + SPECIAL_CHARACTER_MASK_SIZE) that are separators,
+// delimiters, or quotes. The full-width case is written so that the compiler vectorizes the comparisons.
+uint64_t special_character_mask(const std::string_view csv_content, const size_t begin, const ParseConfig& config) {
+  const auto* const characters = csv_content.data() + begin;
+  const auto character_count = std::min(SPECIAL_CHARACTER_MASK_SIZE, csv_content.size() - begin);
+  const auto separator = config.separator;
+  const auto delimiter = config.delimiter;
+  const auto quote = config.quote;
+
+  auto mask = uint64_t{0};
+  if (character_count == SPECIAL_CHARACTER_MASK_SIZE) {
+    // This empty block is used to convince clang-format to keep the pragma indented
+    // NOLINTNEXTLINE
+    {}  // clang-format off
+    #pragma omp simd reduction(|:mask) safelen(SPECIAL_CHARACTER_MASK_SIZE)
+    // clang-format on
+    for (auto index = size_t{0}; index < SPECIAL_CHARACTER_MASK_SIZE; ++index) {
+      const auto character = characters[index];
+      // Bitwise ORs, as short-circuiting would introduce branches that keep the loop from being vectorized
+      const auto is_special_character = static_cast<uint64_t>(character == separator) |
+                                        static_cast<uint64_t>(character == delimiter) |
+                                        static_cast<uint64_t>(character == quote);
+      mask |= is_special_character << index;
+    }
+  } else {
+    for (auto index = size_t{0}; index < character_count; ++index) {
+      const auto character = characters[index];
+      const auto is_special_character = static_cast<uint64_t>(character == separator) |
+                                        static_cast<uint64_t>(character == delimiter) |
+                                        static_cast<uint64_t>(character == quote);
+      mask |= is_special_character << index;
+    }
+  }
+  return mask;
+}
+
+// Data types that infer_meta chooses from, ordered from the narrowest to the widest
+const auto inferable_data_types = std::vector<DataType>{DataType::Int, DataType::Long, DataType::Double,
+                                                        DataType::String};
+
+// Returns the narrowest inferable data type that the unquoted, non-NULL field can be converted to. Uses the same
+// conversions as the CsvConverter.
+DataType infer_data_type(const std::string& field) {
+  const auto converts_completely = [&](const auto& conversion) {
+    try {
+      auto processed_characters = size_t{0};
+      conversion(field, &processed_characters);
+      return processed_characters == field.size();
+    } catch (const std::exception&) {
+      return false;
+    }
+  };
+
+  if (converts_completely([](const auto& string, auto* position) { return std::stoi(string, position); })) {
+    return DataType::Int;
+  }
+  if (converts_completely([](const auto& string, auto* position) { return std::stoll(string, position); })) {
+    return DataType::Long;
+  }
+  if (converts_completely([](const auto& string, auto* position) { return std::stod(string, position); })) {
+    return DataType::Double;
+  }
+  return DataType::String;
+}
+
+}  // namespace
+
 namespace opossum {
 
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const ChunkOffset chunk_size,
-                                        const std::optional<CsvMeta>& csv_meta) {
+                                        const std::optional<CsvMeta>& csv_meta,
+                                        const std::optional<ChunkEncodingSpec>& chunk_encoding_spec,
+                                        const size_t block_size) {
   // If no meta info is given as a parameter, look for a json file
   CsvMeta meta;
   if (csv_meta == std::nullopt) {
@@ -33,9 +169,11 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
 
   auto escaped_linebreak = std::string(1, meta.config.delimiter_escape) + std::string(1, meta.config.delimiter);
 
-  auto table = _create_table_from_meta(chunk_size, meta);
+  auto table = create_table_from_meta(meta, chunk_size);
+  Assert(!chunk_encoding_spec || chunk_encoding_spec->size() == table->column_count(),
+         "ChunkEncodingSpec does not match the number of columns");
 
-  std::ifstream csvfile{filename};
+  std::ifstream csvfile{filename, std::ios::binary};
 
   // return empty table if input file is empty
   if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
@@ -45,48 +183,62 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
     std::getline(csvfile, line);
     Assert(line.find('\r') == std::string::npos, "Windows encoding is not supported, use dos2unix");
   }
-
-  /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
-   */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
   csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
 
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != meta.config.delimiter) content.push_back(meta.config.delimiter);
+  auto reader = CsvBlockReader{csvfile, meta.config.delimiter, block_size};
 
-  std::string_view content_view{content.c_str(), content.size()};
+  // Bound the number of chunks whose unparsed content is held in memory. Once this many jobs are pending, we wait
+  // for the oldest one before reading on.
+  const auto max_pending_jobs = std::max(size_t{2}, size_t{2} * std::thread::hardware_concurrency());
 
   // Save chunks in list to avoid memory relocation
   std::list<Segments> segments_by_chunks;
-  std::vector<std::shared_ptr<AbstractTask>> tasks;
+  std::deque<std::shared_ptr<AbstractTask>> pending_jobs;
   std::vector<size_t> field_ends;
-  std::mutex append_chunk_mutex;
-  while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
+  while (true) {
+    const auto row_count = _find_fields_in_chunk(reader.content(), table->target_chunk_size(), field_ends, meta);
+
+    // The content ends before the chunk is full. Read on, unless there is nothing left to read.
+    if (row_count < table->target_chunk_size() && !reader.end_of_file()) {
+      reader.read_block();
+      continue;
+    }
+    if (row_count == 0) break;
+
+    Assert(field_ends.size() == row_count * table->column_count(),
+           "Number of CSV fields does not match number of columns.");
+
     // create empty chunk
     segments_by_chunks.emplace_back();
     auto& segments = segments_by_chunks.back();
 
-    // Only pass the part of the string that is actually needed to the parsing task
-    std::string_view relevant_content = content_view.substr(0, field_ends.back());
+    // Only pass the part of the content that is actually needed to the parsing job. It is released with the job.
+    auto chunk_content = reader.consume(field_ends.back() + 1);
 
-    // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
+    // create and start parsing job to fill chunk
+    pending_jobs.emplace_back(std::make_shared<JobTask>([chunk_content = std::move(chunk_content), field_ends, &table,
+                                                         &segments, &meta, &escaped_linebreak, &chunk_encoding_spec]() {
+      _parse_into_chunk(chunk_content, field_ends, *table, segments, meta, escaped_linebreak);
 
-    // create and start parsing task to fill chunk
-    tasks.emplace_back(std::make_shared<JobTask>([relevant_content, field_ends, &table, &segments, &meta,
-                                                  &escaped_linebreak, &append_chunk_mutex]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex);
+      if (chunk_encoding_spec) {
+        for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+          segments[column_id] = ChunkEncoder::encode_segment(segments[column_id], table->column_data_type(column_id),
+                                                             (*chunk_encoding_spec)[column_id]);
+        }
+      }
     }));
-    tasks.back()->schedule();
+    pending_jobs.back()->schedule();
+
+    if (pending_jobs.size() >= max_pending_jobs) {
+      Hyrise::get().scheduler()->wait_for_tasks({pending_jobs.front()});
+      pending_jobs.pop_front();
+    }
   }
 
-  Hyrise::get().scheduler()->wait_for_tasks(tasks);
+  Hyrise::get().scheduler()->wait_for_tasks({pending_jobs.begin(), pending_jobs.end()});
+
+  // As the reader ends the content with a delimiter, only a quote that is never closed leaves content behind
+  Assert(reader.content().empty(), "Unterminated quote at the end of the csv file " + filename);
 
   for (auto& segments : segments_by_chunks) {
     DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
@@ -101,10 +253,70 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
 std::shared_ptr<Table> CsvParser::create_table_from_meta_file(const std::string& filename,
                                                               const ChunkOffset chunk_size) {
   const auto meta = process_csv_meta_file(filename);
-  return _create_table_from_meta(chunk_size, meta);
+  return create_table_from_meta(meta, chunk_size);
+}
+
+CsvMeta CsvParser::infer_meta(const std::string& filename, const ParseConfig& config) {
+  std::ifstream csvfile{filename, std::ios::binary};
+  Assert(csvfile.is_open(), "Could not open csv file " + filename + " to infer its column types");
+
+  auto meta = CsvMeta{};
+  meta.config = config;
+
+  // Read until the sample is complete or the file ends
+  auto reader = CsvBlockReader{csvfile, config.delimiter, DEFAULT_BLOCK_SIZE};
+  auto field_ends = std::vector<size_t>{};
+  auto row_count = size_t{0};
+  while (true) {
+    row_count = _find_fields_in_chunk(reader.content(), TYPE_INFERENCE_ROW_COUNT, field_ends, meta);
+    if (row_count == TYPE_INFERENCE_ROW_COUNT || reader.end_of_file()) break;
+    reader.read_block();
+  }
+  if (row_count == 0) return meta;
+
+  const auto column_count = field_ends.size() / row_count;
+  const auto content = reader.content();
+
+  // Index into inferable_data_types per column. Columns without any non-NULL value in the sample become strings.
+  auto data_type_indices = std::vector<std::optional<size_t>>(column_count);
+  meta.columns.resize(column_count);
+
+  auto field_begin = size_t{0};
+  for (auto field_index = size_t{0}; field_index < field_ends.size(); ++field_index) {
+    const auto column_id = field_index % column_count;
+    auto field = std::string{content.substr(field_begin, field_ends[field_index] - field_begin)};
+    field_begin = field_ends[field_index] + 1;
+
+    if (field.empty()) {
+      meta.columns[column_id].nullable = true;
+      continue;
+    }
+
+    const auto is_null_string = boost::to_lower_copy(field) == ParseConfig::NULL_STRING;
+    if (is_null_string && config.null_handling == NullHandling::NullStringAsNull) {
+      meta.columns[column_id].nullable = true;
+      continue;
+    }
+
+    // Quoted fields are strings, as are unquoted null strings that are not treated as NULL
+    const auto is_string = field.front() == config.quote || is_null_string;
+    const auto data_type = is_string ? DataType::String : infer_data_type(field);
+    const auto data_type_index = static_cast<size_t>(
+        std::find(inferable_data_types.begin(), inferable_data_types.end(), data_type) - inferable_data_types.begin());
+    data_type_indices[column_id] = std::max(data_type_indices[column_id].value_or(0), data_type_index);
+  }
+
+  for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+    auto& column_meta = meta.columns[column_id];
+    column_meta.name = "column_" + std::to_string(column_id);
+    const auto data_type = inferable_data_types[data_type_indices[column_id].value_or(inferable_data_types.size() - 1)];
+    column_meta.type = data_type_to_string.left.at(data_type);
+  }
+
+  return meta;
 }
 
-std::shared_ptr<Table> CsvParser::_create_table_from_meta(const ChunkOffset chunk_size, const CsvMeta& meta) {
+std::shared_ptr<Table> CsvParser::create_table_from_meta(const CsvMeta& meta, const ChunkOffset chunk_size) {
   TableColumnDefinitions column_definitions;
   for (const auto& column_meta : meta.columns) {
     auto column_name = column_meta.name;
@@ -121,62 +333,66 @@ std::shared_ptr<Table> CsvParser::_create_table_from_meta(const ChunkOffset chun
   return std::make_shared<Table>(column_definitions, TableType::Data, chunk_size, UseMvcc::Yes);
 }
 
-bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
-                                      const CsvMeta& meta) {
+size_t CsvParser::_find_fields_in_chunk(std::string_view csv_content, const size_t row_limit,
+                                        std::vector<size_t>& field_ends, const CsvMeta& meta) {
   field_ends.clear();
-  if (csv_content.empty()) {
-    return false;
-  }
-
-  std::string search_for{meta.config.separator, meta.config.delimiter, meta.config.quote};
 
-  size_t from = 0;
-  unsigned int rows = 0;
-  unsigned int field_count = 1;
+  size_t rows = 0;
+  size_t field_count = 1;
+  std::optional<size_t> fields_per_row;
   bool in_quotes = false;
-  while (rows < table.target_chunk_size()) {
-    // Find either of row separator, column delimiter, quote identifier
-    auto pos = csv_content.find_first_of(search_for, from);
-    if (std::string::npos == pos) {
-      break;
-    }
-    from = pos + 1;
-    const char elem = csv_content[pos];
-
-    // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
-    if (elem == meta.config.quote) {
-      bool quote_is_escaped = false;
-      if (meta.config.quote != meta.config.escape) {
-        quote_is_escaped = pos != 0 && csv_content[pos - 1] == meta.config.escape;
+
+  // Number of fields that belong to complete rows. Fields of an incomplete row at the end of csv_content are dropped.
+  size_t complete_field_count = 0;
+
+  // Instead of searching for the next special character one by one, we look at blocks of characters and iterate over
+  // the set bits of their special character masks.
+  for (auto block_begin = size_t{0}; block_begin < csv_content.size() && rows < row_limit;
+       block_begin += SPECIAL_CHARACTER_MASK_SIZE) {
+    auto mask = special_character_mask(csv_content, block_begin, meta.config);
+    while (mask && rows < row_limit) {
+      const auto pos = block_begin + __builtin_ctzll(mask);
+      mask &= mask - 1;
+      const char elem = csv_content[pos];
+
+      // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
+      if (elem == meta.config.quote) {
+        bool quote_is_escaped = false;
+        if (meta.config.quote != meta.config.escape) {
+          quote_is_escaped = pos != 0 && csv_content[pos - 1] == meta.config.escape;
+        }
+        if (!quote_is_escaped) {
+          in_quotes = !in_quotes;
+        }
       }
-      if (!quote_is_escaped) {
-        in_quotes = !in_quotes;
+
+      // Determine if delimiter marks end of row or is part of the (string) value
+      const auto ends_row = elem == meta.config.delimiter && !in_quotes;
+      if (ends_row) {
+        if (!fields_per_row) fields_per_row = field_count;
+        DebugAssert(field_count == *fields_per_row, "Number of CSV fields differs between rows.");
+        ++rows;
+        field_count = 0;
       }
-    }
 
-    // Determine if delimiter marks end of row or is part of the (string) value
-    if (elem == meta.config.delimiter && !in_quotes) {
-      DebugAssert(field_count == static_cast<size_t>(table.column_count()),
-                  "Number of CSV fields does not match number of columns.");
-      ++rows;
-      field_count = 0;
-    }
+      // Determine if separator marks end of field or is part of the (string) value
+      if (in_quotes || elem == meta.config.quote) {
+        continue;
+      }
 
-    // Determine if separator marks end of field or is part of the (string) value
-    if (in_quotes || elem == meta.config.quote) {
-      continue;
+      ++field_count;
+      field_ends.push_back(pos);
+      if (ends_row) complete_field_count = field_ends.size();
     }
-
-    ++field_count;
-    field_ends.push_back(pos);
   }
 
-  return true;
+  field_ends.resize(complete_field_count);
+  return rows;
 }
 
 size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends,
                                     const Table& table, Segments& segments, const CsvMeta& meta,
-                                    const std::string& escaped_linebreak, std::mutex& append_chunk_mutex) {
+                                    const std::string& escaped_linebreak) {
   // For each csv column, create a CsvConverter which builds up a ValueSegment
   const auto column_count = table.column_count();
   const auto row_count = field_ends.size() / column_count;
@@ -220,12 +436,10 @@ size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vecto
                            std::to_string(column_id) + ":\n" + exception.what());
   }
 
-  // Transform the field_offsets to segments and add segments to chunk.
-  {
-    std::lock_guard<std::mutex> lock(append_chunk_mutex);
-    for (auto& converter : converters) {
-      segments.push_back(converter->finish());
-    }
+  // Transform the field_offsets to segments and add segments to chunk. Each job fills the segments of its own chunk,
+  // and the chunks are only appended to the table once all jobs are done, so no synchronization is needed.
+  for (auto& converter : converters) {
+    segments.push_back(converter->finish());
   }
 
   return row_count;
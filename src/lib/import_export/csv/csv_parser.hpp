@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv/csv_meta.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
@@ -21,37 +22,57 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * This parser reads the csv file in blocks and separates the data into chunks that are aligned with the csv rows.
+ * Each data chunk is parsed (and optionally encoded) by a separate job. The content of a chunk is released once its job
+ * is done. As only a limited number of jobs may be pending, the unparsed content held in memory is bounded by a few
+ * chunks instead of the size of the file. In the end all chunks are combined to the final table.
  */
 class CsvParser {
  public:
   /*
-   * @param filename      Path to the input file.
-   * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
-   * @returns             The table that was created from the csv file.
+   * @param filename             Path to the input file.
+   * @param csv_meta             Custom csv meta information which will be used instead of the default "filename" +
+   *                             ".json" meta. For files without a meta file, it can be created by infer_meta.
+   * @param chunk_encoding_spec  If given, each chunk is encoded by the job that parses it.
+   * @param block_size           Minimum number of bytes read from the file at once.
+   * @returns                    The table that was created from the csv file.
    */
   static std::shared_ptr<Table> parse(const std::string& filename, const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
-                                      const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                                      const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                                      const std::optional<ChunkEncodingSpec>& chunk_encoding_spec = std::nullopt,
+                                      const size_t block_size = DEFAULT_BLOCK_SIZE);
   static std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                             const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
- protected:
   /*
-   * Use the meta information stored in _meta to create a new table with according column description.
+   * Creates an empty table with the columns described by the meta information.
+   */
+  static std::shared_ptr<Table> create_table_from_meta(const CsvMeta& meta,
+                                                       const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
+
+  /*
+   * Creates the meta information for a csv file that has no meta file. The column types are inferred from the first
+   * TYPE_INFERENCE_ROW_COUNT rows: Each column gets the narrowest of int, long, double, and string that all of its
+   * values can be converted to. Columns that contain empty fields are nullable. The columns are named column_0,
+   * column_1, and so on.
    */
-  static std::shared_ptr<Table> _create_table_from_meta(const ChunkOffset chunk_size, const CsvMeta& meta);
+  static CsvMeta infer_meta(const std::string& filename, const ParseConfig& config = {});
 
+  static constexpr auto TYPE_INFERENCE_ROW_COUNT = size_t{10'000};
+
+  static constexpr auto DEFAULT_BLOCK_SIZE = size_t{16} * 1024 * 1024;
+
+ protected:
   /*
    * @param      csv_content String_view on the remaining content of the CSV.
-   * @param      table       Empty table created by _process_meta_file.
-   * @param[out] field_ends  Empty vector, to be filled with positions of the field ends for one chunk found in \p
+   * @param      row_limit   Maximum number of rows to look for, usually the target chunk size.
+   * @param[out] field_ends  Vector to be filled with positions of the field ends of the complete rows found in \p
    * csv_content.
-   * @returns                False if \p csv_content is empty or chunk_size set to 0, True otherwise.
+   * @returns                The number of complete rows found. Is smaller than \p row_limit if \p csv_content ends
+   *                         before.
    */
-  static bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
-                                    const CsvMeta& meta);
+  static size_t _find_fields_in_chunk(std::string_view csv_content, const size_t row_limit,
+                                      std::vector<size_t>& field_ends, const CsvMeta& meta);
 
   /*
    * @param      csv_chunk  String_view on one chunk of the CSV.
@@ -61,8 +82,7 @@ class CsvParser {
    * @returns               The number of rows in the chunk
    */
   static size_t _parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends, const Table& table,
-                                  Segments& segments, const CsvMeta& meta, const std::string& escaped_linebreak,
-                                  std::mutex& append_chunk_mutex);
+                                  Segments& segments, const CsvMeta& meta, const std::string& escaped_linebreak);
 
   /*
    * @param field The field that needs to be modified to be RFC 4180 compliant.
@@ -1,12 +1,10 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
 
-#include <boost/hana/for_each.hpp>
-#include <boost/hana/tuple.hpp>
-
 #include "abstract_lqp_node.hpp"
 #include "aggregate_node.hpp"
 #include "alias_node.hpp"
@@ -34,6 +32,7 @@
 #include "join_node.hpp"
 #include "limit_node.hpp"
 #include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/alias_operator.hpp"
 #include "operators/change_meta_table.hpp"
 #include "operators/delete.hpp"
@@ -43,6 +42,7 @@
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -55,9 +55,11 @@
 #include "operators/operator_scan_predicate.hpp"
 #include "operators/product.hpp"
 #include "operators/projection.hpp"
+#include "operators/runtime_join_filter.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
@@ -72,8 +74,125 @@
 
 using namespace std::string_literals;  // NOLINT
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Maps a column of a GetTable's output to the column of the stored table. Pruned columns are not part of the output.
+// The pruned column ids are sorted.
+ColumnID get_stored_column_id(const GetTable& get_table, const ColumnID column_id) {
+  auto stored_column_id = column_id;
+  for (const auto pruned_column_id : get_table.pruned_column_ids()) {
+    if (pruned_column_id <= stored_column_id) ++stored_column_id;
+  }
+  return stored_column_id;
+}
+
+// Checks whether the output of an operator will be sorted by the given column within each chunk. Only operators that
+// sort and operators that usually keep the order of their input are considered. As the PQP has not been executed yet,
+// this is an estimation. JoinSortMerge checks the actual sort order of its inputs during execution.
+bool is_sorted_within_chunks(const AbstractOperator& op, const ColumnID column_id) {
+  switch (op.type()) {
+    case OperatorType::Sort:
+      return static_cast<const Sort&>(op).sort_definitions().front().column == column_id;
+
+    case OperatorType::JoinSortMerge: {
+      // The output of an inner equi JoinSortMerge is sorted by both join columns. We only check the left one, as the
+      // column count of the left input is not known before execution.
+      const auto& join_sort_merge = static_cast<const JoinSortMerge&>(op);
+      const auto& primary_predicate = join_sort_merge.primary_predicate();
+      return join_sort_merge.mode() == JoinMode::Inner &&
+             primary_predicate.predicate_condition == PredicateCondition::Equals &&
+             primary_predicate.column_ids.first == column_id;
+    }
+
+    case OperatorType::TableScan: {
+      // The TableScan only keeps the sort order of its input chunks if their pos lists reference a single chunk (see
+      // table_scan.cpp). We can only be sure about that if the input is a data table.
+      const auto& input = *op.left_input();
+      const auto scans_data_table = input.type() == OperatorType::GetTable ||
+                                    (input.type() == OperatorType::Validate &&
+                                     input.left_input()->type() == OperatorType::GetTable);
+      return scans_data_table && is_sorted_within_chunks(input, column_id);
+    }
+
+    case OperatorType::Validate:
+      return is_sorted_within_chunks(*op.left_input(), column_id);
+
+    case OperatorType::GetTable: {
+      const auto& get_table = static_cast<const GetTable&>(op);
+      const auto stored_column_id = get_stored_column_id(get_table, column_id);
+
+      const auto table = Hyrise::get().storage_manager.get_table(get_table.table_name());
+      const auto chunk_count = table->chunk_count();
+      if (chunk_count == 0) return false;
+
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = table->get_chunk(chunk_id);
+        if (!chunk) continue;
+
+        const auto& sorted_by = chunk->individually_sorted_by();
+        if (std::none_of(sorted_by.cbegin(), sorted_by.cend(), [&](const auto& sort_definition) {
+              return sort_definition.column == stored_column_id;
+            })) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+// JoinIndex uses the indexes of the stored table on its right side, which it accesses either directly (GetTable) or
+// through the single-chunk reference segments of a Validate. Stores how many chunks of that table have an index on the
+// join column and which share of the rows is not covered by an index in the @param input_properties.
+void determine_indexed_chunks(const AbstractOperator& op, const ColumnID column_id,
+                              PhysicalInputProperties& input_properties) {
+  const auto& get_table_candidate = op.type() == OperatorType::Validate ? *op.left_input() : op;
+  if (get_table_candidate.type() != OperatorType::GetTable) return;
+
+  const auto& get_table = static_cast<const GetTable&>(get_table_candidate);
+  const auto stored_column_id = get_stored_column_id(get_table, column_id);
+  const auto& pruned_chunk_ids = get_table.pruned_chunk_ids();
+  const auto table = Hyrise::get().storage_manager.get_table(get_table.table_name());
+
+  auto row_count = size_t{0};
+  auto unindexed_row_count = size_t{0};
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (std::binary_search(pruned_chunk_ids.cbegin(), pruned_chunk_ids.cend(), chunk_id)) continue;
+
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    row_count += chunk->size();
+    if (chunk->get_indexes(std::vector<ColumnID>{stored_column_id}).empty()) {
+      unindexed_row_count += chunk->size();
+    } else {
+      ++input_properties.indexed_chunk_count;
+    }
+  }
+
+  input_properties.unindexed_row_share =
+      row_count > 0 ? static_cast<float>(unindexed_row_count) / static_cast<float>(row_count) : 1.0f;
+}
+
+}  // namespace
+
 namespace opossum {
 
+LQPTranslator::LQPTranslator() : LQPTranslator(std::make_shared<CardinalityEstimator>()) {}
+
+LQPTranslator::LQPTranslator(const std::shared_ptr<AbstractCardinalityEstimator>& cardinality_estimator)
+    : LQPTranslator(
+          std::make_shared<CostEstimatorPhysical>(cardinality_estimator, Hyrise::get().physical_cost_coefficients)) {}
+
+LQPTranslator::LQPTranslator(const std::shared_ptr<CostEstimatorPhysical>& cost_estimator)
+    : _cost_estimator(cost_estimator) {}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::shared_ptr<AbstractLQPNode>& node) const {
   /**
    * Translate a node (i.e. call `_translate_by_node_type`) only if it hasn't been translated before, otherwise just
@@ -174,6 +293,8 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
       return _translate_predicate_node_to_table_scan(predicate_node, input_operator);
     case ScanType::IndexScan:
       return _translate_predicate_node_to_index_scan(predicate_node, input_operator);
+    case ScanType::TableIndexScan:
+      return _translate_predicate_node_to_table_index_scan(predicate_node, input_operator);
   }
 
   Fail("Invalid enum value");
@@ -262,6 +383,25 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   return std::make_shared<UnionAll>(index_scan, table_scan);
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_table_index_scan(
+    const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const {
+  // The table index belongs to the stored table, so the IndexScan has to be executed on the GetTable
+  Assert(node->left_input()->type == LQPNodeType::StoredTable, "TableIndexScan must follow a StoredTableNode.");
+
+  const auto operator_predicates = OperatorScanPredicate::from_expression(*node->predicate(), *node);
+  Assert(operator_predicates && operator_predicates->size() == 1, "Expected a single predicate for TableIndexScan");
+
+  const auto& operator_predicate = operator_predicates->front();
+  Assert(operator_predicate.predicate_condition == PredicateCondition::Equals && is_variant(operator_predicate.value),
+         "TableIndexScan requires an equality predicate with a value");
+
+  const auto index_scan = std::make_shared<IndexScan>(input_operator, operator_predicate.column_id,
+                                                      boost::get<AllTypeVariant>(operator_predicate.value));
+  index_scan->lqp_node = node;
+
+  return index_scan;
+}
+
 std::shared_ptr<TableScan> LQPTranslator::_translate_predicate_node_to_table_scan(
     const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const {
   return std::make_shared<TableScan>(input_operator, _translate_expression(node->predicate(), node->left_input()));
@@ -295,10 +435,13 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_projection_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
   auto input_operator = translate_node(node->left_input());
+  return std::make_shared<Sort>(input_operator, _translate_sort_column_definitions(node));
+}
 
-  std::shared_ptr<AbstractOperator> current_pqp = input_operator;
+std::vector<SortColumnDefinition> LQPTranslator::_translate_sort_column_definitions(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
   const auto& pqp_expressions = _translate_expressions(sort_node->node_expressions, node->left_input());
 
   auto pqp_expression_iter = pqp_expressions.begin();
@@ -314,9 +457,8 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
 
     column_definitions.emplace_back(SortColumnDefinition{pqp_column_expression->column_id, *sort_mode_iter});
   }
-  current_pqp = std::make_shared<Sort>(current_pqp, column_definitions);
 
-  return current_pqp;
+  return column_definitions;
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
@@ -348,32 +490,123 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
   const auto& primary_join_predicate = join_predicates.front();
   std::vector<OperatorJoinPredicate> secondary_join_predicates(join_predicates.cbegin() + 1, join_predicates.cend());
 
-  auto join_operator = std::shared_ptr<AbstractOperator>{};
-
   const auto left_data_type = join_node->join_predicates().front()->arguments[0]->data_type();
   const auto right_data_type = join_node->join_predicates().front()->arguments[1]->data_type();
+  const auto join_configuration =
+      JoinConfiguration{join_node->join_mode, primary_join_predicate.predicate_condition, left_data_type,
+                        right_data_type, !secondary_join_predicates.empty()};
+
+  // JoinSortMerge neither clusters nor sorts inputs that are sorted by the join columns within their chunks. JoinIndex
+  // is only considered for equi joins of equal data types if the right input has indexes on the join column.
+  auto input_properties = PhysicalInputProperties{};
+  input_properties.sorted = is_sorted_within_chunks(*left_input_operator, primary_join_predicate.column_ids.first) &&
+                            is_sorted_within_chunks(*right_input_operator, primary_join_predicate.column_ids.second);
+  if (primary_join_predicate.predicate_condition == PredicateCondition::Equals && left_data_type == right_data_type) {
+    determine_indexed_chunks(*right_input_operator, primary_join_predicate.column_ids.second, input_properties);
+  }
 
-  // Lacking a proper cost model, we assume JoinHash is always faster than JoinSortMerge, which is faster than
-  // JoinNestedLoop and thus check for an operator compatible with the JoinNode in that order
-  constexpr auto JOIN_OPERATOR_PREFERENCE_ORDER =
-      hana::to_tuple(hana::tuple_t<JoinHash, JoinSortMerge, JoinNestedLoop>);
+  auto join_operator_types = std::vector<OperatorType>{};
+  if (JoinHash::supports(join_configuration)) join_operator_types.emplace_back(OperatorType::JoinHash);
+  if (JoinSortMerge::supports(join_configuration)) join_operator_types.emplace_back(OperatorType::JoinSortMerge);
+  if (input_properties.indexed_chunk_count > 0) {
+    // Only the table type of the index side is relevant. It is known for the inputs accepted by
+    // determine_indexed_chunks().
+    auto index_join_configuration = join_configuration;
+    index_join_configuration.left_table_type = TableType::References;
+    index_join_configuration.right_table_type =
+        right_input_operator->type() == OperatorType::GetTable ? TableType::Data : TableType::References;
+    index_join_configuration.index_side = IndexSide::Right;
+    if (JoinIndex::supports(index_join_configuration)) join_operator_types.emplace_back(OperatorType::JoinIndex);
+  }
 
-  boost::hana::for_each(JOIN_OPERATOR_PREFERENCE_ORDER, [&](const auto join_operator_t) {
-    using JoinOperator = typename decltype(join_operator_t)::type;
+  // JoinNestedLoop is only used if no other operator supports the JoinNode, as it is hardly ever the fastest one.
+  if (join_operator_types.empty() && JoinNestedLoop::supports(join_configuration)) {
+    join_operator_types.emplace_back(OperatorType::JoinNestedLoop);
+  }
+  Assert(!join_operator_types.empty(),
+         "No operator implementation available for join '"s + join_node->description() + "'");
+
+  // Pick the cheapest implementation. In case of equal costs, the first one is used.
+  auto join_operator_type = join_operator_types.front();
+  if (join_operator_types.size() > 1) {
+    const auto& cost_estimator = _caching_cost_estimator();
+    auto min_cost = cost_estimator.estimate_join_cost(join_node, join_operator_type, input_properties);
+    for (auto candidate_idx = size_t{1}; candidate_idx < join_operator_types.size(); ++candidate_idx) {
+      const auto cost =
+          cost_estimator.estimate_join_cost(join_node, join_operator_types[candidate_idx], input_properties);
+      if (cost < min_cost) {
+        min_cost = cost;
+        join_operator_type = join_operator_types[candidate_idx];
+      }
+    }
+  }
 
-    if (join_operator) return;
+  auto join_operator = std::shared_ptr<AbstractOperator>{};
+  switch (join_operator_type) {
+    case OperatorType::JoinHash:
+      join_operator = std::make_shared<JoinHash>(left_input_operator, right_input_operator, join_node->join_mode,
+                                                 primary_join_predicate, std::move(secondary_join_predicates));
+      break;
+    case OperatorType::JoinSortMerge:
+      join_operator = std::make_shared<JoinSortMerge>(left_input_operator, right_input_operator, join_node->join_mode,
+                                                      primary_join_predicate, std::move(secondary_join_predicates));
+      break;
+    case OperatorType::JoinIndex:
+      join_operator = std::make_shared<JoinIndex>(left_input_operator, right_input_operator, join_node->join_mode,
+                                                  primary_join_predicate, std::move(secondary_join_predicates),
+                                                  IndexSide::Right);
+      break;
+    case OperatorType::JoinNestedLoop:
+      join_operator = std::make_shared<JoinNestedLoop>(left_input_operator, right_input_operator,
+                                                       join_node->join_mode, primary_join_predicate,
+                                                       std::move(secondary_join_predicates));
+      break;
+    default:
+      Fail("Unexpected join operator type");
+  }
 
-    if (JoinOperator::supports({join_node->join_mode, primary_join_predicate.predicate_condition, left_data_type,
-                                right_data_type, !secondary_join_predicates.empty()})) {
-      join_operator = std::make_shared<JoinOperator>(left_input_operator, right_input_operator, join_node->join_mode,
-                                                     primary_join_predicate, std::move(secondary_join_predicates));
-    }
-  });
-  Assert(join_operator, "No operator implementation available for join '"s + join_node->description() + "'");
+  if (join_operator->type() == OperatorType::JoinHash && left_data_type == right_data_type) {
+    _add_runtime_join_filter(join_node->join_mode, primary_join_predicate, left_input_operator, right_input_operator);
+  }
 
   return join_operator;
 }
 
+void LQPTranslator::_add_runtime_join_filter(const JoinMode join_mode, const OperatorJoinPredicate& primary_predicate,
+                                             const std::shared_ptr<AbstractOperator>& left_input_operator,
+                                             const std::shared_ptr<AbstractOperator>& right_input_operator) const {
+  /**
+   * Only inner and semi joins discard probe side rows without a join partner. For semi joins, the left input is the
+   * probe side. For inner joins, any side can be filtered with the values of the other side. We prefer filtering the
+   * right input, as that is the side that JoinHash probes unless the right input is smaller.
+   */
+  auto probe_is_left_input = false;
+  if (join_mode == JoinMode::Semi) {
+    probe_is_left_input = true;
+  } else if (join_mode == JoinMode::Inner) {
+    probe_is_left_input = right_input_operator->type() != OperatorType::TableScan;
+  } else {
+    return;
+  }
+
+  const auto& probe_input_operator = probe_is_left_input ? left_input_operator : right_input_operator;
+  const auto& build_input_operator = probe_is_left_input ? right_input_operator : left_input_operator;
+
+  // The filter drops rows from the scan's output. This is only possible if the join is its only consumer.
+  const auto table_scan = std::dynamic_pointer_cast<TableScan>(probe_input_operator);
+  if (!table_scan || table_scan->runtime_join_filter() || table_scan->consumer_count() != 1 ||
+      table_scan == build_input_operator) {
+    return;
+  }
+
+  const auto build_column_id =
+      probe_is_left_input ? primary_predicate.column_ids.second : primary_predicate.column_ids.first;
+  const auto probe_column_id =
+      probe_is_left_input ? primary_predicate.column_ids.first : primary_predicate.column_ids.second;
+  table_scan->set_runtime_join_filter(
+      std::make_shared<RuntimeJoinFilter>(build_input_operator, build_column_id, probe_column_id));
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto aggregate_node = std::dynamic_pointer_cast<AggregateNode>(node);
@@ -410,15 +643,53 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     group_by_column_ids.emplace_back(*column_id);
   }
 
+  // AggregateSort only sorts inputs that are value clustered by a group-by column chunk by chunk, and it does not sort
+  // them at all if they are also sorted by the only group-by column within each chunk. Of all operators, only
+  // JoinSortMerge produces value-clustered outputs. Other inputs have no properties that AggregateSort benefits from,
+  // so AggregateHash is used for them. Without group-by columns, both operators aggregate the input in a single pass.
+  if (!group_by_column_ids.empty() && input_operator->type() == OperatorType::JoinSortMerge) {
+    const auto& join_sort_merge = static_cast<const JoinSortMerge&>(*input_operator);
+    const auto join_mode = join_sort_merge.mode();
+    const auto& primary_predicate = join_sort_merge.primary_predicate();
+
+    // As in is_sorted_within_chunks(), only the left join column is checked
+    auto input_properties = PhysicalInputProperties{};
+    input_properties.value_clustered =
+        join_mode != JoinMode::Left && join_mode != JoinMode::Right && join_mode != JoinMode::FullOuter &&
+        primary_predicate.predicate_condition == PredicateCondition::Equals &&
+        std::find(group_by_column_ids.cbegin(), group_by_column_ids.cend(), primary_predicate.column_ids.first) !=
+            group_by_column_ids.cend();
+    input_properties.sorted =
+        group_by_column_ids.size() == 1 && is_sorted_within_chunks(*input_operator, group_by_column_ids.front());
+
+    const auto& cost_estimator = _caching_cost_estimator();
+    if (cost_estimator.estimate_aggregate_cost(aggregate_node, AggregateImplementation::Sort, input_properties) <
+        cost_estimator.estimate_aggregate_cost(aggregate_node, AggregateImplementation::Hash, input_properties)) {
+      return std::make_shared<AggregateSort>(input_operator, pqp_aggregate_expressions, group_by_column_ids);
+    }
+  }
+
   return std::make_shared<AggregateHash>(input_operator, pqp_aggregate_expressions, group_by_column_ids);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_limit_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_input());
   auto limit_node = std::dynamic_pointer_cast<LimitNode>(node);
+  const auto& input_node = node->left_input();
+
+  // If the Limit directly follows a Sort with a constant number of rows, we fuse both into a TopK operator. This avoids
+  // sorting the entire input when only the first few rows are needed. We only do this if the Sort has no other
+  // consumers, as these would need the entire sorted input.
+  if (input_node->type == LQPNodeType::Sort && input_node->output_count() == 1 &&
+      limit_node->num_rows_expression()->type == ExpressionType::Value) {
+    const auto sort_input_operator = translate_node(input_node->left_input());
+    return std::make_shared<TopK>(sort_input_operator, _translate_sort_column_definitions(input_node),
+                                  _translate_expressions({limit_node->num_rows_expression()}, input_node).front());
+  }
+
+  const auto input_operator = translate_node(input_node);
   return std::make_shared<Limit>(
-      input_operator, _translate_expressions({limit_node->num_rows_expression()}, node->left_input()).front());
+      input_operator, _translate_expressions({limit_node->num_rows_expression()}, input_node).front());
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_insert_node(
@@ -653,4 +924,12 @@ std::vector<std::shared_ptr<AbstractExpression>> LQPTranslator::_translate_expre
   return pqp_expressions;
 }
 
+const CostEstimatorPhysical& LQPTranslator::_caching_cost_estimator() const {
+  if (!_caching_cost_estimator_instance) {
+    _caching_cost_estimator_instance = std::static_pointer_cast<CostEstimatorPhysical>(_cost_estimator->new_instance());
+    _caching_cost_estimator_instance->guarantee_bottom_up_construction();
+  }
+  return *_caching_cost_estimator_instance;
+}
+
 }  // namespace opossum
@@ -5,7 +5,9 @@
 
 #include "abstract_lqp_node.hpp"
 #include "all_type_variant.hpp"
+#include "cost_estimation/cost_estimator_physical.hpp"
 #include "operators/abstract_operator.hpp"
+#include "statistics/cardinality_estimator.hpp"
 
 namespace opossum {
 
@@ -20,9 +22,23 @@ struct OperatorJoinPredicate;
 /**
  * Translates an LQP (Logical Query Plan), represented by its root node, into an Operator tree for the execution
  * engine, which in return is represented by its root Operator.
+ *
+ * Where several operators implement a node (joins and aggregates), the CostEstimatorPhysical picks the cheapest one.
+ * As the LQP does not change during its translation, the estimated cardinalities and costs are cached. The caching
+ * estimator is only created once a node actually has to be costed, so that plans without a choice between operators
+ * (e.g., most OLTP queries) are not estimated at all.
  */
 class LQPTranslator {
  public:
+  // Uses the PhysicalCostCoefficients installed in Hyrise::get().physical_cost_coefficients and a CardinalityEstimator
+  LQPTranslator();
+
+  // Uses the PhysicalCostCoefficients installed in Hyrise::get().physical_cost_coefficients and the same kind of
+  // cardinality estimator as the Optimizer that optimized the LQP (see Optimizer::cost_estimator())
+  explicit LQPTranslator(const std::shared_ptr<AbstractCardinalityEstimator>& cardinality_estimator);
+
+  explicit LQPTranslator(const std::shared_ptr<CostEstimatorPhysical>& cost_estimator);
+
   virtual ~LQPTranslator() = default;
 
   virtual std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -35,12 +51,19 @@ class LQPTranslator {
   std::shared_ptr<AbstractOperator> _translate_predicate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_predicate_node_to_index_scan(
       const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
+  std::shared_ptr<AbstractOperator> _translate_predicate_node_to_table_index_scan(
+      const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
   std::shared_ptr<TableScan> _translate_predicate_node_to_table_scan(
       const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
   std::shared_ptr<AbstractOperator> _translate_alias_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_projection_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_sort_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  std::vector<SortColumnDefinition> _translate_sort_column_definitions(
+      const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_join_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  void _add_runtime_join_filter(const JoinMode join_mode, const OperatorJoinPredicate& primary_predicate,
+                                const std::shared_ptr<AbstractOperator>& left_input_operator,
+                                const std::shared_ptr<AbstractOperator>& right_input_operator) const;
   std::shared_ptr<AbstractOperator> _translate_aggregate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_limit_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_insert_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -78,6 +101,12 @@ class LQPTranslator {
   //   - identical operators (operators below a diamond shape)
   //   - equal but not identical operators
   mutable LQPNodeUnorderedMap<std::shared_ptr<AbstractOperator>> _operator_by_lqp_node;
+
+  // Returns the caching instance of the _cost_estimator, which is created on the first call
+  const CostEstimatorPhysical& _caching_cost_estimator() const;
+
+  std::shared_ptr<CostEstimatorPhysical> _cost_estimator;
+  mutable std::shared_ptr<CostEstimatorPhysical> _caching_cost_estimator_instance;
 };
 
 }  // namespace opossum
@@ -13,7 +13,8 @@ namespace opossum {
 
 class AbstractExpression;
 
-enum class ScanType : uint8_t { TableScan, IndexScan };
+// IndexScan uses the chunk indexes (GroupKey), TableIndexScan the table index (see TableHashIndex)
+enum class ScanType : uint8_t { TableScan, IndexScan, TableIndexScan };
 
 /**
  * This node type represents a filter.
@@ -45,6 +45,7 @@ enum class OperatorType {
   Sort,
   TableScan,
   TableWrapper,
+  TopK,
   UnionAll,
   UnionPositions,
   Update,
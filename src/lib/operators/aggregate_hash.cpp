@@ -15,8 +15,10 @@
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/base_dictionary_segment.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
 #include "utils/aligned_size.hpp"
 #include "utils/assert.hpp"
 #include "utils/performance_warning.hpp"
@@ -33,6 +35,13 @@ using namespace opossum;  // NOLINT
 // aggregate functions can then retrieve the index from the AggregateKey.
 constexpr auto CACHE_MASK = AggregateKeyEntry{1} << 63u;  // See explanation below
 
+// Below this number of rows per worker, pre-aggregating the input in parallel does not pay off (see _aggregate).
+constexpr auto MIN_ROWS_PER_AGGREGATION_JOB = size_t{16'384};
+
+// If the thread-local pre-aggregation produced fewer groups than this, the partial results are merged without
+// partitioning them first (see _aggregate_parallel).
+constexpr auto MIN_GROUPS_FOR_PARTITIONED_MERGE = size_t{16'384};
+
 template <typename CacheResultIds, typename ResultIds, typename Results, typename AggregateKey>
 typename Results::reference get_or_add_result(CacheResultIds, ResultIds& result_ids, Results& results,
                                               AggregateKey& key, const RowID& row_id) {
@@ -137,6 +146,73 @@ AggregateKey& get_aggregate_key([[maybe_unused]] KeysPerChunk<AggregateKey>& key
   }
 }
 
+// If the values of the segment are stored in a dictionary segment, either directly or referenced by a ReferenceSegment
+// that points to a single chunk, the GROUP BY ids can be derived from the value ids. For this, the value ids are
+// translated into ids using a dense vector that has one entry per dictionary entry. get_id is thus called only once per
+// distinct value of the chunk instead of once per row. Returns false if the segment does not qualify.
+template <typename ColumnDataType, typename GetId, typename SetKey>
+bool partition_by_value_ids(const AbstractSegment& segment, const GetId& get_id, const SetKey& set_key) {
+  auto dictionary_segment = static_cast<const BaseDictionarySegment*>(nullptr);
+  auto position_filter = std::shared_ptr<const AbstractPosList>{};
+  if (const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    const auto& pos_list = reference_segment->pos_list();
+    if (!pos_list->references_single_chunk() || pos_list->empty()) return false;
+
+    const auto referenced_chunk = reference_segment->referenced_table()->get_chunk(pos_list->common_chunk_id());
+    if (!referenced_chunk) return false;
+
+    dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(
+        referenced_chunk->get_segment(reference_segment->referenced_column_id()).get());
+    position_filter = pos_list;
+  } else {
+    dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment);
+  }
+
+  // For large dictionaries of which only few values are referenced, the translation vector would cost more than it
+  // saves.
+  if (!dictionary_segment || dictionary_segment->unique_values_count() > segment.size()) return false;
+
+  // The ids of the value ids that have been seen so far. The maximum AggregateKeyEntry marks value ids that have not
+  // been seen yet.
+  auto ids = std::vector<AggregateKeyEntry>(dictionary_segment->unique_values_count(),
+                                            std::numeric_limits<AggregateKeyEntry>::max());
+  const auto null_value_id = dictionary_segment->null_value_id();
+
+  const auto process_value_id = [&](const ChunkOffset chunk_offset, const ValueID value_id) {
+    if (value_id == null_value_id) {
+      set_key(chunk_offset, AggregateKeyEntry{0});
+      return;
+    }
+
+    auto& id = ids[value_id];
+    if (id == std::numeric_limits<AggregateKeyEntry>::max()) {
+      id = get_id(boost::get<ColumnDataType>(dictionary_segment->value_of_value_id(value_id)));
+    }
+    set_key(chunk_offset, id);
+  };
+
+  resolve_compressed_vector_type(*dictionary_segment->attribute_vector(), [&](const auto& attribute_vector) {
+    auto chunk_offset = ChunkOffset{0};
+    if (!position_filter) {
+      for (const auto value_id : attribute_vector) {
+        process_value_id(chunk_offset, ValueID{value_id});
+        ++chunk_offset;
+      }
+      return;
+    }
+
+    auto decompressor = attribute_vector.create_decompressor();
+    resolve_pos_list_type(position_filter, [&](const auto& resolved_position_filter) {
+      for (const auto& row_id : *resolved_position_filter) {
+        process_value_id(chunk_offset, ValueID{decompressor.get(row_id.chunk_offset)});
+        ++chunk_offset;
+      }
+    });
+  });
+
+  return true;
+}
+
 }  // namespace
 
 namespace opossum {
@@ -200,17 +276,62 @@ struct AggregateContext : public AggregateResultContext<ColumnDataType, aggregat
   std::unique_ptr<AggregateResultIdMap<AggregateKey>> result_ids;
 };
 
+// Merges the partial result of a group (as computed by one of the jobs of _aggregate_parallel) into the result of that
+// group.
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+void merge_aggregate_results(AggregateResult<ColumnDataType, aggregate_function>& result,
+                             const AggregateResult<ColumnDataType, aggregate_function>& partial_result) {
+  if (result.row_id.is_null()) result.row_id = partial_result.row_id;
+  if (partial_result.aggregate_count == 0) return;
+
+  if constexpr (aggregate_function == AggregateFunction::Min) {
+    if (result.aggregate_count == 0 || value_smaller(partial_result.accumulator, result.accumulator)) {
+      result.accumulator = partial_result.accumulator;
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Max) {
+    if (result.aggregate_count == 0 || value_greater(partial_result.accumulator, result.accumulator)) {
+      result.accumulator = partial_result.accumulator;
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Sum || aggregate_function == AggregateFunction::Avg) {
+    result.accumulator += partial_result.accumulator;
+  } else if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+    result.accumulator.insert(partial_result.accumulator.begin(), partial_result.accumulator.end());
+  } else if constexpr (aggregate_function == AggregateFunction::StandardDeviationSample) {
+    // Combine count, mean, and squared_distance_from_mean of both partial results (see AggregateFunctionBuilder), cf.
+    // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+    auto& count = result.accumulator[0];
+    auto& mean = result.accumulator[1];
+    auto& squared_distance_from_mean = result.accumulator[2];
+    const auto partial_count = partial_result.accumulator[0];
+    const auto partial_mean = partial_result.accumulator[1];
+    const auto partial_squared_distance_from_mean = partial_result.accumulator[2];
+
+    const auto combined_count = count + partial_count;
+    const auto delta = partial_mean - mean;
+    mean += delta * partial_count / combined_count;
+    squared_distance_from_mean +=
+        partial_squared_distance_from_mean + delta * delta * count * partial_count / combined_count;
+    count = combined_count;
+
+    if (count > 1) {
+      result.accumulator[3] = std::sqrt(squared_distance_from_mean / (count - 1));
+    }
+  }
+
+  result.aggregate_count += partial_result.aggregate_count;
+}
+
 template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-__attribute__((hot)) void AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index,
-                                                            const AbstractSegment& abstract_segment,
-                                                            KeysPerChunk<AggregateKey>& keys_per_chunk) {
+__attribute__((hot)) void AggregateHash::_aggregate_segment(
+    ChunkID chunk_id, ColumnID column_index, const AbstractSegment& abstract_segment,
+    KeysPerChunk<AggregateKey>& keys_per_chunk, const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts) {
   using AggregateType = typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType;
 
   auto aggregator =
       AggregateFunctionBuilder<ColumnDataType, AggregateType, aggregate_function>().get_aggregate_function();
 
   auto& context = *std::static_pointer_cast<AggregateContext<ColumnDataType, aggregate_function, AggregateKey>>(
-      _contexts_per_column[column_index]);
+      contexts[column_index]);
 
   auto& result_ids = *context.result_ids;
   auto& results = context.results;
@@ -243,7 +364,7 @@ __attribute__((hot)) void AggregateHash::_aggregate_segment(ChunkID chunk_id, Co
   // (and thus more than one context), it makes sense to cache the results indexes, see get_or_add_result for details.
   // Furthermore, if we use the immediate key shortcut (which uses the same code path as caching), we need to pass
   // true_type so that the aggregate keys are checked for immediate access values.
-  if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
+  if (contexts.size() > 1 || _use_immediate_key_shortcut) {
     segment_iterate<ColumnDataType>(abstract_segment,
                                     [&](const auto& position) { process_position(std::true_type{}, position); });
   } else {
@@ -420,97 +541,97 @@ KeysPerChunk<AggregateKey> AggregateHash::_partition_by_groupby_keys() {
               id_counter = 5'000'000'000;
             }
 
+            // Returns the id of a non-NULL value. We need to generate an ID that is unique for the value. In some
+            // cases, we can use an optimization, in others, we can't. We need to somehow track whether we have found
+            // an ID or not. For this, we first set `id` to its maximum value. If after all branches it is still that
+            // max value, no optimized ID generation was applied and we need to generate the ID using the value->ID map.
+            const auto get_id = [&](const auto& value) {
+              auto id = std::numeric_limits<AggregateKeyEntry>::max();
+
+              if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+                const auto& string = value;
+                if (string.size() < 5) {
+                  static_assert(std::is_same_v<AggregateKeyEntry, uint64_t>, "Calculation only valid for uint64_t");
+
+                  const auto char_to_uint = [](const char in, const uint bits) {
+                    // chars may be signed or unsigned. For the calculation as described below, we need signed
+                    // chars.
+                    return static_cast<uint64_t>(*reinterpret_cast<const uint8_t*>(&in)) << bits;
+                  };
+
+                  switch (string.size()) {
+                      // Optimization for short strings (see above):
+                      //
+                      // NULL:              0
+                      // str.length() == 0: 1
+                      // str.length() == 1: 2 + (uint8_t) str            // maximum: 257 (2 + 0xff)
+                      // str.length() == 2: 258 + (uint16_t) str         // maximum: 65'793 (258 + 0xffff)
+                      // str.length() == 3: 65'794 + (uint24_t) str      // maximum: 16'843'009
+                      // str.length() == 4: 16'843'010 + (uint32_t) str  // maximum: 4'311'810'305
+                      // str.length() >= 5: map-based identifiers, starting at 5'000'000'000 for better distinction
+                      //
+                      // This could be extended to longer strings if the size of the input table (and thus the
+                      // maximum number of distinct strings) is taken into account. For now, let's not make it even
+                      // more complicated.
+
+                    case 0: {
+                      id = uint64_t{1};
+                    } break;
+
+                    case 1: {
+                      id = uint64_t{2} + char_to_uint(string[0], 0);
+                    } break;
+
+                    case 2: {
+                      id = uint64_t{258} + char_to_uint(string[1], 8) + char_to_uint(string[0], 0);
+                    } break;
+
+                    case 3: {
+                      id = uint64_t{65'794} + char_to_uint(string[2], 16) + char_to_uint(string[1], 8) +
+                           char_to_uint(string[0], 0);
+                    } break;
+
+                    case 4: {
+                      id = uint64_t{16'843'010} + char_to_uint(string[3], 24) + char_to_uint(string[2], 16) +
+                           char_to_uint(string[1], 8) + char_to_uint(string[0], 0);
+                    } break;
+                  }
+                }
+              }
+
+              if (id == std::numeric_limits<AggregateKeyEntry>::max()) {
+                // Could not take the shortcut above, either because we don't have a string or because it is too
+                // long
+                auto inserted = id_map.try_emplace(value, id_counter);
+
+                id = inserted.first->second;
+
+                // if the id_map didn't have the value as a key and a new element was inserted
+                if (inserted.second) ++id_counter;
+              }
+
+              return id;
+            };
+
             for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
               const auto chunk_in = input_table->get_chunk(chunk_id);
               if (!chunk_in) continue;
 
               auto& keys = keys_per_chunk[chunk_id];
+              const auto set_key = [&](const ChunkOffset chunk_offset, const AggregateKeyEntry id) {
+                if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+                  keys[chunk_offset] = id;
+                } else {
+                  keys[chunk_offset][group_column_index] = id;
+                }
+              };
 
               const auto abstract_segment = chunk_in->get_segment(groupby_column_id);
+              if (partition_by_value_ids<ColumnDataType>(*abstract_segment, get_id, set_key)) continue;
+
               ChunkOffset chunk_offset{0};
               segment_iterate<ColumnDataType>(*abstract_segment, [&](const auto& position) {
-                if (position.is_null()) {
-                  if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                    keys[chunk_offset] = 0u;
-                  } else {
-                    keys[chunk_offset][group_column_index] = 0u;
-                  }
-                } else {
-                  // We need to generate an ID that is unique for the value. In some cases, we can use an optimization,
-                  // in others, we can't. We need to somehow track whether we have found an ID or not. For this, we
-                  // first set `id` to its maximum value. If after all branches it is still that max value, no optimized
-                  // ID generation was applied and we need to generate the ID using the value->ID map.
-                  auto id = std::numeric_limits<AggregateKeyEntry>::max();
-
-                  if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
-                    const auto& string = position.value();
-                    if (string.size() < 5) {
-                      static_assert(std::is_same_v<AggregateKeyEntry, uint64_t>, "Calculation only valid for uint64_t");
-
-                      const auto char_to_uint = [](const char in, const uint bits) {
-                        // chars may be signed or unsigned. For the calculation as described below, we need signed
-                        // chars.
-                        return static_cast<uint64_t>(*reinterpret_cast<const uint8_t*>(&in)) << bits;
-                      };
-
-                      switch (string.size()) {
-                          // Optimization for short strings (see above):
-                          //
-                          // NULL:              0
-                          // str.length() == 0: 1
-                          // str.length() == 1: 2 + (uint8_t) str            // maximum: 257 (2 + 0xff)
-                          // str.length() == 2: 258 + (uint16_t) str         // maximum: 65'793 (258 + 0xffff)
-                          // str.length() == 3: 65'794 + (uint24_t) str      // maximum: 16'843'009
-                          // str.length() == 4: 16'843'010 + (uint32_t) str  // maximum: 4'311'810'305
-                          // str.length() >= 5: map-based identifiers, starting at 5'000'000'000 for better distinction
-                          //
-                          // This could be extended to longer strings if the size of the input table (and thus the
-                          // maximum number of distinct strings) is taken into account. For now, let's not make it even
-                          // more complicated.
-
-                        case 0: {
-                          id = uint64_t{1};
-                        } break;
-
-                        case 1: {
-                          id = uint64_t{2} + char_to_uint(string[0], 0);
-                        } break;
-
-                        case 2: {
-                          id = uint64_t{258} + char_to_uint(string[1], 8) + char_to_uint(string[0], 0);
-                        } break;
-
-                        case 3: {
-                          id = uint64_t{65'794} + char_to_uint(string[2], 16) + char_to_uint(string[1], 8) +
-                               char_to_uint(string[0], 0);
-                        } break;
-
-                        case 4: {
-                          id = uint64_t{16'843'010} + char_to_uint(string[3], 24) + char_to_uint(string[2], 16) +
-                               char_to_uint(string[1], 8) + char_to_uint(string[0], 0);
-                        } break;
-                      }
-                    }
-                  }
-
-                  if (id == std::numeric_limits<AggregateKeyEntry>::max()) {
-                    // Could not take the shortcut above, either because we don't have a string or because it is too
-                    // long
-                    auto inserted = id_map.try_emplace(position.value(), id_counter);
-
-                    id = inserted.first->second;
-
-                    // if the id_map didn't have the value as a key and a new element was inserted
-                    if (inserted.second) ++id_counter;
-                  }
-
-                  if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-                    keys[chunk_offset] = id;
-                  } else {
-                    keys[chunk_offset][group_column_index] = id;
-                  }
-                }
-
+                set_key(chunk_offset, position.is_null() ? AggregateKeyEntry{0} : get_id(position.value()));
                 ++chunk_offset;
               });
             }
@@ -563,24 +684,63 @@ void AggregateHash::_aggregate() {
   /**
    * AGGREGATION STEP
    */
-  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+  _contexts_per_column = _create_contexts<AggregateKey>(_expected_result_size);
+
+  // Larger inputs are pre-aggregated in parallel, see _aggregate_parallel. Each job processes a consecutive range of
+  // chunks with at least MIN_ROWS_PER_AGGREGATION_JOB rows. With the immediate key shortcut, the keys are already
+  // indexes into the results and no hash map is built, so there is not much to gain.
+  const auto chunk_count = input_table->chunk_count();
+  const auto worker_count = Hyrise::get().scheduler()->workers().size();
+  const auto job_count = std::min(worker_count, input_table->row_count() / MIN_ROWS_PER_AGGREGATION_JOB);
+
+  auto chunk_ranges = std::vector<std::pair<ChunkID, ChunkID>>{};
+  if (job_count > 1 && !_use_immediate_key_shortcut) {
+    const auto rows_per_job = input_table->row_count() / job_count;
+    auto range_begin = ChunkID{0};
+    auto range_row_count = size_t{0};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = input_table->get_chunk(chunk_id);
+      if (chunk) range_row_count += chunk->size();
+
+      if (range_row_count >= rows_per_job || chunk_id + 1 == chunk_count) {
+        chunk_ranges.emplace_back(range_begin, ChunkID{chunk_id + 1});
+        range_begin = ChunkID{chunk_id + 1};
+        range_row_count = 0;
+      }
+    }
+  }
+
+  if (chunk_ranges.size() > 1) {
+    _aggregate_parallel<AggregateKey>(chunk_ranges, keys_per_chunk);
+  } else {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      _aggregate_chunk<AggregateKey>(chunk_id, _contexts_per_column, keys_per_chunk);
+    }
+  }
+  step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
+}
+
+template <typename AggregateKey>
+std::vector<std::shared_ptr<SegmentVisitorContext>> AggregateHash::_create_contexts(
+    const size_t preallocated_size) const {
+  const auto& input_table = left_input_table();
+  auto contexts = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
 
   if (!_has_aggregate_functions) {
     /*
     Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
+    That way, contexts will always have at least one context with results.
     This is important later on when we write the group keys into the table.
     The template parameters (int32_t, AggregateFunction::Min) do not matter, as we do not calculate an aggregate anyway.
     */
-    auto context =
-        std::make_shared<AggregateContext<int32_t, AggregateFunction::Min, AggregateKey>>(_expected_result_size);
+    auto context = std::make_shared<AggregateContext<int32_t, AggregateFunction::Min, AggregateKey>>(preallocated_size);
 
-    _contexts_per_column.push_back(context);
+    contexts.push_back(context);
   }
 
   /**
    * Create an AggregateContext for each column in the input table that a normal (i.e. non-DISTINCT) aggregate is
-   * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
+   * created on. We do this here, and not in the per-chunk-loop, because there might be no Chunks in the input
    * and _write_aggregate_output() needs these contexts anyway.
    */
   for (ColumnID aggregate_idx{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
@@ -593,175 +753,414 @@ void AggregateHash::_aggregate() {
       Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
       // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
       auto context = std::make_shared<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-          _expected_result_size);
+          preallocated_size);
 
-      _contexts_per_column[aggregate_idx] = context;
+      contexts[aggregate_idx] = context;
       continue;
     }
     const auto data_type = input_table->column_data_type(input_column_id);
-    _contexts_per_column[aggregate_idx] =
-        _create_aggregate_context<AggregateKey>(data_type, aggregate->aggregate_function);
+    contexts[aggregate_idx] =
+        _create_aggregate_context<AggregateKey>(data_type, aggregate->aggregate_function, preallocated_size);
   }
 
-  // Process Chunks and perform aggregations
-  const auto chunk_count = input_table->chunk_count();
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-    const auto chunk_in = input_table->get_chunk(chunk_id);
-    if (!chunk_in) continue;
+  return contexts;
+}
 
-    // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
-    const auto input_chunk_size = chunk_in->size();
+template <typename AggregateKey>
+void AggregateHash::_aggregate_chunk(const ChunkID chunk_id,
+                                     const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts,
+                                     KeysPerChunk<AggregateKey>& keys_per_chunk) {
+  const auto& input_table = left_input_table();
+  const auto chunk_in = input_table->get_chunk(chunk_id);
+  if (!chunk_in) return;
 
-    if (!_has_aggregate_functions) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without 
-       * aggregate functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly
-       * as `SELECT DISTINCT *` are passed as `groupby_column_ids`).
-       *
-       * As the grouping happens as part of the aggregation but no aggregate function exists, we use
-       * `AggregateFunction::Min` as a fake aggregate function whose result will be discarded. From here on, the steps
-       * are the same as they are for a regular grouped aggregate.
-       */
+  // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
+  const auto input_chunk_size = chunk_in->size();
 
-      auto context =
-          std::static_pointer_cast<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
-              _contexts_per_column[0]);
-
-      auto& result_ids = *context->result_ids;
-      auto& results = context->results;
-
-      // Add value or combination of values is added to the list of distinct value(s). This is done by calling
-      // get_or_add_result, which adds the corresponding entry in the list of GROUP BY values.
-      if (_use_immediate_key_shortcut) {
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          // We are able to use immediate keys, so pass true_type so that the combined caching/immediate key code path
-          // is enabled in get_or_add_result.
-          get_or_add_result(std::true_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
-      } else {
-        // Same as above, but we do not have immediate keys, so we disable that code path to reduce the complexity of
-        // get_aggregate_key.
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          get_or_add_result(std::false_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
+  if (!_has_aggregate_functions) {
+    /**
+     * DISTINCT implementation
+     *
+     * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without 
+     * aggregate functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly
+     * as `SELECT DISTINCT *` are passed as `groupby_column_ids`).
+     *
+     * As the grouping happens as part of the aggregation but no aggregate function exists, we use
+     * `AggregateFunction::Min` as a fake aggregate function whose result will be discarded. From here on, the steps
+     * are the same as they are for a regular grouped aggregate.
+     */
+
+    auto context =
+        std::static_pointer_cast<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
+            contexts[0]);
+
+    auto& result_ids = *context->result_ids;
+    auto& results = context->results;
+
+    // Add value or combination of values is added to the list of distinct value(s). This is done by calling
+    // get_or_add_result, which adds the corresponding entry in the list of GROUP BY values.
+    if (_use_immediate_key_shortcut) {
+      for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+        // We are able to use immediate keys, so pass true_type so that the combined caching/immediate key code path
+        // is enabled in get_or_add_result.
+        get_or_add_result(std::true_type{}, result_ids, results,
+                          get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                          RowID{chunk_id, chunk_offset});
       }
     } else {
-      ColumnID aggregate_idx{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then go through the keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
+      // Same as above, but we do not have immediate keys, so we disable that code path to reduce the complexity of
+      // get_aggregate_key.
+      for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+        get_or_add_result(std::false_type{}, result_ids, results,
+                          get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                          RowID{chunk_id, chunk_offset});
+      }
+    }
+  } else {
+    ColumnID aggregate_idx{0};
+    for (const auto& aggregate : _aggregates) {
+      /**
+       * Special COUNT(*) implementation.
+       * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
+       * We then go through the keys_per_chunk map and count the occurrences of each group key.
+       * The results are saved in the regular aggregate_count variable so that we don't need a
+       * specific output logic for COUNT(*).
+       */
 
-        const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
-        const auto input_column_id = pqp_column.column_id;
+      const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
+      const auto input_column_id = pqp_column.column_id;
 
-        if (input_column_id == INVALID_COLUMN_ID) {
-          Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-          auto context =
-              std::static_pointer_cast<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-                  _contexts_per_column[aggregate_idx]);
+      if (input_column_id == INVALID_COLUMN_ID) {
+        Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
+        auto context =
+            std::static_pointer_cast<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
+                contexts[aggregate_idx]);
 
-          auto& result_ids = *context->result_ids;
-          auto& results = context->results;
+        auto& result_ids = *context->result_ids;
+        auto& results = context->results;
 
-          if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
-            // Not grouped by anything, simply count the number of rows
-            results.resize(1);
-            results[0].aggregate_count += input_chunk_size;
+        if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+          // Not grouped by anything, simply count the number of rows
+          results.resize(1);
+          results[0].aggregate_count += input_chunk_size;
 
-            // We need to set any RowID because the default value (NULL_ROW_ID) would later be skipped. As we are not
-            // reconstructing the GROUP BY values later, the exact value of this row_id does not matter, as long as it
-            // not NULL_ROW_ID.
-            results[0].row_id = RowID{ChunkID{0}, ChunkOffset{0}};
+          // We need to set any RowID because the default value (NULL_ROW_ID) would later be skipped. As we are not
+          // reconstructing the GROUP BY values later, the exact value of this row_id does not matter, as long as it
+          // not NULL_ROW_ID.
+          results[0].row_id = RowID{ChunkID{0}, ChunkOffset{0}};
+        } else {
+          // Count occurrences for each group key -  If we have more than one aggregate function (and thus more than
+          // one context), it makes sense to cache the results indexes, see get_or_add_result for details.
+          if (contexts.size() > 1 || _use_immediate_key_shortcut) {
+            for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+              // Use CacheResultIds==true_type if we have more than one group by column or if the cached result ids
+              // have been written by the immediate key shortcut
+              auto& result =
+                  get_or_add_result(std::true_type{}, result_ids, results,
+                                    get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                                    RowID{chunk_id, chunk_offset});
+              ++result.aggregate_count;
+            }
           } else {
-            // Count occurrences for each group key -  If we have more than one aggregate function (and thus more than
-            // one context), it makes sense to cache the results indexes, see get_or_add_result for details.
-            if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                // Use CacheResultIds==true_type if we have more than one group by column or if the cached result ids
-                // have been written by the immediate key shortcut
-                auto& result =
-                    get_or_add_result(std::true_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
-              }
-            } else {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                auto& result =
-                    get_or_add_result(std::false_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
-              }
+            for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+              auto& result =
+                  get_or_add_result(std::false_type{}, result_ids, results,
+                                    get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                                    RowID{chunk_id, chunk_offset});
+              ++result.aggregate_count;
             }
           }
+        }
 
-          ++aggregate_idx;
-          continue;
+        ++aggregate_idx;
+        continue;
+      }
+
+      const auto abstract_segment = chunk_in->get_segment(input_column_id);
+      const auto data_type = input_table->column_data_type(input_column_id);
+
+      /*
+      Invoke correct aggregator for each segment
+      */
+
+      resolve_data_type(data_type, [&, aggregate](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        switch (aggregate->aggregate_function) {
+          case AggregateFunction::Min:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::Max:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::Sum:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::Avg:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::Count:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::CountDistinct:
+            _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::StandardDeviationSample:
+            _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk, contexts);
+            break;
+          case AggregateFunction::Any:
+            // ANY is a pseudo-function and is handled by _write_groupby_output
+            break;
         }
+      });
 
-        const auto abstract_segment = chunk_in->get_segment(input_column_id);
-        const auto data_type = input_table->column_data_type(input_column_id);
+      ++aggregate_idx;
+    }
+  }
+}  // NOLINT(readability/fn_size)
+
+template <typename AggregateKey>
+void AggregateHash::_aggregate_parallel(const std::vector<std::pair<ChunkID, ChunkID>>& chunk_ranges,
+                                        KeysPerChunk<AggregateKey>& keys_per_chunk) {
+  /**
+   * Parallel aggregation in three steps:
+   *   (1) Each job aggregates a range of chunks into its own (thread-local) contexts, using the same code as the
+   *       single-threaded aggregation. As most inputs contain many rows per group, this shrinks the data that has to
+   *       be exchanged between the jobs.
+   *   (2) The groups found by the jobs are radix-partitioned by the hash of their AggregateKey, so that every group
+   *       ends up in exactly one partition.
+   *   (3) The partitions are merged in parallel. Each merge job builds a hash map for the groups of its partition and
+   *       combines the partial results of the jobs from step (1).
+   * If step (1) found only few groups (e.g., TPC-H Q1), partitioning would cost more than it saves. In that case,
+   * the partial results are merged by a single job directly into _contexts_per_column.
+   */
+  const auto job_count = chunk_ranges.size();
+
+  // (1) Thread-local pre-aggregation. The result ids are local to the contexts of each job.
+  auto contexts_per_job = std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>(job_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(job_count);
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, job_id]() {
+      auto& contexts = contexts_per_job[job_id];
+      contexts = _create_contexts<AggregateKey>(0);
+
+      const auto [begin_chunk_id, end_chunk_id] = chunk_ranges[job_id];
+      for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+        _aggregate_chunk<AggregateKey>(chunk_id, contexts, keys_per_chunk);
+      }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  // All contexts of a job use the same result ids. However, only the context that is aggregated first holds the map
+  // from AggregateKeys to result ids, the others use the ids cached in the keys (see get_or_add_result). For DISTINCT,
+  // that is the first context. Otherwise, it is the first context of an actual aggregate function (ANY is not
+  // aggregated, see _aggregate_chunk).
+  auto primary_context_index = size_t{0};
+  if (_has_aggregate_functions) {
+    while (_aggregates[primary_context_index]->aggregate_function == AggregateFunction::Any) {
+      ++primary_context_index;
+    }
+  }
 
-        /*
-        Invoke correct aggregator for each segment
-        */
+  // A group found by a job, given by its key and the job-local result id.
+  using Group = std::pair<const AggregateKey*, AggregateResultId>;
+  auto groups_per_job = std::vector<std::vector<Group>>(job_count);
+  auto pre_aggregated_group_count = size_t{0};
+  _resolve_context_type(primary_context_index, [&](const auto type, const auto aggregate_function) {
+    using ColumnDataType = typename decltype(type)::type;
+    using Context = AggregateContext<ColumnDataType, decltype(aggregate_function)::value, AggregateKey>;
+
+    for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+      const auto& context = static_cast<const Context&>(*contexts_per_job[job_id][primary_context_index]);
+      auto& groups = groups_per_job[job_id];
+      if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+        // Without GROUP BY columns, there is a single group that is not stored in the map.
+        static const auto empty_aggregate_key = EmptyAggregateKey{};
+        if (!context.results.empty()) groups.emplace_back(&empty_aggregate_key, AggregateResultId{0});
+      } else {
+        groups.reserve(context.result_ids->size());
+        for (const auto& [key, result_id] : *context.result_ids) {
+          groups.emplace_back(&key, result_id);
+        }
+      }
+      pre_aggregated_group_count += groups.size();
+    }
+  });
 
-        resolve_data_type(data_type, [&, aggregate](auto type) {
-          using ColumnDataType = typename decltype(type)::type;
+  // (2) Radix partitioning. Use at least as many partitions as there are jobs so that all workers can merge.
+  auto radix_bits = size_t{0};
+  if (pre_aggregated_group_count >= MIN_GROUPS_FOR_PARTITIONED_MERGE) {
+    while ((size_t{1} << radix_bits) < job_count) ++radix_bits;
+  }
+  const auto partition_count = size_t{1} << radix_bits;
+
+  auto groups_per_job_and_partition = std::vector<std::vector<std::vector<Group>>>(job_count);
+  jobs.clear();
+  for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+    auto& groups_per_partition = groups_per_job_and_partition[job_id];
+    groups_per_partition.resize(partition_count);
+    if (partition_count == 1) {
+      groups_per_partition[0] = std::move(groups_per_job[job_id]);
+      continue;
+    }
 
-          switch (aggregate->aggregate_function) {
-            case AggregateFunction::Min:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::StandardDeviationSample:
-              _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Any:
-              // ANY is a pseudo-function and is handled by _write_groupby_output
-              break;
+    jobs.emplace_back(std::make_shared<JobTask>([&, job_id]() {
+      for (const auto& group : groups_per_job[job_id]) {
+        // Fibonacci hashing spreads the hash values (which, e.g., for a single AggregateKeyEntry, are the key itself)
+        // over the partitions.
+        const auto hash = std::hash<AggregateKey>{}(*group.first) * size_t{0x9E3779B97F4A7C15};
+        groups_per_job_and_partition[job_id][hash >> (64 - radix_bits)].emplace_back(group);
+      }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  // (3) Merging. Without partitioning, the results are written directly into _contexts_per_column.
+  auto contexts_per_partition = std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>(partition_count);
+  auto group_counts = std::vector<size_t>(partition_count);
+  if (partition_count == 1) contexts_per_partition[0] = _contexts_per_column;
+
+  jobs.clear();
+  jobs.reserve(partition_count);
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_id]() {
+      auto& contexts = contexts_per_partition[partition_id];
+      if (partition_count > 1) contexts = _create_contexts<AggregateKey>(0);
+
+      // For each job, the pairs of job-local result ids and the result ids in the merged contexts.
+      auto result_id_mappings = std::vector<std::vector<std::pair<AggregateResultId, AggregateResultId>>>(job_count);
+      auto group_count = size_t{0};
+      if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+        for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+          for (const auto& group : groups_per_job_and_partition[job_id][partition_id]) {
+            result_id_mappings[job_id].emplace_back(group.second, AggregateResultId{0});
+            group_count = 1;
+          }
+        }
+      } else {
+        auto result_ids = AggregateResultIdMap<AggregateKey>{};
+        for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+          const auto& groups = groups_per_job_and_partition[job_id][partition_id];
+          auto& result_id_mapping = result_id_mappings[job_id];
+          result_id_mapping.reserve(groups.size());
+          for (const auto& group : groups) {
+            const auto merged_result_id = result_ids.emplace(*group.first, result_ids.size()).first->second;
+            result_id_mapping.emplace_back(group.second, merged_result_id);
+          }
+        }
+        group_count = result_ids.size();
+      }
+      group_counts[partition_id] = group_count;
+
+      for (auto context_index = size_t{0}; context_index < contexts.size(); ++context_index) {
+        _resolve_context_type(context_index, [&](const auto type, const auto aggregate_function) {
+          using ColumnDataType = typename decltype(type)::type;
+          using Context = AggregateResultContext<ColumnDataType, decltype(aggregate_function)::value>;
+
+          auto& results = static_cast<Context&>(*contexts[context_index]).results;
+          results.resize(group_count);
+          for (auto job_id = size_t{0}; job_id < job_count; ++job_id) {
+            const auto& job_results = static_cast<const Context&>(*contexts_per_job[job_id][context_index]).results;
+            for (const auto& [job_result_id, merged_result_id] : result_id_mappings[job_id]) {
+              merge_aggregate_results(results[merged_result_id], job_results[job_result_id]);
+            }
           }
         });
+      }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
-        ++aggregate_idx;
+  if (partition_count == 1) return;
+
+  // Concatenate the results of the partitions.
+  auto partition_offsets = std::vector<size_t>(partition_count + 1);
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    partition_offsets[partition_id + 1] = partition_offsets[partition_id] + group_counts[partition_id];
+  }
+
+  for (auto context_index = size_t{0}; context_index < _contexts_per_column.size(); ++context_index) {
+    _resolve_context_type(context_index, [&](const auto type, const auto aggregate_function) {
+      using ColumnDataType = typename decltype(type)::type;
+      using Context = AggregateResultContext<ColumnDataType, decltype(aggregate_function)::value>;
+      static_cast<Context&>(*_contexts_per_column[context_index]).results.resize(partition_offsets.back());
+    });
+  }
+
+  jobs.clear();
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_id]() {
+      for (auto context_index = size_t{0}; context_index < _contexts_per_column.size(); ++context_index) {
+        _resolve_context_type(context_index, [&](const auto type, const auto aggregate_function) {
+          using ColumnDataType = typename decltype(type)::type;
+          using Context = AggregateResultContext<ColumnDataType, decltype(aggregate_function)::value>;
+
+          auto& partition_results = static_cast<Context&>(*contexts_per_partition[partition_id][context_index]).results;
+          auto& results = static_cast<Context&>(*_contexts_per_column[context_index]).results;
+          std::move(partition_results.begin(), partition_results.end(),
+                    results.begin() + static_cast<std::ptrdiff_t>(partition_offsets[partition_id]));
+        });
       }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+}
+
+template <typename Functor>
+void AggregateHash::_resolve_context_type(const size_t context_index, const Functor& functor) const {
+  if (!_has_aggregate_functions) {
+    // DISTINCT only uses the first context, see _aggregate_chunk.
+    if (context_index == 0) {
+      functor(hana::type_c<DistinctColumnType>, std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
     }
+    return;
   }
-  step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
-}  // NOLINT(readability/fn_size)
+
+  const auto& aggregate = _aggregates[context_index];
+  const auto input_column_id = static_cast<const PQPColumnExpression&>(*aggregate->argument()).column_id;
+  if (input_column_id == INVALID_COLUMN_ID) {
+    functor(hana::type_c<CountColumnType>, std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+    return;
+  }
+
+  resolve_data_type(left_input_table()->column_data_type(input_column_id), [&](const auto type) {
+    switch (aggregate->aggregate_function) {
+      case AggregateFunction::Min:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+        break;
+      case AggregateFunction::Max:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Max>{});
+        break;
+      case AggregateFunction::Sum:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Sum>{});
+        break;
+      case AggregateFunction::Avg:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Avg>{});
+        break;
+      case AggregateFunction::Count:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::CountDistinct>{});
+        break;
+      case AggregateFunction::StandardDeviationSample:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::StandardDeviationSample>{});
+        break;
+      case AggregateFunction::Any:
+        // ANY is not aggregated, its values are written by _write_groupby_output.
+        break;
+    }
+  });
+}
 
 std::shared_ptr<const Table> AggregateHash::_on_execute() {
   // We do not want the overhead of a vector with heap storage when we have a limited number of aggregate columns.
@@ -1162,10 +1561,10 @@ void AggregateHash::write_aggregate_output(ColumnID aggregate_index) {
 
 template <typename AggregateKey>
 std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
-    const DataType data_type, const AggregateFunction aggregate_function) const {
+    const DataType data_type, const AggregateFunction aggregate_function, const size_t preallocated_size) const {
   std::shared_ptr<SegmentVisitorContext> context;
   resolve_data_type(data_type, [&](auto type) {
-    const auto size = _expected_result_size.load();
+    const auto size = preallocated_size;
     using ColumnDataType = typename decltype(type)::type;
     switch (aggregate_function) {
       case AggregateFunction::Min:
@@ -165,6 +165,25 @@ class AggregateHash : public AbstractAggregateOperator {
   template <typename AggregateKey>
   void _aggregate();
 
+  // Creates one context per aggregate (plus a dummy context for DISTINCT, see _aggregate).
+  template <typename AggregateKey>
+  std::vector<std::shared_ptr<SegmentVisitorContext>> _create_contexts(const size_t preallocated_size) const;
+
+  template <typename AggregateKey>
+  void _aggregate_chunk(const ChunkID chunk_id, const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts,
+                        KeysPerChunk<AggregateKey>& keys_per_chunk);
+
+  // Aggregates the chunk ranges in parallel with thread-local contexts and merges the results into
+  // _contexts_per_column.
+  template <typename AggregateKey>
+  void _aggregate_parallel(const std::vector<std::pair<ChunkID, ChunkID>>& chunk_ranges,
+                           KeysPerChunk<AggregateKey>& keys_per_chunk);
+
+  // Calls functor with the ColumnDataType (as hana::type) and the AggregateFunction (as std::integral_constant) of the
+  // context at context_index. Does nothing for contexts that do not hold results (i.e., for ANY).
+  template <typename Functor>
+  void _resolve_context_type(const size_t context_index, const Functor& functor) const;
+
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_left_input,
       const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -182,11 +201,13 @@ class AggregateHash : public AbstractAggregateOperator {
 
   template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
   void _aggregate_segment(ChunkID chunk_id, ColumnID column_index, const AbstractSegment& abstract_segment,
-                          KeysPerChunk<AggregateKey>& keys_per_chunk);
+                          KeysPerChunk<AggregateKey>& keys_per_chunk,
+                          const std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts);
 
   template <typename AggregateKey>
   std::shared_ptr<SegmentVisitorContext> _create_aggregate_context(const DataType data_type,
-                                                                   const AggregateFunction aggregate_function) const;
+                                                                   const AggregateFunction aggregate_function,
+                                                                   const size_t preallocated_size) const;
 
   std::vector<std::shared_ptr<BaseValueSegment>> _groupby_segments;
   std::vector<std::shared_ptr<SegmentVisitorContext>> _contexts_per_column;
@@ -1,23 +1,28 @@
 #include "import.hpp"
 
+#include <filesystem>
+
 #include <boost/algorithm/string.hpp>
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
 #include "import_export/csv/csv_parser.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
 
 namespace opossum {
 
 Import::Import(const std::string& init_filename, const std::string& tablename, const ChunkOffset chunk_size,
-               const FileType file_type, const std::optional<CsvMeta>& csv_meta)
+               const FileType file_type, const std::optional<CsvMeta>& csv_meta,
+               const std::optional<SegmentEncodingSpec>& target_encoding)
     : AbstractReadOnlyOperator(OperatorType::Import),
       filename(init_filename),
       _tablename(tablename),
       _chunk_size(chunk_size),
       _file_type(file_type),
-      _csv_meta(csv_meta) {
+      _csv_meta(csv_meta),
+      _target_encoding(target_encoding) {
   if (_file_type == FileType::Auto) {
     _file_type = file_type_from_filename(filename);
   }
@@ -37,11 +42,25 @@ std::shared_ptr<const Table> Import::_on_execute() {
   std::shared_ptr<Table> table;
 
   switch (_file_type) {
-    case FileType::Csv:
-      table = CsvParser::parse(filename, _chunk_size, _csv_meta);
-      break;
+    case FileType::Csv: {
+      // Files without a meta file get an inferred one
+      auto csv_meta = _csv_meta;
+      if (!csv_meta) {
+        const auto meta_filename = filename + CsvMeta::META_FILE_EXTENSION;
+        csv_meta = std::filesystem::exists(meta_filename) ? process_csv_meta_file(meta_filename)
+                                                          : CsvParser::infer_meta(filename);
+      }
+
+      // The chunks are encoded by the jobs that parse them
+      auto chunk_encoding_spec = std::optional<ChunkEncodingSpec>{};
+      if (_target_encoding) {
+        chunk_encoding_spec = _chunk_encoding_spec(*CsvParser::create_table_from_meta(*csv_meta, _chunk_size));
+      }
+      table = CsvParser::parse(filename, _chunk_size, csv_meta, chunk_encoding_spec);
+    } break;
     case FileType::Tbl:
       table = load_table(filename, _chunk_size);
+      if (_target_encoding) ChunkEncoder::encode_all_chunks(table, _chunk_encoding_spec(*table));
       break;
     case FileType::Binary:
       table = BinaryParser::parse(filename);
@@ -64,7 +83,19 @@ std::shared_ptr<AbstractOperator> Import::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<Import>(filename, _tablename, _chunk_size, _file_type, _csv_meta);
+  return std::make_shared<Import>(filename, _tablename, _chunk_size, _file_type, _csv_meta, _target_encoding);
+}
+
+ChunkEncodingSpec Import::_chunk_encoding_spec(const Table& table) const {
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  for (const auto data_type : table.column_data_types()) {
+    if (encoding_supports_data_type(_target_encoding->encoding_type, data_type)) {
+      chunk_encoding_spec.emplace_back(*_target_encoding);
+    } else {
+      chunk_encoding_spec.emplace_back(EncodingType::Unencoded);
+    }
+  }
+  return chunk_encoding_spec;
 }
 
 void Import::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
@@ -6,6 +6,7 @@
 #include "abstract_read_only_operator.hpp"
 #include "import_export/csv/csv_meta.hpp"
 #include "import_export/file_type.hpp"
+#include "storage/encoding_type.hpp"
 #include "types.hpp"
 
 #include "SQLParser.h"
@@ -25,11 +26,15 @@ class Import : public AbstractReadOnlyOperator {
    * @param tablename      Name of the table to store in the StorageManager.
    * @param chunk_size     Optional. Chunk size. Does not effect binary import.
    * @param file_type      Optional. Type indicating the file format. If not present, it is guessed by the filename.
-   * @param csv_meta       Optional. A specific meta config, used instead of filename + '.json'
+   * @param csv_meta       Optional. A specific meta config, used instead of filename + '.json'. If neither is
+   *                       present, the meta config is inferred from the file (see CsvParser::infer_meta).
+   * @param target_encoding Optional. Encoding for the imported chunks. Columns whose data type is not supported by
+   *                       the encoding are left unencoded. Does not effect binary import.
    */
   explicit Import(const std::string& init_filename, const std::string& tablename,
                   const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE, const FileType file_type = FileType::Auto,
-                  const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                  const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                  const std::optional<SegmentEncodingSpec>& target_encoding = std::nullopt);
 
   const std::string& name() const final;
   const std::string filename;
@@ -44,11 +49,15 @@ class Import : public AbstractReadOnlyOperator {
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
  private:
+  // Applies _target_encoding to all columns of the table that support it
+  ChunkEncodingSpec _chunk_encoding_spec(const Table& table) const;
+
   // Name for adding the table to the StorageManager
   const std::string _tablename;
   const ChunkOffset _chunk_size;
   FileType _file_type;
   const std::optional<CsvMeta> _csv_meta;
+  const std::optional<SegmentEncodingSpec> _target_encoding;
 };
 
 }  // namespace opossum
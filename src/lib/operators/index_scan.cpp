@@ -5,6 +5,7 @@
 #include "expression/between_expression.hpp"
 
 #include "hyrise.hpp"
+#include "operators/get_table.hpp"
 
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -26,6 +27,15 @@ IndexScan::IndexScan(const std::shared_ptr<const AbstractOperator>& in, const Se
       _right_values{right_values},
       _right_values2{right_values2} {}
 
+IndexScan::IndexScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID left_column_id,
+                     const AllTypeVariant& right_value)
+    : AbstractReadOnlyOperator{OperatorType::IndexScan, in},
+      _index_type{SegmentIndexType::Invalid},
+      _left_column_ids{left_column_id},
+      _predicate_condition{PredicateCondition::Equals},
+      _right_values{right_value},
+      _uses_table_index{true} {}
+
 const std::string& IndexScan::name() const {
   static const auto name = std::string{"IndexScan"};
   return name;
@@ -38,6 +48,11 @@ std::shared_ptr<const Table> IndexScan::_on_execute() {
 
   _out_table = std::make_shared<Table>(_in_table->column_definitions(), TableType::References);
 
+  if (_uses_table_index) {
+    _scan_table_index();
+    return _out_table;
+  }
+
   std::mutex output_mutex;
 
   auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
@@ -68,6 +83,9 @@ std::shared_ptr<AbstractOperator> IndexScan::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  if (_uses_table_index) {
+    return std::make_shared<IndexScan>(copied_left_input, _left_column_ids[0], _right_values[0]);
+  }
   return std::make_shared<IndexScan>(copied_left_input, _index_type, _left_column_ids, _predicate_condition,
                                      _right_values, _right_values2);
 }
@@ -109,6 +127,63 @@ void IndexScan::_validate_input() {
   }
 
   Assert(_in_table->type() == TableType::Data, "IndexScan only supports persistent tables right now.");
+
+  if (_uses_table_index) {
+    Assert(_predicate_condition == PredicateCondition::Equals, "Table indexes only support equality predicates.");
+    Assert(_left_column_ids.size() == 1, "Table indexes only index a single column.");
+    Assert(std::dynamic_pointer_cast<const GetTable>(left_input()), "Table indexes require a GetTable as input.");
+  }
+}
+
+void IndexScan::_scan_table_index() {
+  const auto get_table = std::static_pointer_cast<const GetTable>(left_input());
+  const auto stored_table = Hyrise::get().storage_manager.get_table(get_table->table_name());
+
+  // GetTable might have pruned columns and chunks. The ColumnIDs of its output are mapped to those of the stored table,
+  // which is referenced by the output.
+  const auto& pruned_column_ids = get_table->pruned_column_ids();
+  auto stored_column_ids = std::vector<ColumnID>{};
+  stored_column_ids.reserve(_in_table->column_count());
+  auto pruned_column_ids_iter = pruned_column_ids.begin();
+  for (auto stored_column_id = ColumnID{0}; stored_column_id < stored_table->column_count(); ++stored_column_id) {
+    if (pruned_column_ids_iter != pruned_column_ids.end() && *pruned_column_ids_iter == stored_column_id) {
+      ++pruned_column_ids_iter;
+      continue;
+    }
+    stored_column_ids.emplace_back(stored_column_id);
+  }
+
+  const auto table_index = stored_table->table_index(stored_column_ids[_left_column_ids[0]]);
+  Assert(table_index, "Table index not found for column.");
+
+  auto matches = RowIDPosList{};
+  table_index->equals(_right_values[0], matches);
+
+  // Create one output chunk per referenced chunk, so that the PosLists reference a single chunk
+  std::sort(matches.begin(), matches.end());
+
+  const auto& pruned_chunk_ids = get_table->pruned_chunk_ids();
+  auto range_begin = matches.begin();
+  while (range_begin != matches.end()) {
+    const auto chunk_id = range_begin->chunk_id;
+    const auto range_end = std::find_if(range_begin, matches.end(),
+                                        [&](const auto& row_id) { return row_id.chunk_id != chunk_id; });
+
+    const auto chunk = stored_table->get_chunk(chunk_id);
+    if (chunk && !std::binary_search(pruned_chunk_ids.begin(), pruned_chunk_ids.end(), chunk_id)) {
+      const auto pos_list = std::make_shared<RowIDPosList>(range_begin, range_end);
+      pos_list->guarantee_single_chunk();
+
+      auto segments = Segments{};
+      segments.reserve(stored_column_ids.size());
+      for (const auto stored_column_id : stored_column_ids) {
+        segments.emplace_back(std::make_shared<ReferenceSegment>(stored_table, stored_column_id, pos_list));
+      }
+      _out_table->append_chunk(segments, nullptr, chunk->get_allocator());
+    }
+
+    range_begin = range_end;
+  }
 }
 
 RowIDPosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
@@ -25,6 +25,15 @@ class IndexScan : public AbstractReadOnlyOperator {
             const std::vector<ColumnID>& left_column_ids, const PredicateCondition predicate_condition,
             const std::vector<AllTypeVariant>& right_values, const std::vector<AllTypeVariant>& right_values2 = {});
 
+  /**
+   * Looks up `right_value` in the table index (see TableHashIndex) on `left_column_id` instead of using chunk indexes.
+   * The input has to be a GetTable operator, as the index belongs to the stored table. Only supports
+   * PredicateCondition::Equals. The output references the stored table and, just like the output of a TableScan, has to
+   * be validated.
+   */
+  IndexScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID left_column_id,
+            const AllTypeVariant& right_value);
+
   const std::string& name() const final;
 
   // If set, only the specified chunks will be scanned. See TableScan::excluded_chunk_ids for usage.
@@ -42,6 +51,7 @@ class IndexScan : public AbstractReadOnlyOperator {
   void _validate_input();
   std::shared_ptr<AbstractTask> _create_job(const ChunkID chunk_id, std::mutex& output_mutex);
   RowIDPosList _scan_chunk(const ChunkID chunk_id);
+  void _scan_table_index();
 
  private:
   const SegmentIndexType _index_type;
@@ -49,6 +59,7 @@ class IndexScan : public AbstractReadOnlyOperator {
   const PredicateCondition _predicate_condition;
   const std::vector<AllTypeVariant> _right_values;
   const std::vector<AllTypeVariant> _right_values2;
+  const bool _uses_table_index{false};
 
   std::shared_ptr<const Table> _in_table;
   std::shared_ptr<Table> _out_table;
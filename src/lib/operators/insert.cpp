@@ -213,6 +213,18 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
+  /**
+   * 3. Add the rows to the table indexes. As the rows are not committed yet, lookups of other transactions find them
+   *    but discard them when validating.
+   */
+  for (const auto& table_index : _target_table->table_indexes()) {
+    for (const auto& target_chunk_range : _target_chunk_ranges) {
+      const auto target_chunk = _target_table->get_chunk(target_chunk_range.chunk_id);
+      table_index->insert(target_chunk_range.chunk_id, *target_chunk, target_chunk_range.begin_chunk_offset,
+                          target_chunk_range.end_chunk_offset);
+    }
+  }
+
   return nullptr;
 }
 
@@ -270,6 +282,13 @@ void Insert::_on_rollback_records() {
 
     // This fence ensures that the changes to TID (which are not sequentially consistent) are visible to other threads.
     std::atomic_thread_fence(std::memory_order_release);
+
+    // The rolled back rows stay in the chunk (and their values with them), but they will never become visible. Thus,
+    // we drop them from the table indexes instead of letting every lookup discard them.
+    for (const auto& table_index : _target_table->table_indexes()) {
+      table_index->remove(target_chunk_range.chunk_id, *target_chunk, target_chunk_range.begin_chunk_offset,
+                          target_chunk_range.end_chunk_offset);
+    }
   }
 }
 
@@ -311,7 +311,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     };
 
     Timer timer_materialization;
-    if (_build_input_table->row_count() < _probe_input_table->row_count()) {
+    const auto build_side_is_materialized_first = _build_input_table->row_count() < _probe_input_table->row_count();
+    if (build_side_is_materialized_first) {
       // When materializing the first side (here: the build side), we do not yet have a Bloom filter. To keep the number
       // of code paths low, materialize_*_side always expects a Bloom filter. For the first step, we thus pass in a
       // Bloom filter that returns true for every probe.
@@ -321,8 +322,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
     } else {
       // Here, we first materialize the probe side and use the resulting Bloom filter in the materialization of the
-      // build side. Consequently, the Bloom filter later passed into build() will have no effect as it has already
-      // been used here to filter non-matching values.
+      // build side. Consequently, the Bloom filter does not need to be passed into build() as it has already been used
+      // here to filter non-matching values.
       materialize_probe_side(ALL_TRUE_BLOOM_FILTER);
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
       materialize_build_side(probe_side_bloom_filter);
@@ -397,16 +398,24 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
      *    probe step.
      */
     Timer timer_hash_map_building;
+    const auto& build_bloom_filter = build_side_is_materialized_first ? probe_side_bloom_filter : ALL_TRUE_BLOOM_FILTER;
     if (_secondary_predicates.empty() &&
         (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse)) {
       hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::ExistenceOnly,
-                                                       _radix_bits, probe_side_bloom_filter);
+                                                       _radix_bits, build_bloom_filter);
     } else {
       hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::AllPositions, _radix_bits,
-                                                       probe_side_bloom_filter);
+                                                       build_bloom_filter);
     }
     _performance_data.set_step_runtime(OperatorSteps::Building, timer_hash_map_building.lap());
 
+    // Each Bloom filter has been applied to the values of the other side exactly once, either during the
+    // materialization or (for the probe side's filter) during the build step.
+    if (build_side_is_materialized_first) {
+      _performance_data.build_side_bloom_filter_selectivity = build_side_bloom_filter.probe_statistics().selectivity();
+    }
+    _performance_data.probe_side_bloom_filter_selectivity = probe_side_bloom_filter.probe_statistics().selectivity();
+
     // Store the element counts of the built hash tables. Depending on the Bloom filter, we might have significantly
     // less values stored than in the initial input table.
     for (const auto& hash_table : hash_tables) {
@@ -537,6 +546,12 @@ void JoinHash::PerformanceData::output_to_stream(std::ostream& stream, Descripti
   const auto* const separator = description_mode == DescriptionMode::SingleLine ? " " : "\n";
   stream << separator << "Radix bits: " << radix_bits << ".";
   stream << separator << "Build side is " << (left_input_is_build_side ? "left." : "right.");
+  if (build_side_bloom_filter_selectivity) {
+    stream << separator << "Build side Bloom filter selectivity: " << *build_side_bloom_filter_selectivity << ".";
+  }
+  if (probe_side_bloom_filter_selectivity) {
+    stream << separator << "Probe side Bloom filter selectivity: " << *probe_side_bloom_filter_selectivity << ".";
+  }
 }
 
 }  // namespace opossum
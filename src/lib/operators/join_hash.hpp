@@ -65,6 +65,12 @@ class JoinHash : public AbstractJoinOperator {
     // build_side_position_count (see order of materialization in hash_join.cpp).
     size_t hash_tables_distinct_value_count{0};
     std::optional<size_t> hash_tables_position_count;
+
+    // Measured fraction of values that passed a side's Bloom filter. The build side's filter is applied to the probe
+    // side values only if the build side is materialized first. The probe side's filter is applied to the build side
+    // values either during their materialization or in build(). Unset if no values were probed.
+    std::optional<double> build_side_bloom_filter_selectivity;
+    std::optional<double> probe_side_bloom_filter_selectivity;
   };
 
  protected:
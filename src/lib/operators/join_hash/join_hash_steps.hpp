@@ -3,7 +3,6 @@
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/unsynchronized_pool_resource.hpp>
 #include <boost/container/small_vector.hpp>
-#include <boost/dynamic_bitset.hpp>
 #include <boost/lexical_cast.hpp>
 #include <uninitialized_vector.hpp>
 
@@ -17,6 +16,7 @@
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/segment_iterate.hpp"
 #include "type_comparison.hpp"
+#include "utils/blocked_bloom_filter.hpp"
 
 /*
   This file includes the functions that cover the main steps of our hash join implementation
@@ -222,42 +222,28 @@ class PosHashTable {
   std::optional<UnifiedPosList> _unified_pos_list{};
 };
 
-// The Bloom filter (with k=1) is used during the materialization and build phases. It contains `true` for each
-// `hash_function(value) % BLOOM_FILTER_SIZE`. Much of how the Bloom filter is used in the hash join could be improved:
-// (1) Dynamically check whether Bloom filters are worth the memory and computational costs. This could be based on the
-//     input table sizes, the expected cardinalities, the hardware characteristics, or other factors.
-// (2) Choosing an appropriate filter size. 2^20 was experimentally found to be good for TPC-H SF 10, but is certainly
-//     not optimal in every situation.
-// (3) Evaluate whether using multiple hash functions (k>1) brings any improvement. In a first experiment, however, we
-//     saw no benefits for single-threaded TPC-H SF 10.
-// (4) Use the probe side Bloom filter when partitioning the build side. By doing that, we reduce the size of the
-//     intermediary results. When a Bloom filter-supported partitioning has been done (i.e., partitioning has not
-//     been skipped), we do not need to use a Bloom filter in the build phase anymore.
-// Some of these points could be addressed with relatively low effort and should bring additional, significant benefits.
-// We did not yet work on this because the Bloom filter was a byproduct of a research project and we have not had the
-// resources to optimize it at the time.
-static constexpr auto BLOOM_FILTER_SIZE = 1 << 20;
-static constexpr auto BLOOM_FILTER_MASK = BLOOM_FILTER_SIZE - 1;
-
-// Using dynamic_bitset because, different from vector<bool>, it has an efficient operator| implementation, which is
-// needed for merging partial Bloom filters created by different threads. Note that the dynamic_bitset(n, value)
-// constructor does not do what you would expect it to, so try to avoid it.
-using BloomFilter = boost::dynamic_bitset<>;
-
-// ALL_TRUE_BLOOM_FILTER is initialized by creating a BloomFilter with every value being false and using bitwise
-// negation (~x). As the negation is surprisingly expensive, we create a static empty Bloom filter and reference
-// it where needed. Having a Bloom filter that always returns true avoids a branch in the hot loop.
-static const auto ALL_TRUE_BLOOM_FILTER = ~BloomFilter(BLOOM_FILTER_SIZE);
+// The Bloom filters are used during the materialization and build phases. The filter of the side that is materialized
+// first is used to skip values of the other side that will not find a join partner. The filter of the probe side is
+// used to exclude values from the hash tables that will not be accessed in the probe step. Both filters are sized for
+// the row count of the side they are built from (see BlockedBloomFilter).
+// Future work could use the probe side Bloom filter when partitioning the build side. By doing that, we reduce the size
+// of the intermediary results. When a Bloom filter-supported partitioning has been done (i.e., partitioning has not
+// been skipped), we do not need to use a Bloom filter in the build phase anymore.
+using BloomFilter = BlockedBloomFilter;
+
+// Having a Bloom filter that always returns true avoids a branch in the hot loop.
+static const auto& ALL_TRUE_BLOOM_FILTER = BloomFilter::all_true();
 
 // @param in_table             Table to materialize
 // @param column_id            Column within that table to materialize
 // @param histograms           Out: If radix_bits > 0, contains one histogram per chunk where each histogram contains
 //                             1 << radix_bits slots
 // @param radix_bits           Number of radix_bits, needed only for histogram calculation
-// @param output_bloom_filter  Out: A filled BloomFilter where `value & BLOOM_FILTER_MASK == true` for each value
-//                             encountered in the input column
-// @param input_bloom_filter   Optional: Materialization is skipped for each value where the corresponding slot in the
-//                             Bloom filter is false
+// @param output_bloom_filter  Out: A BloomFilter sized for the row count of in_table that contains the hash of each
+//                             materialized value
+// @param input_bloom_filter   Optional: Materialization is skipped for each value that is not contained in the Bloom
+//                             filter. The number of probed and passed values is recorded in the filter (unless it is
+//                             the ALL_TRUE_BLOOM_FILTER).
 template <typename T, typename HashedType, bool keep_null_values>
 RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
                                     std::vector<std::vector<size_t>>& histograms, const size_t radix_bits,
@@ -278,11 +264,8 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
   const auto pass = size_t{0};
   const auto radix_mask = static_cast<size_t>(pow(2, radix_bits * (pass + 1)) - 1);
 
-  Assert(output_bloom_filter.empty(), "output_bloom_filter should be empty");
-  output_bloom_filter.resize(BLOOM_FILTER_SIZE);
-  std::mutex output_bloom_filter_mutex;
-
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "Invalid input_bloom_filter");
+  // The filter is filled concurrently by all jobs.
+  output_bloom_filter = BloomFilter{in_table->row_count()};
 
   // Create histograms per chunk
   histograms.resize(chunk_count);
@@ -296,14 +279,6 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
     const auto num_rows = chunk_in->size();
 
     const auto materialize = [&, chunk_in, chunk_id, num_rows]() {
-      auto local_output_bloom_filter = BloomFilter{};
-      std::reference_wrapper<BloomFilter> used_output_bloom_filter = output_bloom_filter;
-      if (Hyrise::get().is_multi_threaded()) {
-        // We cannot write to BloomFilter concurrently, so we build a local one first.
-        local_output_bloom_filter = BloomFilter(BLOOM_FILTER_SIZE, false);
-        used_output_bloom_filter = local_output_bloom_filter;
-      }
-
       // Skip chunks that were physically deleted
       if (!chunk_in) return;
 
@@ -323,6 +298,10 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
 
       auto reference_chunk_offset = ChunkOffset{0};
 
+      // Number of values that were checked against / passed the input_bloom_filter.
+      auto bloom_filter_probed_count = size_t{0};
+      auto bloom_filter_passed_count = size_t{0};
+
       const auto segment = chunk_in->get_segment(column_id);
       segment_with_iterators<T>(*segment, [&](auto it, auto end) {
         using IterableType = typename decltype(it)::IterableType;
@@ -347,14 +326,18 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
             const Hash hashed_value = hash_function(static_cast<HashedType>(value.value()));
 
             auto skip = false;
-            if (!value.is_null() && !input_bloom_filter[hashed_value & BLOOM_FILTER_MASK] && !keep_null_values) {
-              // Value in not present in input bloom filter and can be skipped
-              skip = true;
+            if (!value.is_null() && !keep_null_values) {
+              ++bloom_filter_probed_count;
+              if (!input_bloom_filter.contains(hashed_value)) {
+                // Value in not present in input bloom filter and can be skipped
+                skip = true;
+              } else {
+                ++bloom_filter_passed_count;
+              }
             }
 
             if (!skip) {
-              // Fill the corresponding slot in the bloom filter
-              used_output_bloom_filter.get()[hashed_value & BLOOM_FILTER_MASK] = true;
+              output_bloom_filter.insert(hashed_value);
 
               /*
               For ReferenceSegments we do not use the RowIDs from the referenced tables.
@@ -399,10 +382,10 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
 
       histograms[chunk_id] = std::move(histogram);
 
-      if (Hyrise::get().is_multi_threaded()) {
-        // Merge the local_output_bloom_filter into output_bloom_filter
-        std::lock_guard<std::mutex> lock{output_bloom_filter_mutex};
-        output_bloom_filter |= local_output_bloom_filter;
+      // The shared ALL_TRUE_BLOOM_FILTER does not filter anything, recording statistics on it would only cause
+      // contention between all concurrently running joins.
+      if (&input_bloom_filter != &ALL_TRUE_BLOOM_FILTER) {
+        input_bloom_filter.record_probes(bloom_filter_probed_count, bloom_filter_passed_count);
       }
     };
     if (JoinHash::JOB_SPAWN_THRESHOLD > num_rows) {
@@ -424,8 +407,6 @@ template <typename BuildColumnType, typename HashedType>
 std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<BuildColumnType>& radix_container,
                                                            const JoinHashBuildMode mode, const size_t radix_bits,
                                                            const BloomFilter& input_bloom_filter) {
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "invalid input_bloom_filter");
-
   if (radix_container.empty()) return {};
 
   /*
@@ -465,16 +446,21 @@ std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<
       if (radix_bits > 0) {
         hash_table = PosHashTable<HashedType>(mode, elements_count);
       }
+      auto bloom_filter_passed_count = size_t{0};
       for (const auto& element : elements) {
         DebugAssert(!(element.row_id == NULL_ROW_ID), "No NULL_ROW_IDs should make it to this point");
 
         const Hash hashed_value = hash_function(static_cast<HashedType>(element.value));
-        if (!input_bloom_filter[hashed_value & BLOOM_FILTER_MASK]) {
+        if (!input_bloom_filter.contains(hashed_value)) {
           continue;
         }
 
+        ++bloom_filter_passed_count;
         hash_table->emplace(element.value, element.row_id);
       }
+      if (&input_bloom_filter != &ALL_TRUE_BLOOM_FILTER) {
+        input_bloom_filter.record_probes(elements_count, bloom_filter_passed_count);
+      }
 
       if (radix_bits > 0) {
         // In case only a single hash table is built, shrink to fit is called outside of the loop.
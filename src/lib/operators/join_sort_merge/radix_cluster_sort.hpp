@@ -3,7 +3,9 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <numeric>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -39,6 +41,10 @@ struct RadixClusterOutput {
 * -> Then, either radix clustering or range clustering is performed.
 * -> At last, the resulting clusters are sorted.
 *
+* If both join columns are already sorted within each chunk (e.g., the output of a Sort or of another sort merge join),
+* the chunks are materialized as sorted runs and neither clustered nor sorted. Instead, each run is split into value
+* ranges, and each range cluster is created by a k-way merge of the corresponding subranges of all runs.
+*
 * Radix clustering example:
 * cluster_count = 4
 * bits for 4 clusters: 2
@@ -314,6 +320,150 @@ class RadixClusterSort {
     return {std::move(output_left), std::move(output_right)};
   }
 
+  /**
+  * Checks whether the column is sorted within each chunk of the table. If so, the sort mode of each chunk is returned.
+  **/
+  static std::optional<std::vector<SortMode>> _chunk_sort_modes(const Table& table, const ColumnID column_id) {
+    const auto chunk_count = table.chunk_count();
+    auto sort_modes = std::vector<SortMode>{};
+    sort_modes.reserve(chunk_count);
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table.get_chunk(chunk_id);
+      Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+      const auto& sorted_by = chunk->individually_sorted_by();
+      const auto sort_definition_iter =
+          std::find_if(sorted_by.cbegin(), sorted_by.cend(),
+                       [&](const auto& sort_definition) { return sort_definition.column == column_id; });
+      if (sort_definition_iter == sorted_by.cend()) return std::nullopt;
+      sort_modes.emplace_back(sort_definition_iter->sort_mode);
+    }
+
+    return sort_modes;
+  }
+
+  using RunIterator = typename MaterializedSegment<T>::const_iterator;
+
+  /**
+  * Returns the first entry of the sorted range [begin, end) for which is_past is true. The entry at begin must not be
+  * past. As the searched entry is usually close to begin when the runs overlap, the search range is doubled until it
+  * contains the searched entry (exponential search).
+  **/
+  template <typename Predicate>
+  static RunIterator _gallop(RunIterator begin, const RunIterator end, const Predicate& is_past) {
+    auto step = std::ptrdiff_t{1};
+    while (step < std::distance(begin, end) && !is_past(*(begin + step))) {
+      begin += step;
+      step *= 2;
+    }
+    const auto search_end = step < std::distance(begin, end) ? begin + step + 1 : end;
+    return std::partition_point(begin, search_end, [&](const auto& entry) { return !is_past(entry); });
+  }
+
+  /**
+  * Merges sorted subranges into the output. Each step takes the subrange with the smallest current value from a heap
+  * and copies all of its entries that precede the current values of the other subranges at once. Thus, subranges
+  * that do not overlap (e.g., if the table is clustered by the join column) are copied as a whole. For equal values,
+  * entries of earlier subranges come first.
+  **/
+  static void _k_way_merge(std::vector<std::pair<RunIterator, RunIterator>>& subranges,
+                           MaterializedSegment<T>& output) {
+    const auto greater = [&](const size_t lhs, const size_t rhs) {
+      const auto& lhs_value = subranges[lhs].first->value;
+      const auto& rhs_value = subranges[rhs].first->value;
+      return rhs_value < lhs_value || (!(lhs_value < rhs_value) && lhs > rhs);
+    };
+
+    auto heap = std::vector<size_t>(subranges.size());
+    std::iota(heap.begin(), heap.end(), size_t{0});
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    while (heap.size() > 1) {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      const auto subrange_id = heap.back();
+      const auto next_subrange_id = heap.front();
+      auto& subrange = subranges[subrange_id];
+      const auto& next_value = subranges[next_subrange_id].first->value;
+
+      const auto copy_end = subrange_id < next_subrange_id
+                                ? _gallop(subrange.first, subrange.second,
+                                          [&](const auto& entry) { return next_value < entry.value; })
+                                : _gallop(subrange.first, subrange.second,
+                                          [&](const auto& entry) { return !(entry.value < next_value); });
+      output.insert(output.end(), subrange.first, copy_end);
+      subrange.first = copy_end;
+
+      if (subrange.first == subrange.second) {
+        heap.pop_back();
+      } else {
+        std::push_heap(heap.begin(), heap.end(), greater);
+      }
+    }
+
+    if (!heap.empty()) {
+      const auto& subrange = subranges[heap.front()];
+      output.insert(output.end(), subrange.first, subrange.second);
+    }
+  }
+
+  /**
+  * Creates range clusters from sorted runs without sorting. Each run is split by the split values (see
+  * _range_cluster) using binary search. Each cluster is then created by merging its subranges of all runs.
+  **/
+  std::unique_ptr<MaterializedSegmentList<T>> _merge_sorted_runs(
+      const std::unique_ptr<MaterializedSegmentList<T>>& runs, const std::vector<T>& split_values) {
+    const auto run_count = runs->size();
+
+    // For each run, the end of each cluster's subrange. A subrange begins at the end of the previous cluster's one.
+    auto cluster_ends = std::vector<std::vector<RunIterator>>(run_count);
+    for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+      const auto& run = *(*runs)[run_id];
+      auto& run_cluster_ends = cluster_ends[run_id];
+      run_cluster_ends.reserve(_cluster_count);
+
+      auto cluster_end = run.cbegin();
+      for (auto cluster_id = size_t{0}; cluster_id < _cluster_count; ++cluster_id) {
+        if (cluster_id < split_values.size()) {
+          // Each split value is the inclusive upper bound of its cluster.
+          cluster_end = std::upper_bound(cluster_end, run.cend(), split_values[cluster_id],
+                                         [](const T& value, const auto& entry) { return value < entry.value; });
+        } else {
+          cluster_end = run.cend();
+        }
+        run_cluster_ends.emplace_back(cluster_end);
+      }
+    }
+
+    auto output = std::make_unique<MaterializedSegmentList<T>>(_cluster_count);
+
+    auto merge_jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    merge_jobs.reserve(_cluster_count);
+    for (auto cluster_id = size_t{0}; cluster_id < _cluster_count; ++cluster_id) {
+      merge_jobs.emplace_back(std::make_shared<JobTask>([&, cluster_id]() {
+        auto subranges = std::vector<std::pair<RunIterator, RunIterator>>{};
+        auto cluster_size = size_t{0};
+        for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+          const auto begin = cluster_id == 0 ? (*runs)[run_id]->cbegin() : cluster_ends[run_id][cluster_id - 1];
+          const auto end = cluster_ends[run_id][cluster_id];
+          if (begin == end) continue;
+
+          subranges.emplace_back(begin, end);
+          cluster_size += std::distance(begin, end);
+        }
+
+        auto cluster = std::make_shared<MaterializedSegment<T>>();
+        cluster->reserve(cluster_size);
+        _k_way_merge(subranges, *cluster);
+        (*output)[cluster_id] = std::move(cluster);
+      }));
+    }
+
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(merge_jobs);
+
+    return output;
+  }
+
   /**
   * Sorts all clusters of a materialized table.
   **/
@@ -330,15 +480,21 @@ class RadixClusterSort {
   RadixClusterOutput<T> execute() {
     RadixClusterOutput<T> output;
 
+    const auto left_sort_modes = _chunk_sort_modes(*_left_input_table, _left_column_id);
+    const auto right_sort_modes = _chunk_sort_modes(*_right_input_table, _right_column_id);
+    const auto inputs_are_sorted = left_sort_modes && right_sort_modes;
+
     Timer timer;
-    // Sort the chunks of the input tables in the non-equi cases
-    ColumnMaterializer<T> left_column_materializer(!_equi_case, _materialize_null_left);
+    // Sort the chunks of the input tables in the non-equi cases. Chunks that are sorted already keep their order when
+    // being materialized.
+    const auto sort_chunks = !_equi_case && !inputs_are_sorted;
+    ColumnMaterializer<T> left_column_materializer(sort_chunks, _materialize_null_left);
     auto [materialized_left_segments, null_rows_left, samples_left] =
         left_column_materializer.materialize(_left_input_table, _left_column_id);
     output.null_rows_left = std::move(null_rows_left);
     _performance.set_step_runtime(JoinSortMerge::OperatorSteps::LeftSideMaterializing, timer.lap());
 
-    ColumnMaterializer<T> right_column_materializer(!_equi_case, _materialize_null_right);
+    ColumnMaterializer<T> right_column_materializer(sort_chunks, _materialize_null_right);
     auto [materialized_right_segments, null_rows_right, samples_right] =
         right_column_materializer.materialize(_right_input_table, _right_column_id);
     output.null_rows_right = std::move(null_rows_right);
@@ -348,6 +504,30 @@ class RadixClusterSort {
     // determine the new capacity from the iterator: https://stackoverflow.com/a/35359472/1147726)
     samples_left.insert(samples_left.end(), samples_right.begin(), samples_right.end());
 
+    if (inputs_are_sorted) {
+      // Runs of chunks sorted in descending order are reversed, so that all runs are in ascending order.
+      for (auto chunk_id = size_t{0}; chunk_id < materialized_left_segments->size(); ++chunk_id) {
+        if ((*left_sort_modes)[chunk_id] == SortMode::Descending) {
+          auto& run = *(*materialized_left_segments)[chunk_id];
+          std::reverse(run.begin(), run.end());
+        }
+      }
+      for (auto chunk_id = size_t{0}; chunk_id < materialized_right_segments->size(); ++chunk_id) {
+        if ((*right_sort_modes)[chunk_id] == SortMode::Descending) {
+          auto& run = *(*materialized_right_segments)[chunk_id];
+          std::reverse(run.begin(), run.end());
+        }
+      }
+
+      // Range clusters are valid for equi and non-equi joins. The merged clusters are sorted already.
+      const auto split_values = _pick_split_values(samples_left);
+      output.clusters_left = _merge_sorted_runs(materialized_left_segments, split_values);
+      output.clusters_right = _merge_sorted_runs(materialized_right_segments, split_values);
+      _performance.set_step_runtime(JoinSortMerge::OperatorSteps::Clustering, timer.lap());
+
+      return output;
+    }
+
     if (_cluster_count == 1) {
       output.clusters_left = _concatenate_chunks(materialized_left_segments);
       output.clusters_right = _concatenate_chunks(materialized_right_segments);
@@ -27,7 +27,7 @@ namespace opossum {
 Projection::Projection(const std::shared_ptr<const AbstractOperator>& input_operator,
                        const std::vector<std::shared_ptr<AbstractExpression>>& init_expressions)
     : AbstractReadOnlyOperator(OperatorType::Projection, input_operator, nullptr,
-                               std::make_unique<OperatorPerformanceData<OperatorSteps>>()),
+                               std::make_unique<PerformanceData>()),
       expressions(init_expressions) {
   /**
    * Register as a consumer for all uncorrelated subqueries.
@@ -119,7 +119,10 @@ std::shared_ptr<const Table> Projection::_on_execute() {
     pqp_subquery_expression->pqp->deregister_consumer();
   }
 
-  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
+  // Correlated subqueries are executed per row. Their results are shared between the chunks.
+  const auto correlated_subquery_results_cache = std::make_shared<CorrelatedSubqueryResultsCache>();
+
+  auto& step_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
   if (!uncorrelated_subquery_results->empty()) {
     step_performance_data.set_step_runtime(OperatorSteps::UncorrelatedSubqueries, timer.lap());
   }
@@ -176,22 +179,33 @@ std::shared_ptr<const Table> Projection::_on_execute() {
     if (all_segments_forwarded) continue;
 
     // Defines the job that performs the evaluation if the columns are newly generated.
-    auto perform_projection_evaluation = [this, chunk_id, &uncorrelated_subquery_results, expression_count,
+    auto perform_projection_evaluation = [this, chunk_id, &uncorrelated_subquery_results,
+                                          &correlated_subquery_results_cache, expression_count,
                                           &output_segments_by_chunk, &column_is_nullable, &forwarded_pqp_columns]() {
-      auto evaluator = ExpressionEvaluator{left_input_table(), chunk_id, uncorrelated_subquery_results};
+      auto evaluator = ExpressionEvaluator{left_input_table(), chunk_id, uncorrelated_subquery_results,
+                                           correlated_subquery_results_cache};
 
+      // Newly generated columns - the expressions need to be evaluated. They are evaluated together, so that the
+      // evaluator can process them batch by batch and reuse common subexpressions.
+      auto evaluated_column_ids = std::vector<ColumnID>{};
+      auto evaluated_expressions = std::vector<std::shared_ptr<AbstractExpression>>{};
       for (auto column_id = ColumnID{0}; column_id < expression_count; ++column_id) {
         const auto& expression = expressions[column_id];
-
         if (!forwarded_pqp_columns.contains(expression)) {
-          // Newly generated column - the expression needs to be evaluated
-          auto output_segment = evaluator.evaluate_expression_to_segment(*expression);
-          column_is_nullable[column_id] = column_is_nullable[column_id] || output_segment->is_nullable();
-          // Storing the result in output_segments_by_chunk means that the vector for the separate chunks may contain
-          // both ReferenceSegments and ValueSegments. We deal with this later.
-          output_segments_by_chunk[chunk_id][column_id] = std::move(output_segment);
+          evaluated_column_ids.emplace_back(column_id);
+          evaluated_expressions.emplace_back(expression);
         }
       }
+
+      auto output_segments = evaluator.evaluate_expressions_to_segments(evaluated_expressions);
+      for (auto expression_idx = size_t{0}; expression_idx < evaluated_column_ids.size(); ++expression_idx) {
+        const auto column_id = evaluated_column_ids[expression_idx];
+        auto& output_segment = output_segments[expression_idx];
+        column_is_nullable[column_id] = column_is_nullable[column_id] || output_segment->is_nullable();
+        // Storing the result in output_segments_by_chunk means that the vector for the separate chunks may contain
+        // both ReferenceSegments and ValueSegments. We deal with this later.
+        output_segments_by_chunk[chunk_id][column_id] = std::move(output_segment);
+      }
     };
     // Evaluate the expression immediately if it contains less than `JOB_SPAWN_THRESHOLD` rows, otherwise wrap
     // it into a task. The upper bound of the chunk size, which defines if it will be executed in parallel or not,
@@ -211,6 +225,8 @@ std::shared_ptr<const Table> Projection::_on_execute() {
 
   step_performance_data.set_step_runtime(OperatorSteps::ForwardUnmodifiedColumns, forwarding_cost);
   step_performance_data.set_step_runtime(OperatorSteps::EvaluateNewColumns, expression_evaluator_cost);
+  step_performance_data.correlated_subquery_cache_hits = correlated_subquery_results_cache->hit_count();
+  step_performance_data.correlated_subquery_cache_misses = correlated_subquery_results_cache->miss_count();
 
   // Determine the TableColumnDefinitions. We can only do this now because column_is_nullable has been filled in the
   // loop above. If necessary, projection_result_column_definitions holds those newly generated columns that the
@@ -34,6 +34,21 @@ class Projection : public AbstractReadOnlyOperator {
     BuildOutput
   };
 
+  struct PerformanceData : public OperatorPerformanceData<OperatorSteps> {
+    // Lookups in the cache of correlated subquery results (see CorrelatedSubqueryResultsCache)
+    size_t correlated_subquery_cache_hits{0};
+    size_t correlated_subquery_cache_misses{0};
+
+    void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override {
+      OperatorPerformanceData<OperatorSteps>::output_to_stream(stream, description_mode);
+      if (correlated_subquery_cache_hits == 0 && correlated_subquery_cache_misses == 0) return;
+
+      const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+      stream << separator << "Correlated subquery cache: " << correlated_subquery_cache_hits << " hits, "
+             << correlated_subquery_cache_misses << " misses.";
+    }
+  };
+
   /**
    * The dummy table is used for literal projections that have no input table.
    * This was introduce to allow queries like INSERT INTO tbl VALUES (1, 2, 3);
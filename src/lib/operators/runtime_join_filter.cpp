@@ -0,0 +1,181 @@
+#include "runtime_join_filter.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "operators/abstract_operator.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+RuntimeJoinFilter::RuntimeJoinFilter(const std::shared_ptr<const AbstractOperator>& build_input,
+                                     const ColumnID build_column_id, const ColumnID probe_column_id)
+    : _build_input(build_input), _build_column_id(build_column_id), _probe_column_id(probe_column_id) {}
+
+const std::shared_ptr<const AbstractOperator>& RuntimeJoinFilter::build_input() const { return _build_input; }
+
+ColumnID RuntimeJoinFilter::build_column_id() const { return _build_column_id; }
+
+ColumnID RuntimeJoinFilter::probe_column_id() const { return _probe_column_id; }
+
+bool RuntimeJoinFilter::build() {
+  if (!_build_input->executed()) return false;
+  const auto build_table = _build_input->get_output();
+  if (!build_table) return false;
+
+  _data_type = build_table->column_data_type(_build_column_id);
+  _bloom_filter = BlockedBloomFilter{build_table->row_count()};
+
+  resolve_data_type(_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto hash_function = std::hash<ColumnDataType>{};
+    auto min = std::optional<ColumnDataType>{};
+    auto max = std::optional<ColumnDataType>{};
+    auto min_max_mutex = std::mutex{};
+
+    const auto chunk_count = build_table->chunk_count();
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = build_table->get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      const auto add_chunk = [&, chunk]() {
+        auto chunk_min = std::optional<ColumnDataType>{};
+        auto chunk_max = std::optional<ColumnDataType>{};
+        segment_iterate<ColumnDataType>(*chunk->get_segment(_build_column_id), [&](const auto& position) {
+          if (position.is_null()) return;
+
+          const auto& value = position.value();
+          _bloom_filter.insert(hash_function(value));
+          if (!chunk_min || value < *chunk_min) chunk_min = value;
+          if (!chunk_max || value > *chunk_max) chunk_max = value;
+        });
+        if (!chunk_min) return;
+
+        const auto lock = std::lock_guard<std::mutex>{min_max_mutex};
+        if (!min || *chunk_min < *min) min = chunk_min;
+        if (!max || *chunk_max > *max) max = chunk_max;
+      };
+
+      // Similar to the JoinHash, small chunks are not worth the scheduling overhead.
+      constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+      if (chunk->size() >= JOB_SPAWN_THRESHOLD) {
+        jobs.emplace_back(std::make_shared<JobTask>(add_chunk));
+      } else {
+        add_chunk();
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+    if (min) {
+      _min = AllTypeVariant{*min};
+      _max = AllTypeVariant{*max};
+    }
+  });
+
+  return true;
+}
+
+bool RuntimeJoinFilter::can_prune(const Chunk& chunk) const {
+  if (!_min) return true;
+
+  // For reference chunks, the statistics of the referenced chunk are used if all rows stem from a single chunk (as is
+  // the case for the output of, e.g., a Validate).
+  auto statistics_chunk = std::shared_ptr<const Chunk>{};
+  auto statistics_column_id = _probe_column_id;
+  const auto segment = chunk.get_segment(_probe_column_id);
+  if (const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+    const auto& pos_list = reference_segment->pos_list();
+    if (pos_list->empty() || !pos_list->references_single_chunk()) return false;
+
+    statistics_chunk = reference_segment->referenced_table()->get_chunk(pos_list->common_chunk_id());
+    statistics_column_id = reference_segment->referenced_column_id();
+    if (!statistics_chunk) return false;
+  }
+
+  const auto& pruning_statistics =
+      statistics_chunk ? statistics_chunk->pruning_statistics() : chunk.pruning_statistics();
+  if (!pruning_statistics || statistics_column_id >= pruning_statistics->size()) return false;
+
+  const auto& base_segment_statistics = (*pruning_statistics)[statistics_column_id];
+  if (!base_segment_statistics || base_segment_statistics->data_type != _data_type) return false;
+
+  auto can_prune = false;
+  resolve_data_type(_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto& segment_statistics = static_cast<const AttributeStatistics<ColumnDataType>&>(*base_segment_statistics);
+
+    // See ChunkPruningRule::_can_prune.
+    if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+      if (segment_statistics.range_filter) {
+        can_prune |= segment_statistics.range_filter->does_not_contain(PredicateCondition::BetweenInclusive, *_min,
+                                                                       *_max);
+      }
+    }
+
+    if (segment_statistics.min_max_filter) {
+      can_prune |=
+          segment_statistics.min_max_filter->does_not_contain(PredicateCondition::BetweenInclusive, *_min, *_max);
+    }
+  });
+
+  return can_prune;
+}
+
+void RuntimeJoinFilter::filter(const Chunk& chunk, RowIDPosList& matches) const {
+  if (!_min) {
+    matches.clear();
+    return;
+  }
+
+  resolve_data_type(_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto hash_function = std::hash<ColumnDataType>{};
+    const auto& min = boost::get<ColumnDataType>(*_min);
+    const auto& max = boost::get<ColumnDataType>(*_max);
+
+    const auto accessor = create_segment_accessor<ColumnDataType>(chunk.get_segment(_probe_column_id));
+
+    // Compact the matches in place, keeping their order.
+    auto matches_end = matches.begin();
+    for (const auto& match : matches) {
+      const auto value = accessor->access(match.chunk_offset);
+      if (!value || *value < min || *value > max || !_bloom_filter.contains(hash_function(*value))) continue;
+
+      *matches_end = match;
+      ++matches_end;
+    }
+    matches.erase(matches_end, matches.end());
+  });
+}
+
+std::string RuntimeJoinFilter::description() const {
+  auto stream = std::stringstream{};
+  stream << "Runtime join filter on column #" << _probe_column_id << " from column #" << _build_column_id << " of "
+         << _build_input->name();
+  return stream.str();
+}
+
+}  // namespace opossum
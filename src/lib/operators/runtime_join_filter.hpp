@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "all_type_variant.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "types.hpp"
+#include "utils/blocked_bloom_filter.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class Chunk;
+
+/**
+ * Sideways information passing from the build side of a hash join to a TableScan on its probe side. For inner and semi
+ * joins, probe side rows without a join partner are discarded by the join anyway. Filtering them in the scan that
+ * produces the probe side keeps them from being written into the scan's output and materialized by the join:
+ *   - Chunks whose pruning statistics show that no probe value lies within the [min, max] range of the build column
+ *     are skipped.
+ *   - Rows whose probe value is NULL or is not contained in a Bloom filter over the build column are dropped.
+ *
+ * The filter is built from the output of the build input, so the build input has to be executed before the scan.
+ * OperatorTask::make_tasks_from_operator takes care of that. If the build input has not been executed when the scan
+ * starts (e.g., because the operators are executed manually in a different order), the scan does not filter.
+ *
+ * Build and probe column must have the same data type. Filters are created by the LQPTranslator, see
+ * _translate_join_node.
+ */
+class RuntimeJoinFilter {
+ public:
+  // probe_column_id refers to the input of the scan (which has the same columns as its output, i.e., the join input).
+  RuntimeJoinFilter(const std::shared_ptr<const AbstractOperator>& build_input, const ColumnID build_column_id,
+                    const ColumnID probe_column_id);
+
+  const std::shared_ptr<const AbstractOperator>& build_input() const;
+  ColumnID build_column_id() const;
+  ColumnID probe_column_id() const;
+
+  // Creates the Bloom filter and the min/max range from the output of the build input. Returns false if the build
+  // input has not been executed.
+  bool build();
+
+  // Returns true if, according to the chunk's (or, for reference chunks, the referenced chunk's) pruning statistics,
+  // none of its probe values can find a join partner.
+  bool can_prune(const Chunk& chunk) const;
+
+  // Removes all matches (i.e., offsets into chunk) whose probe value cannot find a join partner.
+  void filter(const Chunk& chunk, RowIDPosList& matches) const;
+
+  std::string description() const;
+
+ protected:
+  const std::shared_ptr<const AbstractOperator> _build_input;
+  const ColumnID _build_column_id;
+  const ColumnID _probe_column_id;
+
+  DataType _data_type{DataType::Null};
+  BlockedBloomFilter _bloom_filter;
+
+  // Unset if the build column contains no non-NULL values. In that case, no probe row can find a join partner.
+  std::optional<AllTypeVariant> _min;
+  std::optional<AllTypeVariant> _max;
+};
+
+}  // namespace opossum
@@ -18,6 +18,10 @@ namespace opossum {
  * Operator to sort a table by one or multiple columns. This implements a stable sort, i.e., rows that share the same
  * value will maintain their relative order.
  * By passing multiple sort column definitions it is possible to sort multiple columns with one operator run.
+ *
+ * Where possible, the values of all sort columns are encoded into one binary key per row (see NormalizedSortKeys), so
+ * that the table is sorted in a single pass. Otherwise, it is sorted once per sort column, starting with the least
+ * significant one. In both cases, large inputs are sorted in parallel (see parallel_stable_sort).
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
@@ -0,0 +1,238 @@
+#include "normalized_sort_keys.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The length of a string is stored in a single byte after its characters. As no string in a key can be longer than
+// MAX_KEY_WIDTH, the length always fits.
+static_assert(NormalizedSortKeys::MAX_KEY_WIDTH <= std::numeric_limits<uint8_t>::max(),
+              "The length of strings is stored in a single byte");
+
+template <typename UnsignedType>
+void write_big_endian(uint8_t* destination, UnsignedType value) {
+  for (auto byte_index = sizeof(UnsignedType); byte_index > 0; --byte_index) {
+    destination[byte_index - 1] = static_cast<uint8_t>(value & 0xFFu);
+    value >>= 8u;
+  }
+}
+
+// Number of bytes used to encode a non-NULL value of the given type.
+template <typename ColumnDataType>
+size_t value_width(const size_t max_string_length) {
+  if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+    // Characters plus one byte for the length.
+    return max_string_length + 1;
+  } else {
+    return sizeof(ColumnDataType);
+  }
+}
+
+// Writes the order-preserving (i.e., memcmp-comparable) representation of value, assuming an ascending order.
+template <typename ColumnDataType>
+void encode_value(uint8_t* destination, const ColumnDataType& value, const size_t max_string_length) {
+  if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+    const auto length = value.size();
+    std::memcpy(destination, value.data(), length);
+    std::memset(destination + length, 0, max_string_length - length);
+    destination[max_string_length] = static_cast<uint8_t>(length);
+  } else if constexpr (std::is_integral_v<ColumnDataType>) {
+    // Flipping the sign bit moves negative numbers below positive ones.
+    using UnsignedType = std::make_unsigned_t<ColumnDataType>;
+    constexpr auto SIGN_BIT = UnsignedType{1} << (sizeof(UnsignedType) * 8 - 1);
+    write_big_endian(destination, static_cast<UnsignedType>(static_cast<UnsignedType>(value) ^ SIGN_BIT));
+  } else {
+    static_assert(std::is_floating_point_v<ColumnDataType>, "Unexpected data type");
+    using UnsignedType = std::conditional_t<sizeof(ColumnDataType) == 4, uint32_t, uint64_t>;
+    constexpr auto SIGN_BIT = UnsignedType{1} << (sizeof(UnsignedType) * 8 - 1);
+
+    // -0.0 and 0.0 are equal, but have different bit patterns.
+    const auto normalized_value = value == ColumnDataType{0} ? ColumnDataType{0} : value;
+    auto bits = UnsignedType{};
+    std::memcpy(&bits, &normalized_value, sizeof(bits));
+
+    // For positive numbers, setting the sign bit suffices to order them above the negative numbers. For negative
+    // numbers, a larger magnitude means a smaller number, so all bits are inverted.
+    bits = (bits & SIGN_BIT) ? static_cast<UnsignedType>(~bits) : static_cast<UnsignedType>(bits | SIGN_BIT);
+    write_big_endian(destination, bits);
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::optional<NormalizedSortKeys> NormalizedSortKeys::create(
+    const std::shared_ptr<const Table>& table, const std::vector<SortColumnDefinition>& sort_definitions) {
+  auto column_layouts = std::vector<ColumnLayout>{};
+  column_layouts.reserve(sort_definitions.size());
+
+  auto key_width = size_t{0};
+  for (const auto& sort_definition : sort_definitions) {
+    const auto column_id = sort_definition.column;
+    const auto data_type = table->column_data_type(column_id);
+    const auto nullable = table->column_is_nullable(column_id);
+
+    auto max_string_length = size_t{0};
+    auto width = size_t{0};
+    resolve_data_type(data_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+        // The longest string determines how many bytes have to be reserved for the column.
+        const auto chunk_count = table->chunk_count();
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+          const auto chunk = table->get_chunk(chunk_id);
+          if (!chunk) continue;
+
+          segment_iterate<pmr_string>(*chunk->get_segment(column_id), [&](const auto& position) {
+            if (!position.is_null()) max_string_length = std::max(max_string_length, position.value().size());
+          });
+
+          if (key_width + max_string_length >= MAX_KEY_WIDTH) break;
+        }
+      }
+
+      width = (nullable ? 1 : 0) + value_width<ColumnDataType>(max_string_length);
+    });
+
+    column_layouts.emplace_back(
+        ColumnLayout{column_id, data_type, sort_definition.sort_mode, nullable, key_width, max_string_length});
+    key_width += width;
+
+    if (key_width > MAX_KEY_WIDTH) return std::nullopt;
+  }
+
+  return NormalizedSortKeys{table, std::move(column_layouts), key_width};
+}
+
+NormalizedSortKeys::NormalizedSortKeys(const std::shared_ptr<const Table>& table,
+                                       std::vector<ColumnLayout> column_layouts, const size_t key_width)
+    : _table(table), _column_layouts(std::move(column_layouts)), _key_width(key_width) {
+  const auto chunk_count = _table->chunk_count();
+  _chunk_begins.reserve(chunk_count);
+
+  // Physically deleted chunks occupy no rows in the key buffer.
+  auto row_count = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    _chunk_begins.emplace_back(row_count);
+    const auto chunk = _table->get_chunk(chunk_id);
+    if (chunk) row_count += chunk->size();
+  }
+}
+
+std::vector<NormalizedSortKeys::Entry> NormalizedSortKeys::encode() {
+  const auto chunk_count = _table->chunk_count();
+  const auto row_count = _table->row_count();
+
+  _keys = uninitialized_vector<uint8_t>(row_count * _key_width);
+  auto entries = std::vector<Entry>(row_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    // Similar to the TableScan, small chunks are not worth the scheduling overhead.
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+    const auto chunk = _table->get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    if (chunk->size() >= JOB_SPAWN_THRESHOLD) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() { _encode_chunk(chunk_id, entries); }));
+    } else {
+      _encode_chunk(chunk_id, entries);
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  return entries;
+}
+
+void NormalizedSortKeys::_encode_chunk(const ChunkID chunk_id, std::vector<Entry>& entries) {
+  const auto chunk = _table->get_chunk(chunk_id);
+  const auto chunk_size = chunk->size();
+  const auto chunk_begin = _chunk_begins[chunk_id];
+  auto* const chunk_keys = _keys.data() + chunk_begin * _key_width;
+
+  for (const auto& column_layout : _column_layouts) {
+    const auto& segment = *chunk->get_segment(column_layout.column_id);
+
+    resolve_data_type(column_layout.data_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto width = value_width<ColumnDataType>(column_layout.max_string_length);
+      const auto invert = column_layout.sort_mode == SortMode::Descending;
+
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        auto* key = chunk_keys + position.chunk_offset() * _key_width + column_layout.offset;
+
+        if (column_layout.nullable) {
+          if (position.is_null()) {
+            // All NULLs are equal and come first, independent of the sort mode.
+            std::memset(key, 0, width + 1);
+            return;
+          }
+          *key = 1;
+          ++key;
+        }
+
+        encode_value(key, position.value(), column_layout.max_string_length);
+        if (invert) {
+          for (auto byte_index = size_t{0}; byte_index < width; ++byte_index) {
+            key[byte_index] = static_cast<uint8_t>(~key[byte_index]);
+          }
+        }
+      });
+    });
+  }
+
+  // Copy the first bytes of each key into its entry. Keys shorter than the prefix are padded with zeros.
+  const auto prefix_width = std::min(_key_width, sizeof(uint64_t));
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    const auto* const key = chunk_keys + chunk_offset * _key_width;
+
+    auto prefix = uint64_t{0};
+    for (auto byte_index = size_t{0}; byte_index < prefix_width; ++byte_index) {
+      prefix = (prefix << 8u) | key[byte_index];
+    }
+    prefix <<= 8u * (sizeof(uint64_t) - prefix_width);
+
+    entries[chunk_begin + chunk_offset] = Entry{prefix, RowID{chunk_id, chunk_offset}};
+  }
+}
+
+bool NormalizedSortKeys::less(const Entry& lhs, const Entry& rhs) const {
+  if (lhs.prefix != rhs.prefix) return lhs.prefix < rhs.prefix;
+
+  if (_key_width > sizeof(uint64_t)) {
+    const auto remaining_width = _key_width - sizeof(uint64_t);
+    const auto comparison =
+        std::memcmp(_key(lhs.row_id) + sizeof(uint64_t), _key(rhs.row_id) + sizeof(uint64_t), remaining_width);
+    if (comparison != 0) return comparison < 0;
+  }
+
+  return lhs.row_id < rhs.row_id;
+}
+
+size_t NormalizedSortKeys::key_width() const { return _key_width; }
+
+const uint8_t* NormalizedSortKeys::_key(const RowID& row_id) const {
+  return _keys.data() + (_chunk_begins[row_id.chunk_id] + row_id.chunk_offset) * _key_width;
+}
+
+}  // namespace opossum
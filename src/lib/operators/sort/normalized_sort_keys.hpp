@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <uninitialized_vector.hpp>
+
+#include "all_type_variant.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Encodes the values of all sort columns of a row into a single fixed-width binary key (a "normalized key"), so that
+ * comparing two keys with memcmp yields the order defined by the sort definitions. This allows sorting by multiple
+ * columns in a single pass instead of sorting once per column.
+ *
+ * For each sort column, the key contains:
+ *   - a NULL byte if the column is nullable (0 for NULL, 1 otherwise), so that NULLs come first for both ascending and
+ *     descending orders,
+ *   - the value in big-endian byte order, with the sign bit of integers flipped and floating-point numbers mapped to
+ *     an order-preserving unsigned representation,
+ *   - for strings, the characters padded with zeros to the longest string of the column, followed by the length of
+ *     the string, which orders a string before all longer strings that it is a prefix of.
+ * NULL values are encoded as zeros. For descending sort modes, all value bytes are inverted.
+ *
+ * As the first bytes usually suffice to decide the order of two rows, they are stored inline as `prefix` in the
+ * Entries that are to be sorted. Only if two prefixes are equal, the remaining bytes of the key are compared. Rows
+ * with equal keys are ordered by their RowID, which makes sorting the entries stable.
+ */
+class NormalizedSortKeys {
+ public:
+  // Keys wider than this are not worth it: They use more memory than the materialized values and comparing them is no
+  // longer cheap. This only happens for long strings, which are sorted column by column instead.
+  static constexpr auto MAX_KEY_WIDTH = size_t{128};
+
+  struct Entry {
+    uint64_t prefix;
+    RowID row_id;
+  };
+
+  // Returns std::nullopt if the sort columns cannot be encoded in MAX_KEY_WIDTH bytes.
+  static std::optional<NormalizedSortKeys> create(const std::shared_ptr<const Table>& table,
+                                                  const std::vector<SortColumnDefinition>& sort_definitions);
+
+  // Encodes the keys of all rows and returns one entry per row in the order of the input table. Chunks are encoded in
+  // parallel.
+  std::vector<Entry> encode();
+
+  // Strict weak ordering that corresponds to the sort definitions, with ties being broken by the RowID.
+  bool less(const Entry& lhs, const Entry& rhs) const;
+
+  size_t key_width() const;
+
+ protected:
+  struct ColumnLayout {
+    ColumnID column_id;
+    DataType data_type;
+    SortMode sort_mode;
+    bool nullable;
+
+    // Offset of the column's bytes (including the NULL byte) within the key.
+    size_t offset;
+
+    // For strings, the number of bytes reserved for the characters. Unused for other data types.
+    size_t max_string_length;
+  };
+
+  NormalizedSortKeys(const std::shared_ptr<const Table>& table, std::vector<ColumnLayout> column_layouts,
+                     const size_t key_width);
+
+  void _encode_chunk(const ChunkID chunk_id, std::vector<Entry>& entries);
+
+  const uint8_t* _key(const RowID& row_id) const;
+
+  const std::shared_ptr<const Table> _table;
+  const std::vector<ColumnLayout> _column_layouts;
+  const size_t _key_width;
+
+  // Position of each chunk's first row within _keys and the entries.
+  std::vector<size_t> _chunk_begins;
+
+  // Keys of all rows, key_width bytes each. Filled by encode().
+  uninitialized_vector<uint8_t> _keys;
+};
+
+}  // namespace opossum
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+
+namespace opossum {
+
+/**
+ * Stable sort that makes use of the scheduler's workers. The values are split into one run per worker, and the runs
+ * are sorted in parallel JobTasks. Afterwards, they are merged in parallel: Splitters sampled from the sorted runs
+ * divide the output into disjoint ranges. Each range is written by a k-way merge of the corresponding parts of all
+ * runs. Ties between runs are broken by the run index, which keeps the merge stable.
+ *
+ * Small inputs and schedulers without workers (i.e., the ImmediateExecutionScheduler) use std::stable_sort.
+ */
+template <typename T, typename Compare>
+void parallel_stable_sort(std::vector<T>& values, const Compare& less) {
+  // Below this size, sorting a run is cheaper than scheduling it.
+  constexpr auto MIN_RUN_SIZE = size_t{16'384};
+  // Number of values sampled per run to determine the splitters for the merge.
+  constexpr auto SAMPLES_PER_RUN = size_t{64};
+
+  const auto value_count = values.size();
+  const auto worker_count = Hyrise::get().scheduler()->workers().size();
+  const auto run_count = std::min(worker_count, value_count / MIN_RUN_SIZE);
+  if (run_count <= 1) {
+    std::stable_sort(values.begin(), values.end(), less);
+    return;
+  }
+
+  // 1. Sort the runs.
+  auto run_begins = std::vector<size_t>(run_count + 1);
+  for (auto run_index = size_t{0}; run_index <= run_count; ++run_index) {
+    run_begins[run_index] = value_count * run_index / run_count;
+  }
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(run_count);
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, run_index]() {
+      std::stable_sort(values.begin() + run_begins[run_index], values.begin() + run_begins[run_index + 1], less);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  // 2. Determine the splitters. Each splitter is the first value of a partition. As all runs are split at the first
+  //    value that is not less than the splitter, equal values always end up in the same partition.
+  const auto partition_count = run_count;
+  auto sample_positions = std::vector<size_t>{};
+  sample_positions.reserve(run_count * SAMPLES_PER_RUN);
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    const auto run_size = run_begins[run_index + 1] - run_begins[run_index];
+    for (auto sample_index = size_t{0}; sample_index < SAMPLES_PER_RUN; ++sample_index) {
+      sample_positions.emplace_back(run_begins[run_index] + run_size * sample_index / SAMPLES_PER_RUN);
+    }
+  }
+  std::sort(sample_positions.begin(), sample_positions.end(),
+            [&](const auto lhs, const auto rhs) { return less(values[lhs], values[rhs]); });
+
+  // partition_bounds[partition_index][run_index] is the position in the run at which the partition begins.
+  auto partition_bounds = std::vector<std::vector<size_t>>(partition_count + 1, std::vector<size_t>(run_count));
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    const auto run_end = values.begin() + run_begins[run_index + 1];
+
+    partition_bounds[0][run_index] = run_begins[run_index];
+    for (auto partition_index = size_t{1}; partition_index < partition_count; ++partition_index) {
+      const auto& splitter = values[sample_positions[sample_positions.size() * partition_index / partition_count]];
+      // Partitions are monotonic, so the search can start at the previous partition's bound.
+      const auto search_begin = values.begin() + partition_bounds[partition_index - 1][run_index];
+      partition_bounds[partition_index][run_index] =
+          std::distance(values.begin(), std::lower_bound(search_begin, run_end, splitter, less));
+    }
+    partition_bounds[partition_count][run_index] = run_begins[run_index + 1];
+  }
+
+  // 3. Merge the partitions.
+  auto merged_values = std::vector<T>(value_count);
+  jobs.clear();
+  auto output_begin = size_t{0};
+  for (auto partition_index = size_t{0}; partition_index < partition_count; ++partition_index) {
+    auto partition_size = size_t{0};
+    for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+      partition_size +=
+          partition_bounds[partition_index + 1][run_index] - partition_bounds[partition_index][run_index];
+    }
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_index, output_begin]() {
+      struct Cursor {
+        size_t position;
+        size_t end;
+        size_t run_index;
+      };
+
+      auto cursors = std::vector<Cursor>{};
+      cursors.reserve(run_count);
+      for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+        const auto begin = partition_bounds[partition_index][run_index];
+        const auto end = partition_bounds[partition_index + 1][run_index];
+        if (begin < end) cursors.emplace_back(Cursor{begin, end, run_index});
+      }
+
+      // The heap functions build a max-heap, so the comparator returns true if lhs should be merged after rhs.
+      const auto merged_after = [&](const Cursor& lhs, const Cursor& rhs) {
+        if (less(values[rhs.position], values[lhs.position])) return true;
+        if (less(values[lhs.position], values[rhs.position])) return false;
+        return lhs.run_index > rhs.run_index;
+      };
+      std::make_heap(cursors.begin(), cursors.end(), merged_after);
+
+      auto output_position = output_begin;
+      while (!cursors.empty()) {
+        std::pop_heap(cursors.begin(), cursors.end(), merged_after);
+        auto& cursor = cursors.back();
+        merged_values[output_position] = std::move(values[cursor.position]);
+        ++output_position;
+        ++cursor.position;
+
+        if (cursor.position == cursor.end) {
+          cursors.pop_back();
+        } else {
+          std::push_heap(cursors.begin(), cursors.end(), merged_after);
+        }
+      }
+    }));
+
+    output_begin += partition_size;
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  values = std::move(merged_values);
+}
+
+}  // namespace opossum
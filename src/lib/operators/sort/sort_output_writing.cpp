@@ -0,0 +1,249 @@
+#include "sort_output_writing.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/create_iterable_from_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+// Given an unsorted_table and a pos_list that defines the output order, this materializes all columns in the table,
+// creating chunks of output_chunk_size rows at maximum.
+std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<const Table>& unsorted_table,
+                                                       RowIDPosList pos_list, const ChunkOffset output_chunk_size) {
+  // First, we create a new table as the output
+  // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+  auto output = std::make_shared<Table>(unsorted_table->column_definitions(), TableType::Data, output_chunk_size);
+
+  // After we created the output table and initialized the column structure, we can start adding values. Because the
+  // values are not sorted by input chunks anymore, we can't process them chunk by chunk. Instead the values are copied
+  // column by column for each output row.
+
+  // Ceiling of integer division
+  const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
+  const auto output_chunk_count = div_ceil(pos_list.size(), output_chunk_size);
+  Assert(pos_list.size() <= unsorted_table->row_count(), "PosList is larger than the input table");
+
+  // Vector of segments for each chunk
+  std::vector<Segments> output_segments_by_chunk(output_chunk_count);
+
+  // Materialize column by column, starting a new ValueSegment whenever output_chunk_size is reached
+  const auto input_chunk_count = unsorted_table->chunk_count();
+  const auto row_count = pos_list.size();
+  for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
+    const auto column_data_type = output->column_data_type(column_id);
+    const auto column_is_nullable = unsorted_table->column_is_nullable(column_id);
+
+    resolve_data_type(column_data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      auto chunk_it = output_segments_by_chunk.begin();
+      auto current_segment_size = 0u;
+
+      auto value_segment_value_vector = pmr_vector<ColumnDataType>();
+      auto value_segment_null_vector = pmr_vector<bool>();
+
+      {
+        const auto next_chunk_size = std::min(static_cast<size_t>(output_chunk_size), static_cast<size_t>(row_count));
+        value_segment_value_vector.reserve(next_chunk_size);
+        if (column_is_nullable) value_segment_null_vector.reserve(next_chunk_size);
+      }
+
+      auto accessor_by_chunk_id =
+          std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(unsorted_table->chunk_count());
+      for (auto input_chunk_id = ChunkID{0}; input_chunk_id < input_chunk_count; ++input_chunk_id) {
+        const auto& abstract_segment = unsorted_table->get_chunk(input_chunk_id)->get_segment(column_id);
+        accessor_by_chunk_id[input_chunk_id] = create_segment_accessor<ColumnDataType>(abstract_segment);
+      }
+
+      for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
+        const auto [chunk_id, chunk_offset] = pos_list[row_index];
+
+        auto& accessor = accessor_by_chunk_id[chunk_id];
+        const auto typed_value = accessor->access(chunk_offset);
+        const auto is_null = !typed_value;
+        value_segment_value_vector.push_back(is_null ? ColumnDataType{} : typed_value.value());
+        if (column_is_nullable) value_segment_null_vector.push_back(is_null);
+
+        ++current_segment_size;
+
+        // Check if value segment is full
+        if (current_segment_size >= output_chunk_size) {
+          current_segment_size = 0u;
+
+          std::shared_ptr<ValueSegment<ColumnDataType>> value_segment;
+          if (column_is_nullable) {
+            value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
+                                                                           std::move(value_segment_null_vector));
+          } else {
+            value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector));
+          }
+
+          chunk_it->push_back(value_segment);
+          value_segment_value_vector = pmr_vector<ColumnDataType>();
+          value_segment_null_vector = pmr_vector<bool>();
+
+          const auto next_chunk_size =
+              std::min(static_cast<size_t>(output_chunk_size), static_cast<size_t>(row_count - row_index));
+          value_segment_value_vector.reserve(next_chunk_size);
+          if (column_is_nullable) value_segment_null_vector.reserve(next_chunk_size);
+
+          ++chunk_it;
+        }
+      }
+
+      // Last segment has not been added
+      if (current_segment_size > 0u) {
+        std::shared_ptr<ValueSegment<ColumnDataType>> value_segment;
+        if (column_is_nullable) {
+          value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
+                                                                         std::move(value_segment_null_vector));
+        } else {
+          value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector));
+        }
+        chunk_it->push_back(value_segment);
+      }
+    });
+  }
+
+  for (auto& segments : output_segments_by_chunk) {
+    output->append_chunk(segments);
+  }
+
+  return output;
+}
+
+// Given an unsorted_table and an input_pos_list that defines the output order, this writes the output table as a
+// reference table. This is usually faster, but can only be done if a single column in the input table does not
+// reference multiple tables. An example where this restriction applies is the sorted result of a union between two
+// tables. The restriction is needed because a ReferenceSegment can only reference a single table. It does, however,
+// not necessarily apply to joined tables, so two tables referenced in different columns is fine.
+//
+// If unsorted_table is of TableType::Data, this is trivial and the input_pos_list is used to create the output
+// reference table. If the input is already a reference table, the double indirection needs to be resolved.
+std::shared_ptr<Table> write_reference_output_table(const std::shared_ptr<const Table>& unsorted_table,
+                                                    RowIDPosList input_pos_list, const ChunkOffset output_chunk_size) {
+  // First we create a new table as the output
+  // We have decided against duplicating MVCC data in https://github.com/hyrise/hyrise/issues/408
+  auto output_table = std::make_shared<Table>(unsorted_table->column_definitions(), TableType::References);
+
+  const auto resolve_indirection = unsorted_table->type() == TableType::References;
+  const auto column_count = output_table->column_count();
+
+  // Ceiling of integer division
+  const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
+  const auto output_chunk_count = div_ceil(input_pos_list.size(), output_chunk_size);
+  Assert(input_pos_list.size() <= unsorted_table->row_count(), "PosList is larger than the input table");
+
+  // Vector of segments for each chunk
+  auto output_segments_by_chunk = std::vector<Segments>(output_chunk_count, Segments(column_count));
+
+  if (!resolve_indirection && input_pos_list.size() <= output_chunk_size) {
+    // Shortcut: No need to copy RowIDs if input_pos_list is small enough and we do not need to resolve the indirection.
+    const auto output_pos_list = std::make_shared<RowIDPosList>(std::move(input_pos_list));
+    auto& output_segments = output_segments_by_chunk.at(0);
+    for (auto column_id = ColumnID{0u}; column_id < column_count; ++column_id) {
+      output_segments[column_id] = std::make_shared<ReferenceSegment>(unsorted_table, column_id, output_pos_list);
+    }
+  } else {
+    for (ColumnID column_id{0u}; column_id < column_count; ++column_id) {
+      // To keep the implementation simple, we write the output ReferenceSegments column by column. This means that even
+      // if input ReferenceSegments share a PosList, the output will contain independent PosLists. While this is
+      // slightly more expensive to generate and slightly less efficient for following operators, we assume that the
+      // lion's share of the work has been done before the Sort operator is executed and that the relative cost of this
+      // is acceptable. In the future, this could be improved.
+      auto output_pos_list = std::make_shared<RowIDPosList>();
+      output_pos_list->reserve(output_chunk_size);
+
+      // Collect all input segments for the current column
+      const auto input_chunk_count = unsorted_table->chunk_count();
+      auto input_segments = std::vector<std::shared_ptr<AbstractSegment>>(input_chunk_count);
+      for (auto input_chunk_id = ChunkID{0}; input_chunk_id < input_chunk_count; ++input_chunk_id) {
+        input_segments[input_chunk_id] = unsorted_table->get_chunk(input_chunk_id)->get_segment(column_id);
+      }
+
+      const auto first_reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(input_segments.at(0));
+      const auto referenced_table = resolve_indirection ? first_reference_segment->referenced_table() : unsorted_table;
+      const auto referenced_column_id =
+          resolve_indirection ? first_reference_segment->referenced_column_id() : column_id;
+
+      // write_output_pos_list creates an output reference segment for a given ChunkID, ColumnID and PosList.
+      auto output_chunk_id = ChunkID{0};
+      const auto write_output_pos_list = [&] {
+        DebugAssert(!output_pos_list->empty(), "Asked to write empty output_pos_list");
+        output_segments_by_chunk.at(output_chunk_id)[column_id] =
+            std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, output_pos_list);
+        ++output_chunk_id;
+
+        output_pos_list = std::make_shared<RowIDPosList>();
+        if (output_chunk_id < output_chunk_count) {
+          output_pos_list->reserve(output_chunk_size);
+        }
+      };
+
+      // Iterate over rows in sorted input pos list, dereference them if necessary, and write a chunk every
+      // `output_chunk_size` rows.
+      for (auto input_pos_list_offset = size_t{0}; input_pos_list_offset < input_pos_list.size();
+           ++input_pos_list_offset) {
+        const auto& row_id = input_pos_list[input_pos_list_offset];
+        if (resolve_indirection) {
+          const auto& input_reference_segment = static_cast<ReferenceSegment&>(*input_segments[row_id.chunk_id]);
+          DebugAssert(input_reference_segment.referenced_table() == referenced_table,
+                      "Input column references more than one table");
+          DebugAssert(input_reference_segment.referenced_column_id() == referenced_column_id,
+                      "Input column references more than one column");
+          const auto& input_reference_pos_list = input_reference_segment.pos_list();
+          output_pos_list->emplace_back((*input_reference_pos_list)[row_id.chunk_offset]);
+        } else {
+          output_pos_list->emplace_back(row_id);
+        }
+
+        if (output_pos_list->size() == output_chunk_size) {
+          write_output_pos_list();
+        }
+      }
+      if (!output_pos_list->empty()) {
+        write_output_pos_list();
+      }
+    }
+  }
+
+  for (auto& segments : output_segments_by_chunk) {
+    output_table->append_chunk(segments);
+  }
+
+  return output_table;
+}
+
+bool sort_output_requires_materialization(const std::shared_ptr<const Table>& input_table) {
+  const auto input_chunk_count = input_table->chunk_count();
+  if (input_table->type() != TableType::References || input_chunk_count <= 1) return false;
+
+  const auto input_column_count = input_table->column_count();
+  for (auto input_column_id = ColumnID{0}; input_column_id < input_column_count; ++input_column_id) {
+    const auto& first_segment = input_table->get_chunk(ChunkID{0})->get_segment(input_column_id);
+    const auto& first_reference_segment = static_cast<ReferenceSegment&>(*first_segment);
+
+    const auto& common_referenced_table = first_reference_segment.referenced_table();
+    const auto& common_referenced_column_id = first_reference_segment.referenced_column_id();
+
+    for (auto input_chunk_id = ChunkID{1}; input_chunk_id < input_chunk_count; ++input_chunk_id) {
+      const auto& segment = input_table->get_chunk(input_chunk_id)->get_segment(input_column_id);
+      const auto& referenced_table = static_cast<ReferenceSegment&>(*segment).referenced_table();
+      const auto& referenced_column_id = static_cast<ReferenceSegment&>(*segment).referenced_column_id();
+
+      if (common_referenced_table != referenced_table || common_referenced_column_id != referenced_column_id) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+}  // namespace opossum
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Helpers shared by operators that reorder (and potentially shorten) their input according to a RowIDPosList, i.e.,
+ * Sort and TopK. The pos_list holds RowIDs of the unsorted_table (not of the table referenced by it) in output order.
+ */
+
+// Materializes all columns of unsorted_table in the order given by pos_list, creating chunks of output_chunk_size rows
+// at maximum.
+std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<const Table>& unsorted_table,
+                                                       RowIDPosList pos_list, const ChunkOffset output_chunk_size);
+
+// Writes the output as a reference table, resolving the indirection if unsorted_table is a reference table. This is
+// usually faster, but can only be done if sort_output_requires_materialization returns false.
+std::shared_ptr<Table> write_reference_output_table(const std::shared_ptr<const Table>& unsorted_table,
+                                                    RowIDPosList input_pos_list, const ChunkOffset output_chunk_size);
+
+// Returns true if a column of the input table references multiple tables or multiple columns of the same table. As a
+// ReferenceSegment can only reference a single column of a single table, the output needs to be materialized in that
+// case. This can only occur if there is more than one ReferenceSegment in an input column, e.g., for the result of a
+// union between two tables.
+bool sort_output_requires_materialization(const std::shared_ptr<const Table>& input_table);
+
+}  // namespace opossum
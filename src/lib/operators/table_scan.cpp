@@ -22,10 +22,12 @@
 #include "hyrise.hpp"
 #include "lossless_cast.hpp"
 #include "operators/operator_scan_predicate.hpp"
+#include "operators/runtime_join_filter.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/chunk.hpp"
+#include "storage/pos_lists/bitmap_pos_list.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "table_scan/column_between_table_scan_impl.hpp"
@@ -40,6 +42,39 @@
 
 namespace opossum {
 
+namespace {
+
+// Resolves the positions in `matches` against a BitmapPosList. As the matches are sorted, the iterator only has to
+// skip the bits in between. The result is a bitmap again if enough rows of the referenced chunk are left.
+std::shared_ptr<AbstractPosList> filter_bitmap_pos_list(const BitmapPosList& pos_list_in, const RowIDPosList& matches) {
+  auto position_it = pos_list_in.begin();
+  auto position = ChunkOffset{0};
+  const auto resolve_match = [&](const RowID& match) {
+    position_it += static_cast<std::ptrdiff_t>(match.chunk_offset) - static_cast<std::ptrdiff_t>(position);
+    position = match.chunk_offset;
+    return *position_it;
+  };
+
+  const auto chunk_size = pos_list_in.chunk_size();
+  if (BitmapPosList::prefer_bitmap(matches.size(), chunk_size)) {
+    auto bitmap = BitmapPosList::create_bitmap(chunk_size);
+    for (const auto& match : matches) {
+      BitmapPosList::set_bit(bitmap, resolve_match(match).chunk_offset);
+    }
+    return std::make_shared<BitmapPosList>(pos_list_in.common_chunk_id(), chunk_size, std::move(bitmap));
+  }
+
+  auto pos_list_out = std::make_shared<RowIDPosList>();
+  pos_list_out->reserve(matches.size());
+  pos_list_out->guarantee_single_chunk();
+  for (const auto& match : matches) {
+    pos_list_out->emplace_back(resolve_match(match));
+  }
+  return pos_list_out;
+}
+
+}  // namespace
+
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in,
                      const std::shared_ptr<AbstractExpression>& predicate)
     : AbstractReadOnlyOperator{OperatorType::TableScan, in, nullptr, std::make_unique<PerformanceData>()},
@@ -77,10 +112,17 @@ std::string TableScan::description(DescriptionMode description_mode) const {
   stream << AbstractOperator::description(description_mode) << separator;
   stream << "Impl: " << _impl_description;
   stream << separator << _predicate->as_column_name();
+  if (_runtime_join_filter) stream << separator << _runtime_join_filter->description();
 
   return stream.str();
 }
 
+void TableScan::set_runtime_join_filter(const std::shared_ptr<RuntimeJoinFilter>& runtime_join_filter) {
+  _runtime_join_filter = runtime_join_filter;
+}
+
+const std::shared_ptr<RuntimeJoinFilter>& TableScan::runtime_join_filter() const { return _runtime_join_filter; }
+
 void TableScan::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
   expressions_set_transaction_context({_predicate}, transaction_context);
 }
@@ -93,7 +135,14 @@ std::shared_ptr<AbstractOperator> TableScan::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<TableScan>(copied_left_input, _predicate->deep_copy(copied_ops));
+  const auto copy = std::make_shared<TableScan>(copied_left_input, _predicate->deep_copy(copied_ops));
+  if (_runtime_join_filter) {
+    // The build input is part of the join's other input, which might not have been copied yet.
+    copy->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(
+        _runtime_join_filter->build_input()->deep_copy(copied_ops), _runtime_join_filter->build_column_id(),
+        _runtime_join_filter->probe_column_id()));
+  }
+  return copy;
 }
 
 std::shared_ptr<const Table> TableScan::_on_execute() {
@@ -106,6 +155,13 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
 
   const auto excluded_chunk_set = std::unordered_set<ChunkID>{excluded_chunk_ids.cbegin(), excluded_chunk_ids.cend()};
 
+  // The runtime join filter drops rows that the consuming join would discard. If the scan's output is consumed by
+  // other operators as well (e.g., because the LQPTranslator deduplicated equal subplans), these rows are needed.
+  const auto runtime_join_filter =
+      _runtime_join_filter && consumer_count() == 1 && _runtime_join_filter->build() ? _runtime_join_filter : nullptr;
+  auto num_chunks_pruned_by_runtime_join_filter = std::atomic<size_t>{0};
+  auto num_rows_filtered_by_runtime_join_filter = std::atomic<size_t>{0};
+
   auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
   output_chunks.reserve(in_table->chunk_count() - excluded_chunk_set.size());
 
@@ -118,10 +174,21 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
     const auto chunk_in = in_table->get_chunk(chunk_id);
     Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
+    if (runtime_join_filter && runtime_join_filter->can_prune(*chunk_in)) {
+      ++num_chunks_pruned_by_runtime_join_filter;
+      continue;
+    }
+
     // chunk_in – Copy by value since copy by reference is not possible due to the limited scope of the for-iteration.
-    auto perform_table_scan = [this, chunk_id, chunk_in, &in_table, &output_mutex, &output_chunks]() {
+    auto perform_table_scan = [this, chunk_id, chunk_in, &in_table, &output_mutex, &output_chunks, &runtime_join_filter,
+                               &num_rows_filtered_by_runtime_join_filter]() {
       // The actual scan happens in the sub classes of BaseTableScanImpl
       const auto matches_out = _impl->scan_chunk(chunk_id);
+      if (runtime_join_filter && !matches_out->empty()) {
+        const auto match_count = matches_out->size();
+        runtime_join_filter->filter(*chunk_in, *matches_out);
+        num_rows_filtered_by_runtime_join_filter += match_count - matches_out->size();
+      }
       if (matches_out->empty()) return;
 
       Segments out_segments;
@@ -145,7 +212,8 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
             out_segments.emplace_back(segment_in);
           }
         } else {
-          auto filtered_pos_lists = std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<RowIDPosList>>{};
+          auto filtered_pos_lists =
+              std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<const AbstractPosList>>{};
 
           for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
             const auto segment_in = chunk_in->get_segment(column_id);
@@ -161,22 +229,27 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
             auto& filtered_pos_list = filtered_pos_lists[pos_list_in];
 
             if (!filtered_pos_list) {
-              filtered_pos_list = std::make_shared<RowIDPosList>(matches_out->size());
-              if (pos_list_in->references_single_chunk()) {
-                filtered_pos_list->guarantee_single_chunk();
+              if (const auto bitmap_pos_list_in = std::dynamic_pointer_cast<const BitmapPosList>(pos_list_in)) {
+                filtered_pos_list = filter_bitmap_pos_list(*bitmap_pos_list_in, *matches_out);
               } else {
-                // When segments reference multiple chunks, we do not keep the sort order of the input chunk. The main
-                // reason is that several table scan implementations split the pos lists by chunks (see
-                // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment) and thus shuffle the data. While
-                // this does not affect all scan implementations, we chose the safe and defensive path for now.
-                keep_chunk_sort_order = false;
-              }
-
-              size_t offset = 0;
-              for (const auto& match : *matches_out) {
-                const auto row_id = (*pos_list_in)[match.chunk_offset];
-                (*filtered_pos_list)[offset] = row_id;
-                ++offset;
+                auto row_id_pos_list = std::make_shared<RowIDPosList>(matches_out->size());
+                if (pos_list_in->references_single_chunk()) {
+                  row_id_pos_list->guarantee_single_chunk();
+                } else {
+                  // When segments reference multiple chunks, we do not keep the sort order of the input chunk. The
+                  // main reason is that several table scan implementations split the pos lists by chunks (see
+                  // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment) and thus shuffle the data.
+                  // While this does not affect all scan implementations, we chose the safe and defensive path for now.
+                  keep_chunk_sort_order = false;
+                }
+
+                size_t offset = 0;
+                for (const auto& match : *matches_out) {
+                  const auto row_id = (*pos_list_in)[match.chunk_offset];
+                  (*row_id_pos_list)[offset] = row_id;
+                  ++offset;
+                }
+                filtered_pos_list = row_id_pos_list;
               }
             }
 
@@ -188,11 +261,17 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
       } else {
         matches_out->guarantee_single_chunk();
 
-        // If the entire chunk is matched, create an EntireChunkPosList instead
-        const auto output_pos_list = matches_out->size() == chunk_in->size()
-                                         ? static_cast<std::shared_ptr<AbstractPosList>>(
-                                               std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size()))
-                                         : static_cast<std::shared_ptr<AbstractPosList>>(matches_out);
+        // If the entire chunk is matched, create an EntireChunkPosList instead. If a large share of it is matched, a
+        // BitmapPosList is smaller than the list of RowIDs.
+        const auto chunk_size = chunk_in->size();
+        auto output_pos_list = std::shared_ptr<AbstractPosList>{};
+        if (matches_out->size() == chunk_size) {
+          output_pos_list = std::make_shared<EntireChunkPosList>(chunk_id, chunk_size);
+        } else if (BitmapPosList::prefer_bitmap(matches_out->size(), chunk_size)) {
+          output_pos_list = std::make_shared<BitmapPosList>(chunk_id, chunk_size, *matches_out);
+        } else {
+          output_pos_list = matches_out;
+        }
 
         for (auto column_id = ColumnID{0u}; column_id < in_table->column_count(); ++column_id) {
           const auto ref_segment_out = std::make_shared<ReferenceSegment>(in_table, column_id, output_pos_list);
@@ -225,6 +304,15 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   scan_performance_data.num_chunks_with_early_out = _impl->num_chunks_with_early_out.load();
   scan_performance_data.num_chunks_with_all_rows_matching = _impl->num_chunks_with_all_rows_matching.load();
   scan_performance_data.num_chunks_with_binary_search = _impl->num_chunks_with_binary_search.load();
+  if (runtime_join_filter) {
+    scan_performance_data.num_chunks_pruned_by_runtime_join_filter = num_chunks_pruned_by_runtime_join_filter.load();
+    scan_performance_data.num_rows_filtered_by_runtime_join_filter = num_rows_filtered_by_runtime_join_filter.load();
+  }
+  if (const auto* const expression_evaluator_impl = dynamic_cast<ExpressionEvaluatorTableScanImpl*>(_impl.get())) {
+    const auto& correlated_subquery_results_cache = *expression_evaluator_impl->correlated_subquery_results_cache();
+    scan_performance_data.correlated_subquery_cache_hits = correlated_subquery_results_cache.hit_count();
+    scan_performance_data.correlated_subquery_cache_misses = correlated_subquery_results_cache.miss_count();
+  }
 
   return std::make_shared<Table>(in_table->column_definitions(), TableType::References, std::move(output_chunks));
 }
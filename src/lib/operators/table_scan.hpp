@@ -15,6 +15,7 @@
 namespace opossum {
 
 class PQPSubqueryExpression;
+class RuntimeJoinFilter;
 class Table;
 
 class TableScan : public AbstractReadOnlyOperator {
@@ -51,11 +52,26 @@ class TableScan : public AbstractReadOnlyOperator {
    */
   std::vector<ChunkID> excluded_chunk_ids;
 
+  /**
+   * Filter published by a hash join for which this scan produces the probe side (see RuntimeJoinFilter). Rows that
+   * cannot find a join partner are dropped. The filter is ignored if the scan has other consumers than the join.
+   */
+  void set_runtime_join_filter(const std::shared_ptr<RuntimeJoinFilter>& runtime_join_filter);
+  const std::shared_ptr<RuntimeJoinFilter>& runtime_join_filter() const;
+
   struct PerformanceData : public OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps> {
     std::atomic<size_t> num_chunks_with_early_out{0};
     std::atomic<size_t> num_chunks_with_all_rows_matching{0};
     std::atomic<size_t> num_chunks_with_binary_search{0};
 
+    // Only set if a runtime join filter has been applied.
+    std::optional<size_t> num_chunks_pruned_by_runtime_join_filter;
+    std::optional<size_t> num_rows_filtered_by_runtime_join_filter;
+
+    // Only set if the ExpressionEvaluator was used (see CorrelatedSubqueryResultsCache).
+    std::optional<size_t> correlated_subquery_cache_hits;
+    std::optional<size_t> correlated_subquery_cache_misses;
+
     void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override {
       OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps>::output_to_stream(stream, description_mode);
 
@@ -63,6 +79,15 @@ class TableScan : public AbstractReadOnlyOperator {
       stream << separator << "Chunks: " << num_chunks_with_early_out.load() << " skipped with no results, ";
       stream << separator << num_chunks_with_all_rows_matching.load() << " skipped with all matching, ";
       stream << num_chunks_with_binary_search.load() << " scanned using binary search.";
+      if (num_chunks_pruned_by_runtime_join_filter) {
+        stream << separator << "Runtime join filter: " << *num_chunks_pruned_by_runtime_join_filter
+               << " chunks pruned, " << *num_rows_filtered_by_runtime_join_filter << " rows filtered.";
+      }
+      if (correlated_subquery_cache_hits &&
+          (*correlated_subquery_cache_hits > 0 || *correlated_subquery_cache_misses > 0)) {
+        stream << separator << "Correlated subquery cache: " << *correlated_subquery_cache_hits << " hits, "
+               << *correlated_subquery_cache_misses << " misses.";
+      }
     }
   };
 
@@ -88,6 +113,8 @@ class TableScan : public AbstractReadOnlyOperator {
   const std::shared_ptr<AbstractExpression> _predicate;
   std::vector<std::shared_ptr<PQPSubqueryExpression>> _uncorrelated_subquery_expressions;
 
+  std::shared_ptr<RuntimeJoinFilter> _runtime_join_filter;
+
   std::unique_ptr<AbstractTableScanImpl> _impl;
 
   // The description of the impl, so that it still available after the _impl is resetted in _on_cleanup()
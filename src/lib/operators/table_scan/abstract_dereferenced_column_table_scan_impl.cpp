@@ -7,6 +7,7 @@
 #include "resolve_type.hpp"
 #include "storage/chunk.hpp"
 #include "storage/dictionary_segment.hpp"
+#include "storage/pos_lists/bitmap_pos_list.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/split_pos_list_by_chunk_id.hpp"
 #include "storage/table.hpp"
@@ -44,6 +45,27 @@ void AbstractDereferencedColumnTableScanImpl::_scan_reference_segment(const Refe
     const auto chunk = segment.referenced_table()->get_chunk(pos_list->common_chunk_id());
     auto referenced_segment = chunk->get_segment(segment.referenced_column_id());
 
+    // The bitmap references a large share of the chunk. Instead of accessing the referenced positions one by one, we
+    // scan the entire referenced segment (which can use the optimized scans on compressed segments) and AND the
+    // matches with the bitmap. The position of a match within the PosList is the number of bits set before it. This
+    // is not done for sorted chunks, as the sort order of the input chunk does not hold for the entire referenced
+    // segment and the sorted search is fast anyway.
+    const auto bitmap_pos_list = std::dynamic_pointer_cast<const BitmapPosList>(pos_list);
+    if (bitmap_pos_list &&
+        static_cast<double>(bitmap_pos_list->size()) >=
+            MIN_BITMAP_DENSITY_FOR_UNFILTERED_SCAN * static_cast<double>(bitmap_pos_list->chunk_size()) &&
+        _in_table->get_chunk(chunk_id)->individually_sorted_by().empty()) {
+      auto chunk_matches = RowIDPosList{};
+      _scan_non_reference_segment(*referenced_segment, chunk_id, chunk_matches, nullptr);
+
+      for (const auto& match : chunk_matches) {
+        if (bitmap_pos_list->contains(match.chunk_offset)) {
+          matches.emplace_back(chunk_id, static_cast<ChunkOffset>(bitmap_pos_list->position_of(match.chunk_offset)));
+        }
+      }
+      return;
+    }
+
     _scan_non_reference_segment(*referenced_segment, chunk_id, matches, pos_list);
 
     return;
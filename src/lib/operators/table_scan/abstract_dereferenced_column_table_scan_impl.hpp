@@ -32,6 +32,10 @@ class AbstractDereferencedColumnTableScanImpl : public AbstractTableScanImpl {
   const PredicateCondition predicate_condition;
 
  protected:
+  // If a BitmapPosList references at least this share of the referenced chunk's rows, the entire referenced segment
+  // is scanned and the matches are intersected with the bitmap
+  static constexpr auto MIN_BITMAP_DENSITY_FOR_UNFILTERED_SCAN = 0.25;
+
   void _scan_reference_segment(const ReferenceSegment& segment, const ChunkID chunk_id, RowIDPosList& matches);
 
   // Implemented by the separate Impls. They do not need to deal with ReferenceSegments anymore, as this class
@@ -4,6 +4,7 @@
 #include <string>
 #include <type_traits>
 
+#include "compressed_vector_scan.hpp"
 #include "expression/between_expression.hpp"
 #include "sorted_segment_search.hpp"
 #include "storage/chunk.hpp"
@@ -55,8 +56,11 @@ void ColumnBetweenTableScanImpl::_scan_non_reference_segment(
   }
 
   // Select optimized or generic scanning implementation based on segment type
+  const auto* frame_of_reference_segment = dynamic_cast<const FrameOfReferenceSegment<int32_t>*>(&segment);
   if (dictionary_segment) {
     _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+  } else if (frame_of_reference_segment && !position_filter) {
+    _scan_frame_of_reference_segment(*frame_of_reference_segment, chunk_id, matches);
   } else {
     _scan_generic_segment(segment, chunk_id, matches, position_filter);
   }
@@ -159,6 +163,14 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
     upper_bound_value_id = segment.unique_values_count();
   }
 
+  if (!position_filter) {
+    // Scan the compressed attribute vector without decoding it value by value
+    const auto value_id_range = CompressedVectorScan::ValueRange{lower_bound_value_id, upper_bound_value_id - 1};
+    const auto range_for_block = [&](const size_t) { return value_id_range; };
+    CompressedVectorScan::scan(*segment.attribute_vector(), range_for_block, chunk_id, std::nullopt, matches);
+    return;
+  }
+
   const auto value_id_diff = upper_bound_value_id - lower_bound_value_id;
   const auto comparator = [lower_bound_value_id, value_id_diff](const auto& position) {
     // Using < here because the right value id is the upper_bound. Also, because the value ids are integers, we can do
@@ -173,6 +185,19 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
   });
 }
 
+void ColumnBetweenTableScanImpl::_scan_frame_of_reference_segment(const FrameOfReferenceSegment<int32_t>& segment,
+                                                                  const ChunkID chunk_id,
+                                                                  RowIDPosList& matches) const {
+  // The values are integers, so exclusive bounds can be turned into inclusive ones
+  auto lower_value = int64_t{boost::get<int32_t>(left_value)};
+  if (!is_lower_inclusive_between(predicate_condition)) ++lower_value;
+
+  auto upper_value = int64_t{boost::get<int32_t>(right_value)};
+  if (!is_upper_inclusive_between(predicate_condition)) --upper_value;
+
+  CompressedVectorScan::scan_frame_of_reference_segment(segment, lower_value, upper_value, chunk_id, matches);
+}
+
 void ColumnBetweenTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id,
                                                       RowIDPosList& matches,
                                                       const std::shared_ptr<const AbstractPosList>& position_filter,
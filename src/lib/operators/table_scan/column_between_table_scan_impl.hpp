@@ -5,6 +5,7 @@
 #include "abstract_dereferenced_column_table_scan_impl.hpp"
 
 #include "all_type_variant.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -43,6 +44,10 @@ class ColumnBetweenTableScanImpl : public AbstractDereferencedColumnTableScanImp
   void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
                                 const std::shared_ptr<const AbstractPosList>& position_filter);
 
+  // Optimized scan on the offsets of FrameOfReferenceSegments, used if there is no position filter
+  void _scan_frame_of_reference_segment(const FrameOfReferenceSegment<int32_t>& segment, const ChunkID chunk_id,
+                                        RowIDPosList& matches) const;
+
   void _scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
                             const std::shared_ptr<const AbstractPosList>& position_filter, const SortMode sort_mode);
 
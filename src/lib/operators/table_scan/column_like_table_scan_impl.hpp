@@ -2,7 +2,6 @@
 
 #include <map>
 #include <memory>
-#include <regex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,8 +26,8 @@ class Table;
  *   in order to avoid having to look up each value ID of the attribute vector in the dictionary. This also
  *   enables us to detect if all or none of the values in the segment satisfy the expression.
  *
- * Performance Notes: Uses std::regex as a slow fallback and resorts to much faster Pattern matchers for special cases,
- *                    e.g., StartsWithPattern. 
+ * Performance Notes: The LikeMatcher compiles the pattern once per scan. For dictionary segments, each distinct value
+ *                    is matched only once.
  */
 class ColumnLikeTableScanImpl : public AbstractDereferencedColumnTableScanImpl {
  public:
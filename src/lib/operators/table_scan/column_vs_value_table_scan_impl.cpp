@@ -1,9 +1,11 @@
 #include "column_vs_value_table_scan_impl.hpp"
 
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "compressed_vector_scan.hpp"
 #include "sorted_segment_search.hpp"
 #include "storage/base_dictionary_segment.hpp"
 #include "storage/create_iterable_from_segment.hpp"
@@ -47,6 +49,14 @@ void ColumnVsValueTableScanImpl::_scan_non_reference_segment(
 
   if (const auto* dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment)) {
     _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+    return;
+  }
+
+  // NotEquals does not translate into a single range of offsets. Scans on ReferenceSegments (i.e., with a position
+  // filter) access the offsets of few positions only and use the iterators.
+  const auto* frame_of_reference_segment = dynamic_cast<const FrameOfReferenceSegment<int32_t>*>(&segment);
+  if (frame_of_reference_segment && !position_filter && predicate_condition != PredicateCondition::NotEquals) {
+    _scan_frame_of_reference_segment(*frame_of_reference_segment, chunk_id, matches);
   } else {
     _scan_generic_segment(segment, chunk_id, matches, position_filter);
   }
@@ -147,6 +157,34 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
     return;
   }
 
+  if (!position_filter && predicate_condition != PredicateCondition::NotEquals) {
+    // Scan the compressed attribute vector for the range of matching value IDs. The NULL value ID lies outside of
+    // this range.
+    auto value_id_range = CompressedVectorScan::ValueRange{};
+    switch (predicate_condition) {
+      case PredicateCondition::Equals:
+        value_id_range = {search_value_id, search_value_id};
+        break;
+
+      case PredicateCondition::LessThan:
+      case PredicateCondition::LessThanEquals:
+        value_id_range = {0, search_value_id - 1};
+        break;
+
+      case PredicateCondition::GreaterThan:
+      case PredicateCondition::GreaterThanEquals:
+        value_id_range = {search_value_id, segment.unique_values_count() - 1};
+        break;
+
+      default:
+        Fail("Unsupported comparison type encountered");
+    }
+
+    const auto range_for_block = [&](const size_t) { return value_id_range; };
+    CompressedVectorScan::scan(*segment.attribute_vector(), range_for_block, chunk_id, std::nullopt, matches);
+    return;
+  }
+
   _with_operator_for_dict_segment_scan([&](auto predicate_comparator) {
     auto comparator = [predicate_comparator, search_value_id](const auto& position) {
       return predicate_comparator(position.value(), search_value_id);
@@ -167,6 +205,42 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
   });
 }
 
+void ColumnVsValueTableScanImpl::_scan_frame_of_reference_segment(const FrameOfReferenceSegment<int32_t>& segment,
+                                                                  const ChunkID chunk_id,
+                                                                  RowIDPosList& matches) const {
+  const auto typed_value = int64_t{boost::get<int32_t>(value)};
+
+  auto lower_value = int64_t{std::numeric_limits<int32_t>::min()};
+  auto upper_value = int64_t{std::numeric_limits<int32_t>::max()};
+  switch (predicate_condition) {
+    case PredicateCondition::Equals:
+      lower_value = typed_value;
+      upper_value = typed_value;
+      break;
+
+    case PredicateCondition::LessThan:
+      upper_value = typed_value - 1;
+      break;
+
+    case PredicateCondition::LessThanEquals:
+      upper_value = typed_value;
+      break;
+
+    case PredicateCondition::GreaterThan:
+      lower_value = typed_value + 1;
+      break;
+
+    case PredicateCondition::GreaterThanEquals:
+      lower_value = typed_value;
+      break;
+
+    default:
+      Fail("Unsupported comparison type encountered");
+  }
+
+  CompressedVectorScan::scan_frame_of_reference_segment(segment, lower_value, upper_value, chunk_id, matches);
+}
+
 void ColumnVsValueTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id,
                                                       RowIDPosList& matches,
                                                       const std::shared_ptr<const AbstractPosList>& position_filter,
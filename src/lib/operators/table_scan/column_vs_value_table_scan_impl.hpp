@@ -9,6 +9,7 @@
 #include "abstract_dereferenced_column_table_scan_impl.hpp"
 
 #include "all_type_variant.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -21,6 +22,10 @@ namespace opossum {
  * - For dictionary segments, we basically look up the value ID of the constant value in the dictionary
  *   in order to avoid having to look up each value ID of the attribute vector in the dictionary. This also
  *   enables us to detect if all or none of the values in the segment satisfy the expression.
+ * - For frame-of-reference segments, the constant value is translated into an offset from each frame's minimum.
+ *
+ * Unless a position filter is given, the value IDs and offsets are compared on the compressed vector, see
+ * CompressedVectorScan.
  */
 class ColumnVsValueTableScanImpl : public AbstractDereferencedColumnTableScanImpl {
  public:
@@ -39,6 +44,8 @@ class ColumnVsValueTableScanImpl : public AbstractDereferencedColumnTableScanImp
                              const std::shared_ptr<const AbstractPosList>& position_filter) const;
   void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
                                 const std::shared_ptr<const AbstractPosList>& position_filter);
+  void _scan_frame_of_reference_segment(const FrameOfReferenceSegment<int32_t>& segment, const ChunkID chunk_id,
+                                        RowIDPosList& matches) const;
 
   void _scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
                             const std::shared_ptr<const AbstractPosList>& position_filter,
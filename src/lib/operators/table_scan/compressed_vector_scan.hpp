@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * @brief Scans compressed vectors of unsigned integers for values within a range without decoding them one by one
+ *
+ * The attribute vectors of dictionary segments and the offsets of frame-of-reference segments are compressed vectors.
+ * When a predicate on such a segment is translated into the domain of the vector once (i.e., into value IDs or into
+ * offsets from a frame's minimum), `=`, `<`, `<=`, `>`, `>=`, and BETWEEN all become a check whether the stored
+ * integer lies within an inclusive range. This check is done here directly on the compressed representation instead
+ * of going through the vector's iterators, which decode (and for SIMD-BP128, look up the block of) every single value:
+ *
+ * - FixedSizeByteAligned vectors are compared directly on their uint8_t/uint16_t/uint32_t data.
+ * - SimdBp128 vectors store the bit width of each block of 128 values. All values in a block lie within
+ *   [0, 2^bit_width). If this interval lies completely inside or outside of the searched range, the block is decided
+ *   without touching its data. Only the remaining blocks are unpacked into a small buffer using the SIMD unpacking of
+ *   SimdBp128Packing and compared there.
+ *
+ * Values are compared in groups of 64 that produce a bitmask of matches, similar to _simd_scan_with_iterators in
+ * AbstractTableScanImpl. Only the set bits are then written to the output.
+ */
+class CompressedVectorScan {
+ public:
+  // Values are passed to the range functor (see scan()) and compared in blocks of this size
+  static constexpr auto BLOCK_SIZE = size_t{SimdBp128Packing::block_size};
+
+  // Inclusive range of matching values. If `lower > upper`, no value matches.
+  struct ValueRange {
+    uint32_t lower;
+    uint32_t upper;
+
+    bool empty() const { return lower > upper; }
+  };
+
+  static constexpr auto EMPTY_RANGE = ValueRange{1, 0};
+
+  /**
+   * Translates the inclusive range [lower_value, upper_value] of a frame-of-reference segment's values into the range
+   * of the offsets that are stored for a frame with the given minimum.
+   */
+  template <typename T>
+  static ValueRange frame_of_reference_range(const int64_t lower_value, const int64_t upper_value, const T minimum) {
+    const auto lower = std::max(lower_value - static_cast<int64_t>(minimum), int64_t{0});
+    const auto upper = std::min(upper_value - static_cast<int64_t>(minimum),
+                                static_cast<int64_t>(std::numeric_limits<uint32_t>::max()));
+    if (lower > upper) return EMPTY_RANGE;
+
+    return ValueRange{static_cast<uint32_t>(lower), static_cast<uint32_t>(upper)};
+  }
+
+  /**
+   * Appends the RowIDs of all positions in `vector` whose value lies within the range returned by
+   * `range_for_block(first_index)` to `matches`. The functor is called for every block of BLOCK_SIZE values with the
+   * index of the block's first value. If `null_values` are given, positions flagged as NULL never match. This is
+   * needed for frame-of-reference segments, which store the frame's minimum for NULLs. Dictionary segments use a value
+   * ID outside of the searched range for NULLs instead.
+   */
+  template <typename RangeFunctor>
+  static void scan(const BaseCompressedVector& vector, const RangeFunctor& range_for_block, const ChunkID chunk_id,
+                   const std::optional<pmr_vector<bool>>& null_values, RowIDPosList& matches) {
+    resolve_compressed_vector_type(vector, [&](const auto& typed_vector) {
+      using CompressedVectorType = std::decay_t<decltype(typed_vector)>;
+
+      if constexpr (std::is_same_v<CompressedVectorType, SimdBp128Vector>) {
+        _scan_simd_bp128_vector(typed_vector, range_for_block, chunk_id, null_values, matches);
+      } else {
+        const auto& data = typed_vector.data();
+        const auto size = data.size();
+        for (auto block_begin = size_t{0}; block_begin < size; block_begin += BLOCK_SIZE) {
+          const auto range = range_for_block(block_begin);
+          if (range.empty()) continue;
+
+          const auto block_size = std::min(BLOCK_SIZE, size - block_begin);
+          _scan_block(data.data() + block_begin, block_size, range, block_begin, chunk_id, null_values, matches);
+        }
+      }
+    });
+  }
+
+  /**
+   * Appends the RowIDs of all non-NULL rows of a FrameOfReferenceSegment whose value lies within the inclusive range
+   * [lower_value, upper_value] to `matches`. The range is translated into the offsets of each frame.
+   */
+  template <typename FrameOfReferenceSegmentType>
+  static void scan_frame_of_reference_segment(const FrameOfReferenceSegmentType& segment, const int64_t lower_value,
+                                              const int64_t upper_value, const ChunkID chunk_id,
+                                              RowIDPosList& matches) {
+    static_assert(FrameOfReferenceSegmentType::block_size % BLOCK_SIZE == 0,
+                  "Frames have to consist of whole blocks so that each block has a single minimum");
+
+    const auto& block_minima = segment.block_minima();
+    const auto range_for_block = [&](const size_t first_index) {
+      const auto minimum = block_minima[first_index / FrameOfReferenceSegmentType::block_size];
+      return frame_of_reference_range(lower_value, upper_value, minimum);
+    };
+
+    scan(segment.offset_values(), range_for_block, chunk_id, segment.null_values(), matches);
+  }
+
+ private:
+  template <typename RangeFunctor>
+  static void _scan_simd_bp128_vector(const SimdBp128Vector& vector, const RangeFunctor& range_for_block,
+                                      const ChunkID chunk_id, const std::optional<pmr_vector<bool>>& null_values,
+                                      RowIDPosList& matches) {
+    using Packing = SimdBp128Packing;
+
+    const auto* data = vector.data().data();
+    const auto size = vector.size();
+
+    alignas(16) auto bit_sizes = std::array<uint8_t, Packing::blocks_in_meta_block>{};
+    alignas(16) auto unpacked_block = std::array<uint32_t, Packing::block_size>{};
+
+    // Each meta block starts with the bit widths of its (up to) sixteen blocks, followed by the blocks themselves. A
+    // block with a bit width of n occupies n 128-bit words.
+    for (auto meta_block_begin = size_t{0}; meta_block_begin < size; meta_block_begin += Packing::meta_block_size) {
+      Packing::read_meta_info(data, bit_sizes.data());
+      ++data;
+
+      for (auto block_index = size_t{0}; block_index < Packing::blocks_in_meta_block; ++block_index) {
+        const auto block_begin = meta_block_begin + block_index * Packing::block_size;
+        if (block_begin >= size) break;
+
+        const auto block_size = std::min(size_t{Packing::block_size}, size - block_begin);
+        const auto bit_size = bit_sizes[block_index];
+        const auto range = range_for_block(block_begin);
+
+        // Largest value that can be represented with bit_size bits
+        const auto block_max =
+            bit_size >= 32 ? std::numeric_limits<uint32_t>::max() : (uint32_t{1} << bit_size) - uint32_t{1};
+
+        if (range.empty() || range.lower > block_max) {
+          // No value in the block can match
+        } else if (range.lower == 0 && range.upper >= block_max) {
+          // All values in the block match
+          _write_all_matches(block_size, block_begin, chunk_id, null_values, matches);
+        } else {
+          Packing::unpack_block(data, unpacked_block.data(), bit_size);
+          _scan_block(unpacked_block.data(), block_size, range, block_begin, chunk_id, null_values, matches);
+        }
+
+        data += bit_size;
+      }
+    }
+  }
+
+  template <typename UnsignedIntType>
+  static void _scan_block(const UnsignedIntType* values, const size_t block_size, const ValueRange range,
+                          const size_t first_index, const ChunkID chunk_id,
+                          const std::optional<pmr_vector<bool>>& null_values, RowIDPosList& matches) {
+    constexpr auto MASK_SIZE = size_t{64};
+
+    // (x >= a && x <= b) === ((x - a) <= (b - a)) for unsigned integers, see ColumnBetweenTableScanImpl
+    const auto lower = range.lower;
+    const auto width = range.upper - range.lower;
+
+    for (auto mask_begin = size_t{0}; mask_begin < block_size; mask_begin += MASK_SIZE) {
+      const auto mask_values = std::min(MASK_SIZE, block_size - mask_begin);
+      const auto* const mask_values_begin = values + mask_begin;
+
+      auto mask = uint64_t{0};
+
+      // This empty block is used to convince clang-format to keep the pragma indented
+      // NOLINTNEXTLINE
+      {}  // clang-format off
+      #pragma omp simd reduction(|:mask) safelen(MASK_SIZE)
+      // clang-format on
+      for (auto i = size_t{0}; i < mask_values; ++i) {
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(mask_values_begin[i]) - lower <= width) << i;
+      }
+
+      const auto mask_first_index = first_index + mask_begin;
+      while (mask) {
+        const auto chunk_offset = static_cast<ChunkOffset>(mask_first_index + __builtin_ctzll(mask));
+        if (!null_values || !(*null_values)[chunk_offset]) {
+          matches.emplace_back(chunk_id, chunk_offset);
+        }
+        mask &= mask - 1;
+      }
+    }
+  }
+
+  static void _write_all_matches(const size_t block_size, const size_t first_index, const ChunkID chunk_id,
+                                 const std::optional<pmr_vector<bool>>& null_values, RowIDPosList& matches) {
+    for (auto index = first_index; index < first_index + block_size; ++index) {
+      const auto chunk_offset = static_cast<ChunkOffset>(index);
+      if (!null_values || !(*null_values)[chunk_offset]) {
+        matches.emplace_back(chunk_id, chunk_offset);
+      }
+    }
+  }
+};
+
+}  // namespace opossum
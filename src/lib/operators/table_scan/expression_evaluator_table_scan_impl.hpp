@@ -23,10 +23,14 @@ class ExpressionEvaluatorTableScanImpl : public AbstractTableScanImpl {
   std::string description() const override;
   std::shared_ptr<RowIDPosList> scan_chunk(ChunkID chunk_id) override;
 
+  // Shared by the evaluators of all chunks
+  const std::shared_ptr<CorrelatedSubqueryResultsCache>& correlated_subquery_results_cache() const;
+
  private:
   std::shared_ptr<const Table> _in_table;
   std::shared_ptr<const AbstractExpression> _expression;
   const std::shared_ptr<const ExpressionEvaluator::UncorrelatedSubqueryResults> _uncorrelated_subquery_results;
+  const std::shared_ptr<CorrelatedSubqueryResultsCache> _correlated_subquery_results_cache;
 };
 
 }  // namespace opossum
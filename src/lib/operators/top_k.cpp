@@ -0,0 +1,327 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "operators/sort/sort_output_writing.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+#include "utils/assert.hpp"
+#include "utils/timer.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Materialized values of a single sort column. Rows are identified by their index in the materialized vectors.
+class BaseSortColumnValues {
+ public:
+  virtual ~BaseSortColumnValues() = default;
+
+  virtual void materialize(const AbstractSegment& segment) = 0;
+
+  // Appends the values at the given indices of `source`, which has to be of the same type.
+  virtual void append(const BaseSortColumnValues& source, const std::vector<ChunkOffset>& indices) = 0;
+
+  // Returns a negative value if the row at lhs_index comes first, a positive value if the row at rhs_index comes first,
+  // and zero if both share the same value. NULLs come first, independent of the sort mode (see Sort).
+  virtual int compare(const size_t lhs_index, const size_t rhs_index) const = 0;
+};
+
+template <typename ColumnDataType>
+class SortColumnValues : public BaseSortColumnValues {
+ public:
+  explicit SortColumnValues(const SortMode sort_mode) : _ascending(sort_mode == SortMode::Ascending) {}
+
+  void materialize(const AbstractSegment& segment) final {
+    _values.reserve(_values.size() + segment.size());
+    _nulls.reserve(_nulls.size() + segment.size());
+
+    segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+      const auto is_null = position.is_null();
+      _values.emplace_back(is_null ? ColumnDataType{} : position.value());
+      _nulls.emplace_back(is_null);
+    });
+  }
+
+  void append(const BaseSortColumnValues& source, const std::vector<ChunkOffset>& indices) final {
+    const auto& typed_source = static_cast<const SortColumnValues<ColumnDataType>&>(source);
+    for (const auto index : indices) {
+      _values.emplace_back(typed_source._values[index]);
+      _nulls.emplace_back(typed_source._nulls[index]);
+    }
+  }
+
+  int compare(const size_t lhs_index, const size_t rhs_index) const final {
+    const auto lhs_is_null = _nulls[lhs_index];
+    const auto rhs_is_null = _nulls[rhs_index];
+    if (lhs_is_null || rhs_is_null) return static_cast<int>(rhs_is_null) - static_cast<int>(lhs_is_null);
+
+    const auto& lhs_value = _values[lhs_index];
+    const auto& rhs_value = _values[rhs_index];
+    if (lhs_value == rhs_value) return 0;
+    return (lhs_value < rhs_value) == _ascending ? -1 : 1;
+  }
+
+ private:
+  const bool _ascending;
+  std::vector<ColumnDataType> _values;
+  std::vector<bool> _nulls;
+};
+
+// The candidate rows of one chunk (or, after merging, of the entire table) together with their sort column values.
+struct Candidates {
+  RowIDPosList row_ids;
+  std::vector<std::unique_ptr<BaseSortColumnValues>> columns;
+
+  // Lexicographical comparison over all sort columns. Ties are broken by the position, so that the result is the same
+  // as that of a stable sort.
+  bool row_less(const size_t lhs_index, const size_t rhs_index) const {
+    for (const auto& column : columns) {
+      const auto comparison = column->compare(lhs_index, rhs_index);
+      if (comparison != 0) return comparison < 0;
+    }
+    return lhs_index < rhs_index;
+  }
+};
+
+Candidates create_candidates(const std::shared_ptr<const Table>& table,
+                             const std::vector<SortColumnDefinition>& sort_definitions) {
+  auto candidates = Candidates{};
+  candidates.columns.reserve(sort_definitions.size());
+  for (const auto& sort_definition : sort_definitions) {
+    resolve_data_type(table->column_data_type(sort_definition.column), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      candidates.columns.emplace_back(std::make_unique<SortColumnValues<ColumnDataType>>(sort_definition.sort_mode));
+    });
+  }
+  return candidates;
+}
+
+// Determines the best `row_count` rows of a chunk using a bounded max-heap, i.e., the heap's top is the worst row that
+// is currently part of the result.
+Candidates chunk_top_k(const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
+                       const std::vector<SortColumnDefinition>& sort_definitions, const size_t row_count) {
+  const auto& chunk = table->get_chunk(chunk_id);
+  Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+  auto materialized_chunk = create_candidates(table, sort_definitions);
+  const auto sort_column_count = sort_definitions.size();
+  for (auto sort_column_index = size_t{0}; sort_column_index < sort_column_count; ++sort_column_index) {
+    const auto& segment = chunk->get_segment(sort_definitions[sort_column_index].column);
+    materialized_chunk.columns[sort_column_index]->materialize(*segment);
+  }
+
+  const auto row_less = [&](const ChunkOffset lhs, const ChunkOffset rhs) {
+    return materialized_chunk.row_less(lhs, rhs);
+  };
+
+  const auto chunk_size = chunk->size();
+  const auto heap_size = std::min(row_count, static_cast<size_t>(chunk_size));
+  auto heap = std::vector<ChunkOffset>{};
+  heap.reserve(heap_size);
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    if (heap.size() < heap_size) {
+      heap.emplace_back(chunk_offset);
+      std::push_heap(heap.begin(), heap.end(), row_less);
+    } else if (row_less(chunk_offset, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), row_less);
+      heap.back() = chunk_offset;
+      std::push_heap(heap.begin(), heap.end(), row_less);
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end(), row_less);
+
+  auto candidates = create_candidates(table, sort_definitions);
+  candidates.row_ids.reserve(heap.size());
+  for (const auto chunk_offset : heap) {
+    candidates.row_ids.emplace_back(chunk_id, chunk_offset);
+  }
+  for (auto sort_column_index = size_t{0}; sort_column_index < sort_column_count; ++sort_column_index) {
+    candidates.columns[sort_column_index]->append(*materialized_chunk.columns[sort_column_index], heap);
+  }
+
+  return candidates;
+}
+
+}  // namespace
+
+namespace opossum {
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const std::shared_ptr<AbstractExpression>& row_count_expression, const ChunkOffset output_chunk_size)
+    : AbstractReadOnlyOperator(OperatorType::TopK, in, nullptr,
+                               std::make_unique<OperatorPerformanceData<OperatorSteps>>()),
+      _sort_definitions(sort_definitions),
+      _row_count_expression(row_count_expression),
+      _output_chunk_size(output_chunk_size) {
+  DebugAssert(!_sort_definitions.empty(), "Expected at least one sort criterion");
+}
+
+const std::string& TopK::name() const {
+  static const auto name = std::string{"TopK"};
+  return name;
+}
+
+std::string TopK::description(DescriptionMode description_mode) const {
+  const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << AbstractOperator::description(description_mode) << separator << "k: "
+         << _row_count_expression->as_column_name() << separator << "[";
+  for (auto sort_definition_index = size_t{0}; sort_definition_index < _sort_definitions.size();
+       ++sort_definition_index) {
+    const auto& sort_definition = _sort_definitions[sort_definition_index];
+    if (sort_definition_index > 0) stream << ", ";
+    stream << "Column #" << sort_definition.column << " " << sort_definition.sort_mode;
+  }
+  stream << "]";
+  return stream.str();
+}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<AbstractExpression> TopK::row_count_expression() const { return _row_count_expression; }
+
+std::shared_ptr<AbstractOperator> TopK::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_left_input,
+    const std::shared_ptr<AbstractOperator>& copied_right_input,
+    std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  return std::make_shared<TopK>(copied_left_input, _sort_definitions, _row_count_expression->deep_copy(copied_ops),
+                                _output_chunk_size);
+}
+
+void TopK::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expression_set_parameters(_row_count_expression, parameters);
+}
+
+void TopK::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  expression_set_transaction_context(_row_count_expression, transaction_context);
+}
+
+size_t TopK::_evaluate_row_count() const {
+  auto row_count = size_t{};
+
+  resolve_data_type(_row_count_expression->data_type(), [&](const auto data_type_t) {
+    using LimitDataType = typename decltype(data_type_t)::type;
+
+    if constexpr (std::is_integral_v<LimitDataType>) {
+      const auto row_count_expression_result =
+          ExpressionEvaluator{}.evaluate_expression_to_result<LimitDataType>(*_row_count_expression);
+      Assert(row_count_expression_result->size() == 1, "Expected exactly one row for TopK");
+      Assert(!row_count_expression_result->is_null(0), "Expected non-null for TopK");
+
+      const auto signed_row_count = row_count_expression_result->value(0);
+      Assert(signed_row_count >= 0, "Can't TopK to a negative number of Rows");
+
+      row_count = static_cast<size_t>(signed_row_count);
+    } else {
+      Fail("Non-integral types not allowed in TopK");
+    }
+  });
+
+  return row_count;
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto& input_table = left_input_table();
+
+  for (const auto& sort_definition : _sort_definitions) {
+    Assert(sort_definition.column != INVALID_COLUMN_ID, "TopK: Invalid column in sort definition");
+    Assert(sort_definition.column < input_table->column_count(),
+           "TopK: Column ID is greater than table's column count");
+  }
+
+  const auto row_count = _evaluate_row_count();
+  if (row_count == 0 || input_table->row_count() == 0) {
+    return std::make_shared<Table>(input_table->column_definitions(), TableType::References);
+  }
+
+  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
+  Timer timer;
+
+  // 1. Determine the best rows of each chunk in parallel.
+  const auto chunk_count = input_table->chunk_count();
+  auto candidates_per_chunk = std::vector<Candidates>(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto perform_chunk_top_k = [&, chunk_id]() {
+      candidates_per_chunk[chunk_id] = chunk_top_k(input_table, chunk_id, _sort_definitions, row_count);
+    };
+
+    // Similar to the TableScan, small chunks are not worth the scheduling overhead.
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+    if (input_table->get_chunk(chunk_id)->size() >= JOB_SPAWN_THRESHOLD) {
+      jobs.emplace_back(std::make_shared<JobTask>(perform_chunk_top_k));
+    } else {
+      perform_chunk_top_k();
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+  step_performance_data.set_step_runtime(OperatorSteps::ChunkCandidates, timer.lap());
+
+  // 2. Merge the candidates. As they are appended in the order of their chunks, comparing the positions within the
+  //    merged candidates is the same as comparing the RowIDs.
+  auto merged_candidates = create_candidates(input_table, _sort_definitions);
+  const auto sort_column_count = _sort_definitions.size();
+  for (const auto& chunk_candidates : candidates_per_chunk) {
+    const auto candidate_count = chunk_candidates.row_ids.size();
+    if (candidate_count == 0) continue;
+
+    auto indices = std::vector<ChunkOffset>(candidate_count);
+    std::iota(indices.begin(), indices.end(), ChunkOffset{0});
+    for (auto sort_column_index = size_t{0}; sort_column_index < sort_column_count; ++sort_column_index) {
+      merged_candidates.columns[sort_column_index]->append(*chunk_candidates.columns[sort_column_index], indices);
+    }
+    merged_candidates.row_ids.insert(merged_candidates.row_ids.end(), chunk_candidates.row_ids.begin(),
+                                     chunk_candidates.row_ids.end());
+  }
+  candidates_per_chunk.clear();
+
+  const auto merged_candidate_count = merged_candidates.row_ids.size();
+  const auto output_row_count = std::min(row_count, merged_candidate_count);
+  auto merged_indices = std::vector<size_t>(merged_candidate_count);
+  std::iota(merged_indices.begin(), merged_indices.end(), size_t{0});
+  std::partial_sort(merged_indices.begin(), merged_indices.begin() + output_row_count, merged_indices.end(),
+                    [&](const size_t lhs, const size_t rhs) { return merged_candidates.row_less(lhs, rhs); });
+
+  auto pos_list = RowIDPosList{};
+  pos_list.reserve(output_row_count);
+  for (auto output_row = size_t{0}; output_row < output_row_count; ++output_row) {
+    pos_list.emplace_back(merged_candidates.row_ids[merged_indices[output_row]]);
+  }
+  step_performance_data.set_step_runtime(OperatorSteps::MergeCandidates, timer.lap());
+
+  // 3. Write the output in the same way as the Sort operator does.
+  auto output_table = std::shared_ptr<Table>{};
+  if (sort_output_requires_materialization(input_table)) {
+    output_table = write_materialized_output_table(input_table, std::move(pos_list), _output_chunk_size);
+  } else {
+    output_table = write_reference_output_table(input_table, std::move(pos_list), _output_chunk_size);
+  }
+
+  const auto output_chunk_count = output_table->chunk_count();
+  for (auto output_chunk_id = ChunkID{0}; output_chunk_id < output_chunk_count; ++output_chunk_id) {
+    const auto& output_chunk = output_table->get_chunk(output_chunk_id);
+    output_chunk->finalize();
+    output_chunk->set_individually_sorted_by(_sort_definitions[0]);
+  }
+  step_performance_data.set_step_runtime(OperatorSteps::WriteOutput, timer.lap());
+
+  return output_table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Operator that returns the first n rows of its input according to the sort definitions. It is equivalent to a Sort
+ * followed by a Limit, but instead of sorting the entire input, the rows of each chunk are pushed through a bounded
+ * heap that keeps only the best n rows of that chunk. The chunks are processed in parallel by the scheduler. In a
+ * second step, the per-chunk candidates are merged. Thus, only O(n * chunk count) rows need to be kept instead of the
+ * entire materialized sort columns.
+ *
+ * The output is the same as for Sort and Limit: NULLs come first and rows that share the same values keep their
+ * relative order from the input.
+ */
+class TopK : public AbstractReadOnlyOperator {
+ public:
+  enum class OperatorSteps : uint8_t { ChunkCandidates, MergeCandidates, WriteOutput };
+
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const std::shared_ptr<AbstractExpression>& row_count_expression,
+       const ChunkOffset output_chunk_size = Chunk::DEFAULT_SIZE);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  std::shared_ptr<AbstractExpression> row_count_expression() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_left_input,
+      const std::shared_ptr<AbstractOperator>& copied_right_input,
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+  size_t _evaluate_row_count() const;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  std::shared_ptr<AbstractExpression> _row_count_expression;
+  const ChunkOffset _output_chunk_size;
+};
+
+}  // namespace opossum
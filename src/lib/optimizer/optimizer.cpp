@@ -104,6 +104,8 @@ std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
 
 Optimizer::Optimizer(const std::shared_ptr<AbstractCostEstimator>& cost_estimator) : _cost_estimator(cost_estimator) {}
 
+const std::shared_ptr<AbstractCostEstimator>& Optimizer::cost_estimator() const { return _cost_estimator; }
+
 void Optimizer::add_rule(std::unique_ptr<AbstractRule> rule) {
   rule->cost_estimator = _cost_estimator;
   _rules.emplace_back(std::move(rule));
@@ -47,6 +47,10 @@ class Optimizer final {
 
   static void validate_lqp(const std::shared_ptr<AbstractLQPNode>& root_node);
 
+  // The cost estimator that the rules use. The LQPTranslator uses the same kind of cardinality estimator to choose
+  // between operator implementations.
+  const std::shared_ptr<AbstractCostEstimator>& cost_estimator() const;
+
  private:
   std::vector<std::unique_ptr<AbstractRule>> _rules;
   std::shared_ptr<AbstractCostEstimator> _cost_estimator;
@@ -9,6 +9,10 @@
 #include "all_parameter_variant.hpp"
 #include "constant_mappings.hpp"
 #include "cost_estimation/abstract_cost_estimator.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "expression/value_expression.hpp"
+#include "hyrise.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
 #include "logical_query_plan/predicate_node.hpp"
@@ -40,6 +44,11 @@ void IndexScanRule::_apply_to_plan_without_subqueries(const std::shared_ptr<Abst
         const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
         const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(child);
 
+        if (_is_table_index_scan_applicable(predicate_node)) {
+          predicate_node->scan_type = ScanType::TableIndexScan;
+          return LQPVisitation::VisitInputs;
+        }
+
         const auto indexes_statistics = stored_table_node->indexes_statistics();
         for (const auto& index_statistics : indexes_statistics) {
           if (_is_index_scan_applicable(index_statistics, predicate_node)) {
@@ -81,6 +90,33 @@ bool IndexScanRule::_is_index_scan_applicable(const IndexStatistics& index_stati
   return selectivity <= INDEX_SCAN_SELECTIVITY_THRESHOLD;
 }
 
+bool IndexScanRule::_is_table_index_scan_applicable(const std::shared_ptr<PredicateNode>& predicate_node) const {
+  const auto predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate());
+  if (!predicate || predicate->predicate_condition != PredicateCondition::Equals) return false;
+
+  auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->left_operand());
+  auto value_expression = std::dynamic_pointer_cast<ValueExpression>(predicate->right_operand());
+  if (!column_expression || !value_expression) {
+    column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->right_operand());
+    value_expression = std::dynamic_pointer_cast<ValueExpression>(predicate->left_operand());
+  }
+  if (!column_expression || !value_expression || variant_is_null(value_expression->value)) return false;
+
+  const auto stored_table_node = std::static_pointer_cast<StoredTableNode>(predicate_node->left_input());
+  if (column_expression->original_node.lock() != stored_table_node) return false;
+
+  const auto table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  if (!table->table_index(column_expression->original_column_id)) return false;
+
+  // Unlike for chunk indexes, there is no minimum row count, as a lookup does not depend on the number of chunks
+  const auto row_count_table =
+      cost_estimator->cardinality_estimator->estimate_cardinality(predicate_node->left_input());
+  if (row_count_table == 0) return true;
+
+  const auto row_count_predicate = cost_estimator->cardinality_estimator->estimate_cardinality(predicate_node);
+  return row_count_predicate / row_count_table <= INDEX_SCAN_SELECTIVITY_THRESHOLD;
+}
+
 bool IndexScanRule::_is_single_segment_index(const IndexStatistics& index_statistics) {
   return index_statistics.column_ids.size() == 1;
 }
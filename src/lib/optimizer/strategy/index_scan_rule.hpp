@@ -23,6 +23,10 @@ class PredicateNode;
  * not supported. We also assume that if chunks have an index, all of them are of the same type, we do not mix GroupKey
  * and ART indexes. In addition, chains of IndexScans are not possible since an IndexScan's input must be a GetTable.
  * Currently, only GroupKeyIndexes are supported.
+ *
+ * Table indexes (see TableHashIndex) span all chunks, so that a lookup does not depend on the number of chunks or
+ * rows. For selective equality predicates on a column with a table index, the ScanType is set to TableIndexScan,
+ * which takes precedence over chunk indexes.
  */
 
 class IndexScanRule : public AbstractRule {
@@ -30,6 +34,7 @@ class IndexScanRule : public AbstractRule {
   void _apply_to_plan_without_subqueries(const std::shared_ptr<AbstractLQPNode>& lqp_root) const override;
   bool _is_index_scan_applicable(const IndexStatistics& index_statistics,
                                  const std::shared_ptr<PredicateNode>& predicate_node) const;
+  bool _is_table_index_scan_applicable(const std::shared_ptr<PredicateNode>& predicate_node) const;
   static bool _is_single_segment_index(const IndexStatistics& index_statistics);
 };
 
@@ -20,11 +20,14 @@ class ImmediateExecutionScheduler : public AbstractScheduler {
 
   const std::vector<std::shared_ptr<TaskQueue>>& queues() const override;
 
+  const std::vector<std::shared_ptr<Worker>>& workers() const override;
+
   void schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id = CURRENT_NODE_ID,
                 SchedulePriority priority = SchedulePriority::Default) override;
 
  private:
   std::vector<std::shared_ptr<TaskQueue>> _queues = std::vector<std::shared_ptr<TaskQueue>>{};
+  std::vector<std::shared_ptr<Worker>> _workers = std::vector<std::shared_ptr<Worker>>{};
 };
 
 }  // namespace opossum
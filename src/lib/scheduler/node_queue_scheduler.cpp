@@ -75,6 +75,11 @@ void NodeQueueScheduler::finish() {
 
   _active = false;
 
+  // Wake up all parked workers so that they notice the shutdown.
+  for (auto& queue : _queues) {
+    queue->unpark_all_workers();
+  }
+
   for (auto& worker : _workers) {
     worker->join();
   }
@@ -88,6 +93,8 @@ bool NodeQueueScheduler::active() const { return _active; }
 
 const std::vector<std::shared_ptr<TaskQueue>>& NodeQueueScheduler::queues() const { return _queues; }
 
+const std::vector<std::shared_ptr<Worker>>& NodeQueueScheduler::workers() const { return _workers; }
+
 void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id,
                                   SchedulePriority priority) {
   /**
@@ -101,9 +108,17 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
 
   if (!task->is_ready()) return;
 
+  const auto worker = Worker::get_this_thread_worker();
+
+  // Tasks spawned from within a worker go into that worker's deque, from which they can be stolen by other workers.
+  if (worker && preferred_node_id == CURRENT_NODE_ID && priority == SchedulePriority::Default &&
+      task->is_stealable()) {
+    worker->push_local_task(task);
+    return;
+  }
+
   // Lookup node id for current worker.
   if (preferred_node_id == CURRENT_NODE_ID) {
-    auto worker = Worker::get_this_thread_worker();
     if (worker) {
       preferred_node_id = worker->queue()->node_id();
     } else {
@@ -115,8 +130,15 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
   DebugAssert(!(static_cast<size_t>(preferred_node_id) >= _queues.size()),
               "preferred_node_id is not within range of available nodes");
 
-  auto queue = _queues[preferred_node_id];
+  const auto& queue = _queues[preferred_node_id];
   queue->push(task, static_cast<uint32_t>(priority));
+
+  if (queue->unpark_worker() || !task->is_stealable()) return;
+
+  // All workers of the preferred node are busy. Wake up a worker of a remote node, which can then steal the task.
+  for (const auto& other_queue : _queues) {
+    if (other_queue != queue && other_queue->unpark_worker()) return;
+  }
 }
 
 void NodeQueueScheduler::_group_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) const {
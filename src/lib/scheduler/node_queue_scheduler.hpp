@@ -56,18 +56,18 @@ namespace opossum {
  *
  * WORK STEALING
  *
- * Currently, a simple work stealing is implemented. Work stealing is useful to avoid idle workers (and therefore
- * idle CPUs) while there are still tasks in the system that need to be processed. A worker gets idle if it can not
- * pull a ready task. This occurs in two cases:
- *  1) all tasks in the queue are not ready
- *  2) the queue is empty
- * In both cases the current worker is checking another queue for a ready task. Checking another queue means accessing
- * another node (remote node). As of the physical distance of nodes, accessing a remote nodes is ~1.6 times slower than
- * accessing a local node. [1]
- * Therefore, the current worker fetches a task from a remote queue (without removing it). Then, the current worker
- * is sleeping some milliseconds to give any local worker of the remote node the chance to pull that task. If no local
- * worker of the remote node pulled the task, the current worker is pulling the task and therefore steals it.
- * Afterwards, the current worker is checking its local queue gain.
+ * Besides the TaskQueue of its node, each Worker owns a lock-free work-stealing deque (see WorkStealingDeque). Tasks
+ * that are spawned by a running task (e.g., the JobTasks of a parallelized operator) are pushed to the deque of the
+ * spawning worker. The owner pops from its deque in LIFO order, which keeps the working set small and the caches warm.
+ * A worker that finds neither a task in its own deque nor in its node's TaskQueue becomes a thief: It first steals
+ * (in FIFO order) from the deques of the other workers on the same node and only then from remote nodes. Accessing a
+ * remote node is ~1.6 times slower than accessing a local node. [1]
+ *
+ * High priority tasks are only pushed into the TaskQueues and always take precedence over the worker's own deque.
+ * Non-stealable tasks are never pushed into a deque, so that they cannot be executed by workers of other nodes.
+ *
+ * If no task can be found anywhere, the worker parks on its node's TaskQueue. It is woken up as soon as a new task is
+ * pushed (first workers of the same node, then workers of remote nodes). There is no fixed sleep time.
  *
  * [1] http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
  */
@@ -96,10 +96,15 @@ class NodeQueueScheduler : public AbstractScheduler {
 
   const std::vector<std::shared_ptr<TaskQueue>>& queues() const override;
 
+  const std::vector<std::shared_ptr<Worker>>& workers() const override;
+
   /**
    * @param task
    * @param preferred_node_id The Task will be initially added to this node, but might get stolen by other Nodes later
    * @param priority Determines whether tasks are inserted at the beginning or end of the queue.
+   *
+   * Default priority tasks that are scheduled from within a worker (e.g., JobTasks spawned by an operator) are pushed
+   * into that worker's deque instead of the node's TaskQueue. All other tasks go to the preferred node's TaskQueue.
    */
   void schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id = CURRENT_NODE_ID,
                 SchedulePriority priority = SchedulePriority::Default) override;
@@ -1,11 +1,14 @@
 #include "operator_task.hpp"
 
 #include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "operators/abstract_operator.hpp"
 #include "operators/abstract_read_write_operator.hpp"
+#include "operators/runtime_join_filter.hpp"
+#include "operators/table_scan.hpp"
 
 #include "scheduler/job_task.hpp"
 #include "utils/tracing/probes.hpp"
@@ -23,6 +26,7 @@ std::vector<std::shared_ptr<AbstractTask>> OperatorTask::make_tasks_from_operato
   std::vector<std::shared_ptr<AbstractTask>> tasks;
   std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractTask>> task_by_op;
   _add_tasks_from_operator(op, tasks, task_by_op);
+  _add_runtime_join_filter_dependencies(task_by_op);
   return tasks;
 }
 
@@ -52,6 +56,46 @@ std::shared_ptr<AbstractTask> OperatorTask::_add_tasks_from_operator(
   return task;
 }
 
+void OperatorTask::_add_runtime_join_filter_dependencies(
+    const std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractTask>>& task_by_op) {
+  // Returns true if `task` is a direct or indirect predecessor of `successor`.
+  const auto is_transitive_predecessor = [](const std::shared_ptr<AbstractTask>& task,
+                                            const std::shared_ptr<AbstractTask>& successor) {
+    auto visited_tasks = std::unordered_set<std::shared_ptr<AbstractTask>>{};
+    auto pending_tasks = std::vector<std::shared_ptr<AbstractTask>>{successor};
+    while (!pending_tasks.empty()) {
+      const auto current_task = pending_tasks.back();
+      pending_tasks.pop_back();
+      if (current_task == task) return true;
+      if (!visited_tasks.emplace(current_task).second) continue;
+
+      for (const auto& predecessor : current_task->predecessors()) {
+        pending_tasks.emplace_back(predecessor.lock());
+      }
+    }
+    return false;
+  };
+
+  for (const auto& [op, task] : task_by_op) {
+    const auto table_scan = std::dynamic_pointer_cast<TableScan>(op);
+    if (!table_scan || !table_scan->runtime_join_filter()) continue;
+
+    // The build input is part of the plan as it is an input of the join that the scan feeds.
+    const auto& runtime_join_filter = table_scan->runtime_join_filter();
+    const auto build_input = std::const_pointer_cast<AbstractOperator>(runtime_join_filter->build_input());
+    const auto build_task_iter = task_by_op.find(build_input);
+    if (build_task_iter == task_by_op.end()) continue;
+
+    // Waiting for the build input must not introduce a cycle, which could happen if the scan is (part of) the build
+    // input's subplan. In that case, the scan executes without the filter. If the scan already (indirectly) depends on
+    // the build input, no additional edge is needed.
+    const auto& build_task = build_task_iter->second;
+    if (is_transitive_predecessor(task, build_task) || is_transitive_predecessor(build_task, task)) continue;
+
+    build_task->set_as_predecessor_of(task);
+  }
+}
+
 const std::shared_ptr<AbstractOperator>& OperatorTask::get_operator() const { return _op; }
 
 void OperatorTask::_on_execute() {
@@ -40,6 +40,13 @@ class OperatorTask : public AbstractTask {
       const std::shared_ptr<AbstractOperator>& op, std::vector<std::shared_ptr<AbstractTask>>& tasks,
       std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractTask>>& task_by_op);
 
+  /**
+   * TableScans with a RuntimeJoinFilter have to wait for the filter's build input. Called by
+   * `make_tasks_from_operator` once all tasks have been created.
+   */
+  static void _add_runtime_join_filter_dependencies(
+      const std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractTask>>& task_by_op);
+
  private:
   std::shared_ptr<AbstractOperator> _op;
 };
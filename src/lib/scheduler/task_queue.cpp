@@ -1,5 +1,7 @@
 #include "task_queue.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <utility>
 
@@ -10,12 +12,9 @@ namespace opossum {
 
 TaskQueue::TaskQueue(NodeID node_id) : _node_id(node_id) {}
 
-bool TaskQueue::empty() const {
-  for (const auto& queue : _queues) {
-    if (!queue.empty()) return false;
-  }
-  return true;
-}
+bool TaskQueue::empty() const { return _task_count == 0; }
+
+bool TaskQueue::has_stealable_tasks() const { return _stealable_task_count > 0; }
 
 NodeID TaskQueue::node_id() const { return _node_id; }
 
@@ -26,33 +25,131 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask>& task, uint32_t priorit
   if (!task->try_mark_as_enqueued()) return;
 
   task->set_node_id(_node_id);
-  _queues[priority].push(task);
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutexes[priority]);
+    _queues[priority].push_back(task);
+  }
+  ++_task_count;
+  if (task->is_stealable()) ++_stealable_task_count;
 
-  new_task.notify_one();
+  // The push has to be visible before the pushing thread checks for parked workers, see park_worker(). Waking up a
+  // worker is left to the caller, which knows whether workers of other nodes may take over the task.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
 std::shared_ptr<AbstractTask> TaskQueue::pull() {
-  std::shared_ptr<AbstractTask> task;
-  for (auto& queue : _queues) {
-    if (queue.try_pop(task)) {
-      return task;
-    }
+  for (auto priority = uint32_t{0}; priority < NUM_PRIORITY_LEVELS; ++priority) {
+    if (auto task = _pull(priority)) return task;
   }
   return nullptr;
 }
 
+std::shared_ptr<AbstractTask> TaskQueue::pull(SchedulePriority priority) {
+  return _pull(static_cast<uint32_t>(priority));
+}
+
 std::shared_ptr<AbstractTask> TaskQueue::steal() {
-  std::shared_ptr<AbstractTask> task;
-  for (auto& queue : _queues) {
-    if (queue.try_pop(task)) {
-      if (task->is_stealable()) {
-        return task;
-      } else {
-        queue.push(task);
-      }
-    }
+  if (_stealable_task_count == 0) return nullptr;
+
+  for (auto priority = uint32_t{0}; priority < NUM_PRIORITY_LEVELS; ++priority) {
+    auto& queue = _queues[priority];
+    std::lock_guard<std::mutex> lock(_queue_mutexes[priority]);
+
+    // Thieves take the most recently pushed stealable task from the back, so that they do not contend with the
+    // node's own workers, which pull from the front. Removing it in place keeps the order of the remaining tasks.
+    const auto iter = std::find_if(queue.rbegin(), queue.rend(), [](const auto& task) { return task->is_stealable(); });
+    if (iter == queue.rend()) continue;
+
+    auto task = std::move(*iter);
+    queue.erase(std::next(iter).base());
+    --_task_count;
+    --_stealable_task_count;
+    return task;
   }
   return nullptr;
 }
 
+std::shared_ptr<AbstractTask> TaskQueue::_pull(uint32_t priority) {
+  auto task = std::shared_ptr<AbstractTask>{};
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutexes[priority]);
+    auto& queue = _queues[priority];
+    if (queue.empty()) return nullptr;
+
+    task = std::move(queue.front());
+    queue.pop_front();
+  }
+  --_task_count;
+  if (task->is_stealable()) --_stealable_task_count;
+  return task;
+}
+
+void TaskQueue::park_worker(const std::function<bool()>& has_work, bool is_joining) {
+  auto& parked_counter = is_joining ? _parked_joining_worker_count : _parked_worker_count;
+
+  // Registering happens under the lock that _signal() holds while notifying. Thus, every worker that is waiting when
+  // a notification is sent is included in the counters, which is what allows notify_task_done() to use notify_one.
+  auto observed_epoch = uint64_t{0};
+  {
+    std::lock_guard<std::mutex> lock(_parking_mutex);
+    observed_epoch = _wake_up_epoch;
+    ++parked_counter;
+  }
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  // Re-check after registering. If a task was pushed before we registered, we find it here. If it is pushed
+  // afterwards, the pushing thread sees our registration and signals us.
+  if (!has_work()) {
+    std::unique_lock<std::mutex> lock(_parking_mutex);
+    auto& condition_variable = is_joining ? _task_done : _wake_up;
+    condition_variable.wait(lock, [&]() { return _wake_up_epoch != observed_epoch; });
+  }
+
+  --parked_counter;
+}
+
+bool TaskQueue::unpark_worker() {
+  if (_parked_worker_count > 0) {
+    _signal(_wake_up, false);
+    return true;
+  }
+
+  // Joining workers execute other tasks while waiting, so they can take over the task as well.
+  if (_parked_joining_worker_count > 0) {
+    _signal(_task_done, false);
+    return true;
+  }
+
+  return false;
+}
+
+void TaskQueue::unpark_all_workers() {
+  _signal(_wake_up, true);
+  _signal(_task_done, true);
+}
+
+void TaskQueue::notify_task_done() {
+  const auto parked_joining_worker_count = _parked_joining_worker_count.load();
+  if (parked_joining_worker_count == 0) return;
+
+  // Joining workers wait for different tasks. We do not know whose task finished, so we have to wake up all of them
+  // unless there is only one.
+  _signal(_task_done, parked_joining_worker_count > 1);
+}
+
+size_t TaskQueue::parked_worker_count() const { return _parked_worker_count + _parked_joining_worker_count; }
+
+void TaskQueue::_signal(std::condition_variable& condition_variable, bool notify_all) {
+  // Notify while holding the lock, so that no worker can start waiting between the epoch change and the notification
+  // without being counted (see park_worker()).
+  std::lock_guard<std::mutex> lock(_parking_mutex);
+  ++_wake_up_epoch;
+
+  if (notify_all) {
+    condition_variable.notify_all();
+  } else {
+    condition_variable.notify_one();
+  }
+}
+
 }  // namespace opossum
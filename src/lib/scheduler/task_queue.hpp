@@ -1,11 +1,13 @@
 #pragma once
 
 #include <stdint.h>
-#include <tbb/concurrent_queue.h>
 #include <array>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "types.hpp"
 
@@ -14,7 +16,9 @@ namespace opossum {
 class AbstractTask;
 
 /**
- * Holds a queue of AbstractTasks, usually one of these exists per node
+ * Holds a queue of AbstractTasks, usually one of these exists per node. Tasks spawned by workers are usually not
+ * pushed here, but into the spawning worker's WorkStealingDeque (see Worker). The TaskQueue also serves as the place
+ * where idle workers of the node park until new work arrives.
  */
 class TaskQueue {
  public:
@@ -24,6 +28,11 @@ class TaskQueue {
 
   bool empty() const;
 
+  /**
+   * Returns true if the queue holds tasks that workers of other nodes may steal. Approximation only, like empty().
+   */
+  bool has_stealable_tasks() const;
+
   NodeID node_id() const;
 
   void push(const std::shared_ptr<AbstractTask>& task, uint32_t priority);
@@ -34,23 +43,64 @@ class TaskQueue {
   std::shared_ptr<AbstractTask> pull();
 
   /**
-   * Returns a Tasks that is ready to be executed and removes it from one of the stealable queues
+   * Returns the most recently pushed stealable Task and removes it from the queue. Thieves take tasks from the back
+   * while pull() takes them from the front. Non-stealable tasks are skipped and keep their position.
    */
   std::shared_ptr<AbstractTask> steal();
 
   /**
-   * Notifies one worker as soon as a new task gets pushed into the queue
+   * Returns a Task of the given priority that is ready to be executed and removes it from the queue
+   */
+  std::shared_ptr<AbstractTask> pull(SchedulePriority priority);
+
+  /**
+   * Blocks the calling worker until it is woken up by unpark_worker() or unpark_all_workers(). Instead of sleeping for
+   * a fixed time, the worker registers itself as parked and then checks `has_work` once more before going to sleep.
+   * Together with the sequentially consistent check of the parked worker count in unpark_worker(), this guarantees
+   * that no wake-up is lost: Either the worker sees the newly pushed task or the pushing thread sees the parked worker.
+   * Joining workers (i.e., workers that wait for the completion of tasks they depend on) wait on a separate condition
+   * variable and are additionally woken up by notify_task_done().
+   */
+  void park_worker(const std::function<bool()>& has_work, bool is_joining);
+
+  /**
+   * Wakes up one parked worker. Returns false if no worker was parked on this node.
    */
-  std::condition_variable new_task;
+  bool unpark_worker();
 
   /**
-   * Mutex accessed by workers in order to notify them using condition variable
+   * Wakes up all parked workers, e.g., when the scheduler is shut down.
    */
-  std::mutex lock;
+  void unpark_all_workers();
+
+  /**
+   * Wakes up workers that are waiting for the completion of a task.
+   */
+  void notify_task_done();
+
+  size_t parked_worker_count() const;
 
  private:
+  std::shared_ptr<AbstractTask> _pull(uint32_t priority);
+  void _signal(std::condition_variable& condition_variable, bool notify_all);
+
   NodeID _node_id;
-  std::array<tbb::concurrent_queue<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
+  std::array<std::deque<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
+  std::array<std::mutex, NUM_PRIORITY_LEVELS> _queue_mutexes;
+
+  // Number of (stealable) tasks in _queues. Maintained on push/pull so that idle workers can check for work without
+  // taking the queue locks.
+  std::atomic<size_t> _task_count{0};
+  std::atomic<size_t> _stealable_task_count{0};
+
+  std::atomic<uint32_t> _parked_worker_count{0};
+  std::atomic<uint32_t> _parked_joining_worker_count{0};
+
+  // Incremented (under _parking_mutex) whenever parked workers are signaled. Used to detect spurious wake-ups.
+  uint64_t _wake_up_epoch{0};
+  std::mutex _parking_mutex;
+  std::condition_variable _wake_up;
+  std::condition_variable _task_done;
 };
 
 }  // namespace opossum
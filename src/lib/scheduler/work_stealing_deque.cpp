@@ -0,0 +1,122 @@
+#include "work_stealing_deque.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "abstract_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+WorkStealingDeque::RingBuffer::RingBuffer(size_t init_capacity)
+    : capacity(init_capacity), mask(init_capacity - 1), slots(std::make_unique<Slot[]>(init_capacity)) {
+  DebugAssert(capacity > 0 && (capacity & mask) == 0, "Capacity of the ring buffer must be a power of two");
+}
+
+std::shared_ptr<AbstractTask>* WorkStealingDeque::RingBuffer::load(int64_t index) const {
+  return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+}
+
+void WorkStealingDeque::RingBuffer::store(int64_t index, std::shared_ptr<AbstractTask>* task) {
+  slots[static_cast<size_t>(index) & mask].store(task, std::memory_order_relaxed);
+}
+
+WorkStealingDeque::WorkStealingDeque(size_t initial_capacity) {
+  _buffers.emplace_back(std::make_unique<RingBuffer>(initial_capacity));
+  _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  // Free all tasks that were never picked up. At this point, no other thread may access the deque anymore.
+  const auto top = _top.load(std::memory_order_relaxed);
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+  for (auto index = top; index < bottom; ++index) {
+    delete buffer->load(index);
+  }
+}
+
+void WorkStealingDeque::push(const std::shared_ptr<AbstractTask>& task) {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_acquire);
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+
+  if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1) {
+    buffer = _grow(buffer, top, bottom);
+  }
+
+  buffer->store(bottom, new std::shared_ptr<AbstractTask>(task));
+
+  // Publishes the task to thieves, which read _bottom with acquire semantics.
+  _bottom.store(bottom + 1, std::memory_order_release);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::pop() {
+  const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = _top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // Deque was already empty, restore the previous state.
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto* boxed_task = buffer->load(bottom);
+  if (top == bottom) {
+    // This is the last task in the deque - race against concurrent thieves for it.
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      boxed_task = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  if (!boxed_task) return nullptr;
+
+  // We won the slot and are thus responsible for freeing the boxed task.
+  const auto owned_task = std::unique_ptr<std::shared_ptr<AbstractTask>>(boxed_task);
+  return std::move(*owned_task);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::steal() {
+  auto top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto bottom = _bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom) return nullptr;
+
+  // The slot needs to be read before the CAS. Afterwards, the owner might already have overwritten it.
+  auto* buffer = _buffer.load(std::memory_order_acquire);
+  auto* boxed_task = buffer->load(top);
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    // Lost the race against the owner or another thief. The loser must not touch the slot.
+    return nullptr;
+  }
+
+  const auto owned_task = std::unique_ptr<std::shared_ptr<AbstractTask>>(boxed_task);
+  return std::move(*owned_task);
+}
+
+bool WorkStealingDeque::empty() const { return size() == 0; }
+
+size_t WorkStealingDeque::size() const {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+WorkStealingDeque::RingBuffer* WorkStealingDeque::_grow(RingBuffer* buffer, int64_t top, int64_t bottom) {
+  auto new_buffer = std::make_unique<RingBuffer>(buffer->capacity * 2);
+  for (auto index = top; index < bottom; ++index) {
+    new_buffer->store(index, buffer->load(index));
+  }
+
+  auto* new_buffer_ptr = new_buffer.get();
+  _buffers.emplace_back(std::move(new_buffer));
+  _buffer.store(new_buffer_ptr, std::memory_order_release);
+  return new_buffer_ptr;
+}
+
+}  // namespace opossum
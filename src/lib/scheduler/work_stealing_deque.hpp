@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+
+/**
+ * Lock-free work-stealing deque as described by Chase and Lev ("Dynamic Circular Work-Stealing Deque", SPAA 2005),
+ * using the memory orderings proposed by Lê et al. ("Correct and Efficient Work-Stealing for Weak Memory Models",
+ * PPoPP 2013).
+ *
+ * Each Worker owns one WorkStealingDeque. Only the owning Worker may call push() and pop(), which operate on the bottom
+ * end of the deque in LIFO order. This keeps recently spawned (and thus cache-hot) jobs on the worker that spawned
+ * them. All other workers may call steal(), which takes the oldest task from the top end (FIFO).
+ *
+ * Tasks are stored as heap-allocated shared_ptrs, so that a slot can be read and handed out atomically. Whoever wins
+ * the race for a slot (pop() or steal()) takes ownership of that allocation. Ring buffers that were replaced by a
+ * larger one during push() might still be read by concurrent thieves and are therefore only freed on destruction.
+ */
+class WorkStealingDeque : private Noncopyable {
+ public:
+  explicit WorkStealingDeque(size_t initial_capacity = 256);
+  ~WorkStealingDeque();
+
+  /**
+   * Adds a task to the bottom of the deque. May only be called by the owning thread.
+   */
+  void push(const std::shared_ptr<AbstractTask>& task);
+
+  /**
+   * Removes the most recently pushed task. May only be called by the owning thread. Returns nullptr if the deque is
+   * empty or the last task was stolen concurrently.
+   */
+  std::shared_ptr<AbstractTask> pop();
+
+  /**
+   * Removes the oldest task. May be called by any thread. Returns nullptr if the deque is empty or if another thread
+   * won the race for the top-most task.
+   */
+  std::shared_ptr<AbstractTask> steal();
+
+  /**
+   * Approximation only - the result might be outdated as soon as it is returned.
+   */
+  bool empty() const;
+  size_t size() const;
+
+ private:
+  using Slot = std::atomic<std::shared_ptr<AbstractTask>*>;
+
+  struct RingBuffer {
+    explicit RingBuffer(size_t init_capacity);
+
+    std::shared_ptr<AbstractTask>* load(int64_t index) const;
+    void store(int64_t index, std::shared_ptr<AbstractTask>* task);
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  RingBuffer* _grow(RingBuffer* buffer, int64_t top, int64_t bottom);
+
+  // top and bottom are accessed by different threads, keep them on separate cache lines to avoid false sharing.
+  alignas(64) std::atomic<int64_t> _top{0};
+  alignas(64) std::atomic<int64_t> _bottom{0};
+  alignas(64) std::atomic<RingBuffer*> _buffer;
+
+  // Owns the current as well as all retired ring buffers. Only modified by the owning thread.
+  std::vector<std::unique_ptr<RingBuffer>> _buffers;
+};
+
+}  // namespace opossum
@@ -4,7 +4,7 @@
 #include <sched.h>
 #include <unistd.h>
 
-#include <chrono>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -26,9 +26,6 @@ namespace {
 thread_local std::weak_ptr<opossum::Worker> this_thread_worker;
 }  // namespace
 
-// The sleep time was determined experimentally
-static constexpr auto WORKER_SLEEP_TIME = std::chrono::microseconds(300);
-
 namespace opossum {
 
 std::shared_ptr<Worker> Worker::get_this_thread_worker() { return ::this_thread_worker.lock(); }
@@ -59,41 +56,21 @@ void Worker::operator()() {
   }
 }
 
-void Worker::_work() {
-  // If execute_next has been called, run that task first, otherwise try to retrieve a task from the queue.
+void Worker::_work(const std::vector<std::shared_ptr<AbstractTask>>& awaited_tasks) {
+  // If execute_next has been called, run that task first, otherwise try to retrieve a task from the queues.
   auto task = std::shared_ptr<AbstractTask>{};
   if (_next_task) {
     task = std::move(_next_task);
     _next_task = nullptr;
   } else {
-    task = _queue->pull();
+    task = _pull_task();
   }
 
   if (!task) {
-    // Simple work stealing without explicitly transferring data between nodes.
-    auto work_stealing_successful = false;
-    for (const auto& queue : Hyrise::get().scheduler()->queues()) {
-      if (queue == _queue) {
-        continue;
-      }
-
-      task = queue->steal();
-      if (task) {
-        task->set_node_id(_queue->node_id());
-        work_stealing_successful = true;
-        break;
-      }
-    }
-
-    // If there is no ready task neither in our queue nor in any other, worker waits for a new task to be pushed to the
-    // own queue or returns after timer exceeded (whatever occurs first).
-    if (!work_stealing_successful) {
-      {
-        std::unique_lock<std::mutex> unique_lock(_queue->lock);
-        _queue->new_task.wait_for(unique_lock, WORKER_SLEEP_TIME);
-      }
-      return;
-    }
+    // There is no ready task in any queue. Park until a new task is pushed (or, if we are waiting for tasks, until one
+    // of these finishes).
+    _park(awaited_tasks);
+    return;
   }
 
   const auto successfully_assigned = task->try_mark_as_assigned_to_worker();
@@ -107,6 +84,106 @@ void Worker::_work() {
   // This is part of the Scheduler shutdown system. Count the number of tasks a Worker executed to allow the
   // Scheduler to determine whether all tasks finished
   _num_finished_tasks++;
+
+  _notify_task_done();
+}
+
+std::shared_ptr<AbstractTask> Worker::_pull_task() {
+  // High priority tasks are always executed first. Afterwards, we prefer our own (most recently spawned) tasks over
+  // tasks from the node's queue, as they are likely to still be in the cache and their completion unblocks the task
+  // that spawned them.
+  if (auto task = _queue->pull(SchedulePriority::High)) return task;
+  if (auto task = _local_tasks.pop()) return task;
+  if (auto task = _queue->pull(SchedulePriority::Default)) return task;
+
+  return _steal_task();
+}
+
+std::shared_ptr<AbstractTask> Worker::_steal_task() {
+  const auto& scheduler = Hyrise::get().scheduler();
+  const auto& workers = scheduler->workers();
+  const auto worker_count = workers.size();
+
+  // Start at a random offset so that idle workers do not all contend on the same victim.
+  _next_random = (_next_random + 1) % _random.size();
+  const auto offset = worker_count > 0 ? static_cast<size_t>(_random[_next_random]) % worker_count : size_t{0};
+
+  // Steal from workers of the same node first. Their tasks do not need to be transferred between nodes.
+  for (auto worker_offset = size_t{0}; worker_offset < worker_count; ++worker_offset) {
+    const auto& worker = workers[(offset + worker_offset) % worker_count];
+    if (worker.get() == this || worker->_queue != _queue) continue;
+
+    if (auto task = worker->steal_local_task()) return task;
+  }
+
+  // Simple work stealing without explicitly transferring data between nodes.
+  for (const auto& queue : scheduler->queues()) {
+    if (queue == _queue) continue;
+
+    if (auto task = queue->steal()) {
+      task->set_node_id(_queue->node_id());
+      return task;
+    }
+  }
+
+  // Only stealable tasks are pushed into a worker's deque, so we do not need to check for stealability here.
+  for (auto worker_offset = size_t{0}; worker_offset < worker_count; ++worker_offset) {
+    const auto& worker = workers[(offset + worker_offset) % worker_count];
+    if (worker->_queue == _queue) continue;
+
+    if (auto task = worker->steal_local_task()) {
+      task->set_node_id(_queue->node_id());
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+bool Worker::_has_work() const {
+  const auto& scheduler = Hyrise::get().scheduler();
+
+  // Remote queues might only hold non-stealable tasks, which this worker cannot take. Considering them would make the
+  // worker spin instead of parking.
+  for (const auto& queue : scheduler->queues()) {
+    if (queue == _queue ? !queue->empty() : queue->has_stealable_tasks()) return true;
+  }
+
+  for (const auto& worker : scheduler->workers()) {
+    if (worker->has_local_tasks()) return true;
+  }
+
+  return false;
+}
+
+void Worker::_park(const std::vector<std::shared_ptr<AbstractTask>>& awaited_tasks) {
+  const auto& scheduler = Hyrise::get().scheduler();
+  const auto is_joining = !awaited_tasks.empty();
+
+  _queue->park_worker(
+      [&]() {
+        if (!scheduler->active() || _has_work()) return true;
+        if (!is_joining) return false;
+
+        return std::all_of(awaited_tasks.cbegin(), awaited_tasks.cend(),
+                           [](const auto& task) { return task->is_done(); });
+      },
+      is_joining);
+}
+
+void Worker::_wake_up_idle_worker() const {
+  if (_queue->unpark_worker()) return;
+
+  // All workers of our node are busy, try to get a worker from a remote node to steal the task.
+  for (const auto& queue : Hyrise::get().scheduler()->queues()) {
+    if (queue != _queue && queue->unpark_worker()) return;
+  }
+}
+
+void Worker::_notify_task_done() const {
+  for (const auto& queue : Hyrise::get().scheduler()->queues()) {
+    queue->notify_task_done();
+  }
 }
 
 void Worker::execute_next(const std::shared_ptr<AbstractTask>& task) {
@@ -125,11 +202,33 @@ void Worker::execute_next(const std::shared_ptr<AbstractTask>& task) {
     }
     Assert(successfully_enqueued, "Task was already enqueued, expected to be solely responsible for execution");
     _next_task = task;
+  } else if (task->is_stealable()) {
+    push_local_task(task);
   } else {
     _queue->push(task, static_cast<uint32_t>(SchedulePriority::Default));
+    _queue->unpark_worker();
   }
 }
 
+void Worker::push_local_task(const std::shared_ptr<AbstractTask>& task) {
+  DebugAssert(&*get_this_thread_worker() == this, "Only the owning worker may push into its deque");
+  DebugAssert(task->is_stealable(), "Non-stealable tasks must be pushed into the node's TaskQueue");
+
+  // Someone else was first to enqueue this task? No problem!
+  if (!task->try_mark_as_enqueued()) return;
+
+  task->set_node_id(_queue->node_id());
+  _local_tasks.push(task);
+
+  // See TaskQueue::park_worker for why this fence is needed before checking for parked workers.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  _wake_up_idle_worker();
+}
+
+std::shared_ptr<AbstractTask> Worker::steal_local_task() { return _local_tasks.steal(); }
+
+bool Worker::has_local_tasks() const { return !_local_tasks.empty(); }
+
 void Worker::start() { _thread = std::thread(&Worker::operator(), this); }
 
 void Worker::join() {
@@ -188,6 +287,7 @@ void Worker::_wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& t
       // Actually execute it.
       task->execute();
       ++_num_finished_tasks;
+      _notify_task_done();
 
       // Reset loop so that we re-visit tasks that may have finished in the meantime. We need to decrement `it` because
       // it will be incremented when the loop iteration finishes.
@@ -199,8 +299,9 @@ void Worker::_wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& t
 
   while (!all_own_tasks_done()) {
     // Run any job. This could be any job that is currently enqueued. Note: This job may internally call wait_for_tasks
-    // again, in which case we would first wait for the inner task before the outer task has a chance to proceed.
-    _work();
+    // again, in which case we would first wait for the inner task before the outer task has a chance to proceed. If no
+    // job is available, the worker parks until a new job is pushed or one of our own tasks is finished.
+    _work(tasks);
   }
 }
 
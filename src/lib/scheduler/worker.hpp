@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "scheduler/abstract_task.hpp"
+#include "scheduler/work_stealing_deque.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -16,6 +17,11 @@ class TaskQueue;
 /**
  * To be executed on a separate Thread, fetches and executes tasks until the queue is empty AND the shutdown flag is set
  * Ideally there should be one Worker actively doing work per CPU, but multiple might be active occasionally
+ *
+ * Each worker owns a WorkStealingDeque. Tasks that are scheduled by a task running on this worker (e.g., the JobTasks
+ * of a parallelized operator) are pushed to and popped from this deque in LIFO order. Idle workers steal from the
+ * deques of other workers in FIFO order, first from workers on the same node, then from workers on remote nodes. If no
+ * work can be found, the worker parks on the TaskQueue of its node until it is woken up by a newly scheduled task.
  */
 class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable {
   friend class AbstractScheduler;
@@ -42,6 +48,14 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
   // so that they are worked on as soon as possible by either this or another worker.
   void execute_next(const std::shared_ptr<AbstractTask>& task);
 
+  // Pushes a task into this worker's deque. Must be called from the thread that this worker runs on.
+  void push_local_task(const std::shared_ptr<AbstractTask>& task);
+
+  // Removes the oldest task from this worker's deque. Can be called from any thread.
+  std::shared_ptr<AbstractTask> steal_local_task();
+
+  bool has_local_tasks() const;
+
   uint64_t num_finished_tasks() const;
 
   void operator=(const Worker&) = delete;
@@ -49,7 +63,10 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
 
  protected:
   void operator()();
-  void _work();
+
+  // Executes the next available task. If none is available, the worker parks. If `awaited_tasks` is not empty, the
+  // worker is waiting for these tasks to finish (see _wait_for_tasks) and is also woken up once they are done.
+  void _work(const std::vector<std::shared_ptr<AbstractTask>>& awaited_tasks = {});
 
   void _wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
 
@@ -60,8 +77,25 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
    */
   void _set_affinity();
 
+  // Retrieves the next task in the order: high priority tasks of the own node, own deque, default priority tasks of
+  // the own node, deques of workers on the same node, queues and deques of other nodes.
+  std::shared_ptr<AbstractTask> _pull_task();
+  std::shared_ptr<AbstractTask> _steal_task();
+
+  // Returns true if any queue or deque holds a task that this worker could take.
+  bool _has_work() const;
+
+  void _park(const std::vector<std::shared_ptr<AbstractTask>>& awaited_tasks);
+
+  // Wakes up an idle worker, preferably on the own node, so that it can steal a newly pushed task.
+  void _wake_up_idle_worker() const;
+
+  // Wakes up workers that wait for the completion of tasks.
+  void _notify_task_done() const;
+
   std::shared_ptr<AbstractTask> _next_task{};
   std::shared_ptr<TaskQueue> _queue;
+  WorkStealingDeque _local_tasks;
   WorkerID _id;
   CpuID _cpu_id;
   std::thread _thread;
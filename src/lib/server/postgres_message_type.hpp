@@ -6,6 +6,13 @@ namespace opossum {
 // avoid magic numbers.
 static constexpr auto LENGTH_FIELD_SIZE = 4u;
 
+// Messages that claim to be larger are rejected. Otherwise, a single client could make the server allocate up to 4 GiB
+// by sending a forged length field.
+static constexpr auto MAX_MESSAGE_SIZE = 64u * 1024u * 1024u;
+
+// Special protocol version of startup packets that ask for SSL. We deny SSL support.
+static constexpr auto SSL_REQUEST_CODE = 80877103u;
+
 // Documentation of the message types can be found here:
 // https://www.postgresql.org/docs/12/protocol-message-formats.html
 enum class PostgresMessageType : unsigned char {
@@ -19,6 +26,7 @@ enum class PostgresMessageType : unsigned char {
   ErrorResponse = 'E',
   EmptyQueryResponse = 'I',
   NoDataResponse = 'n',
+  PortalSuspended = 's',
   ReadyForQuery = 'Z',
   RowDescription = 'T',
   DataRow = 'D',
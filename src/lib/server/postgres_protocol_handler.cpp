@@ -1,5 +1,7 @@
 #include "postgres_protocol_handler.hpp"
 
+#include "session_stream.hpp"
+
 namespace opossum {
 
 template <typename SocketType>
@@ -8,15 +10,12 @@ PostgresProtocolHandler<SocketType>::PostgresProtocolHandler(const std::shared_p
 
 template <typename SocketType>
 uint32_t PostgresProtocolHandler<SocketType>::read_startup_packet_header() {
-  // Special SSL version number that we catch to deny SSL support
-  constexpr auto SSL_REQUEST_CODE = 80877103u;
-
   const auto body_length = _read_buffer.template get_value<uint32_t>();
   const auto protocol_version = _read_buffer.template get_value<uint32_t>();
 
   // We currently do not support SSL
   if (protocol_version == SSL_REQUEST_CODE) {
-    _ssl_deny();
+    send_ssl_denial();
     return read_startup_packet_header();
   } else {
     // Subtract uint32_t twice, since both packet length and protocol version have been read already
@@ -89,7 +88,7 @@ void PostgresProtocolHandler<SocketType>::send_row_description_header(const uint
 
 template <typename SocketType>
 void PostgresProtocolHandler<SocketType>::send_row_description(const std::string& column_name, const uint32_t object_id,
-                                                               const int16_t type_width) {
+                                                               const int16_t type_width, const FormatCode format_code) {
   _write_buffer.put_string(column_name);
   // This field contains the table ID (OID in postgres). We have to set it in order to fulfill the protocol
   // specification. We do not know what it's good for.
@@ -99,32 +98,31 @@ void PostgresProtocolHandler<SocketType>::send_row_description(const std::string
   _write_buffer.template put_value<int32_t>(object_id);   // Object id of type
   _write_buffer.template put_value<int16_t>(type_width);  // Data type size
   _write_buffer.template put_value<int32_t>(-1);          // No modifier
-  _write_buffer.template put_value<int16_t>(0u);          // Text format
+  _write_buffer.template put_value<int16_t>(static_cast<int16_t>(format_code));
 }
 
 template <typename SocketType>
-void PostgresProtocolHandler<SocketType>::send_data_row(
-    const std::vector<std::optional<std::string>>& values_as_strings, const uint32_t string_length_sum) {
+void PostgresProtocolHandler<SocketType>::send_data_row(const std::vector<std::optional<std::string_view>>& values,
+                                                        const uint32_t value_length_sum) {
   // The documentation of the fields in this message can be found at:
   // https://www.postgresql.org/docs/12/static/protocol-message-formats.html
 
   _write_buffer.template put_value(PostgresMessageType::DataRow);
 
-  const auto packet_size =
-      LENGTH_FIELD_SIZE + sizeof(uint16_t) + values_as_strings.size() * LENGTH_FIELD_SIZE + string_length_sum;
+  const auto packet_size = LENGTH_FIELD_SIZE + sizeof(uint16_t) + values.size() * LENGTH_FIELD_SIZE + value_length_sum;
 
   _write_buffer.template put_value<uint32_t>(static_cast<uint32_t>(packet_size));
 
   // Number of columns in row
-  _write_buffer.template put_value<uint16_t>(static_cast<uint16_t>(values_as_strings.size()));
+  _write_buffer.template put_value<uint16_t>(static_cast<uint16_t>(values.size()));
 
-  for (const auto& value_string : values_as_strings) {
-    if (value_string.has_value()) {
-      // Size of string representation of value, NOT of value type's size
-      _write_buffer.template put_value<uint32_t>(static_cast<uint32_t>(value_string.value().size()));
+  for (const auto& value : values) {
+    if (value.has_value()) {
+      // Size of the serialized value, NOT of value type's size
+      _write_buffer.template put_value<uint32_t>(static_cast<uint32_t>(value->size()));
 
-      // Text mode means all values are sent as non-terminated strings
-      _write_buffer.put_string(value_string.value(), HasNullTerminator::No);
+      // Values are sent without terminator, both in text and in binary format
+      _write_buffer.put_string(*value, HasNullTerminator::No);
     } else {
       // NULL values are represented by setting the value's length to -1
       _write_buffer.template put_value<int32_t>(-1);
@@ -207,15 +205,18 @@ PreparedStatementDetails PostgresProtocolHandler<SocketType>::read_bind_packet()
 
   const auto num_result_column_format_codes = _read_buffer.template get_value<int16_t>();
 
+  std::vector<FormatCode> result_format_codes;
   for (auto i = 0; i < num_result_column_format_codes; i++) {
-    Assert(_read_buffer.template get_value<int16_t>() == 0, "Assuming all result columns to be in text format (0)");
+    const auto format_code = _read_buffer.template get_value<int16_t>();
+    Assert(format_code == 0 || format_code == 1, "Expected result columns in text (0) or binary (1) format");
+    result_format_codes.emplace_back(static_cast<FormatCode>(format_code));
   }
 
-  return {statement_name, portal, parameter_values};
+  return {statement_name, portal, parameter_values, result_format_codes};
 }
 
 template <typename SocketType>
-std::string PostgresProtocolHandler<SocketType>::read_execute_packet() {
+std::pair<std::string, uint32_t> PostgresProtocolHandler<SocketType>::read_execute_packet() {
   const auto packet_size = _read_buffer.template get_value<uint32_t>();
   auto portal = _read_buffer.get_string(packet_size - 2 * sizeof(uint32_t));
   /* https://www.postgresql.org/docs/12/protocol-flow.html:
@@ -223,8 +224,8 @@ std::string PostgresProtocolHandler<SocketType>::read_execute_packet() {
    the command is always executed to completion, and the row count is ignored.
   */
   const auto row_limit = _read_buffer.template get_value<int32_t>();
-  Assert(row_limit == 0, "Row limit of 0 (unlimited) expected.");
-  return portal;
+  AssertInput(row_limit >= 0, "Row limit must not be negative.");
+  return {portal, static_cast<uint32_t>(row_limit)};
 }
 
 template <typename SocketType>
@@ -266,13 +267,13 @@ void PostgresProtocolHandler<SocketType>::send_execution_info(const std::string&
 }
 
 template <typename SocketType>
-void PostgresProtocolHandler<SocketType>::_ssl_deny() {
+void PostgresProtocolHandler<SocketType>::send_ssl_denial() {
   // The SSL deny packet has a special format. It does not have a field indicating the packet size.
   _write_buffer.template put_value(PostgresMessageType::SslNo);
   _write_buffer.flush();
 }
 
-template class PostgresProtocolHandler<Socket>;
+template class PostgresProtocolHandler<SessionStream>;
 // For testing purposes only. stream_descriptor is used to write data to file
 template class PostgresProtocolHandler<boost::asio::posix::stream_descriptor>;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 
 #include "all_type_variant.hpp"
@@ -11,11 +13,14 @@ namespace opossum {
 
 using ErrorMessage = std::unordered_map<PostgresMessageType, std::string>;
 
-// This struct stores a prepared statement's name, its portal used and the specified parameters.
+// This struct stores a prepared statement's name, its portal used, the specified parameters, and the formats
+// requested for the result columns. An empty list of format codes means text format for all columns, a single format
+// code applies to all columns.
 struct PreparedStatementDetails {
   std::string statement_name;
   std::string portal;
   std::vector<AllTypeVariant> parameters;
+  std::vector<FormatCode> result_format_codes;
 };
 
 // This class extracts information from client messages and serializes the response data according to the PostgreSQL
@@ -25,8 +30,12 @@ class PostgresProtocolHandler {
  public:
   explicit PostgresProtocolHandler(const std::shared_ptr<SocketType>& socket);
 
-  // Handle the startup packet header returning the body's size
+  // Handle the startup packet header returning the body's size. SSL requests are denied, after which the header of
+  // the actual startup packet is read.
   uint32_t read_startup_packet_header();
+
+  // Deny the SSL request of the client
+  void send_ssl_denial();
   void read_startup_packet_body(const uint32_t size);
 
   // Setup new connection: successful authentication + sending parameters
@@ -44,9 +53,10 @@ class PostgresProtocolHandler {
 
   // Send query result
   void send_row_description_header(const uint32_t total_column_name_length, const uint16_t column_count);
-  void send_row_description(const std::string& column_name, const uint32_t object_id, const int16_t type_width);
-  void send_data_row(const std::vector<std::optional<std::string>>& values_as_strings,
-                     const uint32_t string_length_sum);
+  void send_row_description(const std::string& column_name, const uint32_t object_id, const int16_t type_width,
+                            const FormatCode format_code = FormatCode::Text);
+  // Values are already serialized in the format announced in the row description. std::nullopt represents NULL.
+  void send_data_row(const std::vector<std::optional<std::string_view>>& values, const uint32_t value_length_sum);
   void send_command_complete(const std::string& command_complete_message);
 
   // Messages for parsing prepared statements
@@ -59,7 +69,8 @@ class PostgresProtocolHandler {
   // Series of packets for binding and executing prepared statements
   void read_describe_packet();
   PreparedStatementDetails read_bind_packet();
-  std::string read_execute_packet();
+  // Returns the portal name and the maximum number of rows to return (0 means no limit)
+  std::pair<std::string, uint32_t> read_execute_packet();
 
   // Send error message to client if there is an error during parsing or execution
   void send_error_message(const ErrorMessage& error_message);
@@ -67,11 +78,10 @@ class PostgresProtocolHandler {
   // Additional (optional) message containing execution times of different components (such as translator or optimizer)
   void send_execution_info(const std::string& execution_information);
 
-  // This method is required for testing. Otherwise we cannot make the protocol handler flush its data.
+  // Flush the buffered messages. The session uses this to send a result in parts, tests to inspect the messages.
   void force_flush() { _write_buffer.flush(); }
 
  private:
-  void _ssl_deny();
   ReadBuffer<SocketType> _read_buffer;
   WriteBuffer<SocketType> _write_buffer;
 };
@@ -89,7 +89,7 @@ std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const Prepare
   const auto optimizer = Optimizer::create_default_optimizer();
   lqp = optimizer->optimize(std::move(lqp));
 
-  auto pqp = LQPTranslator{}.translate_node(lqp);
+  auto pqp = LQPTranslator{optimizer->cost_estimator()->cardinality_estimator}.translate_node(lqp);
 
   return pqp;
 }
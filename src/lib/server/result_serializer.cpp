@@ -1,13 +1,100 @@
 #include "result_serializer.hpp"
-#include "lossy_cast.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+
 #include "query_handler.hpp"
+#include "resolve_type.hpp"
+#include "session_stream.hpp"
+#include "storage/segment_iterate.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+std::vector<FormatCode> resolve_format_codes(const std::vector<FormatCode>& result_format_codes,
+                                             const size_t column_count) {
+  if (result_format_codes.empty()) return std::vector<FormatCode>(column_count, FormatCode::Text);
+  if (result_format_codes.size() == 1) return std::vector<FormatCode>(column_count, result_format_codes.front());
+  Assert(result_format_codes.size() == column_count, "Expected one format code per result column");
+  return result_format_codes;
+}
+
+// Numbers are formatted directly into the buffer. Floating-point numbers are printed with max_digits10 significant
+// digits, which matches the output of boost::lexical_cast. std::to_chars for floating-point numbers is not available
+// in all standard libraries that we support.
+template <typename T>
+void append_text(std::vector<char>& data, const T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    data.insert(data.end(), value.begin(), value.end());
+  } else if constexpr (std::is_integral_v<T>) {
+    const auto offset = data.size();
+    data.resize(offset + std::numeric_limits<T>::digits10 + 2);
+    const auto result = std::to_chars(data.data() + offset, data.data() + data.size(), value);
+    data.resize(result.ptr - data.data());
+  } else {
+    constexpr auto MAX_LENGTH = size_t{32};
+    const auto offset = data.size();
+    data.resize(offset + MAX_LENGTH);
+    const auto length = std::snprintf(data.data() + offset, MAX_LENGTH, "%.*g", std::numeric_limits<T>::max_digits10,
+                                      static_cast<double>(value));
+    data.resize(offset + length);
+  }
+}
+
+// In binary format, numbers are sent as integers or IEEE 754 floats in network byte order, strings are sent as they
+// are.
+template <typename T>
+void append_binary(std::vector<char>& data, const T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    data.insert(data.end(), value.begin(), value.end());
+  } else {
+    using BitsType = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    static_assert(sizeof(T) == sizeof(BitsType), "Unexpected size of numeric type");
+    auto bits = BitsType{};
+    std::memcpy(&bits, &value, sizeof(T));
+    for (auto byte_index = sizeof(T); byte_index > 0; --byte_index) {
+      data.push_back(static_cast<char>(bits >> ((byte_index - 1) * 8)));
+    }
+  }
+}
+
+template <typename T>
+void serialize_segment(const AbstractSegment& segment, const FormatCode format_code,
+                       ResultCursor::SerializedColumn& serialized_column) {
+  auto& data = serialized_column.data;
+  segment_iterate<T>(segment, [&](const auto& position) {
+    if (position.is_null()) {
+      serialized_column.lengths.emplace_back(-1);
+      return;
+    }
+
+    const auto offset = data.size();
+    if (format_code == FormatCode::Text) {
+      append_text<T>(data, position.value());
+    } else {
+      append_binary<T>(data, position.value());
+    }
+    serialized_column.lengths.emplace_back(static_cast<int32_t>(data.size() - offset));
+  });
+}
+
+}  // namespace
 
 namespace opossum {
 
 template <typename SocketType>
 void ResultSerializer::send_table_description(
     const std::shared_ptr<const Table>& table,
-    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler) {
+    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+    const std::vector<FormatCode>& result_format_codes) {
+  const auto format_codes = resolve_format_codes(result_format_codes, table->column_count());
+
   // Calculate sum of length of all column names
   uint32_t column_name_length_sum = 0;
   for (auto& column_name : table->column_names()) {
@@ -48,46 +135,107 @@ void ResultSerializer::send_table_description(
       case DataType::Null:
         Fail("Bad DataType");
     }
-    postgres_protocol_handler->send_row_description(table->column_name(column_id), object_id, type_width);
+    postgres_protocol_handler->send_row_description(table->column_name(column_id), object_id, type_width,
+                                                    format_codes[column_id]);
   }
 }
 
 template <typename SocketType>
 void ResultSerializer::send_query_response(
     const std::shared_ptr<const Table>& table,
-    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler) {
-  auto values_as_strings = std::vector<std::optional<std::string>>(table->column_count());
+    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+    const std::vector<FormatCode>& result_format_codes) {
+  auto cursor = ResultCursor{};
+  send_query_response(table, postgres_protocol_handler, result_format_codes, cursor, 0);
+}
+
+template <typename SocketType>
+bool ResultSerializer::send_query_response(
+    const std::shared_ptr<const Table>& table,
+    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+    const std::vector<FormatCode>& result_format_codes, ResultCursor& cursor, const uint32_t row_limit,
+    const size_t byte_limit) {
+  const auto column_count = table->column_count();
+  const auto format_codes = resolve_format_codes(result_format_codes, column_count);
+
+  // The buffers are reused for all chunks
+  auto& serialized_columns = cursor.serialized_columns;
+  serialized_columns.resize(column_count);
+  auto values = std::vector<std::optional<std::string_view>>(column_count);
 
   const auto chunk_count = table->chunk_count();
+  auto remaining_row_count = row_limit > 0 ? row_limit : std::numeric_limits<uint64_t>::max();
+  const auto max_byte_count = byte_limit > 0 ? byte_limit : std::numeric_limits<size_t>::max();
+  auto sent_byte_count = size_t{0};
+
+  // Each DataRow message consists of its type, its length, the number of columns, and a length field per value
+  const auto row_header_size = sizeof(PostgresMessageType) + LENGTH_FIELD_SIZE + sizeof(uint16_t) +
+                               column_count * LENGTH_FIELD_SIZE;
 
-  // Iterate over each chunk in result table
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; chunk_id++) {
-    const auto chunk = table->get_chunk(chunk_id);
+  // Iterate over each chunk in result table, starting with the chunk that has been sent partially (if any)
+  while (cursor.chunk_id < chunk_count) {
+    if (remaining_row_count == 0 || sent_byte_count >= max_byte_count) return false;
+
+    const auto chunk = table->get_chunk(cursor.chunk_id);
     const auto chunk_size = chunk->size();
 
-    const auto column_count = table->column_count();
-    auto segments = Segments(column_count);
-    for (auto column_id = ColumnID{0}; column_id < column_count; column_id++) {
-      segments[column_id] = chunk->get_segment(column_id);
+    // Serialize the chunk column by column. Thus, the segment type is resolved once per segment instead of accessing
+    // each value through the virtual operator[], which would also create an AllTypeVariant and a string per value.
+    // If the chunk has been sent partially before, its serialized values are still held by the cursor.
+    if (cursor.chunk_offset == 0) {
+      for (auto column_id = ColumnID{0}; column_id < column_count; column_id++) {
+        auto& serialized_column = serialized_columns[column_id];
+        serialized_column.data.clear();
+        serialized_column.lengths.clear();
+        serialized_column.lengths.reserve(chunk_size);
+        serialized_column.offset = 0;
+
+        resolve_data_type(table->column_data_type(column_id), [&](const auto data_type_t) {
+          using ColumnDataType = typename decltype(data_type_t)::type;
+          serialize_segment<ColumnDataType>(*chunk->get_segment(column_id), format_codes[column_id],
+                                            serialized_column);
+        });
+        DebugAssert(serialized_column.lengths.size() == chunk_size, "Expected one serialized value per row");
+      }
     }
 
-    // Iterate over each row in chunk
-    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-      auto string_length_sum = 0;
+    const auto batch_row_count = std::min(static_cast<uint64_t>(chunk_size - cursor.chunk_offset), remaining_row_count);
+    const auto begin_offset = cursor.chunk_offset;
+    const auto end_offset = static_cast<ChunkOffset>(cursor.chunk_offset + batch_row_count);
+
+    // Iterate over each row in chunk until the row limit or the byte limit is reached
+    for (; cursor.chunk_offset < end_offset && sent_byte_count < max_byte_count; ++cursor.chunk_offset) {
+      auto value_length_sum = uint32_t{0};
       // Iterate over each attribute in row
-      for (auto segment_id = ColumnID{0}; segment_id < column_count; segment_id++) {
-        const auto attribute_value = (*segments[segment_id])[chunk_offset];
-        // The PostgreSQL protocol requires the conversion of values to strings
-        const auto string_value = lossy_variant_cast<pmr_string>(attribute_value);
-        if (string_value.has_value()) {
-          // Sum up string lengths for a row to save an extra loop during serialization
-          string_length_sum += string_value.value().size();
+      for (auto column_id = ColumnID{0}; column_id < column_count; column_id++) {
+        auto& serialized_column = serialized_columns[column_id];
+        const auto length = serialized_column.lengths[cursor.chunk_offset];
+        if (length < 0) {
+          values[column_id] = std::nullopt;
+          continue;
         }
-        values_as_strings[segment_id] = string_value;
+
+        values[column_id] = std::string_view{serialized_column.data.data() + serialized_column.offset,
+                                             static_cast<size_t>(length)};
+        serialized_column.offset += length;
+        // Sum up value lengths for a row to save an extra loop during serialization
+        value_length_sum += length;
       }
-      postgres_protocol_handler->send_data_row(values_as_strings, string_length_sum);
+      postgres_protocol_handler->send_data_row(values, value_length_sum);
+      sent_byte_count += row_header_size + value_length_sum;
+    }
+
+    const auto sent_row_count = static_cast<uint64_t>(cursor.chunk_offset - begin_offset);
+    remaining_row_count -= sent_row_count;
+    cursor.sent_row_count += sent_row_count;
+
+    if (cursor.chunk_offset == chunk_size) {
+      ++cursor.chunk_id;
+      cursor.chunk_offset = ChunkOffset{0};
     }
   }
+
+  return true;
 }
 
 std::string ResultSerializer::build_command_complete_message(const ExecutionInformation& execution_information,
@@ -122,18 +270,31 @@ std::string ResultSerializer::build_command_complete_message(const OperatorType
   }
 }
 
-template void ResultSerializer::send_table_description<Socket>(const std::shared_ptr<const Table>&,
-                                                               const std::shared_ptr<PostgresProtocolHandler<Socket>>&);
+template void ResultSerializer::send_table_description<SessionStream>(
+    const std::shared_ptr<const Table>&, const std::shared_ptr<PostgresProtocolHandler<SessionStream>>&,
+    const std::vector<FormatCode>&);
 
 template void ResultSerializer::send_table_description<boost::asio::posix::stream_descriptor>(
     const std::shared_ptr<const Table>&,
-    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&);
+    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&,
+    const std::vector<FormatCode>&);
 
-template void ResultSerializer::send_query_response<Socket>(const std::shared_ptr<const Table>&,
-                                                            const std::shared_ptr<PostgresProtocolHandler<Socket>>&);
+template void ResultSerializer::send_query_response<SessionStream>(
+    const std::shared_ptr<const Table>&, const std::shared_ptr<PostgresProtocolHandler<SessionStream>>&,
+    const std::vector<FormatCode>&);
 
 template void ResultSerializer::send_query_response<boost::asio::posix::stream_descriptor>(
     const std::shared_ptr<const Table>&,
-    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&);
+    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&,
+    const std::vector<FormatCode>&);
+
+template bool ResultSerializer::send_query_response<SessionStream>(
+    const std::shared_ptr<const Table>&, const std::shared_ptr<PostgresProtocolHandler<SessionStream>>&,
+    const std::vector<FormatCode>&, ResultCursor&, const uint32_t, const size_t);
+
+template bool ResultSerializer::send_query_response<boost::asio::posix::stream_descriptor>(
+    const std::shared_ptr<const Table>&,
+    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&,
+    const std::vector<FormatCode>&, ResultCursor&, const uint32_t, const size_t);
 
 }  // namespace opossum
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
 #include "storage/table.hpp"
@@ -9,20 +11,53 @@ namespace opossum {
 
 struct ExecutionInformation;
 
+// Position of the next row of a result table that has to be sent. Portals keep the cursor if the client limits the
+// number of rows per Execute message, so that the remaining rows can be sent with the following Execute messages.
+struct ResultCursor {
+  // The serialized values of one column of the current chunk. A length of -1 represents NULL. offset points to the
+  // serialized value of the next row.
+  struct SerializedColumn {
+    std::vector<char> data;
+    std::vector<int32_t> lengths;
+    size_t offset{0};
+  };
+
+  ChunkID chunk_id{0};
+  ChunkOffset chunk_offset{0};
+  uint64_t sent_row_count{0};
+
+  // The current chunk is serialized once and kept until all of its rows have been sent.
+  std::vector<SerializedColumn> serialized_columns;
+};
+
 // The ResultSerializer serializes the result data returned by Hyrise according to PostgreSQL Wire Protocol.
+// result_format_codes follow the protocol's convention: An empty vector requests text format for all columns, a single
+// format code applies to all columns, otherwise there is one format code per column.
 class ResultSerializer {
  public:
   // Serialize information about the result table
   template <typename SocketType>
   static void send_table_description(
       const std::shared_ptr<const Table>& table,
-      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler);
+      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+      const std::vector<FormatCode>& result_format_codes = {});
 
   template <typename SocketType>
-  // Cast attributes of the result table and send them row-wise
+  // Serialize the values of each chunk column by column and send them row-wise
   static void send_query_response(
       const std::shared_ptr<const Table>& table,
-      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler);
+      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+      const std::vector<FormatCode>& result_format_codes = {});
+
+  // Send at most row_limit rows (0 means no limit) starting at the cursor's position and advance the cursor. Sending
+  // also stops after the row with which the DataRow messages exceed byte_limit bytes (0 means no limit). This bounds
+  // the output that is kept in memory until the client has received it. Returns true if all rows of the table have
+  // been sent.
+  template <typename SocketType>
+  static bool send_query_response(const std::shared_ptr<const Table>& table,
+                                  const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+                                  const std::vector<FormatCode>& result_format_codes, ResultCursor& cursor,
+                                  const uint32_t row_limit, const size_t byte_limit = 0);
 
   // Build completion message after query execution containing the statement type and the number of rows affected
   static std::string build_command_complete_message(const ExecutionInformation& execution_information,
@@ -2,8 +2,10 @@
 
 #include <pthread.h>
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "hyrise.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
@@ -12,8 +14,13 @@ namespace opossum {
 
 // Specified port (default: 5432) will be opened after initializing the _acceptor
 Server::Server(const boost::asio::ip::address& address, const uint16_t port,
-               const SendExecutionInfo send_execution_info)
-    : _acceptor(_io_service, boost::asio::ip::tcp::endpoint(address, port)), _send_execution_info(send_execution_info) {
+               const SendExecutionInfo send_execution_info, const PlanCacheType plan_cache_type,
+               const uint32_t session_thread_count)
+    : _acceptor(_io_service, boost::asio::ip::tcp::endpoint(address, port)),
+      _send_execution_info(send_execution_info),
+      _plan_cache_type(plan_cache_type),
+      _session_thread_count(session_thread_count > 0 ? session_thread_count
+                                                     : std::max(std::thread::hardware_concurrency(), 1u)) {
   std::cout << "Server started at " << server_address() << " and port " << server_port() << std::endl
             << "Run 'psql -h localhost " << server_address() << "' to connect to the server" << std::endl;
 }
@@ -25,12 +32,33 @@ void Server::run() {
   Hyrise::get().set_scheduler(std::make_shared<opossum::NodeQueueScheduler>());
 
   // Set caches
-  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
-  Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>(DEFAULT_CACHE_CAPACITY, _plan_cache_type);
+  Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>(DEFAULT_CACHE_CAPACITY, _plan_cache_type);
 
   _is_initialized = true;
   _accept_new_session();
+
+  // Sessions do not block threads while waiting for their clients. Thus, a few threads running the io_service are
+  // sufficient to serve a large number of connections. The calling thread is one of them.
+  auto io_service_threads = std::vector<std::thread>{};
+  io_service_threads.reserve(_session_thread_count - 1);
+  for (auto thread_id = uint32_t{1}; thread_id < _session_thread_count; ++thread_id) {
+    io_service_threads.emplace_back([&, thread_id]() {
+      const std::string thread_name = "server_io_" + std::to_string(thread_id);
+#ifdef __APPLE__
+      pthread_setname_np(thread_name.c_str());
+#elif __linux__
+      pthread_setname_np(pthread_self(), thread_name.c_str());
+#endif
+      _io_service.run();
+    });
+  }
+
   _io_service.run();
+
+  for (auto& thread : io_service_threads) {
+    thread.join();
+  }
 }
 
 void Server::_accept_new_session() {
@@ -45,30 +73,12 @@ void Server::_accept_new_session() {
 void Server::_start_session(const std::shared_ptr<Session>& new_session, const boost::system::error_code& error) {
   Assert(!error, error.message());
 
-  std::thread session_thread([session = new_session, &num_running_sessions = this->_num_running_sessions]() mutable {
-    const std::string thread_name = "server_p_" + std::to_string(session->socket()->remote_endpoint().port());
-#ifdef __APPLE__
-    pthread_setname_np(thread_name.c_str());
-#elif __linux__
-    pthread_setname_np(pthread_self(), thread_name.c_str());
-#endif
-
-    ++num_running_sessions;
-
-    session->run();
-
-    // Destroy the session before reducing the number of running sessions. This makes sure that the server has not shut
-    // down yet. In case session.use_count is not yet zero, this makes sure that the destructor is not called in
-    // the detached thread.
-    session.reset();
-    --num_running_sessions;
-  });
+  // We ensure that all sessions are closed before the server is shut down by tracking the number of running sessions.
+  // The session keeps itself alive while it waits for its client or executes a query. Hence, we do not need to store
+  // it here.
+  ++_num_running_sessions;
+  new_session->start([&num_running_sessions = _num_running_sessions]() { --num_running_sessions; });
 
-  // We ensure that all threads are completed before the server is shut down by tracking the number of running threads
-  // in _num_running_sessions. The alternative would be to store the std::thread objects in some kind of data structure
-  // and call join() on all of them before shutting down the server. This would result in a growing number of completed
-  // threads waiting to be joined and the need for a cleanup procedure.
-  session_thread.detach();
   _accept_new_session();
 }
 
@@ -5,20 +5,24 @@
 
 #include "server_types.hpp"
 #include "session.hpp"
+#include "sql/sql_plan_cache.hpp"
 
 namespace opossum {
 
 /* In the following a short description of the classes used for the server implementation.
 
-*  Server - Opens and binds a server socket. Starts a new session per client.
+*  Server - Opens and binds a server socket. Starts a new session per client. All sessions share a small pool of threads
+*           that run the io_service.
 *  Session - Creates a data socket for client server communication. It is responsible for the message flow and holds
-*            session-specific data.
+*            session-specific data. Waits for client requests asynchronously and executes queries via the scheduler.
 *  PostgresProtocolHandler - This class operates on the message level. It serializes and de-serializes information from
 *                            messages.
 *  PostgresMessageTypes - Set of different message types supported by Hyrise.
-*  ReadBuffer - Dedicated ring buffer for reading information from the network socket. Also does network to host byte
+*  SessionStream - In-memory stream between the session and the buffers. It holds the received messages and collects
+*                  the responses, which the session exchanges with the client asynchronously.
+*  ReadBuffer - Dedicated ring buffer for reading information from the session stream. Also does network to host byte
 *               conversion for integer types.
-*  WriteBuffer - Dedicated ring buffer for writing information to the network socket. Does host to network byte
+*  WriteBuffer - Dedicated ring buffer for writing information to the session stream. Does host to network byte
 *                conversion for integer types.
 *  RingBufferIterator - Implements ring buffer logic used by the two buffers.
 *  QueryHandler - Interface between the server and the database logic. Operations, such as creating an SQLPipeline or
@@ -29,9 +33,12 @@ namespace opossum {
 
 class Server {
  public:
-  Server(const boost::asio::ip::address& address, const uint16_t port, const SendExecutionInfo send_execution_info);
+  // session_thread_count is the number of threads that handle the network communication of all sessions. 0 means one
+  // thread per core.
+  Server(const boost::asio::ip::address& address, const uint16_t port, const SendExecutionInfo send_execution_info,
+         const PlanCacheType plan_cache_type = PlanCacheType::GDFS, const uint32_t session_thread_count = 0);
 
-  // Start server to accept new sessions.
+  // Start server to accept new sessions. Returns after the server has been shut down.
   void run();
 
   // Return the port the server is running on.
@@ -55,6 +62,8 @@ class Server {
   boost::asio::io_service _io_service;
   boost::asio::ip::tcp::acceptor _acceptor;
   const SendExecutionInfo _send_execution_info;
+  const PlanCacheType _plan_cache_type;
+  const uint32_t _session_thread_count;
   std::atomic_bool _is_initialized{false};
 };
 }  // namespace opossum
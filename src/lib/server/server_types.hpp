@@ -10,4 +10,8 @@ enum class HasNullTerminator : bool { Yes = true, No = false };
 
 enum class SendExecutionInfo : bool { Yes = true, No = false };
 
+// Format of values exchanged with the client, see
+// https://www.postgresql.org/docs/12/protocol-overview.html#PROTOCOL-FORMAT-CODES
+enum class FormatCode : int16_t { Text = 0, Binary = 1 };
+
 }  // namespace opossum
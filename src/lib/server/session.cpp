@@ -1,45 +1,224 @@
 #include "session.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include <boost/asio/post.hpp>
+
 #include "client_disconnect_exception.hpp"
 #include "postgres_message_type.hpp"
 #include "query_handler.hpp"
 #include "result_serializer.hpp"
+#include "scheduler/job_task.hpp"
 
 namespace opossum {
 
 Session::Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info)
     : _socket(std::make_shared<Socket>(io_service)),
-      _postgres_protocol_handler(std::make_shared<PostgresProtocolHandler<Socket>>(_socket)),
+      _stream(std::make_shared<SessionStream>()),
+      _postgres_protocol_handler(std::make_shared<PostgresProtocolHandler<SessionStream>>(_stream)),
       _send_execution_info(send_execution_info) {}
 
 std::shared_ptr<Socket> Session::socket() { return _socket; }
 
-void Session::run() {
+void Session::start(const std::function<void()>& on_close) {
+  _on_close = on_close;
   // Set TCP_NODELAY in order to disable Nagle's algorithm. It handles congestion control in TCP networks. Therefore,
   // small packets are buffered and sent out later as one large packet. This might introduce a delay of up to 40 ms
   // which we have to avoid. Further reading: https://howdoesinternetwork.com/2015/nagles-algorithm
   _socket->set_option(boost::asio::ip::tcp::no_delay(true));
-  _establish_connection();
-  while (!_terminate_session) {
-    try {
-      _handle_request();
-    } catch (const ClientDisconnectException&) {
+  _receive_requests();
+}
+
+void Session::_process_requests() {
+  while (true) {
+    // Messages usually arrive in batches (e.g., Parse, Bind, Describe, Execute, and Sync). We keep on processing
+    // requests as long as they have already been received completely and only wait for the client otherwise.
+    const auto message_size = _message_size();
+    if (message_size && *message_size > MAX_MESSAGE_SIZE) {
+      _reject_oversized_message(*message_size);
+      return;
+    }
+
+    if (!message_size || _received_data.size() < *message_size) {
+      _receive_requests();
+      return;
+    }
+
+    // We do not support SSL. The client sends the actual startup packet only after it has received the denial.
+    if (!_connection_established && _is_ssl_request(*message_size)) {
+      _received_data.erase(0, *message_size);
+      _postgres_protocol_handler->send_ssl_denial();
+      _send_output_and_process_requests();
+      return;
+    }
+
+    _stream->append_input(std::string_view{_received_data}.substr(0, *message_size));
+    _received_data.erase(0, *message_size);
+
+    auto is_executed_async = false;
+    const auto is_connected = _handle_errors([&]() {
+      if (!_connection_established) {
+        _establish_connection();
+        _connection_established = true;
+      } else {
+        is_executed_async = _handle_request();
+      }
+    });
+
+    if (!is_connected || _terminate_session) {
+      _close();
+      return;
+    }
+
+    // The remaining requests are processed once the execution has finished. Until then, the session must not be
+    // modified.
+    if (is_executed_async) return;
+
+    // Responses are only flushed at the end of a batch (e.g., ReadyForQuery after Sync) or once the write buffer is
+    // full. Only then, we have to wait for the client to receive them. Results are sent in parts, all of which have to
+    // be sent before the next request is handled.
+    if (_stream->has_output() || _send_result_part) {
+      _send_output_and_process_requests();
       return;
-    } catch (const std::exception& e) {
-      std::cerr << "Exception in session with client port " << _socket->remote_endpoint().port() << ":" << std::endl
-                << e.what() << std::endl;
-      const auto error_message = ErrorMessage{{PostgresMessageType::HumanReadableError, e.what()}};
-      _postgres_protocol_handler->send_error_message(error_message);
-      _postgres_protocol_handler->send_ready_for_query();
-      // In case of an error, an error message has to be send to the client followed by a "ReadyForQuery" message.
-      // Messages that have already been received are processed further. A "sync" message makes the server send another
-      // "ReadyForQuery" message. In order to avoid this, we set this flag for further operations. As soon as a new
-      // query arrives it must be set to false again to ensure correct message flow.
-      _sync_send_after_error = true;
     }
   }
 }
 
+void Session::_receive_requests() {
+  _socket->async_read_some(boost::asio::buffer(_receive_buffer), [self = shared_from_this()](
+                                                                     const boost::system::error_code& error,
+                                                                     const size_t bytes_received) {
+    if (error) {
+      self->_close();
+      return;
+    }
+    self->_received_data.append(self->_receive_buffer.data(), bytes_received);
+    self->_process_requests();
+  });
+}
+
+void Session::_send_output_and_process_requests() {
+  // Serialize the next part of a result that is being sent. If the step fails, the error has been sent instead of the
+  // remaining rows and the result is dropped.
+  if (_send_result_part) {
+    auto is_complete = true;
+    const auto is_connected = _handle_errors([&]() { is_complete = _send_result_part(); });
+    if (!is_connected) {
+      _close();
+      return;
+    }
+    if (is_complete) _send_result_part = nullptr;
+  }
+
+  if (!_stream->has_output()) {
+    if (_terminate_session) {
+      _close();
+      return;
+    }
+    _process_requests();
+    return;
+  }
+
+  // The output is kept until the client has received it. Afterwards, we continue with the next part of the result, if
+  // any. Thus, the client's speed of receiving the result limits the speed of serializing it.
+  auto output = std::make_shared<std::string>(_stream->take_output());
+  boost::asio::async_write(*_socket, boost::asio::buffer(*output),
+                           [self = shared_from_this(), output](const boost::system::error_code& error, const size_t) {
+                             if (error) {
+                               self->_close();
+                               return;
+                             }
+                             self->_send_output_and_process_requests();
+                           });
+}
+
+std::optional<size_t> Session::_message_size() const {
+  // Startup packets consist of their length and their body. All other messages start with their type.
+  const auto header_size = (_connection_established ? sizeof(PostgresMessageType) : 0) + LENGTH_FIELD_SIZE;
+  if (_received_data.size() < header_size) return std::nullopt;
+
+  auto network_length = uint32_t{0};
+  std::memcpy(&network_length, _received_data.data() + header_size - LENGTH_FIELD_SIZE, LENGTH_FIELD_SIZE);
+  // The length includes the length field itself. Messages that claim to be shorter are passed on as they are and make
+  // the protocol handler fail.
+  return std::max(header_size, header_size - LENGTH_FIELD_SIZE + ntohl(network_length));
+}
+
+void Session::_reject_oversized_message(const size_t message_size) {
+  // The remaining data cannot be split into messages anymore. Thus, the session ends once the client has received the
+  // error.
+  _received_data.clear();
+  _terminate_session = true;
+  _postgres_protocol_handler->send_error_message(
+      ErrorMessage{{PostgresMessageType::HumanReadableError,
+                    "Message of " + std::to_string(message_size) + " bytes exceeds the maximum message size of " +
+                        std::to_string(MAX_MESSAGE_SIZE) + " bytes"}});
+  _postgres_protocol_handler->force_flush();
+  _send_output_and_process_requests();
+}
+
+bool Session::_is_ssl_request(const size_t message_size) const {
+  if (message_size != 2 * LENGTH_FIELD_SIZE) return false;
+  auto network_protocol_version = uint32_t{0};
+  std::memcpy(&network_protocol_version, _received_data.data() + LENGTH_FIELD_SIZE, LENGTH_FIELD_SIZE);
+  return ntohl(network_protocol_version) == SSL_REQUEST_CODE;
+}
+
+bool Session::_handle_errors(const std::function<void()>& step) {
+  try {
+    step();
+  } catch (const ClientDisconnectException&) {
+    return false;
+  } catch (const std::exception& e) {
+    std::cerr << "Exception in session with client port " << _socket->remote_endpoint().port() << ":" << std::endl
+              << e.what() << std::endl;
+    const auto error_message = ErrorMessage{{PostgresMessageType::HumanReadableError, e.what()}};
+    _postgres_protocol_handler->send_error_message(error_message);
+    _postgres_protocol_handler->send_ready_for_query();
+    // In case of an error, an error message has to be send to the client followed by a "ReadyForQuery" message.
+    // Messages that have already been received are processed further. A "sync" message makes the server send another
+    // "ReadyForQuery" message. In order to avoid this, we set this flag for further operations. As soon as a new
+    // query arrives it must be set to false again to ensure correct message flow.
+    _sync_send_after_error = true;
+  }
+  return true;
+}
+
+void Session::_execute_async(const std::function<void()>& execute_step, const std::function<void()>& send_step) {
+  auto task = std::make_shared<JobTask>([self = shared_from_this(), execute_step, send_step]() {
+    auto exception = std::exception_ptr{};
+    try {
+      execute_step();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+
+    // Hand the session back to the io_service. Exceptions of the execution are passed on so that they are reported to
+    // the client in the same way as exceptions of synchronously handled requests.
+    boost::asio::post(self->_socket->get_executor(), [self, send_step, exception]() {
+      const auto is_connected = self->_handle_errors([&]() {
+        if (exception) std::rethrow_exception(exception);
+        send_step();
+      });
+
+      if (!is_connected) {
+        self->_close();
+        return;
+      }
+      self->_send_output_and_process_requests();
+    });
+  });
+  task->schedule();
+}
+
+void Session::_close() {
+  if (_closed) return;
+  _closed = true;
+  _on_close();
+}
+
 void Session::_establish_connection() {
   const auto body_length = _postgres_protocol_handler->read_startup_packet_header();
 
@@ -53,7 +232,7 @@ void Session::_establish_connection() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
-void Session::_handle_request() {
+bool Session::_handle_request() {
   const auto header = _postgres_protocol_handler->read_packet_type();
 
   switch (header) {
@@ -64,7 +243,7 @@ void Session::_handle_request() {
     case PostgresMessageType::SimpleQueryCommand: {
       _sync_send_after_error = false;
       _handle_simple_query();
-      break;
+      return true;
     }
     case PostgresMessageType::ParseCommand: {
       _sync_send_after_error = false;
@@ -91,43 +270,66 @@ void Session::_handle_request() {
       break;
     }
     case PostgresMessageType::ExecuteCommand: {
-      _handle_execute();
-      break;
+      return _handle_execute();
     }
     default:
       Fail("Unknown packet type");
   }
+  return false;
 }
 
 void Session::_handle_simple_query() {
-  const auto& query = _postgres_protocol_handler->read_query_packet();
+  const auto query = _postgres_protocol_handler->read_query_packet();
 
   // A simple query command invalidates unnamed portals
   _portals.erase("");
 
-  ExecutionInformation execution_information;
-
-  std::tie(execution_information, _transaction_context) =
-      QueryHandler::execute_pipeline(query, _send_execution_info, _transaction_context);
+  // The results are passed from the execution to the sending step, which both run after this method has returned.
+  auto execution_information = std::make_shared<ExecutionInformation>();
+
+  _execute_async(
+      [this, query, execution_information]() {
+        std::tie(*execution_information, _transaction_context) =
+            QueryHandler::execute_pipeline(query, _send_execution_info, _transaction_context);
+      },
+      [this, execution_information]() {
+        if (!execution_information->error_message.empty()) {
+          _postgres_protocol_handler->send_error_message(execution_information->error_message);
+          _postgres_protocol_handler->send_ready_for_query();
+          return;
+        }
+
+        // If there is no result table, e.g. after an INSERT command, we cannot send row data. Otherwise, the result
+        // table of the last statement will be send back.
+        if (!execution_information->result_table) {
+          _complete_simple_query(*execution_information, 0);
+          return;
+        }
+
+        ResultSerializer::send_table_description(execution_information->result_table, _postgres_protocol_handler);
+
+        // The rows are sent in parts. Thus, the client receives the first rows before the entire result is serialized.
+        auto cursor = std::make_shared<ResultCursor>();
+        _send_result_part = [this, execution_information, cursor]() {
+          const auto is_complete = ResultSerializer::send_query_response(
+              execution_information->result_table, _postgres_protocol_handler, {}, *cursor, 0, SERVER_BUFFER_SIZE);
+          if (!is_complete) {
+            _postgres_protocol_handler->force_flush();
+            return false;
+          }
+
+          _complete_simple_query(*execution_information, cursor->sent_row_count);
+          return true;
+        };
+      });
+}
 
-  if (!execution_information.error_message.empty()) {
-    _postgres_protocol_handler->send_error_message(execution_information.error_message);
-  } else {
-    uint64_t row_count = 0;
-    // If there is no result table, e.g. after an INSERT command, we cannot send row data. Otherwise, the result table
-    // of the last statement will be send back.
-    if (execution_information.result_table) {
-      ResultSerializer::send_table_description(execution_information.result_table, _postgres_protocol_handler);
-      ResultSerializer::send_query_response(execution_information.result_table, _postgres_protocol_handler);
-      row_count = execution_information.result_table->row_count();
-    }
-    if (_send_execution_info == SendExecutionInfo::Yes) {
-      _postgres_protocol_handler->send_execution_info(execution_information.pipeline_metrics);
-    }
-    _postgres_protocol_handler->send_command_complete(
-        ResultSerializer::build_command_complete_message(execution_information, row_count));
+void Session::_complete_simple_query(const ExecutionInformation& execution_information, const uint64_t row_count) {
+  if (_send_execution_info == SendExecutionInfo::Yes) {
+    _postgres_protocol_handler->send_execution_info(execution_information.pipeline_metrics);
   }
-
+  _postgres_protocol_handler->send_command_complete(
+      ResultSerializer::build_command_complete_message(execution_information, row_count));
   _postgres_protocol_handler->send_ready_for_query();
 }
 
@@ -153,13 +355,13 @@ void Session::_handle_bind_command() {
   }
 
   // Since bind and execute packet usually arrive together, we still have to handle the execute packet. Therefore,
-  // we first store a nullptr in the portals map to signalize an error. However, if binding succeeds in the next step
-  // this nullptr gets replaced by the correct pqp. Before executing the prepared statement we make a check for errors.
-  _portals.emplace(parameters.portal, nullptr);
+  // we first store a portal without a pqp in the portals map to signalize an error. However, if binding succeeds in the
+  // next step it gets replaced by the correct pqp. Before executing the prepared statement we make a check for errors.
+  _portals.emplace(parameters.portal, Portal{});
 
   const auto pqp = QueryHandler::bind_prepared_plan(parameters);
 
-  _portals[parameters.portal] = pqp;
+  _portals[parameters.portal] = Portal{pqp, parameters.result_format_codes, nullptr, ResultCursor{}};
   _postgres_protocol_handler->send_status_message(PostgresMessageType::BindComplete);
 
   // Ready for query + flush will be done after reading sync message
@@ -174,42 +376,92 @@ void Session::_sync() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
-void Session::_handle_execute() {
-  const std::string& portal_name = _postgres_protocol_handler->read_execute_packet();
+bool Session::_handle_execute() {
+  const auto [portal_name, row_limit] = _postgres_protocol_handler->read_execute_packet();
 
   auto portal_it = _portals.find(portal_name);
   AssertInput(portal_it != _portals.end(), "The specified portal does not exist.");
 
   // In case of an error occured during binding there is no pqp available. Hence, early return here since there is
   // nothing to execute.
-  if (!portal_it->second) {
+  if (!portal_it->second.physical_plan) {
     _portals.erase(portal_it);
-    return;
+    return false;
   }
 
-  const auto physical_plan = portal_it->second;
+  // A suspended portal continues with the remaining rows of its result without executing the plan again.
+  if (portal_it->second.result_table) {
+    _send_portal_result(portal_name, row_limit);
+    return false;
+  }
 
-  if (portal_name.empty()) _portals.erase(portal_it);
+  const auto physical_plan = portal_it->second.physical_plan;
 
   if (!_transaction_context) {
     _transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
   }
   physical_plan->set_transaction_context_recursively(_transaction_context);
 
-  const auto result_table = QueryHandler::execute_prepared_plan(physical_plan);
+  auto result_table = std::make_shared<std::shared_ptr<const Table>>();
+  auto execute_portal_name = portal_name;
+  auto execute_row_limit = row_limit;
+
+  _execute_async(
+      [physical_plan, result_table]() { *result_table = QueryHandler::execute_prepared_plan(physical_plan); },
+      [this, physical_plan, result_table, execute_portal_name, execute_row_limit]() {
+        // If there is no result table, e.g. after an INSERT command, we cannot send row data
+        if (!*result_table) {
+          _postgres_protocol_handler->send_status_message(PostgresMessageType::NoDataResponse);
+          _postgres_protocol_handler->send_command_complete(
+              ResultSerializer::build_command_complete_message(physical_plan->type(), 0));
+          if (execute_portal_name.empty()) _portals.erase(execute_portal_name);
+          return;
+        }
+
+        auto& portal = _portals.at(execute_portal_name);
+        portal.result_table = *result_table;
+        ResultSerializer::send_table_description(portal.result_table, _postgres_protocol_handler,
+                                                 portal.result_format_codes);
+        _send_portal_result(execute_portal_name, execute_row_limit);
+      });
+  return true;
+}
 
-  uint64_t row_count = 0;
-  // If there is no result table, e.g. after an INSERT command, we cannot send row data
-  if (result_table) {
-    ResultSerializer::send_table_description(result_table, _postgres_protocol_handler);
-    ResultSerializer::send_query_response(result_table, _postgres_protocol_handler);
-    row_count = result_table->row_count();
-  } else {
-    _postgres_protocol_handler->send_status_message(PostgresMessageType::NoDataResponse);
-  }
+void Session::_send_portal_result(const std::string& portal_name, const uint32_t row_limit) {
+  const auto previously_sent_row_count = _portals.at(portal_name).result_cursor.sent_row_count;
+
+  _send_result_part = [this, portal_name, row_limit, previously_sent_row_count]() {
+    auto& portal = _portals.at(portal_name);
+    const auto is_complete =
+        ResultSerializer::send_query_response(portal.result_table, _postgres_protocol_handler, portal.result_format_codes,
+                                              portal.result_cursor, row_limit, SERVER_BUFFER_SIZE);
+    const auto sent_row_count = portal.result_cursor.sent_row_count - previously_sent_row_count;
+
+    if (!is_complete) {
+      // The output has reached its limit. The remaining rows are sent once the client has received it.
+      if (row_limit == 0 || sent_row_count < row_limit) {
+        _postgres_protocol_handler->force_flush();
+        return false;
+      }
 
-  _postgres_protocol_handler->send_command_complete(
-      ResultSerializer::build_command_complete_message(physical_plan->type(), row_count));
-  // Ready for query + flush will be done after reading sync message
+      // The client fetches the remaining rows with further Execute messages.
+      _postgres_protocol_handler->send_status_message(PostgresMessageType::PortalSuspended);
+      return true;
+    }
+
+    // Like PostgreSQL, we only report the rows that were sent in response to this Execute message.
+    _postgres_protocol_handler->send_command_complete(
+        ResultSerializer::build_command_complete_message(portal.physical_plan->type(), sent_row_count));
+
+    // The unnamed portal is closed after its execution, named portals can be executed again.
+    if (portal_name.empty()) {
+      _portals.erase(portal_name);
+    } else {
+      portal.result_table = nullptr;
+      portal.result_cursor = ResultCursor{};
+    }
+    // Ready for query + flush will be done after reading sync message
+    return true;
+  };
 }
 }  // namespace opossum
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
 #include "concurrency/transaction_context.hpp"
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
+#include "result_serializer.hpp"
 #include "scheduler/operator_task.hpp"
+#include "session_stream.hpp"
 
 namespace opossum {
 
@@ -12,25 +20,68 @@ namespace opossum {
 // portals used for CURSOR operations are currently not supported by Hyrise. For further documentation see here:
 // https://www.postgresql.org/docs/12/protocol-overview.html#PROTOCOL-QUERY-CONCEPTS
 // Example usage can be found here: https://stackoverflow.com/questions/52479293/postgresql-refcursor-and-portal-name
-class Session {
+//
+// Sessions do not own a thread. All communication with the client is asynchronous: The session receives data until a
+// request message is complete and only then lets one of the threads running the io_service handle it. The protocol
+// handler does not operate on the socket but on a SessionStream, which holds the complete message and collects the
+// response. The response is sent asynchronously, too, and is kept in memory until the client has received it. Results
+// are serialized in parts of about SERVER_BUFFER_SIZE bytes, the next of which is serialized once the client has
+// received the previous one. Thus, a client that stalls in the middle of a message or does not fetch its results
+// neither blocks any thread nor makes the session buffer its entire result. Queries are
+// executed as tasks of the scheduler. The io_service thread is released during the execution and the session continues
+// on one of the io_service threads once the result is available. Only one of these steps is pending for a session at
+// any time, so the session's state is never accessed concurrently.
+class Session : public std::enable_shared_from_this<Session> {
  public:
   explicit Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info);
 
-  // Start new session.
-  void run();
+  // Start new session. The session keeps itself alive until the client disconnects, after which on_close is called.
+  void start(const std::function<void()>& on_close);
 
   std::shared_ptr<Socket> socket();
 
  private:
+  // Handle all complete requests that have been received and receive further requests afterwards.
+  void _process_requests();
+
+  // Receive data from the client asynchronously. _process_requests is called once data has arrived.
+  void _receive_requests();
+
+  // Serialize the next part of the result that is being sent, if any. Send the output of the protocol handler
+  // asynchronously, if there is any, and continue with the next part of the result or further requests afterwards.
+  void _send_output_and_process_requests();
+
+  // Returns the size of the first message in the received data if its header has been received completely.
+  std::optional<size_t> _message_size() const;
+
+  // Send an error for a message that exceeds MAX_MESSAGE_SIZE and close the session afterwards.
+  void _reject_oversized_message(const size_t message_size);
+
+  // Returns true if the complete first message of the received data asks for SSL.
+  bool _is_ssl_request(const size_t message_size) const;
+
+  // Run a step of the message flow. If it fails, an error message is sent to the client. Returns false if the client
+  // has disconnected.
+  bool _handle_errors(const std::function<void()>& step);
+
+  // Execute execute_step as a task of the scheduler. Afterwards, the session continues with send_step on an io_service
+  // thread and processes further requests.
+  void _execute_async(const std::function<void()>& execute_step, const std::function<void()>& send_step);
+
+  void _close();
+
   // Establish new connection by exchanging parameters.
   void _establish_connection();
 
-  // Determine message and call the appropriate method.
-  void _handle_request();
+  // Determine message and call the appropriate method. Returns true if the request is executed asynchronously.
+  bool _handle_request();
 
   // Execute plain SQL statement.
   void _handle_simple_query();
 
+  // Send the messages that follow the result of a simple query.
+  void _complete_simple_query(const ExecutionInformation& execution_information, const uint64_t row_count);
+
   // Parse prepared statement.
   void _handle_parse_command();
 
@@ -40,18 +91,43 @@ class Session {
   // Read describe message. Row description will be send after execution.
   void _handle_describe();
 
-  // Execute prepared statement and send row description.
-  void _handle_execute();
+  // Execute prepared statement and send row description. Returns false if binding has failed and there is nothing to
+  // execute.
+  bool _handle_execute();
+
+  // Send the next rows of an executed portal's result in parts (see _send_result_part). Either suspends the portal or
+  // completes the command.
+  void _send_portal_result(const std::string& portal_name, const uint32_t row_limit);
 
   // Commit current transaction.
   void _sync();
 
+  // A portal holds a bound prepared statement and the formats in which the client expects its result columns. If the
+  // client limits the number of rows per Execute message, the portal is suspended after sending these rows. It keeps
+  // the result table and the position of the next row until the remaining rows have been fetched.
+  struct Portal {
+    std::shared_ptr<AbstractOperator> physical_plan;
+    std::vector<FormatCode> result_format_codes;
+    std::shared_ptr<const Table> result_table;
+    ResultCursor result_cursor;
+  };
+
   const std::shared_ptr<Socket> _socket;
-  const std::shared_ptr<PostgresProtocolHandler<Socket>> _postgres_protocol_handler;
+  const std::shared_ptr<SessionStream> _stream;
+  const std::shared_ptr<PostgresProtocolHandler<SessionStream>> _postgres_protocol_handler;
+  // Buffer for asynchronous reads from the socket and data that has been received but not been handled yet
+  std::array<char, SERVER_BUFFER_SIZE> _receive_buffer;
+  std::string _received_data;
   const SendExecutionInfo _send_execution_info;
+  std::function<void()> _on_close;
+  bool _connection_established = false;
   bool _terminate_session = false;
+  bool _closed = false;
   bool _sync_send_after_error = false;
   std::shared_ptr<TransactionContext> _transaction_context;
-  std::unordered_map<std::string, std::shared_ptr<AbstractOperator>> _portals;
+  std::unordered_map<std::string, Portal> _portals;
+  // Serializes the next part of a result with about SERVER_BUFFER_SIZE bytes, flushes it, and returns true once the
+  // result has been sent completely. The session calls it again whenever the client has received the previous part.
+  std::function<bool()> _send_result_part;
 };
 }  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <boost/asio.hpp>
+
+namespace opossum {
+
+// In-memory stream that a session's PostgresProtocolHandler reads from and writes to instead of the network socket.
+// The session receives complete messages from the client asynchronously and appends them to the input. Likewise, it
+// takes the output and sends it to the client asynchronously. Hence, reading and writing on this stream never blocks,
+// even if the client stalls in the middle of a message or does not fetch its results.
+class SessionStream {
+ public:
+  // Add a complete message to the input
+  void append_input(const std::string_view message) {
+    if (_input_position == _input.size()) {
+      _input.clear();
+      _input_position = 0;
+    }
+    _input.append(message);
+  }
+
+  bool has_output() const { return !_output.empty(); }
+
+  // Remove the output that has not been sent yet and return it
+  std::string take_output() { return std::exchange(_output, std::string{}); }
+
+  // Read as many bytes as available (SyncReadStream). The session only passes complete messages. Thus, running out of
+  // input means that a message is shorter than its header claims, which we treat as a disconnect.
+  template <typename MutableBufferSequence>
+  size_t read_some(const MutableBufferSequence& buffers, boost::system::error_code& error_code) {
+    const auto bytes_read = boost::asio::buffer_copy(
+        buffers, boost::asio::buffer(_input.data() + _input_position, _input.size() - _input_position));
+    _input_position += bytes_read;
+    error_code = bytes_read == 0 && boost::asio::buffer_size(buffers) > 0 ? boost::asio::error::eof
+                                                                          : boost::system::error_code{};
+    return bytes_read;
+  }
+
+  // Append all bytes to the output (SyncWriteStream)
+  template <typename ConstBufferSequence>
+  size_t write_some(const ConstBufferSequence& buffers, boost::system::error_code& error_code) {
+    const auto previous_size = _output.size();
+    const auto bytes_written = boost::asio::buffer_size(buffers);
+    _output.resize(previous_size + bytes_written);
+    boost::asio::buffer_copy(boost::asio::buffer(_output.data() + previous_size, bytes_written), buffers);
+    error_code = {};
+    return bytes_written;
+  }
+
+ private:
+  std::string _input;
+  // Position of the first byte of the input that has not been read yet
+  size_t _input_position{0};
+  std::string _output;
+};
+
+}  // namespace opossum
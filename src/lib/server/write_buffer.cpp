@@ -1,6 +1,7 @@
 #include "write_buffer.hpp"
 
 #include "client_disconnect_exception.hpp"
+#include "session_stream.hpp"
 
 namespace opossum {
 
@@ -21,7 +22,7 @@ bool WriteBuffer<SocketType>::full() const {
 }
 
 template <typename SocketType>
-void WriteBuffer<SocketType>::put_string(const std::string& value, const HasNullTerminator has_null_terminator) {
+void WriteBuffer<SocketType>::put_string(std::string_view value, const HasNullTerminator has_null_terminator) {
   auto position_in_string = 0u;
 
   // Use available space first
@@ -85,7 +86,7 @@ void WriteBuffer<SocketType>::_flush_if_necessary(const size_t bytes_required) {
   }
 }
 
-template class WriteBuffer<Socket>;
+template class WriteBuffer<SessionStream>;
 template class WriteBuffer<boost::asio::posix::stream_descriptor>;
 
 }  // namespace opossum
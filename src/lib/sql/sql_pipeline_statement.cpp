@@ -186,7 +186,7 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
     // Reset time to exclude previous pipeline steps
     started = std::chrono::high_resolution_clock::now();
-    _physical_plan = LQPTranslator{}.translate_node(lqp);
+    _physical_plan = LQPTranslator{_optimizer->cost_estimator()->cardinality_estimator}.translate_node(lqp);
   }
 
   done = std::chrono::high_resolution_clock::now();
@@ -2,15 +2,68 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "cache/gdfs_cache.hpp"
+#include "cache/sharded_cache.hpp"
+#include "utils/assert.hpp"
 
 namespace opossum {
 
 class AbstractOperator;
 class AbstractLQPNode;
 
-using SQLPhysicalPlanCache = GDFSCache<std::string, std::shared_ptr<AbstractOperator>>;
-using SQLLogicalPlanCache = GDFSCache<std::string, std::shared_ptr<AbstractLQPNode>>;
+// The GDFSCache has the better hit ratio, but serializes all accesses. The ShardedCache scales to many concurrent
+// clients (see sharded_cache.hpp).
+enum class PlanCacheType { GDFS, Sharded };
+
+// Plan cache that forwards all calls to the cache implementation selected by the PlanCacheType.
+template <typename Value>
+class SQLPlanCache : public AbstractCache<std::string, Value> {
+ public:
+  using SnapshotEntry = typename AbstractCache<std::string, Value>::SnapshotEntry;
+
+  explicit SQLPlanCache(size_t capacity = DEFAULT_CACHE_CAPACITY, const PlanCacheType type = PlanCacheType::GDFS)
+      : AbstractCache<std::string, Value>(capacity), _type(type) {
+    switch (type) {
+      case PlanCacheType::GDFS:
+        _cache = std::make_unique<GDFSCache<std::string, Value>>(capacity);
+        break;
+      case PlanCacheType::Sharded:
+        _cache = std::make_unique<ShardedCache<std::string, Value>>(capacity);
+        break;
+    }
+  }
+
+  void set(const std::string& key, const Value& value, double cost = 1.0, double size = 1.0) final {
+    _cache->set(key, value, cost, size);
+  }
+
+  std::optional<Value> try_get(const std::string& key) final { return _cache->try_get(key); }
+
+  bool has(const std::string& key) const final { return _cache->has(key); }
+
+  size_t size() const final { return _cache->size(); }
+
+  void clear() final { _cache->clear(); }
+
+  void resize(size_t capacity) final {
+    _cache->resize(capacity);
+    this->_capacity = capacity;
+  }
+
+  std::unordered_map<std::string, SnapshotEntry> snapshot() const final { return _cache->snapshot(); }
+
+  PlanCacheType type() const { return _type; }
+
+ protected:
+  void _evict() final { Fail("Eviction is handled by the underlying cache"); }
+
+  const PlanCacheType _type;
+  std::unique_ptr<AbstractCache<std::string, Value>> _cache;
+};
+
+using SQLPhysicalPlanCache = SQLPlanCache<std::shared_ptr<AbstractOperator>>;
+using SQLLogicalPlanCache = SQLPlanCache<std::shared_ptr<AbstractLQPNode>>;
 
 }  // namespace opossum
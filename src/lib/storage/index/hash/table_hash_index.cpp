@@ -0,0 +1,139 @@
+#include "table_hash_index.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "lossless_cast.hpp"
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_iterate.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+class TableHashIndexImpl : public BaseTableHashIndexImpl {
+ public:
+  void insert(const ChunkID chunk_id, const Chunk& chunk, const ColumnID column_id, const ChunkOffset begin_offset,
+              const ChunkOffset end_offset) final {
+    const auto& segment = *chunk.get_segment(column_id);
+    DebugAssert(end_offset <= segment.size(), "Range to index exceeds the segment");
+
+    segment_with_iterators<T>(segment, [&](auto iter, [[maybe_unused]] const auto end) {
+      iter += begin_offset;
+      for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset, ++iter) {
+        const auto position = *iter;
+        if (position.is_null()) continue;
+
+        _row_ids[position.value()].emplace_back(chunk_id, chunk_offset);
+        ++_row_count;
+      }
+    });
+  }
+
+  void remove(const ChunkID chunk_id, const Chunk& chunk, const ColumnID column_id, const ChunkOffset begin_offset,
+              const ChunkOffset end_offset) final {
+    const auto& segment = *chunk.get_segment(column_id);
+    DebugAssert(end_offset <= segment.size(), "Range to remove exceeds the segment");
+
+    auto values = std::unordered_set<T>{};
+    segment_with_iterators<T>(segment, [&](auto iter, [[maybe_unused]] const auto end) {
+      iter += begin_offset;
+      for (auto chunk_offset = begin_offset; chunk_offset < end_offset; ++chunk_offset, ++iter) {
+        const auto position = *iter;
+        if (!position.is_null()) values.emplace(position.value());
+      }
+    });
+
+    for (const auto& value : values) {
+      const auto iter = _row_ids.find(value);
+      if (iter == _row_ids.end()) continue;
+
+      auto& row_ids = iter->second;
+      _row_count -= std::erase_if(row_ids, [&](const auto& row_id) {
+        return row_id.chunk_id == chunk_id && row_id.chunk_offset >= begin_offset && row_id.chunk_offset < end_offset;
+      });
+      if (row_ids.empty()) _row_ids.erase(iter);
+    }
+  }
+
+  void equals(const AllTypeVariant& value, RowIDPosList& matches) const final {
+    // Values that cannot be represented in the column's type (e.g., 1.5 for an int column) and NULLs match no row
+    const auto typed_value = lossless_variant_cast<T>(value);
+    if (!typed_value) return;
+
+    const auto iter = _row_ids.find(*typed_value);
+    if (iter == _row_ids.end()) return;
+
+    matches.insert(matches.end(), iter->second.begin(), iter->second.end());
+  }
+
+  size_t row_count() const final { return _row_count; }
+
+  size_t memory_usage() const final {
+    auto bytes = sizeof(*this) + _row_ids.bucket_count() * sizeof(void*);
+    for (const auto& [value, row_ids] : _row_ids) {
+      bytes += sizeof(value) + sizeof(row_ids) + row_ids.capacity() * sizeof(RowID);
+      if constexpr (std::is_same_v<T, pmr_string>) {
+        bytes += value.capacity();
+      }
+    }
+    return bytes;
+  }
+
+ private:
+  std::unordered_map<T, std::vector<RowID>> _row_ids;
+  size_t _row_count{0};
+};
+
+}  // namespace
+
+namespace opossum {
+
+TableHashIndex::TableHashIndex(const DataType data_type, const ColumnID column_id)
+    : _data_type(data_type), _column_id(column_id) {
+  resolve_data_type(data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    _impl = std::make_unique<TableHashIndexImpl<ColumnDataType>>();
+  });
+}
+
+ColumnID TableHashIndex::column_id() const { return _column_id; }
+
+DataType TableHashIndex::data_type() const { return _data_type; }
+
+void TableHashIndex::insert(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+                            const ChunkOffset end_offset) {
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  _impl->insert(chunk_id, chunk, _column_id, begin_offset, end_offset);
+}
+
+void TableHashIndex::remove(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+                            const ChunkOffset end_offset) {
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  _impl->remove(chunk_id, chunk, _column_id, begin_offset, end_offset);
+}
+
+void TableHashIndex::remove(const ChunkID chunk_id, const Chunk& chunk) {
+  remove(chunk_id, chunk, ChunkOffset{0}, chunk.size());
+}
+
+void TableHashIndex::equals(const AllTypeVariant& value, RowIDPosList& matches) const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  _impl->equals(value, matches);
+}
+
+size_t TableHashIndex::row_count() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return _impl->row_count();
+}
+
+size_t TableHashIndex::memory_usage() const {
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+  return sizeof(*this) + _impl->memory_usage();
+}
+
+}  // namespace opossum
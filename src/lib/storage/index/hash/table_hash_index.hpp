@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <shared_mutex>
+
+#include "all_type_variant.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+
+class BaseTableHashIndexImpl : private Noncopyable {
+ public:
+  virtual ~BaseTableHashIndexImpl() = default;
+
+  virtual void insert(const ChunkID chunk_id, const Chunk& chunk, const ColumnID column_id,
+                      const ChunkOffset begin_offset, const ChunkOffset end_offset) = 0;
+  virtual void remove(const ChunkID chunk_id, const Chunk& chunk, const ColumnID column_id,
+                      const ChunkOffset begin_offset, const ChunkOffset end_offset) = 0;
+  virtual void equals(const AllTypeVariant& value, RowIDPosList& matches) const = 0;
+  virtual size_t row_count() const = 0;
+  virtual size_t memory_usage() const = 0;
+};
+
+/**
+ * Secondary index on a single column that spans all chunks of a table, including the mutable ones. It maps each
+ * non-NULL value to the RowIDs of the rows holding it, so that point lookups do not have to probe one index per chunk
+ * or scan the chunks that are not indexed yet.
+ *
+ * Unlike the chunk indexes (see AbstractIndex), which are built once on immutable segments, the index is maintained
+ * while the table changes: Table::append(), Table::append_chunk(), and Insert add the rows they have written, rolled
+ * back inserts remove them again, and Table::remove_chunk() drops the entries of physically deleted chunks.
+ *
+ * The index does not know about MVCC. It contains rows of uncommitted inserts as well as deleted rows, which older
+ * snapshots might still see. Thus, the results of lookups have to be validated just like those of a TableScan.
+ *
+ * Thread-safe: lookups can run concurrently with inserts.
+ */
+class TableHashIndex : private Noncopyable {
+ public:
+  TableHashIndex(const DataType data_type, const ColumnID column_id);
+
+  ColumnID column_id() const;
+  DataType data_type() const;
+
+  // Adds the rows [begin_offset, end_offset) of the chunk with the given id
+  void insert(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+              const ChunkOffset end_offset);
+
+  // Removes the entries of the rows [begin_offset, end_offset) of the chunk with the given id
+  void remove(const ChunkID chunk_id, const Chunk& chunk, const ChunkOffset begin_offset,
+              const ChunkOffset end_offset);
+
+  // Removes all entries of the chunk with the given id
+  void remove(const ChunkID chunk_id, const Chunk& chunk);
+
+  // Appends the RowIDs of all rows that hold `value` to `matches`. NULL does not match any row.
+  void equals(const AllTypeVariant& value, RowIDPosList& matches) const;
+
+  // Number of indexed rows
+  size_t row_count() const;
+
+  size_t memory_usage() const;
+
+ private:
+  const DataType _data_type;
+  const ColumnID _column_id;
+
+  mutable std::shared_mutex _mutex;
+  std::unique_ptr<BaseTableHashIndexImpl> _impl;
+};
+
+}  // namespace opossum
@@ -0,0 +1,76 @@
+#include "bitmap_pos_list.hpp"
+
+#include <utility>
+
+#include "row_id_pos_list.hpp"
+
+namespace opossum {
+
+bool BitmapPosList::prefer_bitmap(const size_t row_count, const ChunkOffset chunk_size) {
+  return static_cast<double>(row_count) >= MIN_RATIO * static_cast<double>(chunk_size);
+}
+
+BitmapPosList::Bitmap BitmapPosList::create_bitmap(const ChunkOffset chunk_size) {
+  return Bitmap((chunk_size + BITS_PER_WORD - 1) / BITS_PER_WORD, uint64_t{0});
+}
+
+BitmapPosList::BitmapPosList(const ChunkID common_chunk_id, const ChunkOffset chunk_size, Bitmap bitmap)
+    : _common_chunk_id(common_chunk_id), _chunk_size(chunk_size), _bitmap(std::move(bitmap)) {
+  DebugAssert(_common_chunk_id != INVALID_CHUNK_ID, "Cannot create BitmapPosList for INVALID_CHUNK_ID");
+  Assert(_bitmap.size() == (chunk_size + BITS_PER_WORD - 1) / BITS_PER_WORD, "Bitmap does not match the chunk size");
+  _build_ranks();
+}
+
+BitmapPosList::BitmapPosList(const ChunkID common_chunk_id, const ChunkOffset chunk_size,
+                             const RowIDPosList& pos_list)
+    : _common_chunk_id(common_chunk_id), _chunk_size(chunk_size), _bitmap(create_bitmap(chunk_size)) {
+  DebugAssert(_common_chunk_id != INVALID_CHUNK_ID, "Cannot create BitmapPosList for INVALID_CHUNK_ID");
+  for (const auto& row_id : pos_list) {
+    DebugAssert(row_id.chunk_id == common_chunk_id && row_id.chunk_offset < chunk_size,
+                "PosList references rows outside of the chunk");
+    set_bit(_bitmap, row_id.chunk_offset);
+  }
+  _build_ranks();
+}
+
+bool BitmapPosList::references_single_chunk() const { return true; }
+
+ChunkID BitmapPosList::common_chunk_id() const { return _common_chunk_id; }
+
+bool BitmapPosList::empty() const { return size() == 0; }
+
+size_t BitmapPosList::size() const { return _ranks.back(); }
+
+size_t BitmapPosList::memory_usage(const MemoryUsageCalculationMode) const {
+  return sizeof *this + _bitmap.capacity() * sizeof(Bitmap::value_type) +
+         _ranks.capacity() * sizeof(decltype(_ranks)::value_type);
+}
+
+ChunkOffset BitmapPosList::chunk_size() const { return _chunk_size; }
+
+const BitmapPosList::Bitmap& BitmapPosList::bitmap() const { return _bitmap; }
+
+BitmapPosList::Iterator BitmapPosList::begin() const { return Iterator{this, 0}; }
+
+BitmapPosList::Iterator BitmapPosList::end() const { return Iterator{this, size()}; }
+
+BitmapPosList::Iterator BitmapPosList::cbegin() const { return begin(); }
+
+BitmapPosList::Iterator BitmapPosList::cend() const { return end(); }
+
+void BitmapPosList::_build_ranks() {
+  // Bits beyond the chunk size would be counted as rows
+  if (_chunk_size % BITS_PER_WORD != 0) {
+    DebugAssert(!(_bitmap.back() >> (_chunk_size % BITS_PER_WORD)), "Bits beyond the chunk size are set");
+  }
+
+  _ranks.resize(_bitmap.size() + 1);
+  auto rank = ChunkOffset{0};
+  for (auto word_index = size_t{0}; word_index < _bitmap.size(); ++word_index) {
+    _ranks[word_index] = rank;
+    rank += __builtin_popcountll(_bitmap[word_index]);
+  }
+  _ranks.back() = rank;
+}
+
+}  // namespace opossum
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "abstract_pos_list.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * The BitmapPosList references a subset of the rows of a single chunk by storing one bit per row of that chunk. A
+ * RowIDPosList needs eight bytes per referenced row instead. Next to the bitmap, we store the number of set bits
+ * before each 64-bit word. This gives us the position of a row within the PosList (position_of()) in O(1) and random
+ * access to the n-th row in O(log n). Sequential iteration only looks at the set bits and at the words in between.
+ *
+ * As it is chunk-local, a bitmap can be combined with the results of an unfiltered scan on the referenced chunk by
+ * simply checking the bits of the matches (see AbstractDereferencedColumnTableScanImpl). Operators choose between
+ * a BitmapPosList and a RowIDPosList using prefer_bitmap().
+ *
+ * The rows are always listed in ascending order of their chunk offsets.
+ */
+class BitmapPosList final : public AbstractPosList {
+ public:
+  using Bitmap = pmr_vector<uint64_t>;
+
+  static constexpr auto BITS_PER_WORD = size_t{64};
+
+  // Iterates over the set bits. It stores the current word with the bits that have already been visited cleared, so
+  // that incrementing it does not require a lookup in the rank directory.
+  class Iterator : public boost::iterator_facade<Iterator, RowID, boost::random_access_traversal_tag, RowID> {
+   public:
+    Iterator(const BitmapPosList* pos_list, const size_t index) : _pos_list(pos_list) { _seek(index); }
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    // Advancing by up to this many rows is done by clearing bits instead of searching the rank directory
+    static constexpr auto MAX_SEQUENTIAL_ADVANCE = std::ptrdiff_t{64};
+
+    void increment() {
+      ++_index;
+      _word &= _word - 1;
+
+      const auto word_count = _pos_list->_bitmap.size();
+      while (!_word && ++_word_index < word_count) {
+        _word = _pos_list->_bitmap[_word_index];
+      }
+    }
+
+    void decrement() { _seek(_index - 1); }
+
+    void advance(const std::ptrdiff_t n) {
+      if (n >= 0 && n <= MAX_SEQUENTIAL_ADVANCE) {
+        for (auto step = std::ptrdiff_t{0}; step < n; ++step) {
+          increment();
+        }
+      } else {
+        _seek(_index + n);
+      }
+    }
+
+    bool equal(const Iterator& other) const {
+      DebugAssert(_pos_list == other._pos_list, "Iterator compared to iterator on different BitmapPosList");
+      return _index == other._index;
+    }
+
+    std::ptrdiff_t distance_to(const Iterator& other) const {
+      return static_cast<std::ptrdiff_t>(other._index) - static_cast<std::ptrdiff_t>(_index);
+    }
+
+    RowID dereference() const {
+      DebugAssert(_word, "past-the-end BitmapPosList::Iterator dereferenced");
+      return RowID{_pos_list->_common_chunk_id,
+                   static_cast<ChunkOffset>(_word_index * BITS_PER_WORD + __builtin_ctzll(_word))};
+    }
+
+    void _seek(const size_t index) {
+      _index = index;
+
+      const auto& bitmap = _pos_list->_bitmap;
+      if (index >= _pos_list->size()) {
+        _word_index = bitmap.size();
+        _word = 0;
+        return;
+      }
+
+      // Find the last word that has at most `index` set bits before it. As index < size(), that word contains the
+      // index-th set bit.
+      const auto& ranks = _pos_list->_ranks;
+      _word_index = static_cast<size_t>(std::upper_bound(ranks.begin(), ranks.end(), index) - ranks.begin() - 1);
+      _word = bitmap[_word_index];
+      for (auto skipped_bits = index - ranks[_word_index]; skipped_bits > 0; --skipped_bits) {
+        _word &= _word - 1;
+      }
+    }
+
+    const BitmapPosList* _pos_list;
+    size_t _index{};
+    size_t _word_index{};
+    uint64_t _word{};
+  };
+
+  // Fraction of the rows in the referenced chunk that have to be part of the PosList for a bitmap to be preferred
+  // over a RowIDPosList. At this ratio, the bitmap and its rank directory need a fifth of the memory of the RowIDs.
+  // For sparser lists, skipping the empty words makes the bitmap slower to iterate.
+  static constexpr auto MIN_RATIO = 0.125;
+
+  static bool prefer_bitmap(const size_t row_count, const ChunkOffset chunk_size);
+
+  // Returns a bitmap without any set bits for a chunk with `chunk_size` rows
+  static Bitmap create_bitmap(const ChunkOffset chunk_size);
+
+  static void set_bit(Bitmap& bitmap, const ChunkOffset chunk_offset) {
+    bitmap[chunk_offset / BITS_PER_WORD] |= uint64_t{1} << (chunk_offset % BITS_PER_WORD);
+  }
+
+  BitmapPosList(const ChunkID common_chunk_id, const ChunkOffset chunk_size, Bitmap bitmap);
+
+  // Creates the bitmap from a RowIDPosList that only references rows of the given chunk
+  BitmapPosList(const ChunkID common_chunk_id, const ChunkOffset chunk_size, const RowIDPosList& pos_list);
+
+  bool references_single_chunk() const final;
+  ChunkID common_chunk_id() const final;
+
+  RowID operator[](const size_t index) const final { return *Iterator{this, index}; }
+
+  bool empty() const final;
+  size_t size() const final;
+  size_t memory_usage(const MemoryUsageCalculationMode) const final;
+
+  // Number of rows in the referenced chunk, i.e., the number of bits
+  ChunkOffset chunk_size() const;
+
+  const Bitmap& bitmap() const;
+
+  // Returns whether the row with the given offset in the referenced chunk is part of the PosList
+  bool contains(const ChunkOffset chunk_offset) const {
+    return chunk_offset < _chunk_size &&
+           (_bitmap[chunk_offset / BITS_PER_WORD] >> (chunk_offset % BITS_PER_WORD)) & uint64_t{1};
+  }
+
+  // Returns the index at which the row with the given offset is listed. Requires contains(chunk_offset).
+  size_t position_of(const ChunkOffset chunk_offset) const {
+    DebugAssert(contains(chunk_offset), "Row is not part of the BitmapPosList");
+    const auto word_index = chunk_offset / BITS_PER_WORD;
+    const auto bits_before = _bitmap[word_index] & ((uint64_t{1} << (chunk_offset % BITS_PER_WORD)) - 1);
+    return _ranks[word_index] + __builtin_popcountll(bits_before);
+  }
+
+  Iterator begin() const;
+  Iterator end() const;
+  Iterator cbegin() const;
+  Iterator cend() const;
+
+ private:
+  void _build_ranks();
+
+  const ChunkID _common_chunk_id;
+  const ChunkOffset _chunk_size;
+  Bitmap _bitmap;
+
+  // _ranks[i] holds the number of set bits in the words before _bitmap[i]. The last entry holds the total count.
+  pmr_vector<ChunkOffset> _ranks;
+};
+
+}  // namespace opossum
@@ -130,6 +130,12 @@ void Table::append(const std::vector<AllTypeVariant>& values) {
   }
 
   last_chunk->append(values);
+
+  const auto chunk_id = ChunkID{chunk_count() - 1};
+  const auto chunk_offset = ChunkOffset{last_chunk->size() - 1};
+  for (const auto& table_index : _table_indexes) {
+    table_index->insert(chunk_id, *last_chunk, chunk_offset, chunk_offset + 1);
+  }
 }
 
 void Table::append_mutable_chunk() {
@@ -221,6 +227,14 @@ void Table::remove_chunk(ChunkID chunk_id) {
               }()),
               "Physical delete of chunk prevented: Chunk needs to be fully invalidated before.");
   Assert(_type == TableType::Data, "Removing chunks from other tables than data tables is not intended yet.");
+
+  if (!_table_indexes.empty()) {
+    const auto chunk = get_chunk(chunk_id);
+    for (const auto& table_index : _table_indexes) {
+      table_index->remove(chunk_id, *chunk);
+    }
+  }
+
   std::atomic_store(&_chunks[chunk_id], std::shared_ptr<Chunk>(nullptr));
 }
 
@@ -254,7 +268,15 @@ void Table::append_chunk(const Segments& segments, std::shared_ptr<MvccData> mvc
   // making sure that an uninitialized entry compares equal to nullptr and (2) insert the desired chunk atomically.
 
   auto new_chunk_iter = _chunks.push_back(nullptr);
-  std::atomic_store(&*new_chunk_iter, std::make_shared<Chunk>(segments, mvcc_data, alloc));
+  const auto chunk = std::make_shared<Chunk>(segments, mvcc_data, alloc);
+  std::atomic_store(&*new_chunk_iter, chunk);
+
+  if (!_table_indexes.empty()) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(std::distance(_chunks.begin(), new_chunk_iter))};
+    for (const auto& table_index : _table_indexes) {
+      table_index->insert(chunk_id, *chunk, ChunkOffset{0}, chunk->size());
+    }
+  }
 }
 
 std::vector<AllTypeVariant> Table::get_row(size_t row_idx) const {
@@ -321,6 +343,33 @@ void Table::set_table_statistics(const std::shared_ptr<TableStatistics>& table_s
 
 std::vector<IndexStatistics> Table::indexes_statistics() const { return _indexes; }
 
+void Table::create_table_index(const ColumnID column_id) {
+  Assert(_type == TableType::Data, "Table indexes can only be created on data tables");
+  Assert(column_id < column_count(), "ColumnID out of range");
+  Assert(!table_index(column_id), "Column already has a table index");
+
+  const auto table_index = std::make_shared<TableHashIndex>(column_data_type(column_id), column_id);
+
+  const auto chunk_count = _chunks.size();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    table_index->insert(chunk_id, *chunk, ChunkOffset{0}, chunk->size());
+  }
+
+  _table_indexes.emplace_back(table_index);
+}
+
+std::shared_ptr<TableHashIndex> Table::table_index(const ColumnID column_id) const {
+  for (const auto& table_index : _table_indexes) {
+    if (table_index->column_id() == column_id) return table_index;
+  }
+  return nullptr;
+}
+
+const std::vector<std::shared_ptr<TableHashIndex>>& Table::table_indexes() const { return _table_indexes; }
+
 const TableKeyConstraints& Table::soft_key_constraints() const { return _table_key_constraints; }
 
 void Table::add_soft_key_constraint(const TableKeyConstraint& table_key_constraint) {
@@ -410,6 +459,10 @@ size_t Table::memory_usage(const MemoryUsageCalculationMode mode) const {
     bytes += column_definition.name.size();
   }
 
+  for (const auto& table_index : _table_indexes) {
+    bytes += table_index->memory_usage();
+  }
+
   // TODO(anybody) Statistics and Indexes missing from Memory Usage Estimation
   // TODO(anybody) TableLayout missing
 
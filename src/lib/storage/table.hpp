@@ -10,6 +10,7 @@
 
 #include "abstract_segment.hpp"
 #include "chunk.hpp"
+#include "storage/index/hash/table_hash_index.hpp"
 #include "storage/index/index_statistics.hpp"
 #include "storage/table_column_definition.hpp"
 #include "table_key_constraint.hpp"
@@ -197,6 +198,20 @@ class Table : private Noncopyable {
     _indexes.emplace_back(index_statistics);
   }
 
+  /**
+   * Table indexes span all chunks of the table, including mutable ones, and are maintained by append(),
+   * append_chunk(), and Insert (see TableHashIndex). create_table_index() indexes the existing rows and must not run
+   * concurrently with inserts into the table. There is at most one table index per column.
+   * @{
+   */
+  void create_table_index(const ColumnID column_id);
+
+  // Returns nullptr if the column is not indexed
+  std::shared_ptr<TableHashIndex> table_index(const ColumnID column_id) const;
+
+  const std::vector<std::shared_ptr<TableHashIndex>>& table_indexes() const;
+  /** @} */
+
   /**
    * NOTE: Key constraints are currently NOT ENFORCED and are only used to develop optimization rules.
    * We call them "soft" key constraints to draw attention to that.
@@ -245,6 +260,7 @@ class Table : private Noncopyable {
   std::shared_ptr<TableStatistics> _table_statistics;
   std::unique_ptr<std::mutex> _append_mutex;
   std::vector<IndexStatistics> _indexes;
+  std::vector<std::shared_ptr<TableHashIndex>> _table_indexes;
 
   // For tables with _type==Reference, the row count will not vary. As such, there is no need to iterate over all
   // chunks more than once.
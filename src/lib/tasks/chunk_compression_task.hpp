@@ -35,16 +35,16 @@ class ChunkCompressionTask : public AbstractTask {
   explicit ChunkCompressionTask(const std::string& table_name, const ChunkID chunk_id);
   explicit ChunkCompressionTask(const std::string& table_name, const std::vector<ChunkID>& chunk_ids);
 
- protected:
-  void _on_execute() override;
-
- private:
   /**
    * @brief Checks if a chunks is completed
    *
-   * See class comment for further explanation
+   * See class comment for further explanation. Chunks without MVCC data are completed once they are full. Also used
+   * by plugins that finalize chunks in the background.
    */
-  static bool _chunk_is_completed(const std::shared_ptr<Chunk>& chunk, const uint32_t target_chunk_size);
+  static bool chunk_is_completed(const std::shared_ptr<Chunk>& chunk, const uint32_t target_chunk_size);
+
+ protected:
+  void _on_execute() override;
 
  private:
   const std::string _table_name;
@@ -0,0 +1,75 @@
+#include "blocked_bloom_filter.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace opossum {
+
+std::optional<double> BlockedBloomFilter::ProbeStatistics::selectivity() const {
+  if (probed_count == 0) return std::nullopt;
+  return static_cast<double>(passed_count) / static_cast<double>(probed_count);
+}
+
+BlockedBloomFilter::BlockedBloomFilter() : _blocks(1) {}
+
+BlockedBloomFilter::BlockedBloomFilter(const size_t expected_element_count) {
+  constexpr auto BITS_PER_BLOCK = WORDS_PER_BLOCK * sizeof(uint32_t) * 8;
+  const auto bit_count = expected_element_count * BITS_PER_ELEMENT;
+  const auto block_count = (bit_count + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+  _blocks = std::vector<Block>(std::clamp(block_count, size_t{1}, MAX_BLOCK_COUNT));
+}
+
+BlockedBloomFilter::BlockedBloomFilter(BlockedBloomFilter&& other) noexcept
+    : _blocks(std::move(other._blocks)),
+      _probed_count(other._probed_count.load()),
+      _passed_count(other._passed_count.load()) {}
+
+BlockedBloomFilter& BlockedBloomFilter::operator=(BlockedBloomFilter&& other) noexcept {
+  _blocks = std::move(other._blocks);
+  _probed_count = other._probed_count.load();
+  _passed_count = other._passed_count.load();
+  return *this;
+}
+
+const BlockedBloomFilter& BlockedBloomFilter::all_true() {
+  static const auto all_true_filter = [] {
+    auto filter = BlockedBloomFilter{};
+    for (auto& word : filter._blocks[0].words) {
+      word = std::numeric_limits<uint32_t>::max();
+    }
+    return filter;
+  }();
+  return all_true_filter;
+}
+
+void BlockedBloomFilter::insert(const size_t hash) {
+  const auto mixed_hash = _mix(hash);
+  auto& block = _blocks[_block_index(mixed_hash)];
+  const auto masks = _masks(mixed_hash);
+
+  for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+    auto& word = block.words[word_index];
+    // Most values in a join column are duplicates or share bits with other values. Checking first avoids the more
+    // expensive atomic read-modify-write in these cases.
+    if ((word.load(std::memory_order_relaxed) & masks[word_index]) != masks[word_index]) {
+      word.fetch_or(masks[word_index], std::memory_order_relaxed);
+    }
+  }
+}
+
+void BlockedBloomFilter::record_probes(const size_t probed_count, const size_t passed_count) const {
+  _probed_count.fetch_add(probed_count, std::memory_order_relaxed);
+  _passed_count.fetch_add(passed_count, std::memory_order_relaxed);
+}
+
+BlockedBloomFilter::ProbeStatistics BlockedBloomFilter::probe_statistics() const {
+  return ProbeStatistics{_probed_count.load(), _passed_count.load()};
+}
+
+size_t BlockedBloomFilter::block_count() const { return _blocks.size(); }
+
+size_t BlockedBloomFilter::memory_usage() const { return sizeof(*this) + _blocks.size() * sizeof(Block); }
+
+}  // namespace opossum
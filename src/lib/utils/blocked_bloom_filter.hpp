@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Split block Bloom filter: The filter consists of 256-bit blocks, each of which lies within a single cache line. A
+ * value sets (and a lookup tests) exactly one bit in each of the eight 32-bit words of a single block, i.e., k=8. Thus,
+ * every insert or lookup touches a single cache line and the bits can be computed without data dependencies.
+ *
+ * The filter is sized for the expected number of elements (usually the cardinality of the input it is built from),
+ * using BITS_PER_ELEMENT bits per element. This gives a false positive rate of roughly 0.15% if the estimate holds.
+ *
+ * Inserting is thread-safe and lock-free, so that multiple jobs can fill the same filter without building and merging
+ * local copies. Lookups must not run concurrently with inserts.
+ *
+ * The filter expects hash values (e.g., from std::hash) as input. As these are not necessarily well distributed (for
+ * integers, std::hash usually is the identity), they are mixed before use.
+ */
+class BlockedBloomFilter {
+ public:
+  static constexpr auto BITS_PER_ELEMENT = size_t{16};
+
+  // Upper bound for the memory used by a single filter (64 MB). Larger inputs get a higher false positive rate.
+  static constexpr auto MAX_BLOCK_COUNT = size_t{1} << 21;
+
+  // Number of probed values and the number of values that passed the filter, see record_probes().
+  struct ProbeStatistics {
+    size_t probed_count{0};
+    size_t passed_count{0};
+
+    // Fraction of probed values that passed the filter, std::nullopt if nothing was probed.
+    std::optional<double> selectivity() const;
+  };
+
+  // Creates an empty filter of a single block, usually as a placeholder for a filter that is assigned later.
+  BlockedBloomFilter();
+
+  // Creates an empty filter that is sized for expected_element_count elements.
+  explicit BlockedBloomFilter(const size_t expected_element_count);
+
+  // Moving is not thread-safe.
+  BlockedBloomFilter(BlockedBloomFilter&& other) noexcept;
+  BlockedBloomFilter& operator=(BlockedBloomFilter&& other) noexcept;
+
+  // Returns a filter for which contains() is always true. Having such a filter avoids a branch in hot loops where
+  // filtering is optional.
+  static const BlockedBloomFilter& all_true();
+
+  void insert(const size_t hash);
+
+  bool contains(const size_t hash) const {
+    const auto mixed_hash = _mix(hash);
+    const auto& block = _blocks[_block_index(mixed_hash)];
+    const auto masks = _masks(mixed_hash);
+
+    auto all_bits_set = true;
+    for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+      const auto word = block.words[word_index].load(std::memory_order_relaxed);
+      all_bits_set &= (word & masks[word_index]) == masks[word_index];
+    }
+    return all_bits_set;
+  }
+
+  // Adds to the statistics of how many values were probed and how many passed. As updating shared counters for every
+  // lookup would be expensive, callers are expected to count locally and call this once per batch (e.g., per chunk).
+  // Thread-safe.
+  void record_probes(const size_t probed_count, const size_t passed_count) const;
+
+  ProbeStatistics probe_statistics() const;
+
+  size_t block_count() const;
+  size_t memory_usage() const;
+
+ protected:
+  static constexpr auto WORDS_PER_BLOCK = size_t{8};
+
+  // A 32 byte-aligned block never spans two cache lines.
+  struct alignas(32) Block {
+    std::array<std::atomic<uint32_t>, WORDS_PER_BLOCK> words;
+  };
+
+  // Finalizer of MurmurHash3.
+  static uint64_t _mix(uint64_t hash) {
+    hash ^= hash >> 33u;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33u;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33u;
+    return hash;
+  }
+
+  // The upper 32 bits select the block (multiplicative range reduction instead of modulo), the lower 32 bits the bits
+  // within the block.
+  size_t _block_index(const uint64_t mixed_hash) const {
+    return static_cast<size_t>(((mixed_hash >> 32u) * _blocks.size()) >> 32u);
+  }
+
+  static std::array<uint32_t, WORDS_PER_BLOCK> _masks(const uint64_t mixed_hash) {
+    // Odd constants taken from Parquet's split block Bloom filter. Each one yields an independent bit position (the
+    // upper five bits of the product) for one word.
+    static constexpr auto SALTS = std::array<uint32_t, WORDS_PER_BLOCK>{
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    const auto key = static_cast<uint32_t>(mixed_hash);
+    auto masks = std::array<uint32_t, WORDS_PER_BLOCK>{};
+    for (auto word_index = size_t{0}; word_index < WORDS_PER_BLOCK; ++word_index) {
+      masks[word_index] = uint32_t{1} << ((key * SALTS[word_index]) >> 27u);
+    }
+    return masks;
+  }
+
+  std::vector<Block> _blocks;
+
+  mutable std::atomic<size_t> _probed_count{0};
+  mutable std::atomic<size_t> _passed_count{0};
+};
+
+}  // namespace opossum
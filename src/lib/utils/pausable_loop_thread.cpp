@@ -10,13 +10,14 @@ namespace opossum {
 
 PausableLoopThread::PausableLoopThread(std::chrono::milliseconds loop_sleep_time,
                                        const std::function<void(size_t)>& loop_func)
-    : _loop_sleep_time(loop_sleep_time) {
+    : _loop_sleep_time(loop_sleep_time.count()) {
   _loop_thread = std::thread([&, loop_func] {
     size_t counter = 0;
     while (!_shutdown_flag) {
       std::unique_lock<std::mutex> lk(_mutex);
-      if (_loop_sleep_time > std::chrono::milliseconds(0)) {
-        _cv.wait_for(lk, _loop_sleep_time, [&] { return static_cast<bool>(_shutdown_flag); });
+      const auto loop_sleep_time = std::chrono::milliseconds{_loop_sleep_time.load()};
+      if (loop_sleep_time > std::chrono::milliseconds(0)) {
+        _cv.wait_for(lk, loop_sleep_time, [&] { return static_cast<bool>(_shutdown_flag); });
       }
       if (_shutdown_flag) return;
       while (_pause_requested) {
@@ -31,6 +32,11 @@ PausableLoopThread::PausableLoopThread(std::chrono::milliseconds loop_sleep_time
   });
 }
 
+PausableLoopThread::PausableLoopThread(std::chrono::milliseconds initial_loop_sleep_time,
+                                       const std::function<std::chrono::milliseconds(size_t)>& loop_func)
+    : PausableLoopThread(initial_loop_sleep_time,
+                         [&, loop_func](size_t counter) { set_loop_sleep_time(loop_func(counter)); }) {}
+
 PausableLoopThread::~PausableLoopThread() {
   _pause_requested = true;
   _shutdown_flag = true;
@@ -51,7 +57,7 @@ void PausableLoopThread::resume() {
 }
 
 void PausableLoopThread::set_loop_sleep_time(std::chrono::milliseconds loop_sleep_time) {
-  _loop_sleep_time = loop_sleep_time;
+  _loop_sleep_time = loop_sleep_time.count();
 }
 
 }  // namespace opossum
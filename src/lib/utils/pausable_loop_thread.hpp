@@ -17,6 +17,11 @@ struct PausableLoopThread {
  public:
   PausableLoopThread(std::chrono::milliseconds loop_sleep_time, const std::function<void(size_t)>& loop_func);
 
+  // The loop function returns the time to sleep before its next call. As a lambda returning a duration also converts
+  // to the function type above, callers have to pass an std::function of this type explicitly.
+  PausableLoopThread(std::chrono::milliseconds initial_loop_sleep_time,
+                     const std::function<std::chrono::milliseconds(size_t)>& loop_func);
+
   ~PausableLoopThread();
   void pause();
   void resume();
@@ -29,6 +34,7 @@ struct PausableLoopThread {
   std::mutex _mutex;
   std::condition_variable _cv;
   std::thread _loop_thread;
-  std::chrono::milliseconds _loop_sleep_time;
+  // Written by set_loop_sleep_time() while the loop thread might read it
+  std::atomic<std::chrono::milliseconds::rep> _loop_sleep_time;
 };
 }  // namespace opossum
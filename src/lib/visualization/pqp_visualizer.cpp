@@ -8,6 +8,7 @@
 #include "operators/limit.hpp"
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/top_k.hpp"
 #include "utils/format_bytes.hpp"
 #include "utils/format_duration.hpp"
 #include "visualization/abstract_visualizer.hpp"
@@ -112,6 +113,11 @@ void PQPVisualizer::_build_subtree(const std::shared_ptr<const AbstractOperator>
       _visualize_subqueries(op, limit->row_count_expression(), visualized_ops);
     } break;
 
+    case OperatorType::TopK: {
+      const auto top_k = std::dynamic_pointer_cast<const TopK>(op);
+      _visualize_subqueries(op, top_k->row_count_expression(), visualized_ops);
+    } break;
+
     default: {
     }  // OperatorType has no expressions
   }
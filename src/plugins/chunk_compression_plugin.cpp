@@ -0,0 +1,132 @@
+#include "chunk_compression_plugin.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include "scheduler/abstract_scheduler.hpp"
+#include "scheduler/task_queue.hpp"
+#include "scheduler/worker.hpp"
+#include "storage/base_value_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+#include "tasks/chunk_compression_task.hpp"
+
+namespace opossum {
+
+std::string ChunkCompressionPlugin::description() const { return "Background chunk compression plugin"; }
+
+void ChunkCompressionPlugin::start() {
+  _loop_thread_compression =
+      std::make_unique<PausableLoopThread>(IDLE_DELAY_COMPRESSION, [&](size_t) { _compression_loop(); });
+}
+
+void ChunkCompressionPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_compression.reset();
+}
+
+void ChunkCompressionPlugin::set_encoding_spec(const std::string& table_name,
+                                               const ChunkEncodingSpec& chunk_encoding_spec) {
+  std::lock_guard<std::mutex> lock(_mutex_encoding_specs);
+  _encoding_specs[table_name] = chunk_encoding_spec;
+}
+
+/**
+ * This function finalizes completed chunks and encodes finalized chunks that still contain unencoded segments. It
+ * returns after MAX_CHUNKS_PER_ITERATION chunks have been encoded, so that later iterations continue with the
+ * remaining chunks.
+ */
+void ChunkCompressionPlugin::_compression_loop() {
+  // Encoding is not urgent. If queries are waiting for workers, we leave the cores to them.
+  if (_scheduler_is_busy()) return;
+
+  auto encoded_chunk_count = size_t{0};
+  const auto tables = Hyrise::get().storage_manager.tables();
+
+  for (const auto& [table_name, table] : tables) {
+    if (table->type() != TableType::Data) continue;
+
+    const auto column_data_types = table->column_data_types();
+    const auto chunk_encoding_spec = _encoding_spec(table_name, *table);
+    const auto chunk_count = table->chunk_count();
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      if (chunk->is_mutable()) {
+        // Insert allocates rows in the last chunk while holding the append mutex. Holding it here guarantees that no
+        // rows are added to the chunk while we finalize it.
+        const auto append_lock = table->acquire_append_mutex();
+        if (!ChunkCompressionTask::chunk_is_completed(chunk, table->target_chunk_size())) continue;
+        chunk->finalize();
+      }
+
+      if (!_chunk_needs_encoding(*chunk, chunk_encoding_spec)) continue;
+
+      ChunkEncoder::encode_chunk(chunk, column_data_types, chunk_encoding_spec);
+
+      std::ostringstream message;
+      message << "Encoded chunk " << chunk_id << " of " << table_name;
+      Hyrise::get().log_manager.add_message("ChunkCompressionPlugin", message.str(), LogLevel::Debug);
+
+      ++encoded_chunk_count;
+      if (encoded_chunk_count == MAX_CHUNKS_PER_ITERATION) return;
+    }
+  }
+}
+
+ChunkEncodingSpec ChunkCompressionPlugin::_encoding_spec(const std::string& table_name, const Table& table) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex_encoding_specs);
+    const auto iter = _encoding_specs.find(table_name);
+    if (iter != _encoding_specs.end()) {
+      Assert(iter->second.size() == table.column_count(), "Encoding spec does not match the table's column count");
+      return iter->second;
+    }
+  }
+
+  // Use the encoding of the first finalized chunk, including columns that were deliberately left unencoded. Chunks
+  // that this plugin finalizes are encoded in the same iteration, so a finalized chunk with value segments was not
+  // left unencoded by us. If there is no finalized chunk yet, all columns are dictionary-encoded.
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk || chunk->is_mutable()) continue;
+
+    auto chunk_encoding_spec = ChunkEncodingSpec{};
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      chunk_encoding_spec.emplace_back(get_segment_encoding_spec(chunk->get_segment(column_id)));
+    }
+    return chunk_encoding_spec;
+  }
+
+  return ChunkEncodingSpec(table.column_count());
+}
+
+bool ChunkCompressionPlugin::_chunk_needs_encoding(const Chunk& chunk, const ChunkEncodingSpec& chunk_encoding_spec) {
+  const auto column_count = chunk.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    if (chunk_encoding_spec[column_id].encoding_type == EncodingType::Unencoded) continue;
+    if (std::dynamic_pointer_cast<const BaseValueSegment>(chunk.get_segment(column_id))) return true;
+  }
+  return false;
+}
+
+bool ChunkCompressionPlugin::_scheduler_is_busy() {
+  const auto& scheduler = Hyrise::get().scheduler();
+  for (const auto& queue : scheduler->queues()) {
+    if (!queue->empty()) return true;
+  }
+
+  // Tasks spawned by running tasks are pushed into the deques of the workers, not into the node queues.
+  for (const auto& worker : scheduler->workers()) {
+    if (worker->has_local_tasks()) return true;
+  }
+  return false;
+}
+
+EXPORT_PLUGIN(ChunkCompressionPlugin)
+
+}  // namespace opossum
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "hyrise.hpp"
+#include "storage/chunk.hpp"
+#include "storage/encoding_type.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace opossum {
+
+/*
+ * Rows added through the Insert operator are written to the ValueSegments of the last mutable chunk of a table. When
+ * that chunk is full, Insert simply appends a new chunk, so that tables that grow at runtime mostly consist of
+ * unencoded segments, which consume more memory and cannot be scanned using dictionary-based shortcuts. This plugin
+ * encodes these chunks in the background:
+ * It finalizes chunks that are full and whose inserting transactions have all committed or rolled back ("completed"
+ * chunks, see ChunkCompressionTask) and encodes all finalized chunks that still contain ValueSegments. Encoding also
+ * generates the pruning statistics of the chunk. As the encoded segments replace the value segments atomically,
+ * concurrent readers see either of the two.
+ *
+ * The encoding of a table can be set using set_encoding_spec(). Otherwise, the chunks are encoded the same way as the
+ * first finalized chunk of the table (e.g., as encoded by the BenchmarkTableEncoder). Columns that are unencoded in
+ * that chunk stay unencoded. If the table has no finalized chunk, all columns are dictionary-encoded.
+ *
+ * To not take cores from queries, the plugin runs on a single thread, encodes at most MAX_CHUNKS_PER_ITERATION chunks
+ * per iteration, and skips the iteration if the scheduler has tasks waiting in its queues.
+ */
+class ChunkCompressionPlugin : public AbstractPlugin {
+  friend class ChunkCompressionPluginTest;
+
+ public:
+  std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  void set_encoding_spec(const std::string& table_name, const ChunkEncodingSpec& chunk_encoding_spec);
+
+  /**
+   * IDLE_DELAY_COMPRESSION: sleep after each iteration of the compression loop
+   * MAX_CHUNKS_PER_ITERATION: the number of chunks that are encoded per iteration at most
+   */
+  constexpr static std::chrono::milliseconds IDLE_DELAY_COMPRESSION = std::chrono::milliseconds(100);
+  constexpr static size_t MAX_CHUNKS_PER_ITERATION = 1;
+
+ private:
+  void _compression_loop();
+
+  ChunkEncodingSpec _encoding_spec(const std::string& table_name, const Table& table);
+
+  static bool _chunk_needs_encoding(const Chunk& chunk, const ChunkEncodingSpec& chunk_encoding_spec);
+  static bool _scheduler_is_busy();
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_compression;
+
+  std::mutex _mutex_encoding_specs;
+  std::unordered_map<std::string, ChunkEncodingSpec> _encoding_specs;
+};
+
+}  // namespace opossum
@@ -4,17 +4,22 @@
 #include "operators/table_wrapper.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "storage/base_value_segment.hpp"
 #include "storage/pos_lists/row_id_pos_list.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
+#include "tasks/chunk_compression_task.hpp"
 
 namespace opossum {
 
 std::string MvccDeletePlugin::description() const { return "Physical MVCC delete plugin"; }
 
 void MvccDeletePlugin::start() {
-  _loop_thread_logical_delete =
-      std::make_unique<PausableLoopThread>(IDLE_DELAY_LOGICAL_DELETE, [&](size_t) { _logical_delete_loop(); });
+  _idle_delay_logical_delete = IDLE_DELAY_LOGICAL_DELETE;
+  _loop_thread_logical_delete = std::make_unique<PausableLoopThread>(
+      IDLE_DELAY_LOGICAL_DELETE,
+      std::function<std::chrono::milliseconds(size_t)>{[&](size_t) { return _logical_delete_loop(); }});
 
   _loop_thread_physical_delete =
       std::make_unique<PausableLoopThread>(IDLE_DELAY_PHYSICAL_DELETE, [&](size_t) { _physical_delete_loop(); });
@@ -29,117 +34,155 @@ void MvccDeletePlugin::stop() {
 
 /**
  * This function analyzes each chunk of every table and triggers a chunk-cleanup-procedure if a certain threshold of
- * invalidated rows is exceeded.
+ * invalidated rows is exceeded. The threshold is lower for frequently scanned chunks, as every scan has to validate
+ * their invalidated rows. All candidate chunks of a table are compacted together.
  */
-void MvccDeletePlugin::_logical_delete_loop() {
+std::chrono::milliseconds MvccDeletePlugin::_logical_delete_loop() {
   const auto tables = Hyrise::get().storage_manager.tables();
+  auto deleted_any_chunk = false;
 
   // Check all tables
   for (auto& [table_name, table] : tables) {
     if (table->empty() || table->uses_mvcc() != UseMvcc::Yes) continue;
-    size_t saved_memory = 0;
-    size_t num_chunks = 0;
 
     // Check all chunks, except for the last one, which is currently used for insertions
     const auto max_chunk_id = static_cast<ChunkID>(table->chunk_count() - 1);
+
+    auto access_counts = std::vector<uint64_t>(max_chunk_id);
+    auto max_access_count = uint64_t{0};
     for (auto chunk_id = ChunkID{0}; chunk_id < max_chunk_id; chunk_id++) {
       const auto& chunk = table->get_chunk(chunk_id);
-      if (chunk && !chunk->get_cleanup_commit_id()) {
-        const auto chunk_memory = chunk->memory_usage(MemoryUsageCalculationMode::Sampled);
+      if (!chunk) continue;
+      access_counts[chunk_id] = _chunk_access_count(*chunk);
+      max_access_count = std::max(max_access_count, access_counts[chunk_id]);
+    }
 
-        // Calculate metric 1 – Chunk invalidation level
-        const double invalidated_rows_ratio = static_cast<double>(chunk->invalid_row_count()) / chunk->size();
-        const bool criterion1 = (DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS <= invalidated_rows_ratio);
+    size_t saved_memory = 0;
+    auto candidate_chunk_ids = std::vector<ChunkID>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < max_chunk_id; chunk_id++) {
+      const auto& chunk = table->get_chunk(chunk_id);
+      if (!chunk || chunk->get_cleanup_commit_id()) continue;
 
-        if (!criterion1) {
-          continue;
-        }
+      // Calculate metric 1 – Chunk invalidation level
+      const auto relative_access_count =
+          max_access_count > 0 ? static_cast<double>(access_counts[chunk_id]) / static_cast<double>(max_access_count)
+                               : 0.0;
+      const double invalidated_rows_ratio = static_cast<double>(chunk->invalid_row_count()) / chunk->size();
+      const bool criterion1 = (_invalidated_rows_threshold(relative_access_count) <= invalidated_rows_ratio);
 
-        // Calculate metric 2 – Chunk Hotness
-        auto highest_end_commit_id = CommitID{0};
-        const auto chunk_size = chunk->size();
-        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-          const auto commit_id = chunk->mvcc_data()->get_end_cid(chunk_offset);
-          if (commit_id != MvccData::MAX_COMMIT_ID && commit_id > highest_end_commit_id) {
-            highest_end_commit_id = commit_id;
-          }
+      if (!criterion1) {
+        continue;
+      }
+
+      // Calculate metric 2 – Chunk Hotness
+      auto highest_end_commit_id = CommitID{0};
+      const auto chunk_size = chunk->size();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        const auto commit_id = chunk->mvcc_data()->get_end_cid(chunk_offset);
+        if (commit_id != MvccData::MAX_COMMIT_ID && commit_id > highest_end_commit_id) {
+          highest_end_commit_id = commit_id;
         }
+      }
 
-        const bool criterion2 =
-            highest_end_commit_id + DELETE_THRESHOLD_LAST_COMMIT <= Hyrise::get().transaction_manager.last_commit_id();
+      const bool criterion2 =
+          highest_end_commit_id + DELETE_THRESHOLD_LAST_COMMIT <= Hyrise::get().transaction_manager.last_commit_id();
 
-        if (!criterion2) {
-          continue;
-        }
+      if (!criterion2) {
+        continue;
+      }
 
-        auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
-        const bool success = _try_logical_delete(table_name, chunk_id, transaction_context);
+      candidate_chunk_ids.emplace_back(chunk_id);
+      saved_memory += chunk->memory_usage(MemoryUsageCalculationMode::Sampled);
+      if (candidate_chunk_ids.size() == MAX_CHUNKS_PER_LOGICAL_DELETE) break;
+    }
 
-        if (success) {
-          DebugAssert(table->get_chunk(chunk_id)->get_cleanup_commit_id(),
-                      "Chunk needs to be deleted logically before deleting it physically.");
+    if (candidate_chunk_ids.empty()) continue;
 
-          std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
-          _physical_delete_queue.emplace(table, chunk_id);
-          saved_memory += chunk_memory;
-          num_chunks++;
-        }
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    const bool success = _try_logical_delete(table_name, candidate_chunk_ids, transaction_context);
+    if (!success) continue;
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
+      for (const auto chunk_id : candidate_chunk_ids) {
+        DebugAssert(table->get_chunk(chunk_id)->get_cleanup_commit_id(),
+                    "Chunk needs to be deleted logically before deleting it physically.");
+        _physical_delete_queue.emplace(table, chunk_id);
       }
     }
-    if (saved_memory > 0) {
-      std::ostringstream message;
-      double saved_mb = static_cast<float>(saved_memory) / (1000.0 * 1000.0);
-      message << "Consolidated " << num_chunks << " chunk(s) of " << table_name << ", saved approx. "
-              << std::setprecision(2) << saved_mb << " MB";
-      Hyrise::get().log_manager.add_message("MvccDeletePlugin", message.str(), LogLevel::Info);
-    }
+    deleted_any_chunk = true;
+
+    std::ostringstream message;
+    double saved_mb = static_cast<float>(saved_memory) / (1000.0 * 1000.0);
+    message << "Consolidated " << candidate_chunk_ids.size() << " chunk(s) of " << table_name << ", saved approx. "
+            << std::setprecision(2) << saved_mb << " MB";
+    Hyrise::get().log_manager.add_message("MvccDeletePlugin", message.str(), LogLevel::Info);
   }
+
+  // Back off while there is nothing to clean up
+  _idle_delay_logical_delete = deleted_any_chunk
+                                   ? IDLE_DELAY_LOGICAL_DELETE
+                                   : std::min(_idle_delay_logical_delete * 2, MAX_IDLE_DELAY_LOGICAL_DELETE);
+  return _idle_delay_logical_delete;
 }
 
 /**
- * This function processes the physical-delete-queue until its empty.
+ * This function processes the physical-delete-queue until its empty or its first chunk might still be used. Chunks
+ * are queued in the order of their cleanup commit ids, so the following chunks could not be deleted either.
  */
 void MvccDeletePlugin::_physical_delete_loop() {
   std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
 
-  if (!_physical_delete_queue.empty()) {
+  while (!_physical_delete_queue.empty()) {
     TableAndChunkID table_and_chunk_id = _physical_delete_queue.front();
     const auto& table = table_and_chunk_id.first;
     const auto& chunk = table->get_chunk(table_and_chunk_id.second);
 
     DebugAssert(chunk != nullptr, "Chunk does not exist. Physical Delete can not be applied.");
 
-    if (chunk->get_cleanup_commit_id().has_value()) {
-      // Check whether there are still active transactions that might use the chunk
-      bool conflicting_transactions = false;
-      auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
+    if (!chunk->get_cleanup_commit_id().has_value()) return;
 
-      if (lowest_snapshot_commit_id.has_value()) {
-        conflicting_transactions = chunk->get_cleanup_commit_id().value() > lowest_snapshot_commit_id.value();
-      }
+    // Check whether there are still active transactions that might use the chunk
+    bool conflicting_transactions = false;
+    auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
 
-      if (!conflicting_transactions) {
-        _delete_chunk_physically(table, table_and_chunk_id.second);
-        _physical_delete_queue.pop();
-      }
+    if (lowest_snapshot_commit_id.has_value()) {
+      conflicting_transactions = chunk->get_cleanup_commit_id().value() > lowest_snapshot_commit_id.value();
     }
+
+    if (conflicting_transactions) return;
+
+    _delete_chunk_physically(table, table_and_chunk_id.second);
+    _physical_delete_queue.pop();
   }
 }
 
 bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const ChunkID chunk_id,
                                            const std::shared_ptr<TransactionContext>& transaction_context) {
-  const auto& table = Hyrise::get().storage_manager.get_table(table_name);
-  const auto& chunk = table->get_chunk(chunk_id);
+  return _try_logical_delete(table_name, std::vector<ChunkID>{chunk_id}, transaction_context);
+}
 
-  Assert(chunk != nullptr, "Chunk does not exist. Logical Delete can not be applied.");
-  Assert(chunk_id < (table->chunk_count() - 1),
-         "MVCC Logical Delete should not be applied on the last/current mutable chunk.");
+bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                           const std::shared_ptr<TransactionContext>& transaction_context) {
+  const auto& table = Hyrise::get().storage_manager.get_table(table_name);
+  const auto chunk_count = table->chunk_count();
+
+  Assert(!chunk_ids.empty(), "Expected at least one chunk to delete logically.");
+  auto is_candidate = std::vector<bool>(chunk_count, false);
+  for (const auto chunk_id : chunk_ids) {
+    Assert(table->get_chunk(chunk_id) != nullptr, "Chunk does not exist. Logical Delete can not be applied.");
+    Assert(chunk_id < (chunk_count - 1),
+           "MVCC Logical Delete should not be applied on the last/current mutable chunk.");
+    is_candidate[chunk_id] = true;
+  }
 
-  // Create temporary referencing table that contains the given chunk only
-  //   Include all ChunksIDs of current table except chunk_id for pruning in GetTable
-  std::vector<ChunkID> excluded_chunk_ids(table->chunk_count() - 1);
-  std::iota(excluded_chunk_ids.begin(), excluded_chunk_ids.begin() + chunk_id, 0);
-  std::iota(excluded_chunk_ids.begin() + chunk_id, excluded_chunk_ids.end(), chunk_id + 1);
+  // Create temporary referencing table that contains the given chunks only
+  //   Include all ChunksIDs of current table except chunk_ids for pruning in GetTable
+  std::vector<ChunkID> excluded_chunk_ids;
+  excluded_chunk_ids.reserve(chunk_count - chunk_ids.size());
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (!is_candidate[chunk_id]) excluded_chunk_ids.emplace_back(chunk_id);
+  }
 
   auto get_table = std::make_shared<GetTable>(table_name, excluded_chunk_ids, std::vector<ColumnID>());
   get_table->set_transaction_context(transaction_context);
@@ -150,7 +193,8 @@ bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const
   validate->set_transaction_context(transaction_context);
   validate->execute();
 
-  // Use Update operator to delete and re-insert valid records in chunk
+  // Use Update operator to delete and re-insert valid records in chunk. The valid records of all chunks are appended
+  // to the end of the table next to each other, which compacts them into as few chunks as possible.
   // Pass validate into Update operator twice since data will not be changed.
   auto update = std::make_shared<Update>(table_name, validate, validate);
   update->set_transaction_context(transaction_context);
@@ -165,8 +209,19 @@ bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const
   }
 
   transaction_context->commit();
-  // Mark chunk as logically deleted
-  chunk->set_cleanup_commit_id(transaction_context->commit_id());
+  // Mark chunks as logically deleted
+  for (const auto chunk_id : chunk_ids) {
+    table->get_chunk(chunk_id)->set_cleanup_commit_id(transaction_context->commit_id());
+  }
+
+  // The reinserted rows start in the chunk that was last before the update. Encode them like the chunks they replace.
+  const auto& first_chunk = *table->get_chunk(chunk_ids.front());
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  for (auto column_id = ColumnID{0}; column_id < first_chunk.column_count(); ++column_id) {
+    chunk_encoding_spec.emplace_back(get_segment_encoding_spec(first_chunk.get_segment(column_id)));
+  }
+  _finalize_compacted_chunks(*table, static_cast<ChunkID>(chunk_count - 1), chunk_encoding_spec);
+
   return true;
 }
 
@@ -180,6 +235,54 @@ void MvccDeletePlugin::_delete_chunk_physically(const std::shared_ptr<Table>& ta
   table->remove_chunk(chunk_id);
 }
 
+void MvccDeletePlugin::_finalize_compacted_chunks(Table& table, const ChunkID first_chunk_id,
+                                                  const ChunkEncodingSpec& chunk_encoding_spec) {
+  const auto column_data_types = table.column_data_types();
+  const auto target_chunk_size = table.target_chunk_size();
+  const auto chunk_count = table.chunk_count();
+
+  for (auto chunk_id = first_chunk_id; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    if (chunk->is_mutable()) {
+      // Insert allocates rows in the last chunk while holding the append mutex. Holding it here guarantees that no
+      // rows are added to the chunk while we finalize it.
+      const auto append_lock = table.acquire_append_mutex();
+      if (!ChunkCompressionTask::chunk_is_completed(chunk, target_chunk_size)) continue;
+
+      chunk->finalize();
+    }
+
+    auto needs_encoding = false;
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      if (chunk_encoding_spec[column_id].encoding_type == EncodingType::Unencoded) continue;
+      if (std::dynamic_pointer_cast<const BaseValueSegment>(chunk->get_segment(column_id))) needs_encoding = true;
+    }
+
+    if (needs_encoding) ChunkEncoder::encode_chunk(chunk, column_data_types, chunk_encoding_spec);
+  }
+}
+
+uint64_t MvccDeletePlugin::_chunk_access_count(const Chunk& chunk) {
+  auto access_count = uint64_t{0};
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto& access_counter = chunk.get_segment(column_id)->access_counter;
+    for (auto access_type = size_t{0}; access_type < static_cast<size_t>(SegmentAccessCounter::AccessType::Count);
+         ++access_type) {
+      access_count += access_counter[static_cast<SegmentAccessCounter::AccessType>(access_type)];
+    }
+  }
+  return access_count;
+}
+
+double MvccDeletePlugin::_invalidated_rows_threshold(const double relative_access_count) {
+  DebugAssert(relative_access_count >= 0.0 && relative_access_count <= 1.0, "Expected a relative access count.");
+  return DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS -
+         (DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS - DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS_HOT) *
+             relative_access_count;
+}
+
 EXPORT_PLUGIN(MvccDeletePlugin)
 
 }  // namespace opossum
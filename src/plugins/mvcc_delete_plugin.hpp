@@ -5,10 +5,12 @@
 #include <numeric>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest_prod.h"
 #include "hyrise.hpp"
 #include "storage/chunk.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "utils/abstract_plugin.hpp"
 #include "utils/pausable_loop_thread.hpp"
 #include "utils/singleton.hpp"
@@ -24,8 +26,12 @@ namespace opossum {
  * execution time per transaction low and the database maintains its original performance.
  * The plugin is split into two main functions. The logical delete is responsible for
  * recognizing chunks with high numbers of invalidated rows and fully invalidates them.
+ * Several such chunks of a table are compacted in a single transaction, so that their
+ * remaining rows end up densely packed in new chunks, which are finalized and encoded
+ * like the chunks they replace.
  * The physical delete checks if chunks are not visible anymore for other transactions and
- * removes the chunk from the table completely.
+ * removes the chunk from the table completely. This is also the point where the chunk's
+ * MvccData is released.
  */
 class MvccDeletePlugin : public AbstractPlugin {
   friend class MvccDeletePluginTest;
@@ -40,28 +46,51 @@ class MvccDeletePlugin : public AbstractPlugin {
 
   /**
    * DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS: the percentage of invalidated rows
-   * in chunk to be deleted logically by the plugin.
+   * in chunk to be deleted logically by the plugin. It applies to chunks that are not scanned.
+   * DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS_HOT: the percentage for the most frequently
+   * scanned chunk of a table. Thresholds of other chunks are interpolated by their access counts.
    * DELETE_THRESHOLD_LAST_COMMIT: the number of commits that must have passed since
    * the candidate chunk was last modified
+   * MAX_CHUNKS_PER_LOGICAL_DELETE: the number of chunks compacted in a single transaction
    * IDLE_DELAY_LOGICAL_DELETE: sleep after execution of logical delete
+   * MAX_IDLE_DELAY_LOGICAL_DELETE: upper bound for the sleep, which doubles after each iteration
+   * that did not find any chunk to delete
    * IDLE_DELAY_PHYSICAL_DELETE: sleep after execution of physical delete
    */
   constexpr static double DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS = 0.6;
+  constexpr static double DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS_HOT = 0.2;
   constexpr static CommitID DELETE_THRESHOLD_LAST_COMMIT = CommitID{100};
+  constexpr static size_t MAX_CHUNKS_PER_LOGICAL_DELETE = 8;
   constexpr static std::chrono::milliseconds IDLE_DELAY_LOGICAL_DELETE = std::chrono::milliseconds(1000);
+  constexpr static std::chrono::milliseconds MAX_IDLE_DELAY_LOGICAL_DELETE = std::chrono::milliseconds(10'000);
   constexpr static std::chrono::milliseconds IDLE_DELAY_PHYSICAL_DELETE = std::chrono::milliseconds(1000);
 
  private:
   using TableAndChunkID = std::pair<const std::shared_ptr<Table>, ChunkID>;
 
-  void _logical_delete_loop();
+  // Returns the time to sleep before the next iteration
+  std::chrono::milliseconds _logical_delete_loop();
   void _physical_delete_loop();
 
   static bool _try_logical_delete(const std::string& table_name, ChunkID chunk_id,
                                   const std::shared_ptr<TransactionContext>& transaction_context);
+  static bool _try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                  const std::shared_ptr<TransactionContext>& transaction_context);
   static void _delete_chunk_physically(const std::shared_ptr<Table>& table, ChunkID chunk_id);
 
+  // Finalizes the completed chunks starting at first_chunk_id and encodes them using chunk_encoding_spec
+  static void _finalize_compacted_chunks(Table& table, ChunkID first_chunk_id,
+                                         const ChunkEncodingSpec& chunk_encoding_spec);
+
+  // Sum of all access counters of the chunk's segments
+  static uint64_t _chunk_access_count(const Chunk& chunk);
+
+  // Ratio of invalidated rows above which a chunk is deleted logically. relative_access_count is the chunk's access
+  // count divided by the highest access count of all chunks in the table.
+  static double _invalidated_rows_threshold(double relative_access_count);
+
   std::unique_ptr<PausableLoopThread> _loop_thread_logical_delete, _loop_thread_physical_delete;
+  std::chrono::milliseconds _idle_delay_logical_delete{IDLE_DELAY_LOGICAL_DELETE};
 
   std::mutex _mutex_physical_delete_queue;
   std::queue<TableAndChunkID> _physical_delete_queue;
@@ -1,5 +1,11 @@
+#include <numeric>
+#include <thread>
+#include <vector>
+
 #include "base_test.hpp"
 
+#include "cache/sharded_cache.hpp"
+
 namespace opossum {
 
 // Test for the cache implementation in lib/cache.
@@ -22,6 +28,15 @@ class CachePolicyTest : public BaseTest {
                                                                       const Key& key) const {
     return *(cache._map.find(key)->second);
   }
+
+  template <typename Key, typename Value>
+  std::vector<size_t> shard_capacities(const ShardedCache<Key, Value>& cache) const {
+    auto capacities = std::vector<size_t>{};
+    for (const auto& shard : cache._shards) {
+      capacities.emplace_back(shard.capacity);
+    }
+    return capacities;
+  }
 };
 
 // GDFS Strategy
@@ -85,6 +100,63 @@ TEST_F(CachePolicyTest, GDFSCacheTest) {
   ASSERT_EQ(3, get_full_entry(cache, 3).frequency);
 }
 
+// Sharded cache with CLOCK eviction and TinyLFU admission
+TEST_F(CachePolicyTest, ShardedCacheTest) {
+  // A capacity of 1 results in a single shard.
+  ShardedCache<int, int> cache(1);
+  ASSERT_EQ(shard_capacities(cache).size(), 1u);
+
+  cache.set(1, 2);  // Miss, insert, estimate(1)=1
+  ASSERT_TRUE(cache.has(1));
+  ASSERT_EQ(cache.try_get(1), 2);  // Hit, estimate(1)=2
+
+  cache.set(2, 4);  // Miss, estimate(2)=1, not admitted
+  ASSERT_TRUE(cache.has(1));
+  ASSERT_FALSE(cache.has(2));
+
+  ASSERT_EQ(cache.try_get(2), std::nullopt);  // Miss, estimate(2)=2
+  cache.set(2, 4);                            // Miss, estimate(2)=3, evict 1
+  ASSERT_FALSE(cache.has(1));
+  ASSERT_TRUE(cache.has(2));
+  ASSERT_EQ(cache.try_get(2), 4);
+
+  // Updating an entry does not require admission.
+  cache.set(2, 5);
+  ASSERT_EQ(cache.try_get(2), 5);
+  ASSERT_EQ(cache.snapshot().at(2).frequency, 4);
+
+  // The capacity is distributed over the shards.
+  ShardedCache<int, int> large_cache(100);
+  const auto capacities = shard_capacities(large_cache);
+  ASSERT_EQ(capacities.size(), 16u);
+  ASSERT_EQ(std::accumulate(capacities.begin(), capacities.end(), size_t{0}), 100u);
+}
+
+TEST_F(CachePolicyTest, ShardedCacheConcurrentAccess) {
+  ShardedCache<int, int> cache(64);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < 8; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto access_id = 0; access_id < 10'000; ++access_id) {
+        const auto key = (access_id * 7 + thread_id) % 200;
+        const auto value = cache.try_get(key);
+        if (value) {
+          ASSERT_EQ(*value, key * 2);
+        } else {
+          cache.set(key, key * 2);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_LE(cache.size(), 64u);
+  ASSERT_EQ(cache.snapshot().size(), cache.size());
+}
+
 class CacheTest : public BaseTest {};
 
 TEST_F(CacheTest, Size) {
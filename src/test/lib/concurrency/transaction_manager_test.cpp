@@ -1,8 +1,10 @@
 #include <algorithm>
+#include <thread>
 #include <vector>
 
 #include "base_test.hpp"
 
+#include "concurrency/commit_context.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
 
@@ -12,8 +14,8 @@ class TransactionManagerTest : public BaseTest {
  protected:
   void SetUp() override {}
 
-  static std::unordered_multiset<CommitID>& get_active_snapshot_commit_ids() {
-    return Hyrise::get().transaction_manager._active_snapshot_commit_ids;
+  static std::unordered_multiset<CommitID> get_active_snapshot_commit_ids() {
+    return Hyrise::get().transaction_manager._active_snapshot_commit_ids();
   }
 
   static void register_transaction(CommitID snapshot_commit_id) {
@@ -22,6 +24,13 @@ class TransactionManagerTest : public BaseTest {
   static void deregister_transaction(CommitID snapshot_commit_id) {
     Hyrise::get().transaction_manager._deregister_transaction(snapshot_commit_id);
   }
+
+  static std::shared_ptr<CommitContext> new_commit_context() {
+    return Hyrise::get().transaction_manager._new_commit_context();
+  }
+  static void try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context) {
+    Hyrise::get().transaction_manager._try_increment_last_commit_id(context);
+  }
 };
 
 /** Check if all active snapshot commit ids of uncommitted
@@ -46,30 +55,24 @@ TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   const auto vec = std::vector<CommitID>{t1_snapshot_commit_id, t2_snapshot_commit_id, t3_snapshot_commit_id};
 
   EXPECT_EQ(get_active_snapshot_commit_ids().size(), 3);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t1_snapshot_commit_id));
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t2_snapshot_commit_id));
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t3_snapshot_commit_id));
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), *std::min_element(vec.cbegin(), vec.cend()));
 
   t1_context->commit();
   deregister_transaction(t1_context->snapshot_commit_id());
 
   EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t1_context->snapshot_commit_id()));
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t3_context->snapshot_commit_id()));
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
 
   t3_context->commit();
   deregister_transaction(t3_context->snapshot_commit_id());
 
   EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
+  EXPECT_TRUE(get_active_snapshot_commit_ids().contains(t2_context->snapshot_commit_id()));
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
 
   t2_context->commit();
@@ -84,4 +87,101 @@ TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   register_transaction(t3_snapshot_commit_id);
 }
 
+TEST_F(TransactionManagerTest, TrackActiveCommitIDsConcurrently) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  // More registrations than there are slots so that the fallback is used, too.
+  constexpr auto THREAD_COUNT = size_t{8};
+  constexpr auto REGISTRATIONS_PER_THREAD = size_t{100};
+
+  const auto base_commit_id = CommitID{1'000};
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = size_t{0}; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto registration = size_t{0}; registration < REGISTRATIONS_PER_THREAD; ++registration) {
+        register_transaction(static_cast<CommitID>(base_commit_id + thread_id + registration));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), THREAD_COUNT * REGISTRATIONS_PER_THREAD);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), base_commit_id);
+
+  threads.clear();
+  for (auto thread_id = size_t{0}; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto registration = size_t{0}; registration < REGISTRATIONS_PER_THREAD; ++registration) {
+        deregister_transaction(static_cast<CommitID>(base_commit_id + thread_id + registration));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_TRUE(get_active_snapshot_commit_ids().empty());
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+// Commits from many threads are published in batches. All of them have to become visible in commit id order and the
+// callback of each commit has to be fired exactly once, after the commit became visible.
+TEST_F(TransactionManagerTest, ConcurrentCommits) {
+  auto& manager = Hyrise::get().transaction_manager;
+  const auto initial_last_commit_id = manager.last_commit_id();
+
+  constexpr auto THREAD_COUNT = size_t{8};
+  constexpr auto COMMITS_PER_THREAD = size_t{200};
+  constexpr auto COMMIT_COUNT = THREAD_COUNT * COMMITS_PER_THREAD;
+
+  // Indexed by commit_id - initial_last_commit_id - 1
+  auto pending_flags = std::vector<std::atomic_bool>(COMMIT_COUNT);
+  auto callback_counts = std::vector<std::atomic_uint32_t>(COMMIT_COUNT);
+  auto invisible_in_callback = std::atomic_bool{false};
+
+  // Observes the published commit ids while the commits are running. They must never decrease and never cover a
+  // commit that is not pending yet.
+  auto commits_done = std::atomic_bool{false};
+  auto decreased = false;
+  auto published_before_pending = false;
+  auto observer = std::thread([&]() {
+    auto previous_last_commit_id = initial_last_commit_id;
+    while (!commits_done) {
+      const auto last_commit_id = manager.last_commit_id();
+      decreased |= last_commit_id < previous_last_commit_id;
+      for (auto commit_id = previous_last_commit_id + 1; commit_id <= last_commit_id; ++commit_id) {
+        published_before_pending |= !pending_flags[commit_id - initial_last_commit_id - 1];
+      }
+      previous_last_commit_id = std::max(previous_last_commit_id, last_commit_id);
+    }
+  });
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = size_t{0}; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&]() {
+      for (auto commit = size_t{0}; commit < COMMITS_PER_THREAD; ++commit) {
+        const auto commit_context = new_commit_context();
+        const auto commit_id = commit_context->commit_id();
+        const auto commit_index = commit_id - initial_last_commit_id - 1;
+
+        pending_flags[commit_index] = true;
+        commit_context->make_pending(TransactionID{0}, [&, commit_id, commit_index](TransactionID) {
+          if (manager.last_commit_id() < commit_id) invisible_in_callback = true;
+          ++callback_counts[commit_index];
+        });
+        try_increment_last_commit_id(commit_context);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  commits_done = true;
+  observer.join();
+
+  EXPECT_EQ(manager.last_commit_id(), initial_last_commit_id + COMMIT_COUNT);
+  EXPECT_FALSE(decreased);
+  EXPECT_FALSE(published_before_pending);
+  EXPECT_FALSE(invisible_in_callback);
+  for (auto commit_index = size_t{0}; commit_index < COMMIT_COUNT; ++commit_index) {
+    EXPECT_EQ(callback_counts[commit_index], 1) << "Commit #" << commit_index;
+  }
+}
+
 }  // namespace opossum
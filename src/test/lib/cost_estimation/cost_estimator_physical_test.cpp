@@ -0,0 +1,210 @@
+#include <cstdio>
+#include <fstream>
+
+#include "base_test.hpp"
+
+#include "cost_estimation/cost_estimator_physical.hpp"
+#include "cost_estimation/physical_cost_coefficients.hpp"
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/aggregate_node.hpp"
+#include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "statistics/cardinality_estimator.hpp"
+#include "storage/chunk_encoder.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class CostEstimatorPhysicalTest : public BaseTest {
+ public:
+  void SetUp() override {
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_int3.tbl", 2));
+    Hyrise::get().storage_manager.add_table("table_b", load_table("resources/test_data/tbl/int_int4.tbl", 2));
+
+    node_a = StoredTableNode::make("table_a");
+    a_a = node_a->get_column("a");
+    a_b = node_a->get_column("b");
+    node_b = StoredTableNode::make("table_b");
+    b_a = node_b->get_column("a");
+
+    cost_estimator = std::make_shared<CostEstimatorPhysical>(std::make_shared<CardinalityEstimator>());
+  }
+
+  std::shared_ptr<StoredTableNode> node_a, node_b;
+  std::shared_ptr<LQPColumnExpression> a_a, a_b, b_a;
+  std::shared_ptr<CostEstimatorPhysical> cost_estimator;
+};
+
+TEST_F(CostEstimatorPhysicalTest, JoinImplementations) {
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_a, node_b);
+
+  const auto hash_cost = cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash);
+  const auto sort_merge_cost = cost_estimator->estimate_join_cost(join_node, OperatorType::JoinSortMerge);
+  EXPECT_LT(hash_cost, sort_merge_cost);
+
+  // JoinSortMerge only merges inputs that are sorted within their chunks
+  auto sorted_inputs = PhysicalInputProperties{};
+  sorted_inputs.sorted = true;
+  EXPECT_LT(cost_estimator->estimate_join_cost(join_node, OperatorType::JoinSortMerge, sorted_inputs), hash_cost);
+  EXPECT_EQ(cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash, sorted_inputs), hash_cost);
+
+  // The cheapest implementation for inputs without physical properties is used for the node cost
+  EXPECT_EQ(cost_estimator->estimate_node_cost(join_node), hash_cost);
+
+  EXPECT_THROW(cost_estimator->estimate_join_cost(join_node, OperatorType::TableScan), std::logic_error);
+}
+
+TEST_F(CostEstimatorPhysicalTest, JoinIndex) {
+  // A large right input in a single chunk
+  const auto table_c = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                               ChunkOffset{1'000}, UseMvcc::Yes);
+  for (auto value = int32_t{0}; value < 1'000; ++value) {
+    table_c->append({value});
+  }
+  Hyrise::get().storage_manager.add_table("table_c", table_c);
+  const auto node_c = StoredTableNode::make("table_c");
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(a_a, node_c->get_column("a")), node_a, node_c);
+
+  // Without an index, the chunk is joined with a nested loop. Unlike JoinNestedLoop, JoinIndex does not read the
+  // right input upfront.
+  const auto right_read_cost = cost_estimator->coefficients.read_per_row * 1'000.0f;
+  const auto unindexed_cost = cost_estimator->estimate_join_cost(join_node, OperatorType::JoinIndex);
+  EXPECT_FLOAT_EQ(unindexed_cost,
+                  cost_estimator->estimate_join_cost(join_node, OperatorType::JoinNestedLoop) - right_read_cost);
+
+  // With an index, each row of the left input is looked up in it, which is cheaper than building a hash table
+  auto indexed_input = PhysicalInputProperties{};
+  indexed_input.indexed_chunk_count = 1;
+  indexed_input.unindexed_row_share = 0.0f;
+  const auto indexed_cost = cost_estimator->estimate_join_cost(join_node, OperatorType::JoinIndex, indexed_input);
+  EXPECT_LT(indexed_cost, unindexed_cost);
+  EXPECT_LT(indexed_cost, cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash));
+}
+
+TEST_F(CostEstimatorPhysicalTest, JoinHashBuildSide) {
+  // Only cost building the hash table
+  auto coefficients = PhysicalCostCoefficients{};
+  coefficients.read_per_row = 0.0f;
+  coefficients.output_per_row = 0.0f;
+  coefficients.hash_build_per_row = 1.0f;
+  coefficients.hash_probe_per_row = 0.0f;
+  const auto build_cost_estimator =
+      std::make_shared<CostEstimatorPhysical>(std::make_shared<CardinalityEstimator>(), coefficients);
+
+  const auto left_row_count = static_cast<float>(Hyrise::get().storage_manager.get_table("table_a")->row_count());
+  const auto right_row_count = static_cast<float>(Hyrise::get().storage_manager.get_table("table_b")->row_count());
+  ASSERT_NE(left_row_count, right_row_count);
+
+  // For inner joins, JoinHash builds the hash table for the smaller input. For all other join modes, the join mode
+  // determines the build side.
+  const auto expected_build_row_counts = std::vector<std::pair<JoinMode, float>>{
+      {JoinMode::Inner, std::min(left_row_count, right_row_count)},
+      {JoinMode::Left, right_row_count},
+      {JoinMode::Right, left_row_count},
+      {JoinMode::Semi, right_row_count},
+      {JoinMode::AntiNullAsTrue, right_row_count},
+      {JoinMode::AntiNullAsFalse, right_row_count}};
+  for (const auto& [join_mode, expected_build_row_count] : expected_build_row_counts) {
+    const auto join_node = JoinNode::make(join_mode, equals_(a_a, b_a), node_a, node_b);
+    EXPECT_FLOAT_EQ(build_cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash),
+                    expected_build_row_count);
+  }
+}
+
+TEST_F(CostEstimatorPhysicalTest, JoinEncodings) {
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_a, node_b);
+  const auto unencoded_cost = cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash);
+
+  // Reading from dictionary segments is modeled as fast as reading from unencoded ones, LZ4 is slower
+  ChunkEncoder::encode_all_chunks(Hyrise::get().storage_manager.get_table("table_a"),
+                                  SegmentEncodingSpec{EncodingType::Dictionary});
+  EXPECT_EQ(cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash), unencoded_cost);
+
+  // A caching estimator determines the encodings of a column only once
+  const auto caching_cost_estimator = cost_estimator->new_instance();
+  caching_cost_estimator->guarantee_bottom_up_construction();
+  const auto& caching_physical_cost_estimator = static_cast<const CostEstimatorPhysical&>(*caching_cost_estimator);
+  EXPECT_EQ(caching_physical_cost_estimator.estimate_join_cost(join_node, OperatorType::JoinHash), unencoded_cost);
+
+  ChunkEncoder::encode_all_chunks(Hyrise::get().storage_manager.get_table("table_b"),
+                                  SegmentEncodingSpec{EncodingType::LZ4});
+  EXPECT_GT(cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash), unencoded_cost);
+  EXPECT_EQ(caching_physical_cost_estimator.estimate_join_cost(join_node, OperatorType::JoinHash), unencoded_cost);
+}
+
+TEST_F(CostEstimatorPhysicalTest, AggregateImplementations) {
+  const auto aggregate_node = AggregateNode::make(expression_vector(a_a), expression_vector(sum_(a_b)), node_a);
+
+  const auto hash_cost = cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateImplementation::Hash);
+  EXPECT_LT(hash_cost, cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateImplementation::Sort));
+  EXPECT_EQ(cost_estimator->estimate_node_cost(aggregate_node), hash_cost);
+
+  // Value-clustered inputs are sorted chunk by chunk. If they are also sorted, AggregateSort does not sort at all.
+  auto value_clustered_input = PhysicalInputProperties{};
+  value_clustered_input.value_clustered = true;
+  auto sorted_input = value_clustered_input;
+  sorted_input.sorted = true;
+  EXPECT_LE(
+      cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateImplementation::Sort, value_clustered_input),
+      cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateImplementation::Sort));
+  EXPECT_LT(cost_estimator->estimate_aggregate_cost(aggregate_node, AggregateImplementation::Sort, sorted_input),
+            hash_cost);
+
+  // Without group-by columns, both implementations aggregate the input in a single pass
+  const auto aggregate_node_without_group_by =
+      AggregateNode::make(expression_vector(), expression_vector(sum_(a_b)), node_a);
+  EXPECT_EQ(cost_estimator->estimate_aggregate_cost(aggregate_node_without_group_by, AggregateImplementation::Hash),
+            cost_estimator->estimate_aggregate_cost(aggregate_node_without_group_by, AggregateImplementation::Sort));
+}
+
+TEST_F(CostEstimatorPhysicalTest, Coefficients) {
+  // A cost estimator with cheaper hash tables
+  auto coefficients = PhysicalCostCoefficients{};
+  coefficients.hash_build_per_row /= 2.0f;
+  const auto calibrated_cost_estimator =
+      std::make_shared<CostEstimatorPhysical>(std::make_shared<CardinalityEstimator>(), coefficients);
+
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(a_a, b_a), node_a, node_b);
+  EXPECT_LT(calibrated_cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash),
+            cost_estimator->estimate_join_cost(join_node, OperatorType::JoinHash));
+
+  // New instances keep the coefficients
+  const auto new_instance =
+      std::dynamic_pointer_cast<CostEstimatorPhysical>(calibrated_cost_estimator->new_instance());
+  ASSERT_TRUE(new_instance);
+  EXPECT_EQ(new_instance->coefficients.hash_build_per_row, coefficients.hash_build_per_row);
+}
+
+TEST_F(CostEstimatorPhysicalTest, CoefficientsFile) {
+  const auto filename = test_data_path + "cost_model_coefficients.json";
+
+  auto coefficients = PhysicalCostCoefficients{};
+  coefficients.hash_build_per_row = 12.5f;
+  coefficients.read_factor_by_encoding[EncodingType::LZ4] = 7.0f;
+  save_physical_cost_coefficients(coefficients, filename);
+
+  const auto loaded_coefficients = load_physical_cost_coefficients(filename);
+  EXPECT_EQ(loaded_coefficients.hash_build_per_row, 12.5f);
+  EXPECT_EQ(loaded_coefficients.hash_probe_per_row, coefficients.hash_probe_per_row);
+  EXPECT_EQ(loaded_coefficients.read_factor_by_encoding, coefficients.read_factor_by_encoding);
+
+  // Coefficients that the file does not contain keep their default values, unknown ones are rejected
+  {
+    auto file = std::ofstream{filename};
+    file << R"({"merge_per_row": 3.0})";
+  }
+  const auto partially_loaded_coefficients = load_physical_cost_coefficients(filename);
+  EXPECT_EQ(partially_loaded_coefficients.merge_per_row, 3.0f);
+  EXPECT_EQ(partially_loaded_coefficients.hash_build_per_row, PhysicalCostCoefficients{}.hash_build_per_row);
+
+  {
+    auto file = std::ofstream{filename};
+    file << R"({"merge_per_rows": 3.0})";
+  }
+  EXPECT_THROW(load_physical_cost_coefficients(filename), std::logic_error);
+
+  std::remove(filename.c_str());
+}
+
+}  // namespace opossum
@@ -0,0 +1,141 @@
+#include <memory>
+#include <utility>
+
+#include "base_test.hpp"
+
+#include "expression/evaluation/correlated_subquery_results_cache.hpp"
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class CorrelatedSubqueryResultsCacheTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Column "a" has two distinct values (and a NULL), column "b" has a distinct value per row
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::Int, false}};
+    _table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3});
+    _table->append({1, 10});
+    _table->append({2, 20});
+    _table->append({1, 30});
+    _table->append({2, 40});
+    _table->append({NullValue{}, 50});
+    _table->append({1, 60});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+
+    _a = PQPColumnExpression::from_table(*_table, "a");
+    _b = PQPColumnExpression::from_table(*_table, "b");
+  }
+
+  // Returns a subquery that adds the current value in "a" to all values in "b"
+  std::shared_ptr<PQPSubqueryExpression> _correlated_subquery() const {
+    const auto inner_table_wrapper = std::make_shared<TableWrapper>(_table);
+    const auto projection = std::make_shared<Projection>(
+        inner_table_wrapper, expression_vector(add_(correlated_parameter_(ParameterID{0}, _a), _b)));
+    return pqp_subquery_(projection, DataType::Int, true, std::make_pair(ParameterID{0}, ColumnID{0}));
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+  std::shared_ptr<PQPColumnExpression> _a, _b;
+};
+
+TEST_F(CorrelatedSubqueryResultsCacheTest, GetAndSet) {
+  const auto result_a = load_table("resources/test_data/tbl/int.tbl");
+  const auto result_b = load_table("resources/test_data/tbl/float.tbl");
+  const auto pqp_a = std::make_shared<TableWrapper>(result_a);
+  const auto pqp_b = std::make_shared<TableWrapper>(result_b);
+
+  auto cache = CorrelatedSubqueryResultsCache{};
+  EXPECT_EQ(cache.try_get(*pqp_a, {AllTypeVariant{1}}), nullptr);
+
+  cache.set(*pqp_a, {AllTypeVariant{1}}, result_a);
+  cache.set(*pqp_b, {AllTypeVariant{1}}, result_b);
+  EXPECT_EQ(cache.size(), 2);
+
+  EXPECT_EQ(cache.try_get(*pqp_a, {AllTypeVariant{1}}), result_a);
+  EXPECT_EQ(cache.try_get(*pqp_b, {AllTypeVariant{1}}), result_b);
+  EXPECT_EQ(cache.try_get(*pqp_a, {AllTypeVariant{2}}), nullptr);
+  EXPECT_EQ(cache.try_get(*pqp_a, {AllTypeVariant{1}, AllTypeVariant{1}}), nullptr);
+
+  EXPECT_EQ(cache.hit_count(), 2);
+  EXPECT_EQ(cache.miss_count(), 3);
+}
+
+TEST_F(CorrelatedSubqueryResultsCacheTest, DoesNotCacheNulls) {
+  const auto result = load_table("resources/test_data/tbl/int.tbl");
+  const auto pqp = std::make_shared<TableWrapper>(result);
+
+  auto cache = CorrelatedSubqueryResultsCache{};
+  cache.set(*pqp, {AllTypeVariant{1}, NULL_VALUE}, result);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.try_get(*pqp, {AllTypeVariant{1}, NULL_VALUE}), nullptr);
+}
+
+TEST_F(CorrelatedSubqueryResultsCacheTest, Capacity) {
+  const auto result = load_table("resources/test_data/tbl/int.tbl");
+  const auto pqp = std::make_shared<TableWrapper>(result);
+
+  auto cache = CorrelatedSubqueryResultsCache{2};
+  cache.set(*pqp, {AllTypeVariant{1}}, result);
+  cache.set(*pqp, {AllTypeVariant{2}}, result);
+  cache.set(*pqp, {AllTypeVariant{3}}, result);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_NE(cache.try_get(*pqp, {AllTypeVariant{1}}), nullptr);
+  EXPECT_EQ(cache.try_get(*pqp, {AllTypeVariant{3}}), nullptr);
+}
+
+TEST_F(CorrelatedSubqueryResultsCacheTest, SharedBetweenEvaluators) {
+  const auto subquery = _correlated_subquery();
+  const auto expression = in_(value_(11), subquery);
+  const auto cache = std::make_shared<CorrelatedSubqueryResultsCache>();
+
+  // Chunk 0 has the values 1, 2, 1 in column "a", so the subquery is executed twice
+  const auto result_0 = ExpressionEvaluator{_table, ChunkID{0}, nullptr, cache}.evaluate_expression_to_pos_list(
+      *expression);
+  EXPECT_EQ(result_0, RowIDPosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{2}}}));
+  EXPECT_EQ(cache->size(), 2);
+  EXPECT_EQ(cache->hit_count(), 1);
+  EXPECT_EQ(cache->miss_count(), 2);
+
+  // Chunk 1 reuses the results of chunk 0. The row with the NULL is evaluated, but not cached.
+  const auto result_1 = ExpressionEvaluator{_table, ChunkID{1}, nullptr, cache}.evaluate_expression_to_pos_list(
+      *expression);
+  EXPECT_EQ(result_1, RowIDPosList({RowID{ChunkID{1}, ChunkOffset{2}}}));
+  EXPECT_EQ(cache->size(), 2);
+  EXPECT_EQ(cache->hit_count(), 3);
+  EXPECT_EQ(cache->miss_count(), 3);
+}
+
+TEST_F(CorrelatedSubqueryResultsCacheTest, OperatorPerformanceData) {
+  const auto table_scan = std::make_shared<TableScan>(_table_wrapper, in_(value_(11), _correlated_subquery()));
+  table_scan->execute();
+  EXPECT_EQ(table_scan->get_output()->row_count(), 3);
+
+  const auto& scan_performance_data = dynamic_cast<const TableScan::PerformanceData&>(*table_scan->performance_data);
+  ASSERT_TRUE(scan_performance_data.correlated_subquery_cache_hits);
+  EXPECT_EQ(*scan_performance_data.correlated_subquery_cache_hits, 3);
+  EXPECT_EQ(*scan_performance_data.correlated_subquery_cache_misses, 3);
+
+  const auto projection =
+      std::make_shared<Projection>(_table_wrapper, expression_vector(in_(value_(11), _correlated_subquery())));
+  projection->execute();
+  EXPECT_EQ(projection->get_output()->row_count(), 6);
+
+  const auto& projection_performance_data =
+      dynamic_cast<const Projection::PerformanceData&>(*projection->performance_data);
+  EXPECT_EQ(projection_performance_data.correlated_subquery_cache_hits, 3);
+  EXPECT_EQ(projection_performance_data.correlated_subquery_cache_misses, 3);
+}
+
+}  // namespace opossum
@@ -55,6 +55,39 @@ TEST_F(LikeMatcherTest, NotMatching) {
   EXPECT_FALSE(match("Hello", "He_o"));
 }
 
+TEST_F(LikeMatcherTest, GeneralPatterns) {
+  EXPECT_TRUE(match("Hello", "H_llo"));
+  EXPECT_TRUE(match("Hello", "_____"));
+  EXPECT_TRUE(match("Hello World", "H_llo%W%ld"));
+  EXPECT_TRUE(match("Hello World", "%l_o W%"));
+  EXPECT_TRUE(match("aab", "%ab"));
+  EXPECT_TRUE(match("abab", "%a_%b"));
+  EXPECT_TRUE(match("", ""));
+  EXPECT_TRUE(match("", "%"));
+  EXPECT_TRUE(match("Hello", "%"));
+
+  EXPECT_FALSE(match("Hello", "____"));
+  EXPECT_FALSE(match("Hello", "______"));
+  EXPECT_FALSE(match("Hello World", "H_llo%W%l"));
+  EXPECT_FALSE(match("Hello", ""));
+  EXPECT_FALSE(match("Hello World", "%Hello%Wor"));
+  EXPECT_FALSE(match("ab", "%a_%b"));
+}
+
+TEST_F(LikeMatcherTest, Searcher) {
+  // Use a string that is longer than a block of the vectorized search
+  auto string = std::string(100, 'a');
+  string.replace(70, 3, "abc");
+
+  const auto searcher = LikeMatcher::Searcher{pmr_string{"abc"}};
+  EXPECT_EQ(searcher.find(string), 70);
+  EXPECT_EQ(searcher.find(string, 70), 70);
+  EXPECT_EQ(searcher.find(string, 71), std::string_view::npos);
+  EXPECT_EQ(searcher.find("ab"), std::string_view::npos);
+  EXPECT_EQ(LikeMatcher::Searcher{pmr_string{"a"}}.find(string, 99), 99);
+  EXPECT_EQ(LikeMatcher::Searcher{pmr_string{""}}.find(string, 100), 100);
+}
+
 TEST_F(LikeMatcherTest, LowerUpperBound) {
   const auto pattern = pmr_string("Japan%");
   const auto bounds = LikeMatcher::bounds(pattern);
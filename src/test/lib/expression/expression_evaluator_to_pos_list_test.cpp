@@ -19,6 +19,7 @@
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/load_table.hpp"
 
@@ -51,6 +52,18 @@ class ExpressionEvaluatorToPosListTest : public BaseTest {
     return actual_pos_list == expected_pos_list;
   }
 
+  // Single-chunk table with the nullable int column "a" (every seventh value is NULL, the others equal the row index)
+  // and the string column "s" (the row index)
+  static std::shared_ptr<Table> create_batch_table(const ChunkOffset row_count) {
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}, {"s", DataType::String, false}};
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, row_count);
+    for (auto row_idx = int32_t{0}; row_idx < static_cast<int32_t>(row_count); ++row_idx) {
+      const auto value = row_idx % 7 == 0 ? NULL_VALUE : AllTypeVariant{row_idx};
+      table->append({value, pmr_string{std::to_string(row_idx)}});
+    }
+    return table;
+  }
+
   std::shared_ptr<Table> table_a, table_b;
 
   std::shared_ptr<PQPColumnExpression> c, d, s1, s3, x;
@@ -192,4 +205,42 @@ TEST_F(ExpressionEvaluatorToPosListTest, ExistsUncorrelated) {
   EXPECT_TRUE(test_expression(table_b, ChunkID{0}, *not_exists_(subquery_returning_none), {0, 1, 2, 3}));
 }
 
+TEST_F(ExpressionEvaluatorToPosListTest, BatchedEqualsChunkEvaluation) {
+  // Three batches, the last one is not full
+  const auto table = create_batch_table(ChunkOffset{ExpressionEvaluator::BATCH_SIZE * 2 + 100});
+
+  const auto a = PQPColumnExpression::from_table(*table, "a");
+  const auto s = PQPColumnExpression::from_table(*table, "s");
+
+  // The right operands of the ANDs and ORs are evaluated only for the rows not decided by the left operands
+  const auto expressions = std::vector<std::shared_ptr<AbstractExpression>>{
+      and_(greater_than_(a, 4'000), less_than_(a, 4'010)),
+      and_(greater_than_(a, 100), like_(s, "%1%")),
+      or_(less_than_(a, 10), is_null_(a)),
+      and_(or_(equals_(mod_(a, 3), 0), equals_(mod_(a, 5), 0)), less_than_(add_(a, a), 8'000)),
+      or_(and_(less_than_(a, 50), like_(s, "%3%")), greater_than_(a, 4'100)),
+      and_(less_than_(a, 0), like_(s, "%3%")),
+      or_(greater_than_equals_(a, 0), like_(s, "%3%"))};
+
+  const auto test_expressions = [&]() {
+    for (const auto& expression : expressions) {
+      const auto chunk_pos_list =
+          ExpressionEvaluator{table, ChunkID{0}, {}, {}, ExpressionEvaluator::EvaluationMode::Chunk}
+              .evaluate_expression_to_pos_list(*expression);
+      const auto batched_pos_list = ExpressionEvaluator{table, ChunkID{0}}.evaluate_expression_to_pos_list(*expression);
+      EXPECT_EQ(batched_pos_list, chunk_pos_list) << expression->description();
+    }
+
+    // 4001 to 4009 without 4004, which is NULL
+    const auto pos_list = ExpressionEvaluator{table, ChunkID{0}}.evaluate_expression_to_pos_list(*expressions[0]);
+    EXPECT_EQ(pos_list.size(), 8);
+  };
+
+  test_expressions();
+
+  table->last_chunk()->finalize();
+  ChunkEncoder::encode_all_chunks(table);
+  test_expressions();
+}
+
 }  // namespace opossum
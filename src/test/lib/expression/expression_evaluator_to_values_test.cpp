@@ -21,6 +21,7 @@
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/load_table.hpp"
 
@@ -144,6 +145,18 @@ class ExpressionEvaluatorToValuesTest : public BaseTest {
     return false;
   }
 
+  // Single-chunk table with the nullable int column "a" (every seventh value is NULL, the others equal the row index)
+  // and the string column "s" (the row index)
+  static std::shared_ptr<Table> create_batch_table(const ChunkOffset row_count) {
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}, {"s", DataType::String, false}};
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, row_count);
+    for (auto row_idx = int32_t{0}; row_idx < static_cast<int32_t>(row_count); ++row_idx) {
+      const auto value = row_idx % 7 == 0 ? NULL_VALUE : AllTypeVariant{row_idx};
+      table->append({value, pmr_string{std::to_string(row_idx)}});
+    }
+    return table;
+  }
+
   std::shared_ptr<Table> table_empty, table_a, table_b, table_bools;
 
   std::shared_ptr<PQPColumnExpression> a, b, c, d, e, f, s1, s2, s3, dates, dates2, x, bool_a, bool_b, bool_c;
@@ -808,4 +821,58 @@ TEST_F(ExpressionEvaluatorToValuesTest, CastSeries) {
       test_expression<pmr_string>(table_a, *cast_(c, DataType::String), {"33", std::nullopt, "34", std::nullopt}));
 }
 
+TEST_F(ExpressionEvaluatorToValuesTest, BatchedEqualsChunkEvaluation) {
+  // Three batches, the last one is not full
+  const auto row_count = ChunkOffset{ExpressionEvaluator::BATCH_SIZE * 2 + 100};
+  const auto table = create_batch_table(row_count);
+
+  const auto a = PQPColumnExpression::from_table(*table, "a");
+  const auto s = PQPColumnExpression::from_table(*table, "s");
+
+  // The second expression reuses the first one, and only some batches of the last one contain NULLs
+  const auto a_times_two = mul_(a, 2);
+  const auto expressions = std::vector<std::shared_ptr<AbstractExpression>>{
+      a_times_two,
+      add_(a_times_two, 1),
+      concat_(s, "x"),
+      and_(greater_than_(a, 100), like_(s, "%1%")),
+      case_(greater_than_(a_times_two, 8'000), a, 5)};
+
+  const auto chunk_segments =
+      ExpressionEvaluator{table, ChunkID{0}, {}, {}, ExpressionEvaluator::EvaluationMode::Chunk}
+          .evaluate_expressions_to_segments(expressions);
+  const auto batched_segments = ExpressionEvaluator{table, ChunkID{0}}.evaluate_expressions_to_segments(expressions);
+
+  ASSERT_EQ(batched_segments.size(), expressions.size());
+  for (auto expression_idx = size_t{0}; expression_idx < expressions.size(); ++expression_idx) {
+    EXPECT_EQ(batched_segments[expression_idx]->size(), row_count);
+    EXPECT_EQ(batched_segments[expression_idx]->is_nullable(), chunk_segments[expression_idx]->is_nullable());
+    EXPECT_SEGMENT_EQ_ORDERED(batched_segments[expression_idx], chunk_segments[expression_idx]);
+  }
+
+  EXPECT_EQ((*batched_segments[1])[4'001], AllTypeVariant{8'003});
+  EXPECT_TRUE(variant_is_null((*batched_segments[1])[4'004]));
+  EXPECT_EQ((*batched_segments[2])[4'004], AllTypeVariant{pmr_string{"4004x"}});
+}
+
+TEST_F(ExpressionEvaluatorToValuesTest, BatchedEvaluationAccessesEncodedSegmentsOnce) {
+  const auto row_count = ChunkOffset{ExpressionEvaluator::BATCH_SIZE * 2 + 100};
+  const auto table = create_batch_table(row_count);
+  table->last_chunk()->finalize();
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::LZ4});
+
+  const auto a = PQPColumnExpression::from_table(*table, "a");
+  const auto s = PQPColumnExpression::from_table(*table, "s");
+  ExpressionEvaluator{table, ChunkID{0}}.evaluate_expressions_to_segments({mul_(a, 2), concat_(s, "x")});
+
+  // Each batch only decodes its own rows, so every row is accessed exactly once
+  const auto chunk = table->get_chunk(ChunkID{0});
+  for (const auto column_id : {ColumnID{0}, ColumnID{1}}) {
+    const auto& access_counter = chunk->get_segment(column_id)->access_counter;
+    EXPECT_EQ(access_counter[SegmentAccessCounter::AccessType::Sequential], row_count);
+    EXPECT_EQ(access_counter[SegmentAccessCounter::AccessType::Point], 0);
+    EXPECT_EQ(access_counter[SegmentAccessCounter::AccessType::Random], 0);
+  }
+}
+
 }  // namespace opossum
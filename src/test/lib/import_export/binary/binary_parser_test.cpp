@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -6,6 +9,7 @@
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -13,7 +17,24 @@ namespace opossum {
 
 class BinaryParserTest : public BaseTest {
  protected:
+  void TearDown() override { std::remove(_chunk_directory_filename.c_str()); }
+
+  // Table with four chunks, the last of which is not full
+  static std::shared_ptr<Table> _create_chunk_directory_test_table() {
+    const auto column_definitions = TableColumnDefinitions{
+        {"a", DataType::Int, true}, {"b", DataType::String, false}, {"c", DataType::Double, false}};
+    auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3}, UseMvcc::Yes);
+    for (auto row = 0; row < 10; ++row) {
+      table->append({row % 4 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{row},
+                     pmr_string(static_cast<size_t>(row), 'x'), row * 0.5});
+    }
+    table->last_chunk()->finalize();
+    table->get_chunk(ChunkID{1})->set_individually_sorted_by(SortColumnDefinition{ColumnID{2}});
+    return table;
+  }
+
   const std::string _reference_filepath = "resources/test_data/bin/";
+  const std::string _chunk_directory_filename = test_data_path + "chunk_directory_format_test.bin";
 };
 
 class BinaryParserMultiEncodingTest : public BinaryParserTest, public ::testing::WithParamInterface<EncodingType> {};
@@ -422,4 +443,52 @@ TEST_F(BinaryParserTest, SortColumnDefinitions) {
   EXPECT_TRUE(table->get_chunk(ChunkID{2})->individually_sorted_by().empty());
 }
 
+TEST_P(BinaryParserMultiEncodingTest, ChunkDirectoryFormat) {
+  const auto expected_table = _create_chunk_directory_test_table();
+  ChunkEncoder::encode_all_chunks(expected_table, SegmentEncodingSpec{GetParam()});
+
+  BinaryWriter::write_with_chunk_directory(*expected_table, _chunk_directory_filename);
+  const auto table = BinaryParser::parse(_chunk_directory_filename);
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  EXPECT_EQ(table->chunk_count(), 4);
+  EXPECT_EQ(table->target_chunk_size(), 3);
+  EXPECT_TRUE(table->get_chunk(ChunkID{0})->individually_sorted_by().empty());
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->individually_sorted_by(),
+            std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{2}}});
+
+  // Chunks start at aligned offsets, so the file size is a multiple of the alignment plus the size of the last chunk
+  EXPECT_GT(std::filesystem::file_size(_chunk_directory_filename), 3 * BinaryWriter::CHUNK_DIRECTORY_FORMAT_ALIGNMENT);
+}
+
+TEST_F(BinaryParserTest, ChunkDirectoryFormatEmptyTable) {
+  const auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}}, TableType::Data, 100);
+
+  BinaryWriter::write_with_chunk_directory(*expected_table, _chunk_directory_filename);
+  const auto table = BinaryParser::parse(_chunk_directory_filename);
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  EXPECT_EQ(table->target_chunk_size(), 100);
+}
+
+TEST_F(BinaryParserTest, ChunkDirectoryFormatUnsupportedVersion) {
+  BinaryWriter::write_with_chunk_directory(*_create_chunk_directory_test_table(), _chunk_directory_filename);
+
+  auto file = std::fstream{_chunk_directory_filename, std::ios::binary | std::ios::in | std::ios::out};
+  file.seekp(sizeof(BinaryWriter::CHUNK_DIRECTORY_FORMAT_MAGIC));
+  const auto next_version = BinaryWriter::CHUNK_DIRECTORY_FORMAT_VERSION + 1;
+  file.write(reinterpret_cast<const char*>(&next_version), sizeof(next_version));
+  file.close();
+
+  EXPECT_THROW(BinaryParser::parse(_chunk_directory_filename), std::exception);
+}
+
+TEST_F(BinaryParserTest, ChunkDirectoryFormatTruncatedFile) {
+  BinaryWriter::write_with_chunk_directory(*_create_chunk_directory_test_table(), _chunk_directory_filename);
+  std::filesystem::resize_file(_chunk_directory_filename, std::filesystem::file_size(_chunk_directory_filename) - 1);
+
+  EXPECT_THROW(BinaryParser::parse(_chunk_directory_filename), std::exception);
+}
+
 }  // namespace opossum
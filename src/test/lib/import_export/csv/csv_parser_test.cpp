@@ -1,3 +1,6 @@
+#include <cstdio>
+#include <fstream>
+
 #include "base_test.hpp"
 
 #include "hyrise.hpp"
@@ -5,11 +8,23 @@
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/run_length_segment.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
 
-class CsvParserTest : public BaseTest {};
+class CsvParserTest : public BaseTest {
+ protected:
+  void TearDown() override { std::remove(_generated_filename.c_str()); }
+
+  void _write_generated_file(const std::string& content) const {
+    auto file = std::ofstream{_generated_filename, std::ios::binary};
+    file << content;
+  }
+
+  const std::string _generated_filename = test_data_path + "csv_parser_test.csv";
+};
 
 TEST_F(CsvParserTest, SingleFloatColumn) {
   auto table = CsvParser::parse("resources/test_data/csv/float.csv");
@@ -300,4 +315,105 @@ TEST_F(CsvParserTest, FinalizedChunks) {
   EXPECT_FALSE(table->get_chunk(ChunkID{2})->is_mutable());
 }
 
+TEST_F(CsvParserTest, EncodedChunks) {
+  const auto chunk_encoding_spec =
+      ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::RunLength}, SegmentEncodingSpec{EncodingType::Dictionary}};
+  const auto table = CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{40}, std::nullopt,
+                                      chunk_encoding_spec);
+  const auto expected_table = CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{40});
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  ASSERT_EQ(table->chunk_count(), 3);
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+}
+
+TEST_F(CsvParserTest, QuotedFieldsAcrossChunks) {
+  // Quoted fields with separators and delimiters, so that fields and rows span the blocks in which special characters
+  // are searched for
+  auto content = std::string{};
+  auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, false}}, TableType::Data, 7);
+  for (auto row = 0; row < 1'000; ++row) {
+    const auto string = std::string(static_cast<size_t>(row % 90), 'x') + (row % 3 == 0 ? ",\n" : "");
+    content += std::to_string(row) + ",\"" + string + "\"\n";
+    expected_table->append({row, pmr_string{string}});
+  }
+  _write_generated_file(content);
+
+  auto meta = CsvMeta{};
+  meta.columns = {{"a", "int", false}, {"b", "string", false}};
+  const auto table = CsvParser::parse(_generated_filename, ChunkOffset{7}, meta);
+
+  EXPECT_EQ(table->chunk_count(), 143);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, FieldsAndQuotesAcrossReadBlocks) {
+  // Escaped quotes, separators, and delimiters within quotes, and NULLs, so that every kind of field and quote
+  // straddles a block boundary for some block size
+  _write_generated_file("1,\"a\"\"b\",2.5\n,\"c,\nd\",\n33,\"\"\"\",-1\n4,\"\",\n");
+
+  auto meta = CsvMeta{};
+  meta.columns = {{"a", "int", true}, {"b", "string", false}, {"c", "double", true}};
+  const auto expected_table = CsvParser::parse(_generated_filename, ChunkOffset{2}, meta);
+  ASSERT_EQ(expected_table->row_count(), 4);
+  EXPECT_EQ(expected_table->get_value<pmr_string>(ColumnID{1}, 0), "a\"b");
+  EXPECT_EQ(expected_table->get_value<pmr_string>(ColumnID{1}, 1), "c,\nd");
+
+  for (auto block_size = size_t{1}; block_size <= 8; ++block_size) {
+    const auto table = CsvParser::parse(_generated_filename, ChunkOffset{2}, meta, std::nullopt, block_size);
+    EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  }
+}
+
+TEST_F(CsvParserTest, UnterminatedQuote) {
+  _write_generated_file("1,\"a\"\n2,\"b\n3,c\n");
+
+  auto meta = CsvMeta{};
+  meta.columns = {{"a", "int", false}, {"b", "string", false}};
+  EXPECT_THROW(CsvParser::parse(_generated_filename, Chunk::DEFAULT_SIZE, meta), std::logic_error);
+  EXPECT_THROW(CsvParser::parse(_generated_filename, Chunk::DEFAULT_SIZE, meta, std::nullopt, 2), std::logic_error);
+}
+
+TEST_F(CsvParserTest, InferMeta) {
+  _write_generated_file("1,2147483648,1.5,\"x\",7\n-2,3,2,abc,\n3,,-4e2,\"1\",8\n");
+
+  const auto meta = CsvParser::infer_meta(_generated_filename);
+  ASSERT_EQ(meta.columns.size(), 5);
+  const auto expected_columns = std::vector<std::tuple<std::string, std::string, bool>>{
+      {"column_0", "int", false},
+      {"column_1", "long", true},
+      {"column_2", "double", false},
+      {"column_3", "string", false},
+      {"column_4", "int", true}};
+  for (auto column_id = size_t{0}; column_id < meta.columns.size(); ++column_id) {
+    const auto& column = meta.columns[column_id];
+    EXPECT_EQ(std::tie(column.name, column.type, column.nullable), expected_columns[column_id]);
+  }
+
+  const auto table = CsvParser::parse(_generated_filename, ChunkOffset{2}, meta);
+  auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"column_0", DataType::Int, false},
+                             {"column_1", DataType::Long, true},
+                             {"column_2", DataType::Double, false},
+                             {"column_3", DataType::String, false},
+                             {"column_4", DataType::Int, true}},
+      TableType::Data, 2);
+  expected_table->append({1, int64_t{2147483648}, 1.5, "x", 7});
+  expected_table->append({-2, int64_t{3}, 2.0, "abc", NullValue{}});
+  expected_table->append({3, NullValue{}, -400.0, "1", 8});
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_F(CsvParserTest, InferMetaEmptyFile) {
+  _write_generated_file("");
+  EXPECT_TRUE(CsvParser::infer_meta(_generated_filename).columns.empty());
+  EXPECT_THROW(CsvParser::infer_meta("not_existing_file"), std::exception);
+}
+
 }  // namespace opossum
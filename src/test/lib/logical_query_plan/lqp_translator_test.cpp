@@ -33,12 +33,14 @@
 #include "logical_query_plan/union_node.hpp"
 #include "logical_query_plan/validate_node.hpp"
 #include "operators/aggregate_hash.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/change_meta_table.hpp"
 #include "operators/export.hpp"
 #include "operators/get_table.hpp"
 #include "operators/import.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
@@ -47,9 +49,11 @@
 #include "operators/maintenance/drop_table.hpp"
 #include "operators/product.hpp"
 #include "operators/projection.hpp"
+#include "operators/runtime_join_filter.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "storage/chunk_encoder.hpp"
@@ -626,6 +630,45 @@ TEST_F(LQPTranslatorTest, JoinNodeToJoinHash) {
   EXPECT_EQ(join_op->mode(), JoinMode::Inner);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeWithInstalledCostCoefficients) {
+  // The default LQPTranslator uses the coefficients installed in Hyrise. With expensive hash tables, JoinSortMerge is
+  // cheaper than JoinHash.
+  Hyrise::get().physical_cost_coefficients.hash_build_per_row = 1'000'000.0f;
+
+  const auto join_node =
+      JoinNode::make(JoinMode::Inner, equals_(int_float2_b, int_float_b), int_float_node, int_float2_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinSortMerge>(LQPTranslator{}.translate_node(join_node)));
+}
+
+TEST_F(LQPTranslatorTest, CardinalityEstimatorOnlyUsedForChoices) {
+  // Counts the caching instances created from it
+  class CountingCardinalityEstimator : public CardinalityEstimator {
+   public:
+    std::shared_ptr<AbstractCardinalityEstimator> new_instance() const override {
+      ++instance_count;
+      return CardinalityEstimator::new_instance();
+    }
+
+    mutable size_t instance_count{0};
+  };
+  const auto cardinality_estimator = std::make_shared<CountingCardinalityEstimator>();
+
+  // Plans without a choice between operator implementations are not estimated
+  const auto predicate_node = PredicateNode::make(greater_than_(int_float_a, 5), int_float_node);
+  LQPTranslator{cardinality_estimator}.translate_node(predicate_node);
+  EXPECT_EQ(cardinality_estimator->instance_count, size_t{0});
+
+  // A single caching instance of the given cardinality estimator is used for all joins of the plan
+  // clang-format off
+  const auto join_node =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float2_a),
+    JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float5_a), int_float_node, int_float5_node),
+    int_float2_node);
+  // clang-format on
+  LQPTranslator{cardinality_estimator}.translate_node(join_node);
+  EXPECT_EQ(cardinality_estimator->instance_count, size_t{1});
+}
+
 TEST_F(LQPTranslatorTest, JoinNodeToJoinSortMerge) {
   /**
    * Build LQP and translate to PQP
@@ -644,6 +687,81 @@ TEST_F(LQPTranslatorTest, JoinNodeToJoinSortMerge) {
   EXPECT_EQ(join_op->mode(), JoinMode::Inner);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeToJoinSortMergeForSortedInputs) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  // clang-format off
+  const auto join_node =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_b, int_float2_b),
+    SortNode::make(expression_vector(int_float_b), std::vector{SortMode::Ascending}, int_float_node),
+    SortNode::make(expression_vector(int_float2_b), std::vector{SortMode::Descending}, int_float2_node));
+  // clang-format on
+  const auto op = LQPTranslator{}.translate_node(join_node);
+
+  /**
+   * Check PQP - both inputs are sorted by the join columns, so JoinSortMerge only has to merge them and is preferred
+   * over JoinHash
+   */
+  const auto join_op = std::dynamic_pointer_cast<JoinSortMerge>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->primary_predicate().column_ids, ColumnIDPair(ColumnID{1}, ColumnID{1}));
+  EXPECT_EQ(join_op->primary_predicate().predicate_condition, PredicateCondition::Equals);
+
+  // If only one input is sorted, JoinHash is used
+  // clang-format off
+  const auto join_node_one_sorted_input =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_b, int_float2_b),
+    SortNode::make(expression_vector(int_float_b), std::vector{SortMode::Ascending}, int_float_node),
+    int_float2_node);
+  // clang-format on
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_one_sorted_input)));
+
+  // Scans on the sorted reference tables may shuffle the rows, so JoinHash is used
+  // clang-format off
+  const auto join_node_scanned_sorted_inputs =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_b, int_float2_b),
+    PredicateNode::make(greater_than_(int_float_a, 0),
+      SortNode::make(expression_vector(int_float_b), std::vector{SortMode::Ascending}, int_float_node)),
+    PredicateNode::make(greater_than_(int_float2_a, 0),
+      SortNode::make(expression_vector(int_float2_b), std::vector{SortMode::Descending}, int_float2_node)));
+  // clang-format on
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node_scanned_sorted_inputs)));
+}
+
+TEST_F(LQPTranslatorTest, JoinNodeToJoinIndex) {
+  // The right input is much larger than the left one and has an index on the join column
+  const auto indexed_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                      TableType::Data, ChunkOffset{1'000}, UseMvcc::Yes);
+  for (auto value = int32_t{0}; value < 1'000; ++value) {
+    indexed_table->append({value});
+  }
+  indexed_table->get_chunk(ChunkID{0})->finalize();
+  ChunkEncoder::encode_all_chunks(indexed_table);
+  Hyrise::get().storage_manager.add_table("indexed_table", indexed_table);
+  const auto indexed_table_node = StoredTableNode::make("indexed_table");
+  const auto indexed_table_a = indexed_table_node->get_column("a");
+
+  const auto join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, indexed_table_a), int_float_node,
+                                        indexed_table_node);
+
+  // Without an index, building a hash table for the left input and probing it with the right input is cheapest
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(join_node)));
+
+  // With an index, looking up the rows of the left input in it is cheaper
+  indexed_table->get_chunk(ChunkID{0})->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  const auto op = LQPTranslator{}.translate_node(join_node);
+  const auto join_op = std::dynamic_pointer_cast<JoinIndex>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->primary_predicate().column_ids, ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(join_op->mode(), JoinMode::Inner);
+
+  // JoinIndex is not used if the index is on the left input only
+  const auto swapped_join_node = JoinNode::make(JoinMode::Inner, equals_(int_float_a, indexed_table_a),
+                                                indexed_table_node, int_float_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(swapped_join_node)));
+}
+
 TEST_F(LQPTranslatorTest, JoinNodeToJoinNestedLoop) {
   /**
    * Build LQP and translate to PQP
@@ -691,6 +809,40 @@ TEST_F(LQPTranslatorTest, AggregateNodeSimple) {
   EXPECT_EQ(*count, *count_(pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*")));
 }
 
+TEST_F(LQPTranslatorTest, AggregateNodeToAggregateSort) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  // clang-format off
+  const auto join_node =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_b, int_float2_b),
+    SortNode::make(expression_vector(int_float_b), std::vector{SortMode::Ascending}, int_float_node),
+    SortNode::make(expression_vector(int_float2_b), std::vector{SortMode::Ascending}, int_float2_node));
+
+  const auto lqp =
+  AggregateNode::make(expression_vector(int_float_b), expression_vector(sum_(int_float2_a)),
+    join_node);
+  // clang-format on
+  const auto op = LQPTranslator{}.translate_node(lqp);
+
+  /**
+   * Check PQP - the output of the JoinSortMerge is value clustered and sorted by the group-by column, so AggregateSort
+   * does not need to sort it
+   */
+  const auto aggregate_op = std::dynamic_pointer_cast<AggregateSort>(op);
+  ASSERT_TRUE(aggregate_op);
+  EXPECT_EQ(aggregate_op->groupby_column_ids(), std::vector<ColumnID>{ColumnID{1}});
+  ASSERT_TRUE(std::dynamic_pointer_cast<const JoinSortMerge>(aggregate_op->left_input()));
+
+  // If the input is grouped by an additional column, it needs to be sorted and AggregateHash is used
+  // clang-format off
+  const auto lqp_two_group_by_columns =
+  AggregateNode::make(expression_vector(int_float_b, int_float2_a), expression_vector(sum_(int_float_a)),
+    join_node);
+  // clang-format on
+  EXPECT_TRUE(std::dynamic_pointer_cast<AggregateHash>(LQPTranslator{}.translate_node(lqp_two_group_by_columns)));
+}
+
 TEST_F(LQPTranslatorTest, JoinAndPredicates) {
   /**
    * Build LQP and translate to PQP
@@ -730,6 +882,80 @@ TEST_F(LQPTranslatorTest, JoinAndPredicates) {
   EXPECT_EQ(get_table_op_right->table_name(), "table_int_float2");
 }
 
+TEST_F(LQPTranslatorTest, JoinHashRuntimeJoinFilter) {
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Inner, equals_(int_float_a, int_float2_a),
+    PredicateNode::make(equals_(int_float_b, 42.0), int_float_node),
+    PredicateNode::make(greater_than_(int_float2_b, 30.0), int_float2_node));
+  // clang-format on
+
+  const auto op = LQPTranslator{}.translate_node(lqp);
+
+  const auto join_op = std::dynamic_pointer_cast<const JoinHash>(op);
+  ASSERT_TRUE(join_op);
+
+  // The scan on the right (i.e., probe) side is filtered with the values of the left input.
+  const auto predicate_op_left = std::dynamic_pointer_cast<const TableScan>(join_op->left_input());
+  const auto predicate_op_right = std::dynamic_pointer_cast<const TableScan>(join_op->right_input());
+  ASSERT_TRUE(predicate_op_left);
+  ASSERT_TRUE(predicate_op_right);
+  EXPECT_FALSE(predicate_op_left->runtime_join_filter());
+
+  const auto& runtime_join_filter = predicate_op_right->runtime_join_filter();
+  ASSERT_TRUE(runtime_join_filter);
+  EXPECT_EQ(runtime_join_filter->build_input(), join_op->left_input());
+  EXPECT_EQ(runtime_join_filter->build_column_id(), ColumnID{0});
+  EXPECT_EQ(runtime_join_filter->probe_column_id(), ColumnID{0});
+}
+
+TEST_F(LQPTranslatorTest, JoinHashRuntimeJoinFilterSemiJoin) {
+  // For semi joins, the left input is the probe side.
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Semi, equals_(int_float_a, int_float2_a),
+    PredicateNode::make(equals_(int_float_b, 42.0), int_float_node),
+    PredicateNode::make(greater_than_(int_float2_b, 30.0), int_float2_node));
+  // clang-format on
+
+  const auto op = LQPTranslator{}.translate_node(lqp);
+
+  const auto join_op = std::dynamic_pointer_cast<const JoinHash>(op);
+  ASSERT_TRUE(join_op);
+
+  const auto predicate_op_left = std::dynamic_pointer_cast<const TableScan>(join_op->left_input());
+  const auto predicate_op_right = std::dynamic_pointer_cast<const TableScan>(join_op->right_input());
+  ASSERT_TRUE(predicate_op_left);
+  ASSERT_TRUE(predicate_op_right);
+  EXPECT_FALSE(predicate_op_right->runtime_join_filter());
+
+  const auto& runtime_join_filter = predicate_op_left->runtime_join_filter();
+  ASSERT_TRUE(runtime_join_filter);
+  EXPECT_EQ(runtime_join_filter->build_input(), join_op->right_input());
+}
+
+TEST_F(LQPTranslatorTest, JoinHashNoRuntimeJoinFilterForOuterJoins) {
+  // Outer joins keep the rows without a join partner, so they must not be filtered.
+  // clang-format off
+  const auto lqp =
+  JoinNode::make(JoinMode::Left, equals_(int_float_a, int_float2_a),
+    PredicateNode::make(equals_(int_float_b, 42.0), int_float_node),
+    PredicateNode::make(greater_than_(int_float2_b, 30.0), int_float2_node));
+  // clang-format on
+
+  const auto op = LQPTranslator{}.translate_node(lqp);
+
+  const auto join_op = std::dynamic_pointer_cast<const JoinHash>(op);
+  ASSERT_TRUE(join_op);
+
+  const auto predicate_op_left = std::dynamic_pointer_cast<const TableScan>(join_op->left_input());
+  const auto predicate_op_right = std::dynamic_pointer_cast<const TableScan>(join_op->right_input());
+  ASSERT_TRUE(predicate_op_left);
+  ASSERT_TRUE(predicate_op_right);
+  EXPECT_FALSE(predicate_op_left->runtime_join_filter());
+  EXPECT_FALSE(predicate_op_right->runtime_join_filter());
+}
+
 TEST_F(LQPTranslatorTest, LimitNode) {
   /**
    * Build LQP and translate to PQP
@@ -748,6 +974,53 @@ TEST_F(LQPTranslatorTest, LimitNode) {
   EXPECT_EQ(*limit_op->row_count_expression(), *value_(2));
 }
 
+TEST_F(LQPTranslatorTest, LimitSortToTopK) {
+  /**
+   * LQP resembles:
+   *   SELECT * FROM int_float ORDER BY b DESC, a LIMIT 3
+   */
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(value_(3),
+    SortNode::make(expression_vector(int_float_b, int_float_a), std::vector{SortMode::Descending, SortMode::Ascending},
+      int_float_node));
+  // clang-format on
+
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  const auto top_k = std::dynamic_pointer_cast<const TopK>(pqp);
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(*top_k->row_count_expression(), *value_(3));
+  const auto expected_sort_definitions = std::vector{SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                                                     SortColumnDefinition{ColumnID{0}, SortMode::Ascending}};
+  EXPECT_EQ(top_k->sort_definitions(), expected_sort_definitions);
+
+  const auto get_table = std::dynamic_pointer_cast<const GetTable>(top_k->left_input());
+  ASSERT_TRUE(get_table);
+  EXPECT_EQ(get_table->table_name(), "table_int_float");
+}
+
+TEST_F(LQPTranslatorTest, LimitSortWithMultipleConsumersIsNotFused) {
+  // The Sort node is also consumed by the Union and therefore has to be fully executed.
+  const auto sort_node =
+      SortNode::make(expression_vector(int_float_a), std::vector{SortMode::Ascending}, int_float_node);
+
+  // clang-format off
+  const auto lqp =
+  UnionNode::make(SetOperationMode::All,
+    LimitNode::make(value_(3),
+      sort_node),
+    sort_node);
+  // clang-format on
+
+  const auto pqp = LQPTranslator{}.translate_node(lqp);
+
+  const auto limit = std::dynamic_pointer_cast<const Limit>(pqp->left_input());
+  ASSERT_TRUE(limit);
+  EXPECT_EQ(limit->left_input()->type(), OperatorType::Sort);
+  EXPECT_EQ(limit->left_input(), pqp->right_input());
+}
+
 TEST_F(LQPTranslatorTest, DiamondShapeSimple) {
   /**
    * Test that
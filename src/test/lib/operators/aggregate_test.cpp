@@ -18,6 +18,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
@@ -832,6 +833,73 @@ TYPED_TEST(OperatorsAggregateTest, OuterJoinThenAggregate) {
                          "resources/test_data/tbl/aggregateoperator/groupby_int_1gb_1agg/outer_join.tbl", false);
 }
 
+TYPED_TEST(OperatorsAggregateTest, DictionaryEncodedGroupByColumns) {
+  // AggregateHash groups on the value ids of dictionary segments. Each chunk has a different dictionary, and the
+  // chunks are encoded differently, so that the ids have to be translated into the same space.
+  const auto column_definitions = TableColumnDefinitions{
+      {"s", DataType::String, true}, {"l", DataType::Long, true}, {"v", DataType::Int, false}};
+  const auto create_table = [&]() {
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{4});
+    table->append({pmr_string{"b"}, int64_t{1}, 1});
+    table->append({pmr_string{"a"}, int64_t{2}, 2});
+    table->append({NULL_VALUE, int64_t{1}, 3});
+    table->append({pmr_string{"a longer string"}, NULL_VALUE, 4});
+    table->append({pmr_string{"a"}, int64_t{3}, 5});
+    table->append({pmr_string{"c"}, int64_t{1}, 6});
+    table->append({pmr_string{"a longer string"}, int64_t{2}, 7});
+    table->append({NULL_VALUE, NULL_VALUE, 8});
+    table->append({pmr_string{"b"}, int64_t{3}, 9});
+    table->append({pmr_string{"a"}, int64_t{2}, 10});
+    table->append({pmr_string{"c"}, int64_t{1}, 11});
+    table->append({pmr_string{"a"}, int64_t{2}, 12});
+    table->last_chunk()->finalize();
+    return table;
+  };
+
+  const auto unencoded_table = create_table();
+  const auto encoded_table = create_table();
+  ChunkEncoder::encode_chunks(
+      encoded_table, {ChunkID{0}, ChunkID{1}},
+      {{ChunkID{0}, ChunkEncodingSpec(3, SegmentEncodingSpec{EncodingType::Dictionary})},
+       {ChunkID{1}, ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::FixedStringDictionary},
+                                      SegmentEncodingSpec{EncodingType::Dictionary},
+                                      SegmentEncodingSpec{EncodingType::Unencoded}}}});
+
+  const auto unencoded_wrapper = std::make_shared<TableWrapper>(unencoded_table);
+  unencoded_wrapper->execute();
+  const auto encoded_wrapper = std::make_shared<TableWrapper>(encoded_table);
+  encoded_wrapper->execute();
+
+  const auto v = pqp_column_(ColumnID{2}, DataType::Int, false, "v");
+  const auto count_star = pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*");
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      sum_(v), std::make_shared<AggregateExpression>(AggregateFunction::Count, count_star)};
+
+  const auto groupby_column_id_sets = std::vector<std::vector<ColumnID>>{{ColumnID{0}}, {ColumnID{0}, ColumnID{1}}};
+  for (const auto& groupby_column_ids : groupby_column_id_sets) {
+    SCOPED_TRACE(groupby_column_ids.size());
+
+    const auto expected_aggregate = std::make_shared<TypeParam>(unencoded_wrapper, aggregates, groupby_column_ids);
+    expected_aggregate->execute();
+    const auto aggregate = std::make_shared<TypeParam>(encoded_wrapper, aggregates, groupby_column_ids);
+    aggregate->execute();
+    EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_aggregate->get_output());
+
+    // ReferenceSegments that point to a single dictionary segment are grouped on value ids as well.
+    const auto expected_table_scan = std::make_shared<TableScan>(unencoded_wrapper, greater_than_(v, 2));
+    expected_table_scan->execute();
+    const auto table_scan = std::make_shared<TableScan>(encoded_wrapper, greater_than_(v, 2));
+    table_scan->execute();
+
+    const auto expected_reference_aggregate =
+        std::make_shared<TypeParam>(expected_table_scan, aggregates, groupby_column_ids);
+    expected_reference_aggregate->execute();
+    const auto reference_aggregate = std::make_shared<TypeParam>(table_scan, aggregates, groupby_column_ids);
+    reference_aggregate->execute();
+    EXPECT_TABLE_EQ_UNORDERED(reference_aggregate->get_output(), expected_reference_aggregate->get_output());
+  }
+}
+
 TYPED_TEST(OperatorsAggregateTest, StringVariations) {
   // Check that different strings in the GROUP BY column are treated correctly even in the presence of optimizations.
   // Not using a tbl file as expressing edge cases like "\0" feels safer in C++ code than in tbl files.
@@ -894,4 +962,84 @@ TYPED_TEST(OperatorsAggregateTest, StringVariations) {
   EXPECT_EQ(values_sorted, result_values_sorted);
 }
 
+class AggregateHashParallelTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // With multiple workers, AggregateHash pre-aggregates large inputs in parallel and merges the partial results.
+    Hyrise::get().topology.use_fake_numa_topology(4, 2);
+    Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+    // Column a has 50'000 groups (the gaps prevent the immediate key shortcut), b has ten groups, c is a nullable
+    // value column, and d a float value column.
+    const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false},
+                                                                      {"b", DataType::Int, false},
+                                                                      {"c", DataType::Int, true},
+                                                                      {"d", DataType::Float, false}},
+                                               TableType::Data, ChunkOffset{10'000});
+    for (auto row_id = int32_t{0}; row_id < 70'000; ++row_id) {
+      const auto c = row_id % 7 == 0 ? NULL_VALUE : AllTypeVariant{row_id % 1'000};
+      table->append({row_id % 50'000 * 3, row_id % 10 * 100'000, c, static_cast<float>(row_id % 13)});
+    }
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->never_clear_output();
+    _table_wrapper->execute();
+  }
+
+  // Compares the result of AggregateHash to that of AggregateSort, which does not aggregate in parallel.
+  void expect_equal_to_aggregate_sort(const std::vector<std::pair<ColumnID, AggregateFunction>>& aggregate_definitions,
+                                      const std::vector<ColumnID>& groupby_column_ids) {
+    const auto& table = _table_wrapper->get_output();
+    auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{};
+    for (const auto& [column_id, aggregate_function] : aggregate_definitions) {
+      if (column_id != INVALID_COLUMN_ID) {
+        aggregates.emplace_back(std::make_shared<AggregateExpression>(
+            aggregate_function, pqp_column_(column_id, table->column_data_type(column_id),
+                                            table->column_is_nullable(column_id), table->column_name(column_id))));
+      } else {
+        aggregates.emplace_back(std::make_shared<AggregateExpression>(
+            aggregate_function, pqp_column_(column_id, DataType::Long, false, "*")));
+      }
+    }
+
+    const auto aggregate_hash = std::make_shared<AggregateHash>(_table_wrapper, aggregates, groupby_column_ids);
+    aggregate_hash->execute();
+    const auto aggregate_sort = std::make_shared<AggregateSort>(_table_wrapper, aggregates, groupby_column_ids);
+    aggregate_sort->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), aggregate_sort->get_output());
+  }
+
+  const std::vector<std::pair<ColumnID, AggregateFunction>> _aggregate_definitions{
+      {ColumnID{2}, AggregateFunction::Sum},
+      {ColumnID{2}, AggregateFunction::Min},
+      {ColumnID{3}, AggregateFunction::Max},
+      {ColumnID{3}, AggregateFunction::Avg},
+      {ColumnID{2}, AggregateFunction::Count},
+      {INVALID_COLUMN_ID, AggregateFunction::Count},
+      {ColumnID{2}, AggregateFunction::CountDistinct},
+      {ColumnID{3}, AggregateFunction::StandardDeviationSample}};
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(AggregateHashParallelTest, ManyGroups) {
+  expect_equal_to_aggregate_sort(_aggregate_definitions, {ColumnID{0}});
+}
+
+TEST_F(AggregateHashParallelTest, FewGroups) {
+  expect_equal_to_aggregate_sort(_aggregate_definitions, {ColumnID{1}});
+}
+
+TEST_F(AggregateHashParallelTest, MultipleGroupByColumns) {
+  expect_equal_to_aggregate_sort(_aggregate_definitions, {ColumnID{0}, ColumnID{1}});
+}
+
+TEST_F(AggregateHashParallelTest, NoGroupByColumns) { expect_equal_to_aggregate_sort(_aggregate_definitions, {}); }
+
+TEST_F(AggregateHashParallelTest, Distinct) {
+  expect_equal_to_aggregate_sort({}, {ColumnID{0}});
+  expect_equal_to_aggregate_sort({}, {ColumnID{1}, ColumnID{2}});
+}
+
 }  // namespace opossum
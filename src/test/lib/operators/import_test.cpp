@@ -1,15 +1,20 @@
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <string>
 
 #include "base_test.hpp"
 
 #include "hyrise.hpp"
+#include "import_export/csv/csv_parser.hpp"
 #include "import_export/file_type.hpp"
 #include "operators/import.hpp"
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/frame_of_reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 
 namespace opossum {
 
@@ -136,4 +141,39 @@ TEST_F(OperatorsImportTest, TargetChunkSize) {
   EXPECT_TABLE_EQ_ORDERED(Hyrise::get().storage_manager.get_table("a"), expected_table);
 }
 
+TEST_F(OperatorsImportTest, TargetEncoding) {
+  const auto importer = std::make_shared<Import>("resources/test_data/csv/float_int_large.csv", "a", ChunkOffset{20},
+                                                 FileType::Auto, std::nullopt,
+                                                 SegmentEncodingSpec{EncodingType::FrameOfReference});
+  importer->execute();
+
+  // FrameOfReference does not support floats
+  const auto table = Hyrise::get().storage_manager.get_table("a");
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<FrameOfReferenceSegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+  EXPECT_TABLE_EQ_ORDERED(table, CsvParser::parse("resources/test_data/csv/float_int_large.csv"));
+}
+
+TEST_F(OperatorsImportTest, CsvWithoutMetaFile) {
+  const auto filename = test_data_path + "import_test.csv";
+  {
+    auto file = std::ofstream{filename};
+    file << "1,\"x\"\n2,y\n";
+  }
+
+  const auto importer = std::make_shared<Import>(filename, "a");
+  importer->execute();
+  std::remove(filename.c_str());
+
+  auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"column_0", DataType::Int, false}, {"column_1", DataType::String, false}},
+      TableType::Data);
+  expected_table->append({1, "x"});
+  expected_table->append({2, "y"});
+  EXPECT_TABLE_EQ_ORDERED(Hyrise::get().storage_manager.get_table("a"), expected_table);
+}
+
 }  // namespace opossum
@@ -311,4 +311,82 @@ TYPED_TEST(OperatorsIndexScanTest, AddedChunk) {
                             load_table("resources/test_data/tbl/int_int_shuffled_appended_and_filtered.tbl", 10));
 }
 
+class OperatorsTableIndexScanTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // int_int_shuffled.tbl with a chunk size of 7 has two chunks. The value 4 occurs in both of them.
+    _table = load_table("resources/test_data/tbl/int_int_shuffled.tbl", 7);
+    _table->create_table_index(ColumnID{0});
+    Hyrise::get().storage_manager.add_table("table_index_test_table", _table);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(OperatorsTableIndexScanTest, Equals) {
+  const auto get_table = std::make_shared<GetTable>("table_index_test_table");
+  get_table->execute();
+
+  const auto index_scan = std::make_shared<IndexScan>(get_table, ColumnID{0}, AllTypeVariant{4});
+  index_scan->execute();
+
+  const auto table_scan = std::make_shared<TableScan>(
+      get_table, equals_(pqp_column_(ColumnID{0}, DataType::Int, false, "a"), value_(4)));
+  table_scan->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(index_scan->get_output(), table_scan->get_output());
+  EXPECT_EQ(index_scan->get_output()->chunk_count(), 2);
+}
+
+TEST_F(OperatorsTableIndexScanTest, NoMatches) {
+  const auto get_table = std::make_shared<GetTable>("table_index_test_table");
+  get_table->execute();
+
+  const auto index_scan = std::make_shared<IndexScan>(get_table, ColumnID{0}, AllTypeVariant{5});
+  index_scan->execute();
+  EXPECT_EQ(index_scan->get_output()->row_count(), 0);
+}
+
+TEST_F(OperatorsTableIndexScanTest, PrunedChunksAndColumns) {
+  // Column "a" of the stored table is column 0 of the GetTable output, too. Prune the column "b" and the first chunk.
+  const auto get_table = std::make_shared<GetTable>("table_index_test_table", std::vector<ChunkID>{ChunkID{0}},
+                                                    std::vector<ColumnID>{ColumnID{1}});
+  get_table->execute();
+
+  const auto index_scan = std::make_shared<IndexScan>(get_table, ColumnID{0}, AllTypeVariant{4});
+  index_scan->execute();
+
+  const auto& output = *index_scan->get_output();
+  EXPECT_EQ(output.column_count(), 1);
+  ASSERT_EQ(output.chunk_count(), 1);
+  EXPECT_EQ(output.get_value<int32_t>(ColumnID{0}, 0), 4);
+
+  // The output references the stored table, so that the RowIDs of the index can be used directly
+  const auto reference_segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output.get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(reference_segment);
+  EXPECT_EQ(reference_segment->referenced_table(), _table);
+  EXPECT_EQ(reference_segment->referenced_column_id(), ColumnID{0});
+  EXPECT_EQ(reference_segment->pos_list()->common_chunk_id(), ChunkID{1});
+}
+
+TEST_F(OperatorsTableIndexScanTest, TranslatedFromLQP) {
+  const auto stored_table_node = StoredTableNode::make("table_index_test_table");
+  const auto predicate_node = PredicateNode::make(equals_(stored_table_node->get_column("a"), 4), stored_table_node);
+  predicate_node->scan_type = ScanType::TableIndexScan;
+
+  const auto pqp = LQPTranslator{}.translate_node(predicate_node);
+  const auto index_scan = std::dynamic_pointer_cast<IndexScan>(pqp);
+  ASSERT_TRUE(index_scan);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(index_scan->left_input()));
+
+  // Rows appended after the translation are found as well, as the index is maintained on append
+  _table->append({4, 5});
+  ASSERT_EQ(_table->chunk_count(), 3);
+
+  execute_all({index_scan->mutable_left_input(), index_scan});
+  EXPECT_TABLE_EQ_UNORDERED(index_scan->get_output(),
+                            load_table("resources/test_data/tbl/int_int_shuffled_appended_and_filtered.tbl", 10));
+}
+
 }  // namespace opossum
@@ -165,16 +165,23 @@ TEST_F(JoinHashStepsTest, MaterializeOutputBloomFilter) {
     materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0}, histograms, 1,
                                        bloom_filter);
 
-    // For all input values, their position in the bloom filter should be correctly set to true
-    for (auto value : std::vector<int>{0, 6, 7, 9, 13, 18}) {
-      EXPECT_TRUE(bloom_filter[value]);
+    // The filter is sized for the row count of the input table, which fits in a single block.
+    EXPECT_EQ(bloom_filter.block_count(), 1);
 
-      // Set to false for easier checking of the values that should be false
-      bloom_filter[value] = false;
+    // All input values should be contained in the Bloom filter
+    const auto input_values = std::vector<int>{0, 6, 7, 9, 13, 18};
+    for (const auto value : input_values) {
+      EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(value)));
     }
 
-    // All other slots should be false
-    EXPECT_EQ(bloom_filter, BloomFilter{BLOOM_FILTER_SIZE});
+    // With only six values in the filter, false positives are practically impossible
+    for (auto value = -100; value < 100; ++value) {
+      if (std::find(input_values.begin(), input_values.end(), value) != input_values.end()) continue;
+      EXPECT_FALSE(bloom_filter.contains(std::hash<int>{}(value)));
+    }
+
+    // No statistics are recorded on the shared filter that is used when no input filter is given
+    EXPECT_EQ(ALL_TRUE_BLOOM_FILTER.probe_statistics().probed_count, 0);
   }
 }
 
@@ -184,14 +191,19 @@ TEST_F(JoinHashStepsTest, MaterializeInputBloomFilter) {
     BloomFilter output_bloom_filter;
 
     // Fill input_bloom_filter
-    BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+    BloomFilter input_bloom_filter{3};
     for (auto value : std::vector<int>{6, 7, 9}) {
-      input_bloom_filter[value] = true;
+      input_bloom_filter.insert(std::hash<int>{}(value));
     }
 
     auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
                                                         histograms, 1, output_bloom_filter, input_bloom_filter);
 
+    // All nine non-NULL values have been probed, six of them passed
+    const auto probe_statistics = input_bloom_filter.probe_statistics();
+    EXPECT_EQ(probe_statistics.probed_count, 9);
+    EXPECT_EQ(probe_statistics.passed_count, 6);
+
     auto materialized_values = std::vector<int>{};
     auto chunk_offsets = std::vector<int>{};
 
@@ -284,9 +296,9 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   BloomFilter output_bloom_filter;              // Ignored in this test
 
   // Fill input_bloom_filter
-  BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+  BloomFilter input_bloom_filter{3};
   for (auto value : std::vector<int>{6, 7, 9}) {
-    input_bloom_filter[value] = true;
+    input_bloom_filter.insert(std::hash<int>{}(value));
   }
 
   auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
@@ -303,6 +315,10 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   EXPECT_TRUE(hash_table->contains(9));
   EXPECT_FALSE(hash_table->contains(13));
   EXPECT_FALSE(hash_table->contains(18));
+
+  const auto probe_statistics = input_bloom_filter.probe_statistics();
+  EXPECT_EQ(probe_statistics.probed_count, 9);
+  EXPECT_EQ(probe_statistics.passed_count, 6);
 }
 
 TEST_F(JoinHashStepsTest, ThrowWhenNoNullValuesArePassed) {
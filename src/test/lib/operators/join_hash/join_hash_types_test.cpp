@@ -22,11 +22,9 @@ void test_hash_map(const std::vector<T>& values) {
     partition.null_values.emplace_back(false);
   }
 
-  // Build a BloomFilter that cannot be used to skip any entries by creating a BloomFilter with every value being false
-  // and using bitwise negation (~x).
-  auto bloom_filter = ~BloomFilter(BLOOM_FILTER_SIZE);
-
-  auto hash_maps = build<T, HashType>(RadixContainer<T>{partition}, JoinHashBuildMode::AllPositions, 0, bloom_filter);
+  // Use a BloomFilter that cannot be used to skip any entries.
+  auto hash_maps =
+      build<T, HashType>(RadixContainer<T>{partition}, JoinHashBuildMode::AllPositions, 0, ALL_TRUE_BLOOM_FILTER);
 
   // With only one offset value passed, one hash map will be created
   EXPECT_EQ(hash_maps.size(), 1);
@@ -1,5 +1,6 @@
 #include "base_test.hpp"
 
+#include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/projection.hpp"
 #include "operators/table_wrapper.hpp"
@@ -119,4 +120,69 @@ TEST_F(OperatorsJoinSortMergeTest, SetSortedFlagOnJoinColumns) {
   }
 }
 
+TEST_F(OperatorsJoinSortMergeTest, PresortedInputs) {
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+
+  // Chunks are sorted individually, the last chunk of the left table is sorted in descending order
+  const auto left_table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3});
+  left_table->append({1});
+  left_table->append({3});
+  left_table->append({5});
+  left_table->append({2});
+  left_table->append({2});
+  left_table->append({6});
+  left_table->append({NULL_VALUE});
+  left_table->append({9});
+  left_table->append({4});
+
+  const auto right_table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3});
+  right_table->append({2});
+  right_table->append({3});
+  right_table->append({3});
+  right_table->append({1});
+  right_table->append({5});
+  right_table->append({7});
+
+  const auto set_sorted_by = [](Table& table, const std::vector<SortMode>& sort_modes) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto chunk = table.get_chunk(chunk_id);
+      if (chunk->is_mutable()) chunk->finalize();
+      chunk->set_individually_sorted_by(SortColumnDefinition{ColumnID{0}, sort_modes[chunk_id]});
+    }
+  };
+  set_sorted_by(*left_table, {SortMode::Ascending, SortMode::Ascending, SortMode::Descending});
+  set_sorted_by(*right_table, {SortMode::Ascending, SortMode::Ascending});
+
+  const auto left_input = std::make_shared<TableWrapper>(left_table);
+  const auto right_input = std::make_shared<TableWrapper>(right_table);
+  left_input->never_clear_output();
+  right_input->never_clear_output();
+  left_input->execute();
+  right_input->execute();
+
+  const auto configurations = std::vector<std::pair<JoinMode, PredicateCondition>>{
+      {JoinMode::Inner, PredicateCondition::Equals},        {JoinMode::Left, PredicateCondition::Equals},
+      {JoinMode::FullOuter, PredicateCondition::Equals},    {JoinMode::Inner, PredicateCondition::LessThan},
+      {JoinMode::Left, PredicateCondition::GreaterThanEquals}};
+
+  for (const auto& [join_mode, predicate_condition] : configurations) {
+    SCOPED_TRACE(std::string{magic_enum::enum_name(join_mode)} + " " +
+                 std::string{magic_enum::enum_name(predicate_condition)});
+    const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, predicate_condition};
+
+    const auto join_sort_merge = std::make_shared<JoinSortMerge>(left_input, right_input, join_mode, primary_predicate);
+    join_sort_merge->execute();
+    const auto join_nested_loop =
+        std::make_shared<JoinNestedLoop>(left_input, right_input, join_mode, primary_predicate);
+    join_nested_loop->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(join_sort_merge->get_output(), join_nested_loop->get_output());
+
+    // The sorted chunks are merged instead of being sorted
+    const auto& performance_data =
+        dynamic_cast<const OperatorPerformanceData<JoinSortMerge::OperatorSteps>&>(*join_sort_merge->performance_data);
+    EXPECT_EQ(performance_data.get_step_runtime(JoinSortMerge::OperatorSteps::Sorting).count(), 0);
+  }
+}
+
 }  // namespace opossum
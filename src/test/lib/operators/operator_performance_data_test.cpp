@@ -231,6 +231,11 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(inner_perf.hash_tables_distinct_value_count, 2ul);     // values 2,6
   EXPECT_EQ(inner_perf.hash_tables_position_count, 3ul);           // positions 1,2,3
   EXPECT_TRUE(inner_perf.left_input_is_build_side);
+  // 4 of 14 probe side values passed the build side's filter, 3 of 4 build side values the probe side's filter.
+  ASSERT_TRUE(inner_perf.build_side_bloom_filter_selectivity);
+  EXPECT_DOUBLE_EQ(*inner_perf.build_side_bloom_filter_selectivity, 4.0 / 14.0);
+  ASSERT_TRUE(inner_perf.probe_side_bloom_filter_selectivity);
+  EXPECT_DOUBLE_EQ(*inner_perf.probe_side_bloom_filter_selectivity, 3.0 / 4.0);
 
   // Semi join case: We check that no positions are stored (see explanation for "AllPositions" mode in hash map).
   // Further, we force the larger input to be the build side. As we first materialize the smaller side (i.e., the probe
@@ -247,6 +252,10 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(semi_perf.hash_tables_distinct_value_count, 2ul);
   EXPECT_FALSE(semi_perf.hash_tables_position_count);
   EXPECT_FALSE(semi_perf.left_input_is_build_side);
+  // The probe side is materialized first, so its filter is applied when materializing the build side.
+  EXPECT_FALSE(semi_perf.build_side_bloom_filter_selectivity);
+  ASSERT_TRUE(semi_perf.probe_side_bloom_filter_selectivity);
+  EXPECT_DOUBLE_EQ(*semi_perf.probe_side_bloom_filter_selectivity, 4.0 / 14.0);
 }
 
 // Check that steps of IndexJoin (indexed chunks/unindexed chunks) are executed as expected.
@@ -0,0 +1,179 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/runtime_join_filter.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class RuntimeJoinFilterTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Three chunks with the values 1-4, 5-8, and 9-12.
+    const auto probe_table =
+        std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data, ChunkOffset{4});
+    for (auto value = int32_t{1}; value <= 12; ++value) {
+      probe_table->append({value});
+    }
+    probe_table->last_chunk()->finalize();
+    generate_chunk_pruning_statistics(probe_table);
+
+    const auto build_table =
+        std::make_shared<Table>(TableColumnDefinitions{{"b", DataType::Int, true}}, TableType::Data, ChunkOffset{4});
+    build_table->append({6});
+    build_table->append({7});
+    build_table->append({NULL_VALUE});
+    build_table->append({7});
+
+    const auto null_table =
+        std::make_shared<Table>(TableColumnDefinitions{{"b", DataType::Int, true}}, TableType::Data, ChunkOffset{4});
+    null_table->append({NULL_VALUE});
+
+    _probe_table = probe_table;
+    _probe_wrapper = std::make_shared<TableWrapper>(probe_table);
+    _probe_wrapper->never_clear_output();
+    _probe_wrapper->execute();
+
+    _build_wrapper = std::make_shared<TableWrapper>(build_table);
+    _build_wrapper->never_clear_output();
+
+    _null_build_wrapper = std::make_shared<TableWrapper>(null_table);
+    _null_build_wrapper->never_clear_output();
+    _null_build_wrapper->execute();
+
+    _a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+  }
+
+  // Returns all offsets of the given chunk.
+  static RowIDPosList all_offsets(const ChunkID chunk_id, const ChunkOffset chunk_size) {
+    auto pos_list = RowIDPosList{};
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      pos_list.emplace_back(chunk_id, chunk_offset);
+    }
+    return pos_list;
+  }
+
+  std::shared_ptr<Table> _probe_table;
+  std::shared_ptr<TableWrapper> _probe_wrapper, _build_wrapper, _null_build_wrapper;
+  std::shared_ptr<AbstractExpression> _a;
+};
+
+TEST_F(RuntimeJoinFilterTest, BuildRequiresExecutedInput) {
+  auto runtime_join_filter = RuntimeJoinFilter{_build_wrapper, ColumnID{0}, ColumnID{0}};
+  EXPECT_FALSE(runtime_join_filter.build());
+
+  _build_wrapper->execute();
+  EXPECT_TRUE(runtime_join_filter.build());
+}
+
+TEST_F(RuntimeJoinFilterTest, CanPrune) {
+  _build_wrapper->execute();
+  auto runtime_join_filter = RuntimeJoinFilter{_build_wrapper, ColumnID{0}, ColumnID{0}};
+  ASSERT_TRUE(runtime_join_filter.build());
+
+  EXPECT_TRUE(runtime_join_filter.can_prune(*_probe_table->get_chunk(ChunkID{0})));
+  EXPECT_FALSE(runtime_join_filter.can_prune(*_probe_table->get_chunk(ChunkID{1})));
+  EXPECT_TRUE(runtime_join_filter.can_prune(*_probe_table->get_chunk(ChunkID{2})));
+
+  // Reference chunks use the statistics of the referenced chunk.
+  const auto table_scan = std::make_shared<TableScan>(_probe_wrapper, greater_than_(_a, 2));
+  table_scan->execute();
+  const auto& scanned_table = table_scan->get_output();
+  ASSERT_EQ(scanned_table->chunk_count(), 3);
+  EXPECT_TRUE(runtime_join_filter.can_prune(*scanned_table->get_chunk(ChunkID{0})));
+  EXPECT_FALSE(runtime_join_filter.can_prune(*scanned_table->get_chunk(ChunkID{1})));
+  EXPECT_TRUE(runtime_join_filter.can_prune(*scanned_table->get_chunk(ChunkID{2})));
+}
+
+TEST_F(RuntimeJoinFilterTest, Filter) {
+  _build_wrapper->execute();
+  auto runtime_join_filter = RuntimeJoinFilter{_build_wrapper, ColumnID{0}, ColumnID{0}};
+  ASSERT_TRUE(runtime_join_filter.build());
+
+  auto matches = all_offsets(ChunkID{1}, ChunkOffset{4});
+  runtime_join_filter.filter(*_probe_table->get_chunk(ChunkID{1}), matches);
+  EXPECT_EQ(matches, RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{2}}}));
+
+  matches = all_offsets(ChunkID{0}, ChunkOffset{4});
+  runtime_join_filter.filter(*_probe_table->get_chunk(ChunkID{0}), matches);
+  EXPECT_TRUE(matches.empty());
+}
+
+TEST_F(RuntimeJoinFilterTest, BuildSideWithoutValues) {
+  auto runtime_join_filter = RuntimeJoinFilter{_null_build_wrapper, ColumnID{0}, ColumnID{0}};
+  ASSERT_TRUE(runtime_join_filter.build());
+
+  EXPECT_TRUE(runtime_join_filter.can_prune(*_probe_table->get_chunk(ChunkID{1})));
+
+  auto matches = all_offsets(ChunkID{1}, ChunkOffset{4});
+  runtime_join_filter.filter(*_probe_table->get_chunk(ChunkID{1}), matches);
+  EXPECT_TRUE(matches.empty());
+}
+
+TEST_F(RuntimeJoinFilterTest, TableScanWithFilter) {
+  const auto table_scan = std::make_shared<TableScan>(_probe_wrapper, greater_than_(_a, 1));
+  table_scan->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(_build_wrapper, ColumnID{0}, ColumnID{0}));
+  const auto join = std::make_shared<JoinHash>(
+      _build_wrapper, table_scan, JoinMode::Inner,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+
+  _build_wrapper->execute();
+  table_scan->execute();
+
+  const auto expected_scan_result =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  expected_scan_result->append({6});
+  expected_scan_result->append({7});
+  EXPECT_TABLE_EQ_UNORDERED(table_scan->get_output(), expected_scan_result);
+
+  const auto& performance_data = dynamic_cast<TableScan::PerformanceData&>(*table_scan->performance_data);
+  EXPECT_EQ(performance_data.num_chunks_pruned_by_runtime_join_filter, 2);
+  EXPECT_EQ(performance_data.num_rows_filtered_by_runtime_join_filter, 2);
+
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 3);
+}
+
+TEST_F(RuntimeJoinFilterTest, TableScanWithMultipleConsumers) {
+  // If the scan's output is used by other operators as well, the filter must not be applied.
+  const auto table_scan = std::make_shared<TableScan>(_probe_wrapper, greater_than_(_a, 1));
+  table_scan->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(_build_wrapper, ColumnID{0}, ColumnID{0}));
+  const auto join = std::make_shared<JoinHash>(
+      _build_wrapper, table_scan, JoinMode::Inner,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+  const auto other_scan = std::make_shared<TableScan>(table_scan, greater_than_(_a, 10));
+
+  _build_wrapper->execute();
+  table_scan->execute();
+
+  EXPECT_EQ(table_scan->get_output()->row_count(), 11);
+  const auto& performance_data = dynamic_cast<TableScan::PerformanceData&>(*table_scan->performance_data);
+  EXPECT_FALSE(performance_data.num_chunks_pruned_by_runtime_join_filter);
+  EXPECT_FALSE(performance_data.num_rows_filtered_by_runtime_join_filter);
+}
+
+TEST_F(RuntimeJoinFilterTest, DeepCopy) {
+  const auto table_scan = std::make_shared<TableScan>(_probe_wrapper, greater_than_(_a, 1));
+  table_scan->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(_build_wrapper, ColumnID{0}, ColumnID{0}));
+  const auto join = std::make_shared<JoinHash>(
+      _build_wrapper, table_scan, JoinMode::Inner,
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals});
+
+  const auto copied_join = join->deep_copy();
+  const auto copied_table_scan = std::dynamic_pointer_cast<const TableScan>(copied_join->right_input());
+  ASSERT_TRUE(copied_table_scan);
+  ASSERT_TRUE(copied_table_scan->runtime_join_filter());
+  EXPECT_EQ(copied_table_scan->runtime_join_filter()->build_input(), copied_join->left_input());
+  EXPECT_NE(copied_table_scan->runtime_join_filter()->build_input(), _build_wrapper);
+}
+
+}  // namespace opossum
@@ -1,8 +1,12 @@
+#include <random>
+
 #include "base_test.hpp"
 
 #include "operators/join_hash.hpp"
 #include "operators/sort.hpp"
+#include "operators/sort/normalized_sort_keys.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 
 namespace opossum {
 
@@ -228,4 +232,139 @@ TEST_F(SortTest, InputReferencesDifferentColumns) {
   EXPECT_EQ(sort.get_output()->type(), TableType::Data);
 }
 
+namespace {
+
+// Generates a table with random values that cover the encoding of negative numbers, -0.0, NULLs, and strings that are
+// prefixes of each other. The long strings in column e cannot be encoded into normalized keys.
+std::shared_ptr<Table> create_random_sort_input(const size_t row_count, const ChunkOffset chunk_size) {
+  const auto column_definitions = TableColumnDefinitions{
+      {"a", DataType::Int, true},   {"b", DataType::Float, false}, {"c", DataType::String, true},
+      {"d", DataType::Long, false}, {"e", DataType::String, false}};
+
+  auto random_engine = std::mt19937{17};
+  const auto random_int = [&](const int min, const int max) {
+    return std::uniform_int_distribution<int>{min, max}(random_engine);
+  };
+
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, chunk_size);
+  for (auto row = size_t{0}; row < row_count; ++row) {
+    const auto a = random_int(0, 9) == 0 ? NULL_VALUE : AllTypeVariant{random_int(-5, 5)};
+    const auto b = random_int(0, 9) == 0 ? -0.0f : static_cast<float>(random_int(-4, 4)) / 2.0f;
+    const auto c = random_int(0, 9) == 0 ? NULL_VALUE : AllTypeVariant{pmr_string(random_int(0, 3), 'x')};
+    const auto d = int64_t{random_int(-3, 3)} * int64_t{10'000'000'000};
+    const auto e = pmr_string(static_cast<size_t>(random_int(0, 1)) * NormalizedSortKeys::MAX_KEY_WIDTH, 'y') +
+                   pmr_string(random_int(0, 2), 'z');
+    table->append({a, b, c, d, e});
+  }
+  table->last_chunk()->finalize();
+
+  return table;
+}
+
+// Sorts the table by various combinations of columns and compares the result to a stable sort of the materialized
+// rows.
+void expect_sort_matches_reference_order(const std::shared_ptr<Table>& table) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto asc = [](const uint16_t column_id) {
+    return SortColumnDefinition{ColumnID{column_id}, SortMode::Ascending};
+  };
+  const auto desc = [](const uint16_t column_id) {
+    return SortColumnDefinition{ColumnID{column_id}, SortMode::Descending};
+  };
+  const auto sort_definitions_variations = std::vector<std::vector<SortColumnDefinition>>{
+      {asc(0), desc(1)}, {desc(2), desc(0), asc(3)}, {desc(3), asc(2), asc(1)}, {asc(4), desc(0)}};
+
+  for (const auto& sort_definitions : sort_definitions_variations) {
+    auto expected_rows = table->get_rows();
+    std::stable_sort(expected_rows.begin(), expected_rows.end(), [&](const auto& lhs, const auto& rhs) {
+      for (const auto& sort_definition : sort_definitions) {
+        const auto& lhs_value = lhs[sort_definition.column];
+        const auto& rhs_value = rhs[sort_definition.column];
+        if (variant_is_null(lhs_value) || variant_is_null(rhs_value)) {
+          if (variant_is_null(lhs_value) == variant_is_null(rhs_value)) continue;
+          // NULLs come first, independent of the sort mode.
+          return variant_is_null(lhs_value);
+        }
+        if (lhs_value == rhs_value) continue;
+        return sort_definition.sort_mode == SortMode::Ascending ? lhs_value < rhs_value : rhs_value < lhs_value;
+      }
+      return false;
+    });
+
+    const auto expected_table = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+    for (const auto& row : expected_rows) {
+      expected_table->append(row);
+    }
+
+    auto sort = Sort{table_wrapper, sort_definitions};
+    sort.execute();
+    EXPECT_TABLE_EQ_ORDERED(sort.get_output(), expected_table);
+  }
+}
+
+}  // namespace
+
+TEST_F(SortTest, MultipleColumnsMatchReferenceOrder) {
+  expect_sort_matches_reference_order(create_random_sort_input(2'000, ChunkOffset{600}));
+}
+
+TEST_F(SortTest, ParallelSortMatchesReferenceOrder) {
+  // With multiple workers, large inputs are sorted in multiple runs that are merged afterwards.
+  Hyrise::get().topology.use_fake_numa_topology(4, 2);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  expect_sort_matches_reference_order(create_random_sort_input(70'000, ChunkOffset{10'000}));
+}
+
+TEST_F(SortTest, NormalizedSortKeysWidth) {
+  // Column a is an int, column b a nullable int, and column c contains strings of up to ten characters.
+  const auto key_width = [&](const std::vector<SortColumnDefinition>& sort_definitions) {
+    const auto normalized_sort_keys = NormalizedSortKeys::create(input_table, sort_definitions);
+    return normalized_sort_keys ? std::optional<size_t>{normalized_sort_keys->key_width()} : std::nullopt;
+  };
+
+  EXPECT_EQ(key_width({SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}), 4);
+  EXPECT_EQ(key_width({SortColumnDefinition{ColumnID{1}, SortMode::Descending}}), 5);
+  EXPECT_EQ(key_width({SortColumnDefinition{ColumnID{2}, SortMode::Ascending},
+                       SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}),
+            (10 + 1) + 4);
+
+  const auto long_string_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::String, false}}, TableType::Data);
+  long_string_table->append({pmr_string(NormalizedSortKeys::MAX_KEY_WIDTH, 'a')});
+  EXPECT_FALSE(
+      NormalizedSortKeys::create(long_string_table, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}));
+}
+
+TEST_F(SortTest, NormalizedSortKeysSkipPhysicallyDeletedChunks) {
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::String, false}}, TableType::Data,
+                                             ChunkOffset{2}, UseMvcc::Yes);
+  for (const auto* value : {"d", "c", "much longer", "value", "b", "a"}) {
+    table->append({pmr_string{value}});
+  }
+
+  const auto chunk = table->get_chunk(ChunkID{1});
+  chunk->increase_invalid_row_count(chunk->size());
+  table->remove_chunk(ChunkID{1});
+
+  // The removed chunk neither determines the key width (one character plus the length byte) nor occupies entries.
+  auto normalized_sort_keys =
+      NormalizedSortKeys::create(table, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}});
+  ASSERT_TRUE(normalized_sort_keys);
+  EXPECT_EQ(normalized_sort_keys->key_width(), 1 + 1);
+
+  auto entries = normalized_sort_keys->encode();
+  ASSERT_EQ(entries.size(), 4);
+  std::sort(entries.begin(), entries.end(),
+            [&](const auto& lhs, const auto& rhs) { return normalized_sort_keys->less(lhs, rhs); });
+
+  const auto expected_row_ids = std::vector<RowID>{RowID{ChunkID{2}, ChunkOffset{1}}, RowID{ChunkID{2}, ChunkOffset{0}},
+                                                   RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{0}, ChunkOffset{0}}};
+  for (auto entry_index = size_t{0}; entry_index < entries.size(); ++entry_index) {
+    EXPECT_EQ(entries[entry_index].row_id, expected_row_ids[entry_index]);
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_scan/compressed_vector_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+
+#include "constant_mappings.hpp"
+
+namespace opossum {
+
+class OperatorsTableScanCompressedVectorScanTest : public BaseTestWithParam<VectorCompressionType> {
+ protected:
+  void SetUp() override {
+    // Small values that fit into one byte, with a few blocks of zeros, which SIMD-BP128 stores with a bit width of 0
+    _small_values = pmr_vector<uint32_t>(5'000);
+    for (auto index = size_t{0}; index < _small_values.size(); ++index) {
+      _small_values[index] = (index >= 1'024 && index < 1'536) ? 0 : index % 7;
+    }
+
+    // Values that need more than 16 bits. The first blocks only contain smaller values.
+    _large_values = pmr_vector<uint32_t>(4'500);
+    for (auto index = size_t{0}; index < _large_values.size(); ++index) {
+      _large_values[index] = index < 512 ? index : (index * 7'919) % 100'003;
+    }
+  }
+
+  std::vector<RowID> _scan(const pmr_vector<uint32_t>& values, const CompressedVectorScan::ValueRange range,
+                           const std::optional<pmr_vector<bool>>& null_values = std::nullopt) const {
+    const auto compressed_vector = compress_vector(values, GetParam(), {});
+    auto matches = RowIDPosList{};
+    CompressedVectorScan::scan(
+        *compressed_vector, [&](const size_t) { return range; }, ChunkID{1}, null_values, matches);
+    return std::vector<RowID>(matches.begin(), matches.end());
+  }
+
+  static std::vector<RowID> _expected(const pmr_vector<uint32_t>& values, const CompressedVectorScan::ValueRange range,
+                                      const std::optional<pmr_vector<bool>>& null_values = std::nullopt) {
+    auto expected = std::vector<RowID>{};
+    for (auto index = size_t{0}; index < values.size(); ++index) {
+      if (values[index] >= range.lower && values[index] <= range.upper && !(null_values && (*null_values)[index])) {
+        expected.emplace_back(ChunkID{1}, static_cast<ChunkOffset>(index));
+      }
+    }
+    return expected;
+  }
+
+  // Scans the column "a" of the given table with all encodings that use compressed vectors and compares the result
+  // with the one of the unencoded table
+  void _test_encoded_scans(const std::shared_ptr<Table>& table,
+                           const std::function<std::shared_ptr<TableScan>(const std::shared_ptr<AbstractOperator>&)>&
+                               create_scan) const {
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    const auto expected_scan = create_scan(table_wrapper);
+    expected_scan->execute();
+
+    for (const auto encoding_type : {EncodingType::Dictionary, EncodingType::FrameOfReference}) {
+      const auto encoded_table = std::make_shared<Table>(table->column_definitions(), TableType::Data,
+                                                         table->target_chunk_size());
+      encoded_table->append_chunk(Segments{table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})});
+      encoded_table->last_chunk()->finalize();
+      ChunkEncoder::encode_all_chunks(encoded_table, SegmentEncodingSpec{encoding_type, GetParam()});
+
+      const auto encoded_table_wrapper = std::make_shared<TableWrapper>(encoded_table);
+      encoded_table_wrapper->execute();
+      const auto scan = create_scan(encoded_table_wrapper);
+      scan->execute();
+
+      EXPECT_TABLE_EQ_ORDERED(scan->get_output(), expected_scan->get_output());
+    }
+  }
+
+  pmr_vector<uint32_t> _small_values;
+  pmr_vector<uint32_t> _large_values;
+};
+
+auto table_scan_compressed_vector_scan_test_formatter =
+    [](const ::testing::TestParamInfo<VectorCompressionType> info) {
+      auto string = vector_compression_type_to_string.left.at(info.param);
+      string.erase(std::remove_if(string.begin(), string.end(), [](char c) { return !std::isalnum(c); }),
+                   string.end());
+      return string;
+    };
+
+INSTANTIATE_TEST_SUITE_P(VectorCompressionTypes, OperatorsTableScanCompressedVectorScanTest,
+                         ::testing::Values(VectorCompressionType::SimdBp128,
+                                           VectorCompressionType::FixedSizeByteAligned),
+                         table_scan_compressed_vector_scan_test_formatter);
+
+TEST_P(OperatorsTableScanCompressedVectorScanTest, ScanRanges) {
+  const auto max = std::numeric_limits<uint32_t>::max();
+  const auto ranges = std::vector<CompressedVectorScan::ValueRange>{
+      {3, 3}, {0, 0}, {0, 5}, {1, 2}, {6, 6}, {0, max}, {7, max}, {300, 70'000}, {100'002, max}, {500, 500}};
+
+  for (const auto& range : ranges) {
+    EXPECT_EQ(_scan(_small_values, range), _expected(_small_values, range));
+    EXPECT_EQ(_scan(_large_values, range), _expected(_large_values, range));
+  }
+
+  EXPECT_TRUE(_scan(_small_values, CompressedVectorScan::EMPTY_RANGE).empty());
+  EXPECT_TRUE(_scan(_large_values, CompressedVectorScan::EMPTY_RANGE).empty());
+}
+
+TEST_P(OperatorsTableScanCompressedVectorScanTest, ScanRangesPerBlock) {
+  // Only the values of every other block can match
+  const auto compressed_vector = compress_vector(_large_values, GetParam(), {});
+  const auto range = CompressedVectorScan::ValueRange{100, 50'000};
+  const auto range_for_block = [&](const size_t first_index) {
+    return (first_index / CompressedVectorScan::BLOCK_SIZE) % 2 == 0 ? range : CompressedVectorScan::EMPTY_RANGE;
+  };
+
+  auto matches = RowIDPosList{};
+  CompressedVectorScan::scan(*compressed_vector, range_for_block, ChunkID{1}, std::nullopt, matches);
+
+  auto expected = std::vector<RowID>{};
+  for (const auto& row_id : _expected(_large_values, range)) {
+    if ((row_id.chunk_offset / CompressedVectorScan::BLOCK_SIZE) % 2 == 0) expected.emplace_back(row_id);
+  }
+  EXPECT_EQ(std::vector<RowID>(matches.begin(), matches.end()), expected);
+}
+
+TEST_P(OperatorsTableScanCompressedVectorScanTest, NullValues) {
+  auto null_values = pmr_vector<bool>(_small_values.size());
+  for (auto index = size_t{0}; index < null_values.size(); index += 3) {
+    null_values[index] = true;
+  }
+
+  const auto all_values = CompressedVectorScan::ValueRange{0, std::numeric_limits<uint32_t>::max()};
+  EXPECT_EQ(_scan(_small_values, all_values, null_values), _expected(_small_values, all_values, null_values));
+
+  const auto zeros = CompressedVectorScan::ValueRange{0, 0};
+  EXPECT_EQ(_scan(_small_values, zeros, null_values), _expected(_small_values, zeros, null_values));
+}
+
+TEST_P(OperatorsTableScanCompressedVectorScanTest, FrameOfReferenceRange) {
+  const auto max = std::numeric_limits<uint32_t>::max();
+
+  const auto range_a = CompressedVectorScan::frame_of_reference_range(int64_t{10}, int64_t{20}, int32_t{5});
+  EXPECT_EQ(range_a.lower, 5u);
+  EXPECT_EQ(range_a.upper, 15u);
+
+  const auto range_b = CompressedVectorScan::frame_of_reference_range(int64_t{-10}, int64_t{20}, int32_t{5});
+  EXPECT_EQ(range_b.lower, 0u);
+  EXPECT_EQ(range_b.upper, 15u);
+
+  EXPECT_TRUE(CompressedVectorScan::frame_of_reference_range(int64_t{-10}, int64_t{4}, int32_t{5}).empty());
+
+  const auto range_c = CompressedVectorScan::frame_of_reference_range(
+      int64_t{std::numeric_limits<int32_t>::min()}, int64_t{std::numeric_limits<int32_t>::max()},
+      std::numeric_limits<int32_t>::min());
+  EXPECT_EQ(range_c.lower, 0u);
+  EXPECT_EQ(range_c.upper, max);
+}
+
+TEST_P(OperatorsTableScanCompressedVectorScanTest, EncodedSegmentScans) {
+  // Three frames of the FrameOfReferenceSegment with different minima, including negative values and NULLs
+  const auto row_count = 5'000;
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}}, TableType::Data,
+                                             ChunkOffset{row_count});
+  for (auto row = 0; row < row_count; ++row) {
+    if (row % 11 == 0) {
+      table->append({NullValue{}});
+    } else {
+      table->append({(row / 2'048) * 1'000 - 1'500 + (row * 31) % 701});
+    }
+  }
+
+  for (const auto predicate_condition :
+       {PredicateCondition::Equals, PredicateCondition::NotEquals, PredicateCondition::LessThan,
+        PredicateCondition::LessThanEquals, PredicateCondition::GreaterThan, PredicateCondition::GreaterThanEquals}) {
+    for (const auto value : {-2'000, -1'500, -1'000, 0, 57, 200, 1'200, 5'000}) {
+      _test_encoded_scans(table, [&](const auto& input) {
+        return create_table_scan(input, ColumnID{0}, predicate_condition, value);
+      });
+    }
+  }
+
+  for (const auto predicate_condition :
+       {PredicateCondition::BetweenInclusive, PredicateCondition::BetweenLowerExclusive,
+        PredicateCondition::BetweenUpperExclusive, PredicateCondition::BetweenExclusive}) {
+    for (const auto& values : std::vector<std::pair<int32_t, int32_t>>{
+             {-2'000, 5'000}, {-1'500, -800}, {-700, 900}, {57, 57}, {1'000, 1'100}, {3'000, 4'000}}) {
+      _test_encoded_scans(table, [&](const auto& input) {
+        return create_between_table_scan(input, ColumnID{0}, values.first, values.second, predicate_condition);
+      });
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,156 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ public:
+  static void SetUpTestCase() {
+    input_table = load_table("resources/test_data/tbl/sort/input.tbl", 20);
+    input_table_wrapper = std::make_shared<TableWrapper>(input_table);
+    input_table_wrapper->never_clear_output();
+    input_table_wrapper->execute();
+  }
+
+ protected:
+  // TopK has to produce exactly the same rows in the same order as a Sort followed by a Limit.
+  static void expect_same_as_sort_and_limit(const std::shared_ptr<AbstractOperator>& input,
+                                            const std::vector<SortColumnDefinition>& sort_definitions,
+                                            const int64_t row_count) {
+    const auto top_k = std::make_shared<TopK>(input, sort_definitions, value_(row_count));
+    top_k->execute();
+
+    const auto sort = std::make_shared<Sort>(input, sort_definitions);
+    const auto limit = std::make_shared<Limit>(sort, value_(row_count));
+    sort->execute();
+    limit->execute();
+
+    EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+  }
+
+  static inline std::shared_ptr<Table> input_table;
+  static inline std::shared_ptr<AbstractOperator> input_table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, SingleColumn) {
+  for (const auto row_count : {1, 3, 20, 21, 50, 100}) {
+    expect_same_as_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}},
+                                  row_count);
+    expect_same_as_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{0}, SortMode::Descending}},
+                                  row_count);
+  }
+}
+
+TEST_F(OperatorsTopKTest, NullsAndStrings) {
+  for (const auto row_count : {1, 5, 30}) {
+    expect_same_as_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{1}, SortMode::Ascending}},
+                                  row_count);
+    expect_same_as_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{1}, SortMode::Descending}},
+                                  row_count);
+    expect_same_as_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{2}, SortMode::Descending}},
+                                  row_count);
+  }
+}
+
+TEST_F(OperatorsTopKTest, MultipleColumns) {
+  for (const auto row_count : {1, 7, 25, 50}) {
+    expect_same_as_sort_and_limit(input_table_wrapper,
+                                  {SortColumnDefinition{ColumnID{0}, SortMode::Ascending},
+                                   SortColumnDefinition{ColumnID{1}, SortMode::Descending}},
+                                  row_count);
+    expect_same_as_sort_and_limit(input_table_wrapper,
+                                  {SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                                   SortColumnDefinition{ColumnID{2}, SortMode::Ascending}},
+                                  row_count);
+  }
+}
+
+TEST_F(OperatorsTopKTest, ReferenceInput) {
+  const auto table_scan = std::make_shared<TableScan>(
+      input_table_wrapper, greater_than_(pqp_column_(ColumnID{0}, DataType::Int, false, "a"), 10));
+  table_scan->never_clear_output();
+  table_scan->execute();
+
+  expect_same_as_sort_and_limit(table_scan, {SortColumnDefinition{ColumnID{1}, SortMode::Ascending}}, 10);
+
+  const auto top_k = std::make_shared<TopK>(
+      table_scan, std::vector{SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}, value_(5));
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->type(), TableType::References);
+}
+
+TEST_F(OperatorsTopKTest, OutputIsSorted) {
+  const auto sort_definition = SortColumnDefinition{ColumnID{0}, SortMode::Descending};
+  const auto top_k = std::make_shared<TopK>(input_table_wrapper, std::vector{sort_definition}, value_(30), 8);
+  top_k->execute();
+
+  const auto& output = top_k->get_output();
+  EXPECT_EQ(output->row_count(), 30);
+  EXPECT_EQ(output->chunk_count(), 4);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& sorted_by = output->get_chunk(chunk_id)->individually_sorted_by();
+    ASSERT_EQ(sorted_by.size(), 1);
+    EXPECT_EQ(sorted_by.front(), sort_definition);
+  }
+}
+
+TEST_F(OperatorsTopKTest, ZeroRows) {
+  const auto top_k = std::make_shared<TopK>(
+      input_table_wrapper, std::vector{SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}, value_(int64_t{0}));
+  top_k->execute();
+
+  EXPECT_EQ(top_k->get_output()->row_count(), 0);
+  EXPECT_EQ(top_k->get_output()->column_definitions(), input_table->column_definitions());
+}
+
+TEST_F(OperatorsTopKTest, EmptyInput) {
+  const auto empty_table_wrapper =
+      std::make_shared<TableWrapper>(Table::create_dummy_table(input_table->column_definitions()));
+  empty_table_wrapper->execute();
+
+  const auto top_k = std::make_shared<TopK>(
+      empty_table_wrapper, std::vector{SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}, value_(5));
+  top_k->execute();
+
+  EXPECT_EQ(top_k->get_output()->row_count(), 0);
+}
+
+TEST_F(OperatorsTopKTest, Parameters) {
+  const auto top_k = std::make_shared<TopK>(
+      input_table_wrapper, std::vector{SortColumnDefinition{ColumnID{0}, SortMode::Ascending}},
+      correlated_parameter_(ParameterID{0}, int64_t{1}));
+  top_k->set_parameters({{ParameterID{0}, AllTypeVariant{int64_t{4}}}});
+  top_k->execute();
+
+  EXPECT_EQ(top_k->get_output()->row_count(), 4);
+}
+
+TEST_F(OperatorsTopKTest, DeepCopy) {
+  const auto top_k = std::make_shared<TopK>(
+      input_table_wrapper, std::vector{SortColumnDefinition{ColumnID{2}, SortMode::Descending}}, value_(3));
+  const auto copy = std::dynamic_pointer_cast<TopK>(top_k->deep_copy());
+  ASSERT_TRUE(copy);
+
+  EXPECT_EQ(copy->sort_definitions(), top_k->sort_definitions());
+  EXPECT_EQ(*copy->row_count_expression(), *top_k->row_count_expression());
+
+  top_k->execute();
+  // The table wrapper needs to be executed manually.
+  copy->mutable_left_input()->execute();
+  copy->execute();
+  EXPECT_TABLE_EQ_ORDERED(copy->get_output(), top_k->get_output());
+}
+
+}  // namespace opossum
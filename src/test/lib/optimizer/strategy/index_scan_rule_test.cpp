@@ -161,6 +161,50 @@ TEST_F(IndexScanRuleTest, IndexScanWithIndexPrunedColumn) {
   EXPECT_EQ(predicate_node_0->scan_type, ScanType::IndexScan);
 }
 
+TEST_F(IndexScanRuleTest, TableIndexScanForSelectiveEquals) {
+  table->create_table_index(ColumnID{2});
+  generate_mock_statistics(1'000'000);
+  table->table_statistics()->column_statistics.at(2)->set_statistics_object(
+      GenericHistogram<int32_t>::with_single_bin(0, 20'000, 1'000'000, 1'000));
+
+  // Table indexes only support equality predicates
+  auto predicate_node_0 = PredicateNode::make(greater_than_(c, 19'900));
+  predicate_node_0->set_left_input(stored_table_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_0);
+  EXPECT_EQ(predicate_node_0->scan_type, ScanType::TableScan);
+
+  // Not selective enough, as column a only has ten distinct values
+  table->create_table_index(ColumnID{0});
+  auto predicate_node_1 = PredicateNode::make(equals_(a, 10));
+  predicate_node_1->set_left_input(stored_table_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_1);
+  EXPECT_EQ(predicate_node_1->scan_type, ScanType::TableScan);
+
+  // Column b is not indexed
+  auto predicate_node_2 = PredicateNode::make(equals_(b, 10));
+  predicate_node_2->set_left_input(stored_table_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_2);
+  EXPECT_EQ(predicate_node_2->scan_type, ScanType::TableScan);
+
+  auto predicate_node_3 = PredicateNode::make(equals_(10, c));
+  predicate_node_3->set_left_input(stored_table_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_3);
+  EXPECT_EQ(predicate_node_3->scan_type, ScanType::TableIndexScan);
+}
+
+TEST_F(IndexScanRuleTest, TableIndexScanPreferredOverChunkIndex) {
+  table->create_index<GroupKeyIndex>({ColumnID{2}});
+  table->create_table_index(ColumnID{2});
+  generate_mock_statistics(1'000'000);
+  table->table_statistics()->column_statistics.at(2)->set_statistics_object(
+      GenericHistogram<int32_t>::with_single_bin(0, 20'000, 1'000'000, 1'000));
+
+  auto predicate_node_0 = PredicateNode::make(equals_(c, 19'900));
+  predicate_node_0->set_left_input(stored_table_node);
+  StrategyBaseTest::apply_rule(rule, predicate_node_0);
+  EXPECT_EQ(predicate_node_0->scan_type, ScanType::TableIndexScan);
+}
+
 TEST_F(IndexScanRuleTest, IndexScanOnlyOnOutputOfStoredTableNode) {
   table->create_index<GroupKeyIndex>({ColumnID{2}});
 
@@ -10,6 +10,7 @@
 #include "operators/abstract_join_operator.hpp"
 #include "operators/get_table.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/runtime_join_filter.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/union_positions.hpp"
 #include "scheduler/operator_task.hpp"
@@ -113,4 +114,52 @@ TEST_F(OperatorTaskTest, MakeDiamondShape) {
     // We don't have to wait here, because we are running the task tests without a scheduler
   }
 }
+
+TEST_F(OperatorTaskTest, RuntimeJoinFilterDependency) {
+  auto gt_a = std::make_shared<GetTable>("table_a");
+  auto gt_b = std::make_shared<GetTable>("table_b");
+  auto a = PQPColumnExpression::from_table(*_test_table_b, "a");
+  auto scan_b = std::make_shared<TableScan>(gt_b, greater_than_(a, 0));
+  scan_b->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(gt_a, ColumnID{0}, ColumnID{0}));
+  auto join = std::make_shared<JoinHash>(
+      gt_a, scan_b, JoinMode::Inner,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+  auto tasks = OperatorTask::make_tasks_from_operator(join);
+
+  ASSERT_EQ(tasks.size(), 4u);
+  EXPECT_EQ(static_cast<const OperatorTask&>(*tasks[0]).get_operator(), gt_a);
+  EXPECT_EQ(static_cast<const OperatorTask&>(*tasks[2]).get_operator(), scan_b);
+
+  // The scan waits for the filter's build input.
+  std::vector<std::shared_ptr<AbstractTask>> expected_successors_0({tasks[3], tasks[2]});
+  EXPECT_EQ(tasks[0]->successors(), expected_successors_0);
+
+  for (auto& task : tasks) {
+    task->schedule();
+    // We don't have to wait here, because we are running the task tests without a scheduler
+  }
+
+  auto expected_result = load_table("resources/test_data/tbl/join_operators/int_inner_join.tbl", 2);
+  EXPECT_TABLE_EQ_UNORDERED(expected_result,
+                            static_cast<const OperatorTask&>(*tasks.back()).get_operator()->get_output());
+}
+
+TEST_F(OperatorTaskTest, RuntimeJoinFilterWithoutCycle) {
+  // The filter's build input depends on the scan itself. Waiting for it would deadlock, so no dependency is added.
+  auto gt_a = std::make_shared<GetTable>("table_a");
+  auto a = PQPColumnExpression::from_table(*_test_table_a, "a");
+  auto scan_a = std::make_shared<TableScan>(gt_a, greater_than_(a, 0));
+  auto scan_b = std::make_shared<TableScan>(scan_a, greater_than_(a, 1));
+  scan_a->set_runtime_join_filter(std::make_shared<RuntimeJoinFilter>(scan_b, ColumnID{0}, ColumnID{0}));
+
+  auto tasks = OperatorTask::make_tasks_from_operator(scan_b);
+
+  ASSERT_EQ(tasks.size(), 3u);
+  std::vector<std::shared_ptr<AbstractTask>> expected_successors_2{};
+  EXPECT_EQ(tasks[2]->successors(), expected_successors_2);
+
+  // Break the reference cycle between scan_a and scan_b.
+  scan_a->set_runtime_join_filter(nullptr);
+}
 }  // namespace opossum
@@ -13,6 +13,7 @@
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "scheduler/task_queue.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
 
@@ -271,6 +272,70 @@ TEST_F(SchedulerTest, VerifyTaskQueueSetup) {
   Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, NestedJobsAreStolenAcrossNodes) {
+  // Jobs spawned by a job end up in the deque of the spawning worker and have to be stolen by the other workers,
+  // including those of the remote nodes. Idle workers are parked and must be woken up for this.
+  Hyrise::get().topology.use_fake_numa_topology(8, 2);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  std::atomic_uint counter{0};
+
+  auto outer_jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto outer_job_id = 0; outer_job_id < 4; ++outer_job_id) {
+    outer_jobs.emplace_back(std::make_shared<JobTask>([&counter]() {
+      auto inner_jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      for (auto inner_job_id = 0; inner_job_id < 100; ++inner_job_id) {
+        inner_jobs.emplace_back(std::make_shared<JobTask>([&counter]() { ++counter; }));
+      }
+      Hyrise::get().scheduler()->schedule_and_wait_for_tasks(inner_jobs);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(outer_jobs);
+
+  EXPECT_EQ(counter, 400);
+
+  Hyrise::get().scheduler()->finish();
+}
+
+TEST_F(SchedulerTest, TaskQueueCountsStealableTasks) {
+  // Workers of remote nodes only consider a TaskQueue when deciding whether to park if it holds stealable tasks
+  auto queue = TaskQueue{NodeID{0}};
+  const auto non_stealable_task = std::make_shared<JobTask>([]() {}, SchedulePriority::Default, false);
+  const auto stealable_task = std::make_shared<JobTask>([]() {});
+
+  queue.push(non_stealable_task, static_cast<uint32_t>(SchedulePriority::Default));
+  EXPECT_FALSE(queue.empty());
+  EXPECT_FALSE(queue.has_stealable_tasks());
+  EXPECT_EQ(queue.steal(), nullptr);
+
+  queue.push(stealable_task, static_cast<uint32_t>(SchedulePriority::High));
+  EXPECT_TRUE(queue.has_stealable_tasks());
+  EXPECT_EQ(queue.steal(), stealable_task);
+  EXPECT_FALSE(queue.has_stealable_tasks());
+
+  EXPECT_EQ(queue.pull(), non_stealable_task);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(SchedulerTest, TaskQueueStealsFromTheBackWithoutReordering) {
+  auto queue = TaskQueue{NodeID{0}};
+  const auto first_task = std::make_shared<JobTask>([]() {});
+  const auto non_stealable_task = std::make_shared<JobTask>([]() {}, SchedulePriority::Default, false);
+  const auto second_task = std::make_shared<JobTask>([]() {});
+  const auto last_task = std::make_shared<JobTask>([]() {}, SchedulePriority::Default, false);
+
+  for (const auto& task : {first_task, non_stealable_task, second_task, last_task}) {
+    queue.push(task, static_cast<uint32_t>(SchedulePriority::Default));
+  }
+
+  EXPECT_EQ(queue.steal(), second_task);
+
+  EXPECT_EQ(queue.pull(), first_task);
+  EXPECT_EQ(queue.pull(), non_stealable_task);
+  EXPECT_EQ(queue.pull(), last_task);
+  EXPECT_TRUE(queue.empty());
+}
+
 TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress) {
   Hyrise::get().topology.use_default_topology(1);
   Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
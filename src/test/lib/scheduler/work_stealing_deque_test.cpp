@@ -0,0 +1,106 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/work_stealing_deque.hpp"
+
+namespace opossum {
+
+class WorkStealingDequeTest : public BaseTest {};
+
+TEST_F(WorkStealingDequeTest, PopIsLifoStealIsFifo) {
+  auto deque = WorkStealingDeque{};
+  EXPECT_TRUE(deque.empty());
+
+  const auto task_a = std::make_shared<JobTask>([]() {});
+  const auto task_b = std::make_shared<JobTask>([]() {});
+  const auto task_c = std::make_shared<JobTask>([]() {});
+
+  deque.push(task_a);
+  deque.push(task_b);
+  deque.push(task_c);
+  EXPECT_EQ(deque.size(), 3);
+
+  EXPECT_EQ(deque.pop(), task_c);
+  EXPECT_EQ(deque.steal(), task_a);
+  EXPECT_EQ(deque.pop(), task_b);
+
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST_F(WorkStealingDequeTest, Grow) {
+  auto deque = WorkStealingDeque{2};
+
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto task_id = 0; task_id < 100; ++task_id) {
+    tasks.emplace_back(std::make_shared<JobTask>([]() {}));
+    deque.push(tasks.back());
+  }
+  EXPECT_EQ(deque.size(), 100);
+
+  for (auto task_id = 0; task_id < 100; ++task_id) {
+    EXPECT_EQ(deque.steal(), tasks[task_id]);
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(WorkStealingDequeTest, ReleasesRemainingTasks) {
+  const auto task = std::make_shared<JobTask>([]() {});
+  {
+    auto deque = WorkStealingDeque{};
+    deque.push(task);
+    EXPECT_EQ(task.use_count(), 2);
+  }
+  EXPECT_EQ(task.use_count(), 1);
+}
+
+TEST_F(WorkStealingDequeTest, ConcurrentPopAndSteal) {
+  // Every task must be handed out exactly once, no matter whether it is popped by the owner or stolen by a thief.
+  constexpr auto TASK_COUNT = 10'000;
+
+  auto deque = WorkStealingDeque{4};
+  auto executed_count = std::atomic_uint32_t{0};
+  auto owner_done = std::atomic_bool{false};
+
+  auto thieves = std::vector<std::thread>{};
+  for (auto thief_id = 0; thief_id < 3; ++thief_id) {
+    thieves.emplace_back([&]() {
+      while (!owner_done || !deque.empty()) {
+        if (const auto task = deque.steal()) {
+          EXPECT_TRUE(task->try_mark_as_assigned_to_worker());
+          ++executed_count;
+        }
+      }
+    });
+  }
+
+  for (auto task_id = 0; task_id < TASK_COUNT; ++task_id) {
+    deque.push(std::make_shared<JobTask>([]() {}));
+    if (task_id % 3 == 0) {
+      if (const auto task = deque.pop()) {
+        EXPECT_TRUE(task->try_mark_as_assigned_to_worker());
+        ++executed_count;
+      }
+    }
+  }
+
+  while (const auto task = deque.pop()) {
+    EXPECT_TRUE(task->try_mark_as_assigned_to_worker());
+    ++executed_count;
+  }
+  owner_done = true;
+
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  EXPECT_EQ(executed_count, TASK_COUNT);
+}
+
+}  // namespace opossum
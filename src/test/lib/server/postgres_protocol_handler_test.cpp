@@ -249,6 +249,29 @@ TEST_F(PostgresProtocolHandlerTest, ReadBindPacket) {
   EXPECT_EQ(statement_information.portal, portal);
   EXPECT_EQ(statement_information.statement_name, statement_name);
   EXPECT_EQ(statement_information.parameters, std::vector<AllTypeVariant>{"test"});
+  EXPECT_EQ(statement_information.result_format_codes, std::vector<FormatCode>{FormatCode::Text});
+}
+
+TEST_F(PostgresProtocolHandlerTest, ReadBindPacketWithBinaryResults) {
+  const std::string portal = "test_portal";
+  const std::string statement_name = "test_statement";
+
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x29'});
+  _mocked_socket->write(portal);
+  _mocked_socket->write(std::string{"\0", 1});
+  _mocked_socket->write(statement_name);
+  _mocked_socket->write(std::string{"\0", 1});
+  // No parameter format codes and no parameters
+  _mocked_socket->write(std::string{"\0", 2});
+  _mocked_socket->write(std::string{"\0", 2});
+  // Two result columns, the first one in binary format
+  _mocked_socket->write(std::string{'\0', '\x02'});
+  _mocked_socket->write(std::string{'\0', '\x01', '\0', '\0'});
+
+  const auto& statement_information = _protocol_handler->read_bind_packet();
+  EXPECT_EQ(statement_information.portal, portal);
+  EXPECT_TRUE(statement_information.parameters.empty());
+  EXPECT_EQ(statement_information.result_format_codes, (std::vector<FormatCode>{FormatCode::Binary, FormatCode::Text}));
 }
 
 TEST_F(PostgresProtocolHandlerTest, ReadExecutePacket) {
@@ -258,7 +281,21 @@ TEST_F(PostgresProtocolHandlerTest, ReadExecutePacket) {
   _mocked_socket->write(portal_name);
   _mocked_socket->write({'\0', '\0', '\0', '\0', '\0'});
 
-  EXPECT_EQ(_protocol_handler->read_execute_packet(), portal_name);
+  const auto [read_portal_name, row_limit] = _protocol_handler->read_execute_packet();
+  EXPECT_EQ(read_portal_name, portal_name);
+  EXPECT_EQ(row_limit, 0u);
+}
+
+TEST_F(PostgresProtocolHandlerTest, ReadExecutePacketWithRowLimit) {
+  const std::string portal_name = "some_portal";
+  _mocked_socket->write(std::string{'\0', '\0', '\0', '\x14'});
+  _mocked_socket->write(portal_name);
+  // Null terminator of the portal name followed by a limit of 100 rows
+  _mocked_socket->write({'\0', '\0', '\0', '\0', '\x64'});
+
+  const auto [read_portal_name, row_limit] = _protocol_handler->read_execute_packet();
+  EXPECT_EQ(read_portal_name, portal_name);
+  EXPECT_EQ(row_limit, 100u);
 }
 
 TEST_F(PostgresProtocolHandlerTest, SendErrorMessage) {
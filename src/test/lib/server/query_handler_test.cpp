@@ -34,7 +34,7 @@ TEST_F(QueryHandlerTest, CreatePreparedPlan) {
 
 TEST_F(QueryHandlerTest, BindParameters) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a = ?");
-  const auto specification = PreparedStatementDetails{"test_statement", "", {12345}};
+  const auto specification = PreparedStatementDetails{"test_statement", "", {12345}, {}};
 
   const auto bound_plan = QueryHandler::bind_prepared_plan(specification);
   EXPECT_EQ(bound_plan->type(), OperatorType::Validate);
@@ -50,7 +50,7 @@ TEST_F(QueryHandlerTest, BindParameters) {
 
 TEST_F(QueryHandlerTest, ExecutePreparedStatement) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
-  const auto specification = PreparedStatementDetails{"test_statement", "", {123}};
+  const auto specification = PreparedStatementDetails{"test_statement", "", {123}, {}};
   const auto pqp = QueryHandler::bind_prepared_plan(specification);
 
   auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
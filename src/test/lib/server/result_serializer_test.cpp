@@ -1,6 +1,10 @@
+#include <cstring>
+#include <optional>
+
 #include "base_test.hpp"
 #include "mock_socket.hpp"
 
+#include "lossy_cast.hpp"
 #include "server/postgres_protocol_handler.hpp"
 #include "server/result_serializer.hpp"
 
@@ -17,6 +21,50 @@ class ResultSerializerTest : public BaseTest {
         std::make_shared<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>(_mocked_socket->get_socket());
   }
 
+  using Row = std::vector<std::optional<std::string>>;
+
+  // Table with one column per data type, spread over two chunks
+  static std::shared_ptr<Table> _create_value_table() {
+    const auto table = std::make_shared<Table>(
+        TableColumnDefinitions{{"i", DataType::Int, false},
+                               {"l", DataType::Long, true},
+                               {"f", DataType::Float, false},
+                               {"d", DataType::Double, false},
+                               {"s", DataType::String, true}},
+        TableType::Data, ChunkOffset{2});
+    table->append({-17, int64_t{12'345'678'901}, 1.5f, 0.1, pmr_string{"abc"}});
+    table->append({2'147'483'647, NULL_VALUE, -0.25f, 1e10, NULL_VALUE});
+    table->append({0, int64_t{-1}, 3.2f, -2.5, pmr_string{""}});
+    return table;
+  }
+
+  // Splits the content of DataRow messages into their values
+  static std::vector<Row> _parse_data_rows(const std::string& file_content) {
+    auto rows = std::vector<Row>{};
+    auto position = file_content.cbegin();
+    while (position != file_content.cend()) {
+      EXPECT_EQ(static_cast<PostgresMessageType>(*position), PostgresMessageType::DataRow);
+      const auto message_end = position + 1 + NetworkConversionHelper::get_message_length(position + 1);
+      position += sizeof(PostgresMessageType) + sizeof(uint32_t);
+      const auto value_count = NetworkConversionHelper::get_small_int(position);
+      position += sizeof(uint16_t);
+
+      auto& row = rows.emplace_back();
+      for (auto value_id = 0; value_id < value_count; ++value_id) {
+        const auto length = static_cast<int32_t>(NetworkConversionHelper::get_message_length(position));
+        position += sizeof(uint32_t);
+        if (length < 0) {
+          row.emplace_back(std::nullopt);
+          continue;
+        }
+        row.emplace_back(std::string{position, position + length});
+        position += length;
+      }
+      EXPECT_EQ(position, message_end);
+    }
+    return rows;
+  }
+
   std::shared_ptr<Table> _test_table;
   std::shared_ptr<MockSocket> _mocked_socket;
   std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>> _protocol_handler;
@@ -43,6 +91,132 @@ TEST_F(ResultSerializerTest, QueryResponse) {
   EXPECT_EQ(std::count(file_content.begin(), file_content.end(), 'D'), _test_table->row_count());
 }
 
+TEST_F(ResultSerializerTest, RowDescriptionBinaryFormat) {
+  ResultSerializer::send_table_description(_test_table, _protocol_handler, {FormatCode::Binary});
+  _protocol_handler->force_flush();
+  const std::string file_content = _mocked_socket->read();
+
+  // The format code is the last field of each column description
+  EXPECT_EQ(NetworkConversionHelper::get_small_int(file_content.cend() - sizeof(uint16_t)), 1);
+}
+
+TEST_F(ResultSerializerTest, QueryResponseTextValues) {
+  const auto table = _create_value_table();
+  ResultSerializer::send_query_response(table, _protocol_handler);
+  _protocol_handler->force_flush();
+  const auto rows = _parse_data_rows(_mocked_socket->read());
+
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows[0], (Row{"-17", "12345678901", "1.5", "0.10000000000000001", "abc"}));
+  EXPECT_EQ(rows[1], (Row{"2147483647", std::nullopt, "-0.25", "10000000000", std::nullopt}));
+  EXPECT_EQ(rows[2], (Row{"0", "-1", "3.20000005", "-2.5", ""}));
+
+  // The text representation is the same as the one of the lossy_variant_cast that was used before
+  for (auto row_id = size_t{0}; row_id < rows.size(); ++row_id) {
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      const auto expected_value = lossy_variant_cast<pmr_string>(table->get_row(row_id)[column_id]);
+      ASSERT_EQ(rows[row_id][column_id].has_value(), expected_value.has_value());
+      if (expected_value) {
+        EXPECT_EQ(*rows[row_id][column_id], std::string{*expected_value});
+      }
+    }
+  }
+}
+
+TEST_F(ResultSerializerTest, QueryResponseBinaryValues) {
+  const auto table = _create_value_table();
+  // Send all columns but the string column in binary format
+  ResultSerializer::send_query_response(
+      table, _protocol_handler,
+      {FormatCode::Binary, FormatCode::Binary, FormatCode::Binary, FormatCode::Binary, FormatCode::Text});
+  _protocol_handler->force_flush();
+  const auto rows = _parse_data_rows(_mocked_socket->read());
+
+  ASSERT_EQ(rows.size(), 3);
+  const auto& row = rows[0];
+  ASSERT_EQ(row[0]->size(), 4);
+  EXPECT_EQ(static_cast<int32_t>(NetworkConversionHelper::get_message_length(row[0]->cbegin())), -17);
+
+  ASSERT_EQ(row[1]->size(), 8);
+  auto long_bits = uint64_t{0};
+  for (const auto byte : *row[1]) {
+    long_bits = (long_bits << 8) | static_cast<uint8_t>(byte);
+  }
+  EXPECT_EQ(static_cast<int64_t>(long_bits), 12'345'678'901);
+
+  ASSERT_EQ(row[2]->size(), 4);
+  const auto float_bits = NetworkConversionHelper::get_message_length(row[2]->cbegin());
+  auto float_value = 0.0f;
+  std::memcpy(&float_value, &float_bits, sizeof(float));
+  EXPECT_EQ(float_value, 1.5f);
+
+  ASSERT_EQ(row[3]->size(), 8);
+  auto double_bits = uint64_t{0};
+  for (const auto byte : *row[3]) {
+    double_bits = (double_bits << 8) | static_cast<uint8_t>(byte);
+  }
+  auto double_value = 0.0;
+  std::memcpy(&double_value, &double_bits, sizeof(double));
+  EXPECT_EQ(double_value, 0.1);
+
+  EXPECT_EQ(row[4], "abc");
+  EXPECT_EQ(rows[1][1], std::nullopt);
+  EXPECT_EQ(rows[2][4], "");
+}
+
+TEST_F(ResultSerializerTest, QueryResponseInBatches) {
+  const auto table = _create_value_table();
+  auto cursor = ResultCursor{};
+
+  // The first batch ends at the end of the first chunk, the second one contains the remaining row
+  EXPECT_FALSE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 2));
+  _protocol_handler->force_flush();
+  EXPECT_EQ(_parse_data_rows(_mocked_socket->read()).size(), 2);
+  EXPECT_EQ(cursor.sent_row_count, 2);
+
+  EXPECT_TRUE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 2));
+  _protocol_handler->force_flush();
+  const auto rows = _parse_data_rows(_mocked_socket->read());
+  EXPECT_EQ(cursor.sent_row_count, 3);
+
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows[0], (Row{"-17", "12345678901", "1.5", "0.10000000000000001", "abc"}));
+  EXPECT_EQ(rows[2], (Row{"0", "-1", "3.20000005", "-2.5", ""}));
+}
+
+TEST_F(ResultSerializerTest, QueryResponseInBatchesWithinChunk) {
+  const auto table = _create_value_table();
+  auto cursor = ResultCursor{};
+
+  // The second batch continues within the first chunk and ends in the second chunk
+  EXPECT_FALSE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 1));
+  EXPECT_TRUE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 5));
+  _protocol_handler->force_flush();
+  const auto rows = _parse_data_rows(_mocked_socket->read());
+
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows[1], (Row{"2147483647", std::nullopt, "-0.25", "10000000000", std::nullopt}));
+  EXPECT_EQ(cursor.sent_row_count, 3);
+}
+
+TEST_F(ResultSerializerTest, QueryResponseWithByteLimit) {
+  const auto table = _create_value_table();
+  auto cursor = ResultCursor{};
+
+  // Sending stops after the row that exceeds the byte limit
+  EXPECT_FALSE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 0, 1));
+  EXPECT_EQ(cursor.sent_row_count, 1);
+  EXPECT_FALSE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 0, 1));
+  EXPECT_EQ(cursor.sent_row_count, 2);
+  EXPECT_TRUE(ResultSerializer::send_query_response(table, _protocol_handler, {}, cursor, 0, 1));
+  _protocol_handler->force_flush();
+  const auto rows = _parse_data_rows(_mocked_socket->read());
+
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows[1], (Row{"2147483647", std::nullopt, "-0.25", "10000000000", std::nullopt}));
+  EXPECT_EQ(cursor.sent_row_count, 3);
+}
+
 TEST_F(ResultSerializerTest, CommandCompleteMessage) {
   EXPECT_EQ(ResultSerializer::build_command_complete_message(OperatorType::Insert, 1), "INSERT 0 1");
   EXPECT_EQ(ResultSerializer::build_command_complete_message(OperatorType::Update, 1), "UPDATE -1");
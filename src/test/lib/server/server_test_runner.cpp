@@ -107,6 +107,30 @@ TEST_F(ServerTestRunner, ValidateCorrectTransfer) {
   }
 }
 
+TEST_F(ServerTestRunner, TestLargeResult) {
+  // The result is much larger than SERVER_BUFFER_SIZE and is therefore sent in many parts
+  const auto row_count = int32_t{20'000};
+  const auto large_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                                   ChunkOffset{1'000});
+  for (auto value = int32_t{0}; value < row_count; ++value) {
+    large_table->append({value});
+  }
+  Hyrise::get().storage_manager.add_table("large_table", large_table);
+
+  pqxx::connection connection{_connection_string};
+  pqxx::nontransaction transaction{connection};
+  connection.prepare("large_statement", "SELECT a FROM large_table WHERE a >= ? ORDER BY a");
+
+  const auto simple_query_result = transaction.exec("SELECT a FROM large_table ORDER BY a;");
+  const auto prepared_result = transaction.exec_prepared("large_statement", 0);
+  ASSERT_EQ(simple_query_result.size(), static_cast<size_t>(row_count));
+  ASSERT_EQ(prepared_result.size(), static_cast<size_t>(row_count));
+  for (auto row_id = int32_t{0}; row_id < row_count; ++row_id) {
+    EXPECT_EQ(simple_query_result[row_id][0].as<int32_t>(), row_id);
+    EXPECT_EQ(prepared_result[row_id][0].as<int32_t>(), row_id);
+  }
+}
+
 TEST_F(ServerTestRunner, TestCopyImport) {
   pqxx::connection connection{_connection_string};
 
@@ -287,6 +311,57 @@ TEST_F(ServerTestRunner, TestMultipleConnections) {
   EXPECT_EQ(result3.size(), expected_num_rows);
 }
 
+TEST_F(ServerTestRunner, TestStalledClients) {
+  // Clients that stop in the middle of a message must not keep the server from serving other clients. We stall more
+  // clients than the server has threads. Half of them stop within the startup packet, the other half within a query.
+  auto io_service = boost::asio::io_service{};
+  const auto endpoint = boost::asio::ip::tcp::endpoint{boost::asio::ip::address_v4::loopback(), _server->server_port()};
+  const auto partial_startup_packet = std::vector<char>{0, 0, 0, 8, 0, 3};
+  const auto startup_packet_and_partial_query = std::vector<char>{0, 0, 0, 8, 0, 3, 0, 0, 'Q', 0, 0, 0, 100, 'S', 'E'};
+
+  const auto stalled_client_count = std::thread::hardware_concurrency() + 1;
+  auto stalled_clients = std::vector<std::shared_ptr<Socket>>{};
+  stalled_clients.reserve(stalled_client_count);
+  for (auto client_id = size_t{0}; client_id < stalled_client_count; ++client_id) {
+    const auto stalled_client = std::make_shared<Socket>(io_service);
+    stalled_client->connect(endpoint);
+    boost::asio::write(*stalled_client, boost::asio::buffer(client_id % 2 == 0 ? partial_startup_packet
+                                                                                : startup_packet_and_partial_query));
+    stalled_clients.emplace_back(stalled_client);
+  }
+
+  auto healthy_client = std::async(std::launch::async, [&]() {
+    pqxx::connection connection{_connection_string};
+    pqxx::nontransaction transaction{connection};
+    return transaction.exec("SELECT * FROM table_a;").size();
+  });
+
+  ASSERT_EQ(healthy_client.wait_for(std::chrono::seconds(10)), std::future_status::ready)
+      << "Stalled clients blocked the server.";
+  EXPECT_EQ(healthy_client.get(), _table_a->row_count());
+
+  // Closing the stalled clients' connections lets the server shut down
+  for (const auto& stalled_client : stalled_clients) {
+    stalled_client->close();
+  }
+}
+
+TEST_F(ServerTestRunner, TestOversizedMessage) {
+  // The query claims to be almost 2 GiB long. The server rejects it without waiting for its body and closes the
+  // connection afterwards.
+  auto io_service = boost::asio::io_service{};
+  auto client = Socket{io_service};
+  client.connect(boost::asio::ip::tcp::endpoint{boost::asio::ip::address_v4::loopback(), _server->server_port()});
+  const auto startup_packet_and_oversized_query = std::vector<char>{0, 0, 0, 8, 0, 3, 0, 0, 'Q', 0x7F, 0, 0, 0};
+  boost::asio::write(client, boost::asio::buffer(startup_packet_and_oversized_query));
+
+  auto response = std::string{};
+  auto error = boost::system::error_code{};
+  boost::asio::read(client, boost::asio::dynamic_buffer(response), error);
+  EXPECT_EQ(error, boost::asio::error::eof);
+  EXPECT_NE(response.find("exceeds the maximum message size"), std::string::npos);
+}
+
 TEST_F(ServerTestRunner, TestSimpleInsertSelect) {
   pqxx::connection connection{_connection_string};
   pqxx::nontransaction transaction{connection};
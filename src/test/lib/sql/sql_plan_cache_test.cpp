@@ -34,7 +34,7 @@ class QueryPlanCacheTest : public BaseTest {
     }
   }
 
-  size_t query_frequency(const std::string& key) const { return (*(cache->_map.find(key)->second)).frequency; }
+  size_t query_frequency(const std::string& key) const { return *cache->snapshot().at(key).frequency; }
 
   const std::string Q1 = "SELECT * FROM table_a;";
   const std::string Q2 = "SELECT * FROM table_b;";
@@ -91,6 +91,31 @@ TEST_F(QueryPlanCacheTest, AutomaticQueryOperatorCacheGDFS) {
   EXPECT_EQ(9u, _query_plan_cache_hits);
 }
 
+// Test query plan cache with the sharded implementation. A new plan is only admitted to a full cache if it is used
+// more frequently than the plan that it would replace.
+TEST_F(QueryPlanCacheTest, AutomaticQueryOperatorCacheSharded) {
+  cache = std::make_shared<SQLPhysicalPlanCache>(1, PlanCacheType::Sharded);
+  EXPECT_EQ(cache->type(), PlanCacheType::Sharded);
+
+  execute_query(Q1);  // Miss, insert.
+  execute_query(Q1);  // Hit.
+  execute_query(Q1);  // Hit.
+  execute_query(Q2);  // Miss, not admitted as Q1 was used more often.
+  execute_query(Q1);  // Hit.
+
+  EXPECT_TRUE(cache->has(Q1));
+  EXPECT_FALSE(cache->has(Q2));
+  EXPECT_EQ(3u, _query_plan_cache_hits);
+
+  for (auto execution_count = 0; execution_count < 5; ++execution_count) {
+    execute_query(Q2);  // Miss until Q2 was used more often than Q1, which is then evicted.
+  }
+
+  EXPECT_FALSE(cache->has(Q1));
+  EXPECT_TRUE(cache->has(Q2));
+  EXPECT_EQ(1u, cache->size());
+}
+
 // Check access to PQP cache. When set, check the underlying cache implementation, and verify that it is a GDFS cache
 // that supports retrieving the cache frequency count.
 TEST_F(QueryPlanCacheTest, CachedPQPFrequencyCount) {
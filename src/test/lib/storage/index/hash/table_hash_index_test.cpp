@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/index/hash/table_hash_index.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class TableHashIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String, false}};
+    _table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3}, UseMvcc::Yes);
+    _table->append({1, pmr_string{"one"}});
+    _table->append({2, pmr_string{"two"}});
+    _table->append({1, pmr_string{"one"}});
+    _table->append({NullValue{}, pmr_string{"null"}});
+    _table->append({3, pmr_string{"three"}});
+
+    // The first chunk was finalized by append() and is encoded, the second one is still mutable
+    ChunkEncoder::encode_chunks(_table, {ChunkID{0}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  }
+
+  static RowIDPosList _equals(const TableHashIndex& index, const AllTypeVariant& value) {
+    auto matches = RowIDPosList{};
+    index.equals(value, matches);
+    std::sort(matches.begin(), matches.end());
+    return matches;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(TableHashIndexTest, IndexesExistingChunks) {
+  _table->create_table_index(ColumnID{0});
+  _table->create_table_index(ColumnID{1});
+
+  const auto index_a = _table->table_index(ColumnID{0});
+  const auto index_b = _table->table_index(ColumnID{1});
+  ASSERT_TRUE(index_a);
+  ASSERT_TRUE(index_b);
+  EXPECT_EQ(index_a->column_id(), ColumnID{0});
+  EXPECT_EQ(index_a->data_type(), DataType::Int);
+  EXPECT_EQ(_table->table_indexes().size(), 2);
+
+  // NULLs are not indexed
+  EXPECT_EQ(index_a->row_count(), 4);
+  EXPECT_EQ(index_b->row_count(), 5);
+  EXPECT_GT(index_a->memory_usage(), 0);
+
+  EXPECT_EQ(_equals(*index_a, 1), RowIDPosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{2}}}));
+  EXPECT_EQ(_equals(*index_a, 3), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}}));
+  EXPECT_EQ(_equals(*index_a, 4), RowIDPosList{});
+  EXPECT_EQ(_equals(*index_b, pmr_string{"null"}), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableHashIndexTest, NullAndLossyValuesMatchNothing) {
+  _table->create_table_index(ColumnID{0});
+  const auto index = _table->table_index(ColumnID{0});
+
+  EXPECT_EQ(_equals(*index, NULL_VALUE), RowIDPosList{});
+  EXPECT_EQ(_equals(*index, 1.5f), RowIDPosList{});
+  EXPECT_EQ(_equals(*index, int64_t{1}).size(), 2);
+  EXPECT_EQ(_equals(*index, 2.0).size(), 1);
+}
+
+TEST_F(TableHashIndexTest, NoIndexForColumn) {
+  _table->create_table_index(ColumnID{0});
+  EXPECT_FALSE(_table->table_index(ColumnID{1}));
+  EXPECT_THROW(_table->create_table_index(ColumnID{0}), std::logic_error);
+}
+
+TEST_F(TableHashIndexTest, MaintainedByInsert) {
+  _table->create_table_index(ColumnID{0});
+  Hyrise::get().storage_manager.add_table("table_a", _table);
+
+  const auto values = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  values->append({3, pmr_string{"three"}});
+  values->append({4, pmr_string{"four"}});
+  values->append({NullValue{}, pmr_string{"null"}});
+  const auto table_wrapper = std::make_shared<TableWrapper>(values);
+  table_wrapper->execute();
+
+  const auto insert = std::make_shared<Insert>("table_a", table_wrapper);
+  const auto context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  insert->set_transaction_context(context);
+  insert->execute();
+  context->commit();
+
+  // The rows fill up the second chunk and start a third one
+  const auto index = _table->table_index(ColumnID{0});
+  EXPECT_EQ(index->row_count(), 6);
+  EXPECT_EQ(_equals(*index, 3), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{2}}}));
+  EXPECT_EQ(_equals(*index, 4), RowIDPosList({RowID{ChunkID{2}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableHashIndexTest, MaintainedByAppend) {
+  _table->create_table_index(ColumnID{0});
+  const auto index = _table->table_index(ColumnID{0});
+
+  _table->append({3, pmr_string{"three"}});
+  _table->append({5, pmr_string{"five"}});
+  EXPECT_EQ(index->row_count(), 6);
+  EXPECT_EQ(_equals(*index, 3), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}, RowID{ChunkID{1}, ChunkOffset{2}}}));
+  EXPECT_EQ(_equals(*index, 5), RowIDPosList({RowID{ChunkID{2}, ChunkOffset{0}}}));
+
+  const auto segment_a =
+      std::make_shared<ValueSegment<int32_t>>(pmr_vector<int32_t>{5, 0}, pmr_vector<bool>{false, true});
+  const auto segment_b = std::make_shared<ValueSegment<pmr_string>>(pmr_vector<pmr_string>{"five", "null"});
+  _table->append_chunk({segment_a, segment_b}, std::make_shared<MvccData>(2, CommitID{0}));
+  EXPECT_EQ(index->row_count(), 7);
+  EXPECT_EQ(_equals(*index, 5), RowIDPosList({RowID{ChunkID{2}, ChunkOffset{0}}, RowID{ChunkID{3}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableHashIndexTest, RolledBackInsertsAreRemoved) {
+  _table->create_table_index(ColumnID{0});
+  Hyrise::get().storage_manager.add_table("table_a", _table);
+
+  const auto values = std::make_shared<Table>(_table->column_definitions(), TableType::Data);
+  values->append({1, pmr_string{"one"}});
+  values->append({4, pmr_string{"four"}});
+  const auto table_wrapper = std::make_shared<TableWrapper>(values);
+  table_wrapper->execute();
+
+  const auto insert = std::make_shared<Insert>("table_a", table_wrapper);
+  const auto context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  insert->set_transaction_context(context);
+  insert->execute();
+
+  const auto index = _table->table_index(ColumnID{0});
+  EXPECT_EQ(index->row_count(), 6);
+
+  context->rollback(RollbackReason::User);
+
+  // Only the entries of the rolled back rows are removed, not those of other rows with the same value
+  EXPECT_EQ(index->row_count(), 4);
+  EXPECT_EQ(_equals(*index, 1), RowIDPosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{2}}}));
+  EXPECT_EQ(_equals(*index, 4), RowIDPosList{});
+}
+
+TEST_F(TableHashIndexTest, RemoveChunk) {
+  _table->create_table_index(ColumnID{0});
+  const auto index = _table->table_index(ColumnID{0});
+  const auto memory_usage = index->memory_usage();
+
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  chunk->increase_invalid_row_count(chunk->size());
+  _table->remove_chunk(ChunkID{0});
+
+  EXPECT_EQ(index->row_count(), 1);
+  EXPECT_EQ(_equals(*index, 1), RowIDPosList{});
+  EXPECT_EQ(_equals(*index, 3), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}}));
+  EXPECT_LT(index->memory_usage(), memory_usage);
+}
+
+}  // namespace opossum
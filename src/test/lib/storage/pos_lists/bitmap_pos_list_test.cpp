@@ -0,0 +1,184 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/delete.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/pos_lists/bitmap_pos_list.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class BitmapPosListTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Every third row of a chunk with 200 rows, i.e., the words of the bitmap have different numbers of set bits
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < ChunkOffset{200}; chunk_offset += 3) {
+      _row_ids.emplace_back(ChunkID{2}, chunk_offset);
+    }
+    _pos_list = std::make_shared<BitmapPosList>(ChunkID{2}, ChunkOffset{200}, _row_ids);
+  }
+
+  // Table with a single chunk whose column "a" holds the values 0 to 999
+  static std::shared_ptr<Table> _create_table(const UseMvcc use_mvcc) {
+    const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                               ChunkOffset{1'000}, use_mvcc);
+    for (auto value = 0; value < 1'000; ++value) {
+      table->append({value});
+    }
+    return table;
+  }
+
+  RowIDPosList _row_ids;
+  std::shared_ptr<BitmapPosList> _pos_list;
+};
+
+TEST_F(BitmapPosListTest, Properties) {
+  EXPECT_TRUE(_pos_list->references_single_chunk());
+  EXPECT_EQ(_pos_list->common_chunk_id(), ChunkID{2});
+  EXPECT_EQ(_pos_list->chunk_size(), 200);
+  EXPECT_EQ(_pos_list->size(), 67);
+  EXPECT_FALSE(_pos_list->empty());
+  EXPECT_EQ(_pos_list->bitmap().size(), 4);
+  EXPECT_LT(_pos_list->memory_usage(MemoryUsageCalculationMode::Full),
+            _row_ids.memory_usage(MemoryUsageCalculationMode::Full));
+
+  const auto empty_pos_list =
+      BitmapPosList{ChunkID{0}, ChunkOffset{100}, BitmapPosList::create_bitmap(ChunkOffset{100})};
+  EXPECT_TRUE(empty_pos_list.empty());
+  EXPECT_EQ(empty_pos_list.begin(), empty_pos_list.end());
+}
+
+TEST_F(BitmapPosListTest, Iteration) {
+  EXPECT_EQ(std::vector<RowID>(_pos_list->begin(), _pos_list->end()),
+            std::vector<RowID>(_row_ids.begin(), _row_ids.end()));
+  EXPECT_EQ(_pos_list->end() - _pos_list->begin(), 67);
+
+  // Random access, both through the iterator and through the virtual interface
+  for (const auto index : {size_t{0}, size_t{1}, size_t{21}, size_t{22}, size_t{43}, size_t{66}}) {
+    EXPECT_EQ((*_pos_list)[index], _row_ids[index]);
+    EXPECT_EQ(*(_pos_list->begin() + index), _row_ids[index]);
+    EXPECT_EQ(static_cast<const AbstractPosList&>(*_pos_list)[index], _row_ids[index]);
+  }
+
+  auto iter = _pos_list->begin() + 66;
+  iter -= 44;
+  EXPECT_EQ(*iter, _row_ids[22]);
+  iter += 2;
+  EXPECT_EQ(*iter, _row_ids[24]);
+  --iter;
+  EXPECT_EQ(*iter, _row_ids[23]);
+}
+
+TEST_F(BitmapPosListTest, ContainsAndPositionOf) {
+  EXPECT_TRUE(_pos_list->contains(ChunkOffset{0}));
+  EXPECT_FALSE(_pos_list->contains(ChunkOffset{1}));
+  EXPECT_TRUE(_pos_list->contains(ChunkOffset{198}));
+  EXPECT_FALSE(_pos_list->contains(ChunkOffset{200}));
+  EXPECT_FALSE(_pos_list->contains(ChunkOffset{5'000}));
+
+  for (auto position = size_t{0}; position < _row_ids.size(); ++position) {
+    EXPECT_EQ(_pos_list->position_of(_row_ids[position].chunk_offset), position);
+  }
+}
+
+TEST_F(BitmapPosListTest, PreferBitmap) {
+  EXPECT_FALSE(BitmapPosList::prefer_bitmap(100, ChunkOffset{1'000}));
+  EXPECT_TRUE(BitmapPosList::prefer_bitmap(125, ChunkOffset{1'000}));
+  EXPECT_TRUE(BitmapPosList::prefer_bitmap(300, ChunkOffset{1'000}));
+}
+
+TEST_F(BitmapPosListTest, SegmentIteration) {
+  const auto table = _create_table(UseMvcc::No);
+  auto pos_list = RowIDPosList{};
+  for (auto chunk_offset = ChunkOffset{5}; chunk_offset < ChunkOffset{1'000}; chunk_offset += 7) {
+    pos_list.emplace_back(ChunkID{0}, chunk_offset);
+  }
+  const auto bitmap_pos_list = std::make_shared<BitmapPosList>(ChunkID{0}, ChunkOffset{1'000}, pos_list);
+
+  for (const auto encoding_type : {EncodingType::Unencoded, EncodingType::Dictionary}) {
+    ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{encoding_type});
+    const auto reference_segment = ReferenceSegment{table, ColumnID{0}, bitmap_pos_list};
+
+    auto values = std::vector<int32_t>{};
+    segment_iterate<int32_t>(reference_segment, [&](const auto& position) { values.emplace_back(position.value()); });
+
+    ASSERT_EQ(values.size(), pos_list.size());
+    for (auto index = size_t{0}; index < values.size(); ++index) {
+      EXPECT_EQ(values[index], static_cast<int32_t>(pos_list[index].chunk_offset));
+    }
+  }
+}
+
+TEST_F(BitmapPosListTest, EmittedAndConsumedByTableScan) {
+  const auto table = _create_table(UseMvcc::No);
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary});
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // 30% of the rows match, so the scan emits a bitmap
+  const auto scan_a = create_table_scan(table_wrapper, ColumnID{0}, PredicateCondition::GreaterThanEquals, 700);
+  scan_a->execute();
+  const auto& chunk_a = *scan_a->get_output()->get_chunk(ChunkID{0});
+  const auto& segment_a = static_cast<const ReferenceSegment&>(*chunk_a.get_segment(ColumnID{0}));
+  ASSERT_TRUE(std::dynamic_pointer_cast<const BitmapPosList>(segment_a.pos_list()));
+  EXPECT_EQ(segment_a.pos_list()->size(), 300);
+
+  // The bitmap is dense enough for the second scan to scan the entire referenced segment and AND the result. The
+  // result is still dense enough to be a bitmap.
+  const auto scan_b = create_table_scan(scan_a, ColumnID{0}, PredicateCondition::LessThan, 950);
+  scan_b->execute();
+  const auto& chunk_b = *scan_b->get_output()->get_chunk(ChunkID{0});
+  const auto& segment_b = static_cast<const ReferenceSegment&>(*chunk_b.get_segment(ColumnID{0}));
+  ASSERT_TRUE(std::dynamic_pointer_cast<const BitmapPosList>(segment_b.pos_list()));
+  EXPECT_EQ(segment_b.pos_list()->size(), 250);
+  EXPECT_EQ((*segment_b.pos_list())[0], RowID(ChunkID{0}, ChunkOffset{700}));
+  EXPECT_EQ((*segment_b.pos_list())[249], RowID(ChunkID{0}, ChunkOffset{949}));
+
+  // Few matches are stored as a RowIDPosList
+  const auto scan_c = create_table_scan(scan_b, ColumnID{0}, PredicateCondition::Equals, 800);
+  scan_c->execute();
+  const auto& chunk_c = *scan_c->get_output()->get_chunk(ChunkID{0});
+  const auto& segment_c = static_cast<const ReferenceSegment&>(*chunk_c.get_segment(ColumnID{0}));
+  ASSERT_TRUE(std::dynamic_pointer_cast<const RowIDPosList>(segment_c.pos_list()));
+  EXPECT_EQ((*segment_c.pos_list())[0], RowID(ChunkID{0}, ChunkOffset{800}));
+}
+
+TEST_F(BitmapPosListTest, ConsumedByValidate) {
+  const auto table = _create_table(UseMvcc::Yes);
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Delete the rows with values below 100
+  const auto delete_scan = create_table_scan(table_wrapper, ColumnID{0}, PredicateCondition::LessThan, 100);
+  delete_scan->execute();
+  const auto delete_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto delete_op = std::make_shared<Delete>(delete_scan);
+  delete_op->set_transaction_context(delete_context);
+  delete_op->execute();
+  delete_context->commit();
+
+  const auto scan = create_table_scan(table_wrapper, ColumnID{0}, PredicateCondition::LessThan, 500);
+  scan->execute();
+
+  const auto validate = std::make_shared<Validate>(scan);
+  validate->set_transaction_context(Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes));
+  validate->execute();
+
+  const auto& chunk = *validate->get_output()->get_chunk(ChunkID{0});
+  const auto& segment = static_cast<const ReferenceSegment&>(*chunk.get_segment(ColumnID{0}));
+  ASSERT_TRUE(std::dynamic_pointer_cast<const BitmapPosList>(segment.pos_list()));
+  EXPECT_EQ(segment.pos_list()->size(), 400);
+  EXPECT_EQ((*segment.pos_list())[0], RowID(ChunkID{0}, ChunkOffset{100}));
+}
+
+}  // namespace opossum
@@ -0,0 +1,87 @@
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "utils/blocked_bloom_filter.hpp"
+
+namespace opossum {
+
+class BlockedBloomFilterTest : public BaseTest {};
+
+TEST_F(BlockedBloomFilterTest, Sizing) {
+  EXPECT_EQ(BlockedBloomFilter{}.block_count(), 1);
+  EXPECT_EQ(BlockedBloomFilter{0}.block_count(), 1);
+  EXPECT_EQ(BlockedBloomFilter{16}.block_count(), 1);
+  EXPECT_EQ(BlockedBloomFilter{17}.block_count(), 2);
+  EXPECT_EQ(BlockedBloomFilter{100'000}.block_count(), 6'250);
+  EXPECT_EQ(BlockedBloomFilter{size_t{1} << 40}.block_count(), BlockedBloomFilter::MAX_BLOCK_COUNT);
+}
+
+TEST_F(BlockedBloomFilterTest, InsertAndContains) {
+  const auto hash_function = std::hash<int>{};
+  auto bloom_filter = BlockedBloomFilter{10'000};
+
+  for (auto value = 0; value < 10'000; ++value) {
+    bloom_filter.insert(hash_function(value * 2));
+    EXPECT_TRUE(bloom_filter.contains(hash_function(value * 2)));
+  }
+
+  // No false negatives
+  for (auto value = 0; value < 10'000; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(hash_function(value * 2)));
+  }
+
+  // The expected false positive rate is about 0.15%. Allow for some variance.
+  auto false_positive_count = 0;
+  for (auto value = 0; value < 10'000; ++value) {
+    false_positive_count += bloom_filter.contains(hash_function(value * 2 + 1));
+  }
+  EXPECT_LT(false_positive_count, 50);
+}
+
+TEST_F(BlockedBloomFilterTest, ConcurrentInserts) {
+  const auto hash_function = std::hash<int>{};
+  const auto thread_count = 4;
+  const auto values_per_thread = 10'000;
+  auto bloom_filter = BlockedBloomFilter{thread_count * values_per_thread};
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto value = thread_id; value < thread_count * values_per_thread; value += thread_count) {
+        bloom_filter.insert(hash_function(value));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto value = 0; value < thread_count * values_per_thread; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(hash_function(value)));
+  }
+}
+
+TEST_F(BlockedBloomFilterTest, AllTrue) {
+  const auto& bloom_filter = BlockedBloomFilter::all_true();
+  for (auto value = -1'000; value < 1'000; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(value)));
+  }
+}
+
+TEST_F(BlockedBloomFilterTest, ProbeStatistics) {
+  auto bloom_filter = BlockedBloomFilter{10};
+  EXPECT_FALSE(bloom_filter.probe_statistics().selectivity());
+
+  bloom_filter.record_probes(10, 2);
+  bloom_filter.record_probes(30, 8);
+
+  const auto probe_statistics = bloom_filter.probe_statistics();
+  EXPECT_EQ(probe_statistics.probed_count, 40);
+  EXPECT_EQ(probe_statistics.passed_count, 10);
+  EXPECT_DOUBLE_EQ(*probe_statistics.selectivity(), 0.25);
+}
+
+}  // namespace opossum
@@ -0,0 +1,160 @@
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+#include "lib/utils/plugin_test_utils.hpp"
+
+#include "../../plugins/chunk_compression_plugin.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+#include "utils/plugin_manager.hpp"
+
+namespace opossum {
+
+class ChunkCompressionPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}};
+    _table = std::make_shared<Table>(column_definitions, TableType::Data, _chunk_size, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  void _insert_rows(const size_t row_count,
+                    const std::shared_ptr<TransactionContext>& transaction_context = nullptr) const {
+    for (auto row_id = size_t{0}; row_id < row_count; ++row_id) {
+      const auto sql = "INSERT INTO " + _table_name + " VALUES (" + std::to_string(row_id) + ", 'value')";
+      auto builder = SQLPipelineBuilder{sql};
+      if (transaction_context) builder.with_transaction_context(transaction_context);
+      auto sql_pipeline = builder.create_pipeline();
+      const auto [pipeline_status, _] = sql_pipeline.get_result_table();
+      ASSERT_EQ(pipeline_status, SQLPipelineStatus::Success);
+    }
+  }
+
+  EncodingType _encoding_type(const ChunkID chunk_id, const ColumnID column_id) const {
+    return get_segment_encoding_spec(_table->get_chunk(chunk_id)->get_segment(column_id)).encoding_type;
+  }
+
+  static void _compression_loop(ChunkCompressionPlugin& plugin) { plugin._compression_loop(); }
+
+  ChunkCompressionPlugin _plugin;
+  std::shared_ptr<Table> _table;
+  const std::string _table_name{"compressionTestTable"};
+  static constexpr auto _chunk_size = ChunkOffset{4};
+};
+
+TEST_F(ChunkCompressionPluginTest, LoadUnloadPlugin) {
+  auto& pm = Hyrise::get().plugin_manager;
+  pm.load_plugin(build_dylib_path("libhyriseChunkCompressionPlugin"));
+  pm.unload_plugin("hyriseChunkCompressionPlugin");
+}
+
+TEST_F(ChunkCompressionPluginTest, EncodesCompletedChunks) {
+  _insert_rows(10);
+  ASSERT_EQ(_table->chunk_count(), 3);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Unencoded);
+
+  // Only one chunk is encoded per iteration
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Dictionary);
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{1}), EncodingType::Dictionary);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->pruning_statistics());
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{0}), EncodingType::Unencoded);
+
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{0}), EncodingType::Dictionary);
+
+  // The last chunk is not full yet
+  _compression_loop(_plugin);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{2})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{0}), EncodingType::Unencoded);
+
+  // Inserts continue to work and the data is unchanged
+  _insert_rows(4);
+  EXPECT_EQ(_table->chunk_count(), 4);
+  _compression_loop(_plugin);
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{0}), EncodingType::Dictionary);
+
+  auto sql_pipeline = SQLPipelineBuilder{"SELECT COUNT(*), SUM(a) FROM " + _table_name}.create_pipeline();
+  const auto [pipeline_status, result_table] = sql_pipeline.get_result_table();
+  EXPECT_EQ(result_table->get_value<int64_t>(ColumnID{0}, 0), 14);
+  EXPECT_EQ(result_table->get_value<int64_t>(ColumnID{1}, 0), 45 + 6);
+}
+
+TEST_F(ChunkCompressionPluginTest, SkipsChunksWithUncommittedInserts) {
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  _insert_rows(4, transaction_context);
+  _insert_rows(1);
+  ASSERT_EQ(_table->chunk_count(), 2);
+
+  _compression_loop(_plugin);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Unencoded);
+
+  transaction_context->commit();
+
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Dictionary);
+}
+
+TEST_F(ChunkCompressionPluginTest, EncodesRolledBackInserts) {
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  _insert_rows(4, transaction_context);
+  _insert_rows(1);
+  transaction_context->rollback(RollbackReason::User);
+
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Dictionary);
+}
+
+TEST_F(ChunkCompressionPluginTest, UsesEncodingOfFinalizedChunks) {
+  _insert_rows(8);
+  ASSERT_EQ(_table->chunk_count(), 2);
+
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  chunk->finalize();
+  ChunkEncoder::encode_chunk(chunk, _table->column_data_types(),
+                             ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::FrameOfReference},
+                                               SegmentEncodingSpec{EncodingType::Unencoded}});
+
+  // The second column was deliberately left unencoded in chunk 0, so it stays unencoded in both chunks
+  _compression_loop(_plugin);
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::FrameOfReference);
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{1}), EncodingType::Unencoded);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{0}), EncodingType::FrameOfReference);
+  EXPECT_EQ(_encoding_type(ChunkID{1}, ColumnID{1}), EncodingType::Unencoded);
+
+  // If the first chunk is completely unencoded, completed chunks are only finalized
+  ChunkEncoder::encode_chunk(chunk, _table->column_data_types(), SegmentEncodingSpec{EncodingType::Unencoded});
+  _insert_rows(4);
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{2})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{0}), EncodingType::Unencoded);
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{1}), EncodingType::Unencoded);
+}
+
+TEST_F(ChunkCompressionPluginTest, UsesEncodingSpec) {
+  _plugin.set_encoding_spec(_table_name, ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::RunLength},
+                                                           SegmentEncodingSpec{EncodingType::Unencoded}});
+  _insert_rows(5);
+
+  _compression_loop(_plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->is_mutable());
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::RunLength);
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{1}), EncodingType::Unencoded);
+}
+
+}  // namespace opossum
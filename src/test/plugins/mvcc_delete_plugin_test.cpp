@@ -15,6 +15,8 @@
 #include "operators/table_scan.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "utils/load_table.hpp"
@@ -65,10 +67,19 @@ class MvccDeletePluginTest : public BaseTest {
                                   std::shared_ptr<TransactionContext> transaction_context) {
     return MvccDeletePlugin::_try_logical_delete(table_name, chunk_id, transaction_context);
   }
+  static bool _try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids) {
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    return MvccDeletePlugin::_try_logical_delete(table_name, chunk_ids, transaction_context);
+  }
   static void _delete_chunk_physically(const std::string& table_name, ChunkID chunk_id) {
     MvccDeletePlugin::_delete_chunk_physically(Hyrise::get().storage_manager.get_table(table_name), chunk_id);
   }
 
+  static uint64_t _chunk_access_count(const Chunk& chunk) { return MvccDeletePlugin::_chunk_access_count(chunk); }
+  static double _invalidated_rows_threshold(const double relative_access_count) {
+    return MvccDeletePlugin::_invalidated_rows_threshold(relative_access_count);
+  }
+
   static int _get_int_value_from_table(const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
                                        const ColumnID column_id, const ChunkOffset chunk_offset) {
     const auto& segment = table->get_chunk(chunk_id)->get_segment(column_id);
@@ -209,4 +220,68 @@ TEST_F(MvccDeletePluginTest, PhysicalDelete) {
   EXPECT_TRUE(table->get_chunk(chunk_to_delete_id) == nullptr);
 }
 
+/**
+ * This test checks that several sparse chunks are compacted in a single transaction. Their valid rows end up in a new
+ * chunk, which is finalized and encoded like the chunks it replaces.
+ */
+TEST_F(MvccDeletePluginTest, CompactMultipleChunks) {
+  const auto table_name = std::string{"mvccCompactionTable"};
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             ChunkOffset{4}, UseMvcc::Yes);
+  for (auto value = 0; value < 12; ++value) {
+    table->append({value});
+  }
+  ChunkEncoder::encode_chunks(table, {ChunkID{0}, ChunkID{1}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  Hyrise::get().storage_manager.add_table(table_name, table);
+
+  // --- Invalidate half of the rows in chunks 0 and 1
+  // --- Expected: _, _, 2, 3 | _, _, 6, 7 | 8, 9, 10, 11
+  {
+    auto pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a IN (0, 1, 4, 5)"}.create_pipeline();
+    (void)pipeline.get_result_table();
+  }
+
+  EXPECT_TRUE(_try_logical_delete(table_name, std::vector<ChunkID>{ChunkID{0}, ChunkID{1}}));
+  // --- Expected: _, _, _, _ | _, _, _, _ | 8, 9, 10, 11 | 2, 3, 6, 7
+  EXPECT_EQ(table->chunk_count(), 4);
+  const auto cleanup_commit_id = table->get_chunk(ChunkID{0})->get_cleanup_commit_id();
+  ASSERT_TRUE(cleanup_commit_id);
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->get_cleanup_commit_id(), cleanup_commit_id);
+  EXPECT_FALSE(table->get_chunk(ChunkID{2})->get_cleanup_commit_id());
+
+  const auto compacted_chunk = table->get_chunk(ChunkID{3});
+  EXPECT_EQ(compacted_chunk->size(), 4);
+  EXPECT_FALSE(compacted_chunk->is_mutable());
+  EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<int32_t>>(compacted_chunk->get_segment(ColumnID{0})));
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 4; ++chunk_offset) {
+    EXPECT_EQ(_get_int_value_from_table(table, ChunkID{3}, ColumnID{0}, chunk_offset),
+              std::vector<int>({2, 3, 6, 7})[chunk_offset]);
+  }
+
+  auto pipeline = SQLPipelineBuilder{"SELECT SUM(a) FROM " + table_name}.create_pipeline();
+  const auto [pipeline_status, result_table] = pipeline.get_result_table();
+  EXPECT_EQ(result_table->get_value<int64_t>(ColumnID{0}, 0), 2 + 3 + 6 + 7 + 8 + 9 + 10 + 11);
+
+  _delete_chunk_physically(table_name, ChunkID{0});
+  _delete_chunk_physically(table_name, ChunkID{1});
+  EXPECT_EQ(table->get_chunk(ChunkID{0}), nullptr);
+  EXPECT_EQ(table->get_chunk(ChunkID{1}), nullptr);
+}
+
+TEST_F(MvccDeletePluginTest, InvalidatedRowsThreshold) {
+  // Chunks that are not scanned keep the default threshold, the most frequently scanned chunk is cleaned up earliest
+  EXPECT_DOUBLE_EQ(_invalidated_rows_threshold(0.0), MvccDeletePlugin::DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS);
+  EXPECT_DOUBLE_EQ(_invalidated_rows_threshold(1.0),
+                   MvccDeletePlugin::DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS_HOT);
+  EXPECT_DOUBLE_EQ(_invalidated_rows_threshold(0.5), 0.4);
+
+  const auto table = Hyrise::get().storage_manager.get_table(_table_name);
+  const auto& chunk = *table->get_chunk(ChunkID{0});
+  const auto access_count = _chunk_access_count(chunk);
+
+  auto pipeline = SQLPipelineBuilder{"SELECT * FROM " + _table_name + " WHERE a > 1"}.create_pipeline();
+  (void)pipeline.get_result_table();
+  EXPECT_GT(_chunk_access_count(chunk), access_count);
+}
+
 }  // namespace opossum